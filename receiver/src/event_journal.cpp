@@ -0,0 +1,315 @@
+/**
+ * @file event_journal.cpp
+ * @brief Append-only binary event journal implementation
+ * @version 1.0.0
+ * @date 2026-10-17
+ */
+
+#include "event_journal.hpp"
+
+static const uint32_t RECORD_SIZE = sizeof(JournalRecord);
+
+// Left untouched by the bootloader on resets other than power-on
+RTC_NOINIT_ATTR static RetainedJournalBatch pending;
+
+EventJournal::EventJournal() : partition(nullptr), sectorCount(0), writeOffset(0),
+                               nextSequence(0), bootCount(0), mounted(false),
+                               oldestPendingMs(0), flushDue(false),
+                               droppedCount(0), pageWrites(0), sectorErases(0) {
+    lock = portMUX_INITIALIZER_UNLOCKED;
+}
+
+uint8_t EventJournal::crc8(const uint8_t *data, size_t length) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+bool EventJournal::isValid(const JournalRecord &record) {
+    return record.sequence != JOURNAL_ERASED_SEQUENCE &&
+           record.crc == crc8((const uint8_t *)&record, RECORD_SIZE - 1);
+}
+
+void EventJournal::commitBatch() {
+    pending.magic = JOURNAL_RETAINED_MAGIC;
+    pending.crc = crc8((const uint8_t *)&pending, offsetof(RetainedJournalBatch, crc));
+}
+
+bool EventJournal::setup(bool warmReset) {
+    // RTC memory holds garbage after power-on; after a warm reset it may hold a batch
+    bool intact = pending.magic == JOURNAL_RETAINED_MAGIC && pending.count <= JOURNAL_PAGE_RECORDS &&
+                  pending.crc == crc8((const uint8_t *)&pending, offsetof(RetainedJournalBatch, crc));
+    if (!warmReset || !intact) {
+        pending.count = 0;
+        commitBatch();
+    }
+
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                         (esp_partition_subtype_t)JOURNAL_PARTITION_SUBTYPE,
+                                         JOURNAL_PARTITION_LABEL);
+    if (!partition) {
+        Serial.println("ERROR: Journal partition not found (check board_build.partitions)");
+        return false;
+    }
+
+    sectorCount = partition->size / JOURNAL_SECTOR_SIZE;
+    if (sectorCount < 2) {
+        Serial.println("ERROR: Journal partition needs at least two sectors");
+        return false;
+    }
+
+    if (!locateEnd()) {
+        return false;
+    }
+
+    mounted = true;
+    recoverBatch();
+    Serial.printf("Event journal: %lu KB, boot %u, next record %lu at offset 0x%lx\n",
+                  (unsigned long)(sectorCount * JOURNAL_SECTOR_SIZE / 1024), bootCount,
+                  (unsigned long)nextSequence, (unsigned long)writeOffset);
+    return true;
+}
+
+bool EventJournal::locateEnd() {
+    // The sector whose first record has the highest sequence holds the log head
+    bool found = false;
+    uint32_t newestSector = 0;
+    uint32_t newestSequence = 0;
+    for (uint32_t sector = 0; sector < sectorCount; sector++) {
+        JournalRecord first;
+        if (esp_partition_read(partition, sector * JOURNAL_SECTOR_SIZE, &first, RECORD_SIZE) != ESP_OK) {
+            Serial.println("ERROR: Journal read failed");
+            return false;
+        }
+        if (isValid(first) && (!found || first.sequence > newestSequence)) {
+            found = true;
+            newestSector = sector;
+            newestSequence = first.sequence;
+        }
+    }
+
+    if (!found) {
+        // Empty (or foreign) partition - start a fresh log at sector 0
+        writeOffset = 0;
+        nextSequence = 0;
+        bootCount = 0;
+        return true;
+    }
+
+    // Walk the head sector a page at a time to its first free slot
+    JournalRecord page[JOURNAL_PAGE_RECORDS];
+    JournalRecord last = {};
+    uint32_t sectorStart = newestSector * JOURNAL_SECTOR_SIZE;
+    writeOffset = sectorStart + JOURNAL_SECTOR_SIZE;
+    for (uint32_t offset = sectorStart; offset < sectorStart + JOURNAL_SECTOR_SIZE; offset += sizeof(page)) {
+        if (esp_partition_read(partition, offset, page, sizeof(page)) != ESP_OK) {
+            Serial.println("ERROR: Journal read failed");
+            return false;
+        }
+        bool freeSlotFound = false;
+        for (uint32_t i = 0; i < JOURNAL_PAGE_RECORDS; i++) {
+            if (page[i].sequence == JOURNAL_ERASED_SEQUENCE) {
+                writeOffset = offset + i * RECORD_SIZE;
+                freeSlotFound = true;
+                break;
+            }
+            if (isValid(page[i])) {
+                last = page[i];
+            }
+        }
+        if (freeSlotFound) {
+            break;
+        }
+    }
+
+    if (writeOffset >= sectorCount * JOURNAL_SECTOR_SIZE) {
+        writeOffset = 0;
+    }
+    nextSequence = last.sequence + 1;
+    bootCount = last.bootCount + 1;
+    return true;
+}
+
+void EventJournal::recoverBatch() {
+    // Records not yet in flash when the last boot ended - a flush cut short
+    // by the reset may already have written some of them
+    JournalRecord batch[JOURNAL_PAGE_RECORDS];
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < pending.count; i++) {
+        if (isValid(pending.records[i]) && pending.records[i].sequence >= nextSequence) {
+            batch[count++] = pending.records[i];
+        }
+    }
+    pending.count = 0;
+    commitBatch();
+
+    if (count == 0) {
+        return;
+    }
+    if (writeRecords(batch, count)) {
+        Serial.printf("Event journal: %u records from before the reset recovered\n", count);
+    }
+    nextSequence = batch[count - 1].sequence + 1;
+    bootCount = batch[count - 1].bootCount + 1;
+}
+
+void EventJournal::log(JournalEventType type, uint8_t channel, uint8_t code, int16_t value1, int8_t value2) {
+    if (!mounted) {
+        return;
+    }
+
+    portENTER_CRITICAL(&lock);
+    if (pending.count >= JOURNAL_PAGE_RECORDS) {
+        droppedCount++;
+        portEXIT_CRITICAL(&lock);
+        return;
+    }
+
+    JournalRecord &record = pending.records[pending.count];
+    record.sequence = nextSequence++;
+    record.uptimeMs = millis();
+    record.bootCount = bootCount;
+    record.type = type;
+    record.channel = channel;
+    record.code = code;
+    record.value1 = value1;
+    record.value2 = value2;
+    record.crc = crc8((const uint8_t *)&record, RECORD_SIZE - 1);
+
+    if (pending.count == 0) {
+        oldestPendingMs = record.uptimeMs;
+    }
+    if (type == JOURNAL_RELAY || type == JOURNAL_SAFETY_TIMEOUT) {
+        flushDue = true; // Stove switching is what the journal is read for
+    }
+    pending.count++; // Record complete before it is counted
+    commitBatch();
+    portEXIT_CRITICAL(&lock);
+}
+
+void EventJournal::service() {
+    if (pending.count == 0) {
+        return;
+    }
+    if (flushDue || pending.count >= JOURNAL_PAGE_RECORDS ||
+        millis() - oldestPendingMs >= JOURNAL_FLUSH_INTERVAL_MS) {
+        flush();
+    }
+}
+
+bool EventJournal::flush() {
+    if (!mounted) {
+        return false;
+    }
+
+    // Take the batch under the lock, program flash outside it
+    JournalRecord batch[JOURNAL_PAGE_RECORDS];
+    portENTER_CRITICAL(&lock);
+    uint8_t count = pending.count;
+    memcpy(batch, pending.records, count * RECORD_SIZE);
+    flushDue = false;
+    portEXIT_CRITICAL(&lock);
+
+    if (count == 0) {
+        return true;
+    }
+    bool written = writeRecords(batch, count);
+
+    // Keep the batch in RTC memory until it is in flash; log() may have added to it meanwhile
+    portENTER_CRITICAL(&lock);
+    pending.count -= count;
+    memmove(pending.records, &pending.records[count], pending.count * RECORD_SIZE);
+    if (pending.count > 0) {
+        oldestPendingMs = pending.records[0].uptimeMs;
+    }
+    commitBatch();
+    portEXIT_CRITICAL(&lock);
+    return written;
+}
+
+bool EventJournal::writeRecords(const JournalRecord *records, uint8_t count) {
+    uint8_t written = 0;
+    while (written < count) {
+        // Entering a sector means it holds the oldest data - recycle it
+        if (writeOffset % JOURNAL_SECTOR_SIZE == 0) {
+            if (esp_partition_erase_range(partition, writeOffset, JOURNAL_SECTOR_SIZE) != ESP_OK) {
+                Serial.println("ERROR: Journal sector erase failed");
+                return false;
+            }
+            sectorErases++;
+        }
+
+        uint32_t room = (JOURNAL_SECTOR_SIZE - writeOffset % JOURNAL_SECTOR_SIZE) / RECORD_SIZE;
+        uint8_t chunk = (count - written) < room ? (count - written) : room;
+        if (esp_partition_write(partition, writeOffset, &records[written], chunk * RECORD_SIZE) != ESP_OK) {
+            Serial.println("ERROR: Journal write failed");
+            return false;
+        }
+        pageWrites++;
+
+        written += chunk;
+        writeOffset += chunk * RECORD_SIZE;
+        if (writeOffset >= sectorCount * JOURNAL_SECTOR_SIZE) {
+            writeOffset = 0;
+        }
+    }
+    return true;
+}
+
+uint32_t EventJournal::streamRecords(Stream *out) {
+    // Oldest data starts in the sector after the head; the head sector comes last
+    uint32_t headSector = writeOffset / JOURNAL_SECTOR_SIZE;
+    uint32_t count = 0;
+    JournalRecord page[JOURNAL_PAGE_RECORDS];
+
+    for (uint32_t n = 1; n <= sectorCount; n++) {
+        uint32_t sectorStart = ((headSector + n) % sectorCount) * JOURNAL_SECTOR_SIZE;
+        for (uint32_t offset = sectorStart; offset < sectorStart + JOURNAL_SECTOR_SIZE; offset += sizeof(page)) {
+            if (esp_partition_read(partition, offset, page, sizeof(page)) != ESP_OK) {
+                return count;
+            }
+            for (uint32_t i = 0; i < JOURNAL_PAGE_RECORDS; i++) {
+                if (page[i].sequence == JOURNAL_ERASED_SEQUENCE) {
+                    continue;
+                }
+                if (out) {
+                    out->write((const uint8_t *)&page[i], RECORD_SIZE);
+                }
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+void EventJournal::dump(Stream &out) {
+    if (!mounted) {
+        out.println("JOURNAL UNAVAILABLE");
+        return;
+    }
+
+    flush();
+    uint32_t count = streamRecords(nullptr);
+    out.printf("JOURNAL BEGIN %lu %lu\n", (unsigned long)count, (unsigned long)RECORD_SIZE);
+    streamRecords(&out);
+    out.println("JOURNAL END");
+}
+
+String EventJournal::getStatistics() const {
+    if (!mounted) {
+        return String("journal unavailable");
+    }
+
+    char buffer[160];
+    snprintf(buffer, sizeof(buffer),
+             "journal %lu KB, boot %u, next record %lu, page writes %lu, sector erases %lu, dropped %lu",
+             (unsigned long)(sectorCount * JOURNAL_SECTOR_SIZE / 1024), bootCount,
+             (unsigned long)nextSequence, (unsigned long)pageWrites,
+             (unsigned long)sectorErases, (unsigned long)droppedCount);
+    return String(buffer);
+}
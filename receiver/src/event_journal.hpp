@@ -0,0 +1,171 @@
+/**
+ * @file event_journal.hpp
+ * @brief Append-only binary event journal in a dedicated flash partition
+ * @version 1.0.0
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <esp_partition.h>
+
+// Configuration
+#define JOURNAL_PARTITION_LABEL "journal" // See receiver/partitions.csv
+#define JOURNAL_PARTITION_SUBTYPE 0x40    // Custom data subtype
+#define JOURNAL_SECTOR_SIZE 4096          // Flash erase unit
+#define JOURNAL_PAGE_RECORDS 16           // 16 records x 16 bytes = one 256-byte flash page
+#define JOURNAL_FLUSH_INTERVAL_MS 60000   // Longest a record waits in RAM before it is written
+#define JOURNAL_ERASED_SEQUENCE 0xFFFFFFFF
+#define JOURNAL_RETAINED_MAGIC 0x4A524E4C // "JRNL"
+
+/**
+ * @enum JournalEventType
+ * @brief What a journal record describes
+ */
+enum JournalEventType : uint8_t
+{
+    JOURNAL_BOOT = 1,           // code = reset reason, value1 = relay channel count
+    JOURNAL_COMMAND = 2,        // channel = source node, code = JournalCommandCode, value1/value2 = RSSI/SNR
+    JOURNAL_RELAY = 3,          // channel = relay channel, code = new state (0 OFF, 1 ON), value1 = 1 if resumed after a reset
+    JOURNAL_SAFETY_TIMEOUT = 4, // channel = relay channel, value1 = cutoff latency (ms)
+    JOURNAL_LINK = 5,           // value1/value2 = RSSI/SNR of the last packet
+    JOURNAL_HEATER_FAULT = 6    // channel = relay channel, code = thermostat's heater alarm (0 cleared, 1 no heat, 2 stuck ON)
+};
+
+/**
+ * @enum JournalCommandCode
+ * @brief Received command, compressed to one byte
+ */
+enum JournalCommandCode : uint8_t
+{
+    JOURNAL_CMD_UNKNOWN = 0,
+    JOURNAL_CMD_STOVE_ON = 1,
+    JOURNAL_CMD_STOVE_OFF = 2,
+    JOURNAL_CMD_STATUS_REQUEST = 3
+};
+
+/**
+ * @struct JournalRecord
+ * @brief One 16-byte journal entry as stored in flash
+ */
+struct __attribute__((packed)) JournalRecord
+{
+    uint32_t sequence;  // Monotonic across reboots, JOURNAL_ERASED_SEQUENCE = free slot
+    uint32_t uptimeMs;  // millis() when the event was logged
+    uint8_t bootCount;  // Increments on every boot (wraps)
+    uint8_t type;       // JournalEventType
+    uint8_t channel;    // Relay channel or node ID, see JournalEventType
+    uint8_t code;       // Event-specific code
+    int16_t value1;     // Event-specific value
+    int8_t value2;      // Event-specific value
+    uint8_t crc;        // CRC-8 over the preceding 15 bytes
+};
+static_assert(sizeof(JournalRecord) == 16, "JournalRecord must stay 16 bytes");
+
+/**
+ * @struct RetainedJournalBatch
+ * @brief Records waiting for the next page write, kept in RTC slow memory (survives resets, not power loss)
+ */
+struct RetainedJournalBatch
+{
+    uint32_t magic;
+    uint8_t count;                               // Records in the batch
+    uint8_t crc;                                 // CRC-8 over magic and count, each record carries its own
+    JournalRecord records[JOURNAL_PAGE_RECORDS];
+};
+
+/**
+ * @class EventJournal
+ * @brief Circular log of receiver events with wear leveling and batched writes
+ *
+ * Records are buffered in RTC memory and programmed one flash page at a time,
+ * at most once per JOURNAL_FLUSH_INTERVAL_MS unless the page fills up or a
+ * relay switch or safety timeout is logged. A batch cut short by a watchdog
+ * or panic reset is written out by the next setup(). The
+ * partition is used as a ring of sectors: writes advance linearly and the
+ * oldest sector is erased only when the log wraps into it. Every sector
+ * therefore sees the same erase count. With a status request every 30 s, a
+ * 512 KB partition holds about ten days of events. Each sector is then erased
+ * roughly once every ten days, far below the flash's endurance.
+ *
+ * log() may be called from either core; flush and dump run on the control core.
+ */
+class EventJournal
+{
+private:
+    const esp_partition_t *partition;
+    uint32_t sectorCount;
+    uint32_t writeOffset;  // Next free byte in the partition
+    uint32_t nextSequence;
+    uint8_t bootCount;
+    bool mounted;
+
+    // Batch waiting for the next page write (the records live in RTC memory)
+    unsigned long oldestPendingMs;
+    bool flushDue; // A record that must reach flash without waiting for the interval
+    portMUX_TYPE lock;
+
+    // Statistics
+    uint32_t droppedCount;
+    uint32_t pageWrites;
+    uint32_t sectorErases;
+
+    static uint8_t crc8(const uint8_t *data, size_t length);
+    static bool isValid(const JournalRecord &record);
+    static void commitBatch();
+    void recoverBatch();
+    bool locateEnd();
+    bool writeRecords(const JournalRecord *records, uint8_t count);
+    uint32_t streamRecords(Stream *out); // nullptr = count only
+
+public:
+    /**
+     * @brief Constructor
+     */
+    EventJournal();
+
+    /**
+     * @brief Find the journal partition and the end of the existing log
+     * @param warmReset true after a watchdog, panic or software reset: records
+     *                  still waiting in RTC memory are written to flash first
+     * @return true if the journal is usable
+     */
+    bool setup(bool warmReset);
+
+    /**
+     * @brief Append an event (buffered, never touches flash)
+     * Relay switches and safety timeouts make the next service() write the batch.
+     * @param type Event type
+     * @param channel Relay channel or node ID
+     * @param code Event-specific code
+     * @param value1 Event-specific value
+     * @param value2 Event-specific value
+     */
+    void log(JournalEventType type, uint8_t channel, uint8_t code, int16_t value1 = 0, int8_t value2 = 0);
+
+    /**
+     * @brief Write the batch when it is full, old enough or holds a relay event (call from loop())
+     */
+    void service();
+
+    /**
+     * @brief Write the batch now
+     * @return true if everything buffered reached flash
+     */
+    bool flush();
+
+    /**
+     * @brief Stream the whole journal, oldest first, as raw records
+     * Format: "JOURNAL BEGIN <count> <record size>\n", binary records, "JOURNAL END\n".
+     * Decode with tools/decode_journal.py.
+     * @param out Output stream (normally Serial)
+     */
+    void dump(Stream &out);
+
+    /**
+     * @brief Get journal usage as a printable string
+     * @return Statistics string
+     */
+    String getStatistics() const;
+};
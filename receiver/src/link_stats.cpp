@@ -0,0 +1,161 @@
+/**
+ * @file link_stats.cpp
+ * @brief Per-sender link quality statistics implementation
+ * @version 1.0.0
+ * @date 2026-10-17
+ */
+
+#include "link_stats.hpp"
+
+LinkStats::LinkStats() {
+    memset(senders, 0, sizeof(senders));
+}
+
+LinkStats::Sender *LinkStats::findOrAdd(uint8_t nodeId) {
+    Sender *oldest = &senders[0];
+    for (size_t i = 0; i < LINK_STATS_MAX_SENDERS; i++) {
+        Sender &sender = senders[i];
+        if (sender.active && sender.nodeId == nodeId) {
+            return &sender;
+        }
+        if (!sender.active) {
+            oldest = &sender; // A free slot beats any eviction
+        } else if (oldest->active && sender.lastArrivalUs < oldest->lastArrivalUs) {
+            oldest = &sender;
+        }
+    }
+
+    memset(oldest, 0, sizeof(Sender));
+    oldest->active = true;
+    oldest->nodeId = nodeId;
+    return oldest;
+}
+
+const LinkStats::Sender *LinkStats::find(uint8_t nodeId) const {
+    for (size_t i = 0; i < LINK_STATS_MAX_SENDERS; i++) {
+        if (senders[i].active && senders[i].nodeId == nodeId) {
+            return &senders[i];
+        }
+    }
+    return nullptr;
+}
+
+void LinkStats::record(uint8_t nodeId, int16_t rssi, int8_t snr, int64_t arrivalUs, int32_t sequence) {
+    Sender *sender = findOrAdd(nodeId);
+
+    // Sequence gaps -> lost packets (16-bit counter, wraps)
+    uint8_t gap = 0;
+    if (sequence != LINK_STATS_NO_SEQUENCE) {
+        if (sender->hasSequence) {
+            uint16_t missing = (uint16_t)((uint16_t)sequence - sender->lastSequence - 1);
+            if (missing <= LINK_STATS_MAX_GAP) {
+                gap = (uint8_t)missing;
+                sender->lost += missing;
+            }
+        }
+        sender->hasSequence = true;
+        sender->lastSequence = (uint16_t)sequence;
+    }
+
+    uint32_t intervalMs = 0;
+    if (sender->received > 0) {
+        intervalMs = (uint32_t)((arrivalUs - sender->lastArrivalUs) / 1000);
+        sender->rssiEwma += LINK_STATS_EWMA_ALPHA * (rssi - sender->rssiEwma);
+        sender->snrEwma += LINK_STATS_EWMA_ALPHA * (snr - sender->snrEwma);
+    } else {
+        sender->rssiEwma = rssi;
+        sender->snrEwma = snr;
+    }
+
+    sender->rssi[sender->head] = rssi;
+    sender->snr[sender->head] = snr;
+    sender->gap[sender->head] = gap;
+    sender->intervalMs[sender->head] = intervalMs;
+    sender->head = (sender->head + 1) % LINK_STATS_WINDOW;
+    if (sender->count < LINK_STATS_WINDOW) {
+        sender->count++;
+    }
+
+    sender->lastArrivalUs = arrivalUs;
+    sender->received++;
+}
+
+bool LinkStats::getSummary(uint8_t nodeId, LinkSummary &summary) const {
+    const Sender *sender = find(nodeId);
+    if (!sender || sender->count == 0) {
+        return false;
+    }
+
+    memset(&summary, 0, sizeof(summary));
+    summary.nodeId = nodeId;
+    summary.samples = sender->count;
+    summary.rssiMin = summary.rssiMax = sender->rssi[0];
+    summary.snrMin = summary.snrMax = sender->snr[0];
+    summary.rssiEwma = sender->rssiEwma;
+    summary.snrEwma = sender->snrEwma;
+    summary.received = sender->received;
+    summary.lost = sender->lost;
+
+    uint32_t lostInWindow = 0;
+    uint32_t intervalTotal = 0;
+    uint32_t intervalCount = 0;
+    for (uint8_t i = 0; i < sender->count; i++) {
+        if (sender->rssi[i] < summary.rssiMin) summary.rssiMin = sender->rssi[i];
+        if (sender->rssi[i] > summary.rssiMax) summary.rssiMax = sender->rssi[i];
+        if (sender->snr[i] < summary.snrMin) summary.snrMin = sender->snr[i];
+        if (sender->snr[i] > summary.snrMax) summary.snrMax = sender->snr[i];
+        lostInWindow += sender->gap[i];
+
+        uint32_t interval = sender->intervalMs[i];
+        if (interval > 0) {
+            if (intervalCount == 0 || interval < summary.intervalMinMs) summary.intervalMinMs = interval;
+            if (interval > summary.intervalMaxMs) summary.intervalMaxMs = interval;
+            intervalTotal += interval;
+            intervalCount++;
+        }
+    }
+    if (intervalCount > 0) {
+        summary.intervalMeanMs = intervalTotal / intervalCount;
+    }
+
+    summary.hasErrorRate = sender->hasSequence;
+    if (summary.hasErrorRate) {
+        summary.errorPercent = (uint8_t)(lostInWindow * 100 / (lostInWindow + sender->count));
+    }
+    return true;
+}
+
+String LinkStats::addFields(const String &response, uint8_t nodeId) const {
+    LinkSummary summary;
+    if (!getSummary(nodeId, summary)) {
+        return response;
+    }
+
+    String frame = ProtocolHelper::addField(response, P2P_FIELD_LINK_RSSI, String((int)lroundf(summary.rssiEwma)));
+    frame = ProtocolHelper::addField(frame, P2P_FIELD_LINK_SNR, String((int)lroundf(summary.snrEwma)));
+    if (summary.hasErrorRate) {
+        frame = ProtocolHelper::addField(frame, P2P_FIELD_LINK_ERRORS, String(summary.errorPercent));
+    }
+    return frame;
+}
+
+String LinkStats::getStatistics() const {
+    String stats = "";
+    for (size_t i = 0; i < LINK_STATS_MAX_SENDERS; i++) {
+        LinkSummary s;
+        if (!senders[i].active || !getSummary(senders[i].nodeId, s)) {
+            continue;
+        }
+
+        char line[200];
+        snprintf(line, sizeof(line),
+                 "node %u: RSSI %d..%d (avg %.1f) dBm, SNR %d..%d (avg %.1f) dB, "
+                 "loss %s%u%%, interval %lu..%lu (mean %lu) ms, %lu received, %lu lost\n",
+                 s.nodeId, s.rssiMin, s.rssiMax, s.rssiEwma, s.snrMin, s.snrMax, s.snrEwma,
+                 s.hasErrorRate ? "" : "n/a ", s.errorPercent,
+                 (unsigned long)s.intervalMinMs, (unsigned long)s.intervalMaxMs,
+                 (unsigned long)s.intervalMeanMs, (unsigned long)s.received, (unsigned long)s.lost);
+        stats += line;
+    }
+    return stats.length() > 0 ? stats : String("no senders heard yet\n");
+}
@@ -0,0 +1,118 @@
+/**
+ * @file link_stats.hpp
+ * @brief Rolling per-sender link quality statistics
+ * @version 1.0.0
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "../../shared/protocol_common.hpp"
+
+// Configuration
+#define LINK_STATS_MAX_SENDERS 8 // Thermostats tracked at once (least recently heard is replaced)
+#define LINK_STATS_WINDOW 16     // Packets per sender kept for min/max/error rate
+#define LINK_STATS_EWMA_ALPHA 0.125f
+#define LINK_STATS_MAX_GAP 100   // Larger sequence jumps mean the sender restarted, not lost packets
+#define LINK_STATS_NO_SEQUENCE -1
+
+/**
+ * @struct LinkSummary
+ * @brief Link quality of one sender over the last LINK_STATS_WINDOW packets
+ */
+struct LinkSummary
+{
+    uint8_t nodeId;
+    uint8_t samples;        // Packets in the window
+    int16_t rssiMin;        // dBm
+    int16_t rssiMax;
+    float rssiEwma;
+    int8_t snrMin;          // dB
+    int8_t snrMax;
+    float snrEwma;
+    bool hasErrorRate;      // False until the sender has sent sequence numbers
+    uint8_t errorPercent;   // Lost / (lost + received) in the window
+    uint32_t intervalMinMs; // Inter-arrival times in the window, 0 if fewer than 2 packets
+    uint32_t intervalMaxMs;
+    uint32_t intervalMeanMs;
+    uint32_t received;      // Since boot
+    uint32_t lost;          // Since boot, from sequence gaps
+};
+
+/**
+ * @class LinkStats
+ * @brief Per-sender RSSI/SNR, packet loss and inter-arrival statistics
+ *
+ * Each sender gets fixed ring buffers of its last LINK_STATS_WINDOW packets
+ * and running EWMAs, so memory use is constant. Loss is estimated from
+ * gaps in the frame sequence numbers (P2P_FIELD_SEQUENCE). Frames we overhear
+ * for other receivers count too, because they travel the same path.
+ *
+ * Control core only.
+ */
+class LinkStats
+{
+private:
+    struct Sender
+    {
+        bool active;
+        uint8_t nodeId;
+        uint8_t head;  // Next ring slot
+        uint8_t count; // Valid ring entries
+        int16_t rssi[LINK_STATS_WINDOW];
+        int8_t snr[LINK_STATS_WINDOW];
+        uint8_t gap[LINK_STATS_WINDOW];         // Packets lost right before this one
+        uint32_t intervalMs[LINK_STATS_WINDOW]; // Time since the previous packet, 0 for the first
+        float rssiEwma;
+        float snrEwma;
+        bool hasSequence;
+        uint16_t lastSequence;
+        int64_t lastArrivalUs;
+        uint32_t received;
+        uint32_t lost;
+    };
+
+    Sender senders[LINK_STATS_MAX_SENDERS];
+
+    Sender *findOrAdd(uint8_t nodeId);
+    const Sender *find(uint8_t nodeId) const;
+
+public:
+    /**
+     * @brief Constructor
+     */
+    LinkStats();
+
+    /**
+     * @brief Record one received frame
+     * @param nodeId Sender node ID (P2P_NODE_ID_NONE for unaddressed senders)
+     * @param rssi Packet RSSI (dBm)
+     * @param snr Packet SNR (dB)
+     * @param arrivalUs esp_timer time of arrival
+     * @param sequence Frame sequence number, LINK_STATS_NO_SEQUENCE if absent
+     */
+    void record(uint8_t nodeId, int16_t rssi, int8_t snr, int64_t arrivalUs, int32_t sequence);
+
+    /**
+     * @brief Get the statistics of one sender
+     * @param nodeId Sender node ID
+     * @param summary Filled in when the sender is known
+     * @return true if the sender has been heard
+     */
+    bool getSummary(uint8_t nodeId, LinkSummary &summary) const;
+
+    /**
+     * @brief Append the sender's link quality fields (RSSI, SNR, error rate) to a response
+     * @param response Response frame
+     * @param nodeId Sender the response goes to
+     * @return Response with fields, unchanged if the sender is unknown
+     */
+    String addFields(const String &response, uint8_t nodeId) const;
+
+    /**
+     * @brief Get all senders' statistics as a printable string
+     * @return Statistics string, one line per sender
+     */
+    String getStatistics() const;
+};
@@ -15,7 +15,13 @@ LoRaReceiver::LoRaReceiver() :
     isInitialized(false),
     currentMode(LoRaCommunicationMode::P2P),
     quietLogCounter(0),
-    quietLogInterval(200) // Log every 200th check when no messages
+    quietLogInterval(200), // Log every 200th check when no messages
+    rxState(ContinuousRxState::IDLE),
+    rxArmTime(0),
+    rxLineLength(0),
+    rxLineOverflow(false),
+    lastRssi(0),
+    lastSnr(0)
 {
     // Constructor
 }
@@ -26,10 +32,22 @@ LoRaReceiver::~LoRaReceiver() {
     }
 }
 
-bool LoRaReceiver::setup(int rxPin, int txPin) {
+bool LoRaReceiver::setup(int rxPin, int txPin, bool fastResume) {
     this->rxPin = rxPin;
     this->txPin = txPin;
     
+    // Initialize UART for Grove-Wio-E5
+    loraSerial = new HardwareSerial(1); // Use UART1
+    modem.attach(loraSerial, rxPin, txPin);
+    
+    if (fastResume) {
+        if (resumeModem()) {
+            return true;
+        }
+        Serial.println("Fast resume failed - running full modem setup");
+        loraSerial->end();
+    }
+    
     Serial.printf("Setting up LoRa receiver on pins RX:%d, TX:%d\n", rxPin, txPin);
     Serial.println("IMPORTANT: Verify physical connections:");
     Serial.println("  Grove-Wio-E5 TX --> ESP32 RX (GPIO44/D6)");
@@ -37,154 +55,11 @@ bool LoRaReceiver::setup(int rxPin, int txPin) {
     Serial.println("  Grove-Wio-E5 VCC --> 3.3V");
     Serial.println("  Grove-Wio-E5 GND --> GND");
     
-    // Initialize UART for Grove-Wio-E5
-    loraSerial = new HardwareSerial(1); // Use UART1
-    
     Serial.println("Waiting for Grove-Wio-E5 and M5Dial to power up and stabilize...");
     Serial.printf("Initialization timeout: %d seconds\n", LORA_INIT_TIMEOUT_MS / 1000);
-    delay(3000); // Give module time to fully boot after power-on
-    
-    bool communicationEstablished = false;
     unsigned long initStartTime = millis();
     
-#if LORA_DISABLE_BAUD_SEARCH
-    // Use fixed baud rate - no search
-    Serial.printf("Using fixed baud rate: %d (baud search disabled)\n", LORA_FIXED_BAUD_RATE);
-    loraSerial->begin(LORA_FIXED_BAUD_RATE, SERIAL_8N1, rxPin, txPin);
-    
-    // Give module MUCH more time to fully boot - some modules need 5+ seconds
-    // Break up delay with watchdog resets to prevent timeout
-    Serial.println("Waiting for module to fully boot (5 seconds)...");
-    for (int i = 0; i < 10; i++) {
-        delay(500);
-        esp_task_wdt_reset();
-    }
-    
-    // Send multiple wake-up commands to ensure module is responsive
-    Serial.println("Sending wake-up sequence...");
-    for (int i = 0; i < 5; i++) {
-        clearSerialBuffer();
-        loraSerial->println();
-        delay(200);
-    }
-    clearSerialBuffer();
-    delay(500);
-    
-    // Try to connect with extended timeout for M5Dial to come online
-    int attempt = 0;
-    while (!communicationEstablished && (millis() - initStartTime < LORA_INIT_TIMEOUT_MS)) {
-        attempt++;
-        Serial.printf("Connection attempt %d (elapsed: %lu ms)...\n", 
-                     attempt, millis() - initStartTime);
-        esp_task_wdt_reset(); // Reset watchdog during attempts
-        
-        // Send wake-up bytes in case module is in low-power auto mode
-        // Based on andresoliva/LoRa-E5 library wake-up sequence
-        clearSerialBuffer();
-        loraSerial->write(0xFF);
-        loraSerial->write(0xFF);
-        loraSerial->write(0xFF);
-        loraSerial->write(0xFF);
-        delay(100);
-        
-        // Send wake-up sequence - send a blank line first to clear any buffer
-        clearSerialBuffer();
-        loraSerial->println();
-        delay(100);
-        clearSerialBuffer();
-        loraSerial->println("AT");
-        delay(100);
-        clearSerialBuffer();
-        
-        if (sendATCommand("AT", "OK", 3000)) {
-            Serial.printf("SUCCESS! Module responding at %d baud\n", LORA_FIXED_BAUD_RATE);
-            communicationEstablished = true;
-            break;
-        }
-        
-        // Check if ANY data was received
-        clearSerialBuffer();
-        loraSerial->println("AT");
-        delay(500);
-        if (loraSerial->available()) {
-            Serial.print("  Received data: ");
-            while (loraSerial->available()) {
-                Serial.printf("0x%02X ", loraSerial->read());
-            }
-            Serial.println("\n  (May indicate wrong baud rate or connection issue)");
-        } else {
-            Serial.println("  No response - waiting for M5Dial...");
-        }
-        
-        delay(2000); // Wait longer between attempts for M5Dial to initialize
-    }
-#else
-    // Try multiple baud rates - Grove-Wio-E5 can be 9600, 19200, or 115200
-    const int baudRates[] = {19200, 9600, 115200};
-    
-    for (int baud : baudRates) {
-        if (millis() - initStartTime >= LORA_INIT_TIMEOUT_MS) {
-            Serial.println("Initialization timeout reached");
-            break;
-        }
-        
-        Serial.printf("\nTrying baud rate: %d\n", baud);
-        esp_task_wdt_reset(); // Reset watchdog before trying new baud rate
-        
-        if (baud != 19200) {
-            loraSerial->end(); // End previous attempt (skip for first attempt)
-            delay(500);
-        }
-        loraSerial->begin(baud, SERIAL_8N1, rxPin, txPin);
-        
-        delay(2000); // Wait for module to stabilize
-        
-        // Send wake-up sequence
-        loraSerial->println();
-        delay(200);
-        loraSerial->println("AT");
-        delay(200);
-        clearSerialBuffer();
-        
-        // Test with multiple AT command attempts, respecting overall timeout
-        for (int attempt = 1; attempt <= 5; attempt++) {
-            if (millis() - initStartTime >= LORA_INIT_TIMEOUT_MS) {
-                Serial.println("Initialization timeout reached");
-                break;
-            }
-            
-            Serial.printf("  Attempt %d at %d baud (elapsed: %lu ms)...\n", 
-                         attempt, baud, millis() - initStartTime);
-            esp_task_wdt_reset(); // Reset watchdog during attempts
-            
-            if (sendATCommand("AT", "OK", 3000)) {
-                Serial.printf("SUCCESS! Module responding at %d baud\n", baud);
-                communicationEstablished = true;
-                break;
-            }
-            
-            // Check if ANY data was received
-            clearSerialBuffer();
-            loraSerial->println("AT");
-            delay(500);
-            if (loraSerial->available()) {
-                Serial.print("  Received garbage data: ");
-                while (loraSerial->available()) {
-                    Serial.printf("0x%02X ", loraSerial->read());
-                }
-                Serial.println("\n  (Wrong baud rate or connection issue)");
-            } else {
-                Serial.println("  No response - waiting for M5Dial...");
-            }
-            
-            delay(2000); // Wait longer between attempts
-        }
-        
-        if (communicationEstablished) break;
-    }
-#endif
-    
-    if (!communicationEstablished) {
+    if (!modem.connect()) {
         Serial.println("\n========================================");
         Serial.printf("FAILED: Could not communicate with module after %lu seconds!\n", 
                      (millis() - initStartTime) / 1000);
@@ -203,16 +78,7 @@ bool LoRaReceiver::setup(int rxPin, int txPin) {
     }
     
     Serial.println("Grove-Wio-E5 communication established");
-    
-    // Disable echo to prevent command echoing
-    Serial.println("Disabling echo mode...");
-    clearSerialBuffer();
-    delay(100);
-    if (sendATCommand("ATE0", "OK", 2000)) {
-        Serial.println("Echo disabled successfully");
-    } else {
-        Serial.println("Warning: Could not disable echo (continuing anyway)");
-    }
+    modem.disableEcho();
     
     // Reset module to ensure clean state
     if (!reset()) {
@@ -223,7 +89,6 @@ bool LoRaReceiver::setup(int rxPin, int txPin) {
     // Try P2P mode first (default)
     currentMode = LoRaCommunicationMode::P2P;
     if (configureP2P()) {
-        Serial.println("P2P mode configured successfully");
         isInitialized = true;
         return true;
     }
@@ -248,66 +113,62 @@ bool LoRaReceiver::setup(int rxPin, int txPin) {
     return true;
 }
 
-bool LoRaReceiver::configureP2P()
-{
-    Serial.println("Configuring P2P mode...");
-    
-    // Enter TEST mode for P2P communication
-    if (!sendATCommand("AT+MODE=TEST", "OK")) {
-        Serial.println("Failed to enter TEST mode");
+bool LoRaReceiver::resumeModem() {
+    // The modem is not reset together with the ESP32, so it is already booted
+    // at the configured baud rate; it may be asleep or still in RX mode
+    Serial.println("Fast resume: probing Grove-Wio-E5 without boot delays...");
+    rxState = ContinuousRxState::IDLE;
+    if (!modem.resume(LORA_FAST_RESUME_ATTEMPTS)) {
         return false;
     }
     
-    // Configure RF parameters for P2P using constants from protocol_common.hpp
-    String rfConfigCommand = "AT+TEST=RFCFG," + 
-                           String(P2P_FREQUENCY) + "," +  // Frequency in MHz (module converts to Hz)
-                           P2P_SPREADING_FACTOR + "," +
-                           P2P_BANDWIDTH + "," +
-                           P2P_CODING_RATE + "," +
-                           P2P_PREAMBLE_LENGTH + "," +
-                           P2P_TX_POWER;
+    sendATCommand("ATE0", "OK", 1000);
     
-    if (!sendATCommand(rfConfigCommand, "RFCFG")) {
-        Serial.println("Failed to configure P2P RF parameters");
+    // No module reset - P2P settings are simply written again
+    currentMode = LoRaCommunicationMode::P2P;
+    if (!configureP2P()) {
         return false;
     }
     
-    Serial.println("P2P mode configured successfully");
-    Serial.printf("Frequency: %d MHz, SF: %s, BW: %s, CR: %s, Power: %s dBm\n",
-                  P2P_FREQUENCY, P2P_SPREADING_FACTOR, P2P_BANDWIDTH, 
-                  P2P_CODING_RATE, P2P_TX_POWER);
-    
+    isInitialized = true;
+    Serial.println("Fast resume: P2P link restored");
     return true;
 }
 
+bool LoRaReceiver::configureP2P()
+{
+    rxState = ContinuousRxState::IDLE;
+    return modem.configureP2P();
+}
+
 bool LoRaReceiver::configureLoRaWAN() {
     Serial.println("Configuring LoRaWAN settings...");
     
-    // Set to LoRaWAN mode
-    if (!sendATCommand("AT+MODE=LWOTAA", "OK")) {
+    // Set to LoRaWAN mode - replies echo the setting ("+MODE: LWOTAA"), not "OK"
+    if (!sendATCommand("AT+MODE=LWOTAA", "LWOTAA")) {
         return false;
     }
     
     // Set region (US915 for North America, EU868 for Europe)
     // Adjust this based on your region
-    if (!sendATCommand("AT+DR=US915", "OK")) {
+    if (!sendATCommand("AT+DR=US915", "US915")) {
         return false;
     }
     
     // Set data rate
-    if (!sendATCommand("AT+DR=5", "OK")) {
+    if (!sendATCommand("AT+DR=5", "DR")) {
         return false;
     }
     
     // Configure keys (these should match your transmitter)
     // Keys are defined in secrets.h for security
-    String appEuiCommand = "AT+APPEUI=" + String(LORAWAN_APP_EUI);
-    if (!sendATCommand(appEuiCommand, "OK")) {
+    String appEuiCommand = "AT+ID=APPEUI," + String(LORAWAN_APP_EUI);
+    if (!sendATCommand(appEuiCommand, "APPEUI")) {
         return false;
     }
     
-    String appKeyCommand = "AT+APPKEY=" + String(LORAWAN_APP_KEY);
-    if (!sendATCommand(appKeyCommand, "OK")) {
+    String appKeyCommand = "AT+KEY=APPKEY," + String(LORAWAN_APP_KEY);
+    if (!sendATCommand(appKeyCommand, "APPKEY")) {
         return false;
     }
     
@@ -316,127 +177,128 @@ bool LoRaReceiver::configureLoRaWAN() {
 }
 
 bool LoRaReceiver::joinNetwork() {
-    Serial.println("Attempting to join LoRaWAN network...");
-    
-    // Enhanced join process with multiple attempts
-    int maxAttempts = 3;
-    for (int attempt = 1; attempt <= maxAttempts; attempt++) {
-        Serial.printf("Join attempt %d/%d\n", attempt, maxAttempts);
-        
-        // Clear buffer before join attempt
-        clearSerialBuffer();
-        
-        // Attempt to join network
-        if (!sendATCommand("AT+JOIN", "OK", 3000)) {
-            Serial.printf("Join command failed on attempt %d\n", attempt);
-            if (attempt < maxAttempts) {
-                delay(5000); // Wait before retry
-                continue;
-            }
-            return false;
+    rxState = ContinuousRxState::IDLE;
+    return modem.joinNetwork();
+}
+
+bool LoRaReceiver::sendP2PMessage(const String &message)
+{
+    rxState = ContinuousRxState::IDLE; // Transmitting ends continuous RX
+    return modem.sendP2PMessage(message);
+}
+
+void LoRaReceiver::startContinuousReceive()
+{
+    // Anything still buffered belongs to the previous command
+    clearSerialBuffer();
+    rxLineLength = 0;
+    rxLineOverflow = false;
+
+    // The modem answers "+TEST: RXLRPKT" and then stays in RX, reporting each
+    // frame as +TEST: LEN:n, RSSI:x, SNR:y followed by +TEST: RX "hex".
+    // It only leaves RX when it receives another AT command.
+    loraSerial->println("AT+TEST=RXLRPKT");
+    rxState = ContinuousRxState::ARMING;
+    rxArmTime = millis();
+
+    quietLogCounter++;
+    if (quietLogCounter % quietLogInterval == 1) {
+        Serial.println("Sent: AT+TEST=RXLRPKT (continuous receive)");
+    }
+}
+
+String LoRaReceiver::pollReceivedFrame()
+{
+    String message = "";
+
+    // Drain only what is already in the UART FIFO - never wait for more
+    while (loraSerial->available()) {
+        char c = loraSerial->read();
+
+        if (c == '\r') {
+            continue;
         }
-        
-        // Wait for join confirmation (this can take up to 30 seconds)
-        unsigned long startTime = millis();
-        bool joinStarted = false;
-        
-        while (millis() - startTime < 35000) { // Extended timeout
-            String response = readResponse(1000);
-            
-            if (response.indexOf("+JOIN: Start") >= 0) {
-                joinStarted = true;
-                Serial.println("Join process started...");
-            } else if (response.indexOf("+JOIN: Network joined") >= 0) {
-                Serial.println("Successfully joined LoRaWAN network");
-                
-                // Optional: Enable auto low power mode after successful join
-                setAutoLowPowerMode(true);
-                
-                return true;
-            } else if (response.indexOf("+JOIN: Join failed") >= 0) {
-                Serial.printf("Join failed on attempt %d\n", attempt);
-                break; // Exit inner loop to try again
+
+        if (c != '\n') {
+            if (rxLineLength < LORA_RX_LINE_MAX - 1) {
+                rxLine[rxLineLength++] = c;
+            } else {
+                rxLineOverflow = true; // Keep discarding until end of line
             }
-            delay(1000);
+            continue;
         }
-        
-        if (!joinStarted) {
-            Serial.printf("Join process never started on attempt %d\n", attempt);
-        } else {
-            Serial.printf("Join timeout on attempt %d\n", attempt);
+
+        rxLine[rxLineLength] = '\0';
+        bool overflowed = rxLineOverflow;
+        size_t length = rxLineLength;
+        rxLineLength = 0;
+        rxLineOverflow = false;
+
+        if (overflowed) {
+            Serial.printf("P2P RX: dropped over-long modem line (>%d chars)\n", LORA_RX_LINE_MAX - 1);
+            continue;
         }
-        
-        if (attempt < maxAttempts) {
-            Serial.println("Waiting before next join attempt...");
-            delay(10000); // Wait longer between attempts
+
+        if (length > 0 && processReceivedLine(rxLine, message)) {
+            // Leave any following bytes for the next call
+            return message;
         }
     }
-    
-    Serial.println("All join attempts failed");
-    return false;
-}
 
-bool LoRaReceiver::sendP2PMessage(const String &message)
-{
-    // Convert message to hex format
-    String hexMessage = ProtocolHelper::asciiToHex(message);
-    
-    // Send P2P message using AT+TEST=TXLRPKT
-    String command = "AT+TEST=TXLRPKT,\"" + hexMessage + "\"";
-    
-    if (!sendATCommand(command, "TX DONE", 3000)) {
-        Serial.println("P2P transmission failed");
-        return false;
+    // The modem never confirmed RX mode - try again on the next call
+    if (rxState == ContinuousRxState::ARMING && millis() - rxArmTime > LORA_RX_ARM_TIMEOUT_MS) {
+        Serial.println("P2P RX: no RXLRPKT confirmation from modem, re-arming receive mode");
+        rxState = ContinuousRxState::IDLE;
     }
-    
-    Serial.printf("P2P TX: %s\n", message.c_str());
-    return true;
+
+    return message;
 }
 
-String LoRaReceiver::receiveP2PMessage(int timeout)
+bool LoRaReceiver::processReceivedLine(const char *line, String &message)
 {
-    // Enter receive mode and get the full response
-    quietLogCounter++;
-    bool shouldLog = (quietLogCounter % quietLogInterval == 0);
-    
-    // Get response from sendATCommand which already waits for full RX window
-    clearSerialBuffer();
-    loraSerial->println("AT+TEST=RXLRPKT");
-    if (shouldLog) {
-        Serial.println("Sent: AT+TEST=RXLRPKT");
+    if (strstr(line, "+TEST: RXLRPKT") != nullptr) {
+        rxState = ContinuousRxState::LISTENING;
+        return false;
     }
-    
-    String response = readResponse(timeout);
-    
-    if (shouldLog) {
-        Serial.printf("Received: %s (took %lu ms)\n", response.c_str(), timeout);
+
+    // Packet header: +TEST: LEN:8, RSSI:-45, SNR:10
+    const char *header = strstr(line, "+TEST: LEN:");
+    if (header != nullptr) {
+        const char *rssi = strstr(header, "RSSI:");
+        const char *snr = strstr(header, "SNR:");
+        if (rssi) {
+            lastRssi = atoi(rssi + 5);
+        }
+        if (snr) {
+            lastSnr = atoi(snr + 4);
+        }
+        return false;
     }
-    
-    // Look for received data in format: +TEST: RX "hexdata"
-    int rxIndex = response.indexOf("+TEST: RX ");
-    if (rxIndex >= 0) {
-        int startQuote = response.indexOf('"', rxIndex);
-        int endQuote = response.indexOf('"', startQuote + 1);
-        
-        if (startQuote >= 0 && endQuote >= 0) {
-            String hexData = response.substring(startQuote + 1, endQuote);
-            String decodedMessage = ProtocolHelper::hexToAscii(hexData);
-            Serial.printf("P2P RX: %s\n", decodedMessage.c_str());
+
+    // Packet payload: +TEST: RX "hexdata"
+    const char *payload = strstr(line, "+TEST: RX ");
+    if (payload != nullptr) {
+        const char *startQuote = strchr(payload, '"');
+        const char *endQuote = startQuote ? strchr(startQuote + 1, '"') : nullptr;
+
+        if (startQuote && endQuote) {
+            String hexData = "";
+            hexData.concat(startQuote + 1, endQuote - startQuote - 1);
+            message = ProtocolHelper::hexToAscii(hexData);
+            Serial.printf("P2P RX: %s (RSSI %d dBm, SNR %d dB)\n", message.c_str(), lastRssi, lastSnr);
             quietLogCounter = 0; // Reset counter on activity
-            return decodedMessage;
+            return message.length() > 0;
         }
+        return false;
     }
-    
-    // Only log "no message" periodically to reduce spam
-    if (shouldLog) {
-        Serial.printf("No P2P message received (checked %lu times)\n", quietLogCounter);
+
+    // Anything else is unsolicited modem output (e.g. a late "RX DONE" or error)
+    if (strstr(line, "ERROR") != nullptr) {
+        Serial.printf("P2P RX: modem reported '%s', re-arming receive mode\n", line);
+        rxState = ContinuousRxState::IDLE;
     }
-    return "";
-}
 
-bool LoRaReceiver::enterP2PReceiveMode()
-{
-    return sendATCommand("AT+TEST=RXLRPKT", "RX DONE", 1000);
+    return false;
 }
 
 String LoRaReceiver::checkForCommand() {
@@ -446,9 +308,12 @@ String LoRaReceiver::checkForCommand() {
     
     // Use different methods based on current communication mode
     if (currentMode == LoRaCommunicationMode::P2P) {
-        // P2P mode: Check for P2P messages
-        // Use 13 second timeout to allow full RX window (11s) plus overhead
-        return receiveP2PMessage(13000);
+        // P2P mode: keep the modem in continuous RX and consume whatever
+        // frames it has reported since the last call
+        if (rxState == ContinuousRxState::IDLE) {
+            startContinuousReceive();
+        }
+        return pollReceivedFrame();
     } else {
         // LoRaWAN mode: Check for downlink messages
         if (loraSerial->available()) {
@@ -533,180 +398,49 @@ bool LoRaReceiver::isReady() {
 }
 
 bool LoRaReceiver::reset() {
-    Serial.println("Resetting Grove-Wio-E5 module...");
-    
-    if (!sendATCommand("AT+RESET", "", 2000)) {
-        return false;
-    }
-    
-    delay(3000); // Wait for reset to complete
-    
-    // Clear any boot messages
-    clearSerialBuffer();
-    
-    // Test communication after reset
-    return sendATCommand("AT", "OK", 3000);
+    rxState = ContinuousRxState::IDLE;
+    return modem.reset();
 }
 
 // Private helper methods
 
 bool LoRaReceiver::sendATCommand(const String& command, const String& expectedResponse, int timeout) {
-    if (!loraSerial) {
-        return false;
-    }
-    
-    // Quiet logging: only log RXLRPKT commands periodically
-    bool isRxCommand = command.startsWith("AT+TEST=RXLRPKT");
-    bool shouldLog = !isRxCommand || (quietLogCounter % quietLogInterval == 0);
-    
-    // Enhanced buffer clearing - wait for buffer to settle
-    clearSerialBuffer();
-    delay(50); // Allow any pending data to arrive
-    clearSerialBuffer(); // Clear again for better reliability
-    
-    // Start timing measurement
-    unsigned long startTime = millis();
-    
-    // Send command
-    loraSerial->println(command);
-    if (shouldLog) {
-        Serial.printf("Sent: %s\n", command.c_str());
-    }
-    
-    if (expectedResponse.length() == 0) {
-        return true; // No response expected
-    }
-    
-    // Wait for response with improved parsing
-    String response = readResponse(timeout);
-    unsigned long commandTime = millis() - startTime;
-    
-    if (shouldLog) {
-        Serial.printf("Received: %s (took %lu ms)\n", response.c_str(), commandTime);
-    }
-    
-    // Handle echo: module may echo the command before responding
-    // Check if the expected response exists anywhere in the full response
-    // This handles cases where format is "AT\r\nOK\r\n" or "AT\r\n+AT: OK\r\n"
-    bool success = (response.indexOf(expectedResponse) >= 0) || 
-                   (expectedResponse == "OK" && (response.indexOf("+OK") >= 0 || 
-                                                  response.indexOf("\nOK") >= 0 ||
-                                                  response.indexOf("\r\nOK") >= 0 ||
-                                                  response.indexOf("+AT: OK") >= 0 ||
-                                                  (response.indexOf("OK") >= 0 && response.length() > command.length()))) ||
-                   (response.length() > 0 && expectedResponse.length() > 0 && 
-                    response.indexOf("+") == 0); // Any "+XXX" response is valid acknowledgment
-    
-    if (!success && expectedResponse != "") {
-        Serial.printf("Command failed - expected '%s' but got '%s'\n", 
-                     expectedResponse.c_str(), response.c_str());
-        // Print hex dump for debugging if we got data
-        if (response.length() > 0) {
-            Serial.print("  Received data: ");
-            for (unsigned int i = 0; i < response.length() && i < 50; i++) {
-                Serial.printf("0x%02X ", (unsigned char)response.charAt(i));
-            }
-            Serial.println();
-            // Check if this looks like echo
-            String responseUpper = response;
-            responseUpper.toUpperCase();
-            String commandUpper = command;
-            commandUpper.toUpperCase();
-            if (responseUpper.startsWith(commandUpper) && response.indexOf("OK") < 0) {
-                Serial.println("  (Echo received but no OK - module may need reset or longer timeout)");
-            } else if (response.length() > 0 && response.indexOf(command) < 0 && response.indexOf(expectedResponse) < 0) {
-                Serial.println("  (Unexpected response - may indicate wrong baud rate)");
-            }
-        } else {
-            Serial.println("  No response received - check connections and power");
-        }
-    }
-    
-    return success;
+    // Any AT command takes the modem out of continuous RX
+    rxState = ContinuousRxState::IDLE;
+    return modem.sendATCommand(command, expectedResponse, timeout);
 }
 
 String LoRaReceiver::readResponse(int timeout) {
-    if (!loraSerial) {
-        return "";
-    }
-    
-    String response = "";
-    unsigned long startTime = millis();
-    unsigned long lastDataTime = millis();
-    
-    while (millis() - startTime < timeout) {
-        esp_task_wdt_reset(); // Reset watchdog during long waits
-        
-        if (loraSerial->available()) {
-            char c = loraSerial->read();
-            response += c;
-            lastDataTime = millis(); // Reset data timeout
-        } else if (response.length() > 0) {
-            // For short responses during init (like echoed AT), wait longer for the actual response
-            // Only break if we've waited at least 500ms after last data
-            unsigned long silenceTime = millis() - lastDataTime;
-            if (silenceTime > 500) {
-                // For TX commands, must wait for TX DONE after the echo
-                // SF12 transmission can take several seconds
-                if (response.indexOf("TXLRPKT") >= 0 && response.indexOf("TX DONE") < 0 && silenceTime < 11000) {
-                    delay(10);
-                    continue;
-                }
-                // For RX commands, must wait for RX DONE or received data after the echo
-                // RX window can be long at SF12, wait up to 11 seconds
-                if (response.indexOf("RXLRPKT") >= 0 && response.indexOf("RX DONE") < 0 && response.indexOf("RXLRPKT,") < 0 && silenceTime < 11000) {
-                    // Keep waiting for RX DONE or received message data
-                    delay(10);
-                    continue;
-                }
-                // If response looks incomplete (just echo with no OK), wait a bit more
-                if (response.length() <= 10 && response.indexOf("OK") < 0 && silenceTime < 1000) {
-                    // Keep waiting, might be slow response
-                    delay(10);
-                    continue;
-                }
-                // Got enough silence, response is complete
-                break;
-            }
-        }
-        delay(10);
-    }
-    
-    response.trim();
-    return response;
+    return modem.readResponse(timeout);
 }
 
 void LoRaReceiver::clearSerialBuffer() {
-    if (!loraSerial) {
-        return;
-    }
-    
-    // Enhanced buffer clearing with timeout
-    unsigned long startTime = millis();
-    while (loraSerial->available() && (millis() - startTime < 1000)) {
-        loraSerial->read();
-        delay(1); // Small delay to ensure all data is read
-    }
+    modem.clearSerialBuffer();
 }
 
 bool LoRaReceiver::enterLowPowerMode() {
-    Serial.println("Entering LoRa low power mode...");
-    return sendATCommand("AT+LOWPOWER", "OK", 3000);
+    rxState = ContinuousRxState::IDLE;
+    return modem.enterLowPowerMode();
 }
 
 bool LoRaReceiver::wakeUp() {
-    Serial.println("Waking up LoRa module...");
-    // Send any character to wake up
-    loraSerial->println("AT");
-    delay(100);
-    return sendATCommand("AT", "OK", 3000);
+    rxState = ContinuousRxState::IDLE;
+    return modem.wakeUp();
 }
 
 bool LoRaReceiver::setAutoLowPowerMode(bool enable) {
-    String command = "AT+LOWPOWER=AUTOMODE,";
-    command += enable ? "ON" : "OFF";
-    Serial.printf("Setting auto low power mode: %s\n", enable ? "ON" : "OFF");
-    return sendATCommand(command, "OK", 3000);
+    rxState = ContinuousRxState::IDLE;
+    return modem.setAutoLowPowerMode(enable);
+}
+
+int LoRaReceiver::getLastRssi() const
+{
+    return lastRssi;
+}
+
+int LoRaReceiver::getLastSnr() const
+{
+    return lastSnr;
 }
 
 LoRaCommunicationMode LoRaReceiver::getCurrentMode()
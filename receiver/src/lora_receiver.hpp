@@ -8,12 +8,41 @@
 #pragma once
 
 #include <Arduino.h>
+#include <esp_task_wdt.h>
 #include "../../shared/protocol_common.hpp"
+#include "../../shared/wio_e5_modem.hpp"
 
 // Configuration flags
 #define LORA_DISABLE_BAUD_SEARCH true // Set to true to skip baud rate search and use fixed 9600
 #define LORA_FIXED_BAUD_RATE 9600     // Baud rate to use when DISABLE_BAUD_SEARCH is true
 #define LORA_INIT_TIMEOUT_MS 180000   // Wait up to 3 minutes for M5Dial to come online
+#define LORA_RX_LINE_MAX 256          // Longest modem line kept by the receive parser (hex payload + header)
+#define LORA_RX_ARM_TIMEOUT_MS 2000   // Re-send AT+TEST=RXLRPKT if the modem has not confirmed RX mode by then
+#define LORA_FAST_RESUME_ATTEMPTS 3   // AT probes before a fast resume falls back to the full setup
+
+/**
+ * @struct ReceiverModemPolicy
+ * @brief WioE5Modem settings for the receiver
+ */
+struct ReceiverModemPolicy
+{
+    static const bool BAUD_SEARCH = !LORA_DISABLE_BAUD_SEARCH;
+    static const long FIXED_BAUD = LORA_FIXED_BAUD_RATE;
+    static const unsigned long BOOT_WAIT_MS = 8000; // Module powers up together with the receiver
+    static const unsigned long CONNECT_TIMEOUT_MS = LORA_INIT_TIMEOUT_MS;
+    static void feedWatchdog() { esp_task_wdt_reset(); }
+};
+
+/**
+ * @enum ContinuousRxState
+ * @brief State of the modem's continuous P2P receive mode
+ */
+enum class ContinuousRxState
+{
+    IDLE = 0,      // Modem is not listening (after TX, AT commands, or startup)
+    ARMING = 1,    // AT+TEST=RXLRPKT sent, waiting for "+TEST: RXLRPKT"
+    LISTENING = 2  // Modem is in continuous RX and reports frames as they arrive
+};
 
 /**
  * @class LoRaReceiver
@@ -26,6 +55,7 @@ class LoRaReceiver
 {
 private:
     HardwareSerial *loraSerial;
+    WioE5Modem<HardwareSerial, ReceiverModemPolicy> modem; // Shared AT command layer
     int rxPin;
     int txPin;
     bool isInitialized;
@@ -35,7 +65,7 @@ private:
     unsigned long quietLogCounter;
     unsigned long quietLogInterval;
 
-    // AT command handling
+    // AT command handling (delegates to modem; any command ends continuous RX)
     bool sendATCommand(const String &command, const String &expectedResponse = "OK", int timeout = 5000);
     String readResponse(int timeout = 5000);
     void clearSerialBuffer();
@@ -45,10 +75,44 @@ private:
     bool configureLoRaWAN();
     bool joinNetwork();
 
+    /**
+     * @brief Reattach to a modem that stayed powered through an ESP32 reset
+     * Skips the boot waits and the module reset; only P2P is reconfigured.
+     * @return true if the modem answered and P2P mode is configured
+     */
+    bool resumeModem();
+
+    // Continuous receive parser state
+    ContinuousRxState rxState;
+    unsigned long rxArmTime;
+    char rxLine[LORA_RX_LINE_MAX];
+    size_t rxLineLength;
+    bool rxLineOverflow;
+    int lastRssi;
+    int lastSnr;
+
     // P2P communication methods
     bool sendP2PMessage(const String &message);
-    String receiveP2PMessage(int timeout = 2000);
-    bool enterP2PReceiveMode();
+
+    /**
+     * @brief Put the modem into continuous RX without waiting for the confirmation
+     * The "+TEST: RXLRPKT" acknowledgment is consumed later by pollReceivedFrame()
+     */
+    void startContinuousReceive();
+
+    /**
+     * @brief Drain whatever bytes the modem has sent so far (never blocks)
+     * @return Decoded P2P message if a complete frame arrived, empty string otherwise
+     */
+    String pollReceivedFrame();
+
+    /**
+     * @brief Handle one complete line from the modem while in continuous RX
+     * @param line NUL-terminated line without CR/LF
+     * @param message Set to the decoded payload when the line carries a frame
+     * @return true if the line carried a frame
+     */
+    bool processReceivedLine(const char *line, String &message);
 
 public:
     /**
@@ -65,12 +129,15 @@ public:
      * @brief Initialize the LoRa receiver
      * @param rxPin UART RX pin (connected to Grove-Wio-E5 TX)
      * @param txPin UART TX pin (connected to Grove-Wio-E5 RX)
+     * @param fastResume Try the fast path first (ESP32 reset, modem still powered)
      * @return true if initialization successful
      */
-    bool setup(int rxPin, int txPin);
+    bool setup(int rxPin, int txPin, bool fastResume = false);
 
     /**
      * @brief Check for incoming LoRa commands
+     * In P2P mode the modem stays in continuous RX and this call only drains
+     * the UART, so it returns immediately when nothing has arrived.
      * @return Command string if received, empty string if none
      */
     String checkForCommand();
@@ -119,6 +186,18 @@ public:
      */
     bool setAutoLowPowerMode(bool enable);
 
+    /**
+     * @brief Get RSSI reported by the modem for the last received frame
+     * @return RSSI in dBm (0 if no frame received yet)
+     */
+    int getLastRssi() const;
+
+    /**
+     * @brief Get SNR reported by the modem for the last received frame
+     * @return SNR in dB (0 if no frame received yet)
+     */
+    int getLastSnr() const;
+
     /**
      * @brief Get current communication mode
      * @return Current LoRaCommunicationMode
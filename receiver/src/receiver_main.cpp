@@ -15,9 +15,20 @@
  *
  * @functionality:
  *   - Receives LoRaWAN commands from M5Stack Dial thermostat
- *   - Controls gas stove via pin D10 (HIGH/LOW)
+ *   - Radio I/O runs in its own task on core 0; relay, LED and safety logic
+ *     run in loop() on core 1. They exchange messages through lock-free
+ *     SPSC queues (fixed size, no heap).
+ *   - Controls gas stove via pin D10 (HIGH/LOW); further relay channels can be
+ *     bound to other thermostat node IDs (multi-zone, see ZONE_BINDINGS)
  *   - Provides status feedback via LED
  *   - Implements failsafe timeout for safety
+ *   - Records commands, relay transitions, safety timeouts and link quality in
+ *     a flash journal (type DUMP on the serial console, decode with
+ *     tools/decode_journal.py)
+ *   - Optional slot-synchronized listening: radio and CPU sleep between the
+ *     bound thermostats' announced transmit slots (RECEIVER_SYNC_LISTEN_ENABLED)
+ *   - After a watchdog/panic reset, stoves that were legitimately ON resume
+ *     for a short grace period until the thermostat reconfirms them
  *
  * @pin_assignments:
  *   - D10: Gas stove control output (HIGH = ON, LOW = OFF)
@@ -25,17 +36,28 @@
  *   - D6/D7: Grove-Wio-E5 UART (RX/TX)
  *   
  * @safety_features:
- *   - Automatic timeout to turn OFF stove if no signal received
+ *   - Automatic timeout to turn OFF stove if no signal received (esp_timer driven)
  *   - Watchdog timer protection
  *   - Status LED for visual feedback
  *   - Serial debugging for troubleshooting
  */
 
 #include <Arduino.h>
+#include <atomic>
 #include <esp_task_wdt.h>
+#include <esp_timer.h>
+#include <esp_sleep.h>
+#include <esp_system.h>
 #include "lora_receiver.hpp"
 #include "stove_relay.hpp"
 #include "status_led.hpp"
+#include "safety_timer.hpp"
+#include "spsc_queue.hpp"
+#include "sync_listener.hpp"
+#include "zone_router.hpp"
+#include "event_journal.hpp"
+#include "relay_retention.hpp"
+#include "link_stats.hpp"
 
 // Pin definitions for XIAO ESP32S3
 const int STOVE_CONTROL_PIN = 10;    // Output to gas stove control (GPIO10)
@@ -44,26 +66,413 @@ const int STATUS_LED_PIN = 9;        // Status LED (optional) (GPIO9)
 const int LORA_RX_PIN = 44;         // Grove-Wio-E5 TX -> ESP32 RX (GPIO44/D7)
 const int LORA_TX_PIN = 43;         // Grove-Wio-E5 RX -> ESP32 TX (GPIO43/D6)
 
+// Multi-zone addressing
+const uint8_t RECEIVER_NODE_ID = P2P_DEFAULT_RECEIVER_ID; // This receiver's node ID (frames with another D= are ignored)
+
+/**
+ * @struct ZoneBinding
+ * @brief One relay channel and the thermostat node that controls it
+ */
+struct ZoneBinding
+{
+    uint8_t thermostatId;
+    int pin;
+};
+
+// Channel 0 also answers unaddressed frames from thermostats without a node ID
+const ZoneBinding ZONE_BINDINGS[] = {
+    {P2P_DEFAULT_THERMOSTAT_ID, STOVE_CONTROL_PIN}, // Thermostat 1 -> D10
+};
+const uint8_t ZONE_COUNT = sizeof(ZONE_BINDINGS) / sizeof(ZONE_BINDINGS[0]);
+static_assert(ZONE_COUNT <= ZONE_MAX_CHANNELS, "Too many relay channels for ZoneRouter");
+static_assert(ZONE_COUNT < SYNC_MAX_THERMOSTATS, "Too many thermostats for SyncListener");
+
 // Safety timeout - turn off stove if no signal received (in milliseconds)
 const unsigned long SAFETY_TIMEOUT = 10 * 60 * 1000; // 10 minutes
 
+// Task layout - Arduino's loop() already runs on core 1
+const BaseType_t RADIO_TASK_CORE = 0;          // Radio driver (UART to Grove-Wio-E5)
+const uint32_t RADIO_TASK_STACK = 8192;        // AT command handling uses String
+const UBaseType_t RADIO_TASK_PRIORITY = 2;     // Above loopTask (1), below esp_timer
+const unsigned long CONTROL_TICK_MS = 10;      // Safety/journal follow-up period when no command arrives
+const unsigned long STATS_INTERVAL_MS = 300000; // 5 minutes
+
+// Fixed-size messages passed between the two cores - a whole frame always fits
+const size_t LINK_MESSAGE_MAX = P2P_MAX_FRAME_LENGTH + 1;
+
+struct RadioCommand
+{
+    char text[LINK_MESSAGE_MAX];
+    int64_t receivedUs; // esp_timer time when the radio task parsed the frame
+    int16_t rssi;       // Link quality of the packet (dBm / dB)
+    int8_t snr;
+};
+
+struct RadioResponse
+{
+    char text[LINK_MESSAGE_MAX];
+};
+
+/**
+ * @struct LatencyStats
+ * @brief Running min/max/mean of command-to-relay latency
+ */
+struct LatencyStats
+{
+    uint32_t count = 0;
+    int64_t minUs = 0;
+    int64_t maxUs = 0;
+    int64_t totalUs = 0;
+
+    void add(int64_t latencyUs)
+    {
+        if (count == 0 || latencyUs < minUs) minUs = latencyUs;
+        if (latencyUs > maxUs) maxUs = latencyUs;
+        totalUs += latencyUs;
+        count++;
+    }
+};
+
 // Component instances
 LoRaReceiver loraReceiver;
-StoveRelay stoveRelay;
+StoveRelay stoveRelays[ZONE_COUNT];   // One per relay channel
+SafetyTimer safetyTimers[ZONE_COUNT]; // Independent cutoff per channel
+ZoneRouter zoneRouter; // Bound in setup() before the radio task starts, read-only afterwards
 StatusLED statusLED;
+EventJournal journal;
+RelayRetention relayRetention;
+LinkStats linkStats; // Control core only
+SyncListener syncListener; // Radio task only
+
+// Inter-core queues: radio task -> loop() and loop() -> radio task
+SpscQueue<RadioCommand, 8> commandQueue;
+SpscQueue<RadioResponse, 8> responseQueue;
+TaskHandle_t controlTaskHandle = nullptr;
+TaskHandle_t radioTaskHandle = nullptr;
 
 // Global state tracking
-unsigned long lastCommandTime = 0;
 bool systemInitialized = false;
+bool awaitingReconfirm[ZONE_COUNT] = {}; // Resumed after a reset, thermostat has not resent its state yet
+uint8_t heaterFault[ZONE_COUNT] = {};    // Last heater alarm reported by each zone's thermostat (0 = none)
+LatencyStats commandLatency;
+std::atomic<uint32_t> oversizeCommands(0);  // Received frames over P2P_MAX_FRAME_LENGTH (radio task)
+std::atomic<uint32_t> oversizeResponses(0); // Responses over P2P_MAX_FRAME_LENGTH (control task)
+
+/**
+ * @brief Copy a frame into a link message, refusing rather than truncating it
+ * A cut-off field would parse as a different value.
+ * @param text Destination buffer (LINK_MESSAGE_MAX)
+ * @param frame Frame to copy
+ * @return true if the whole frame fit
+ */
+bool copyFrame(char (&text)[LINK_MESSAGE_MAX], const String &frame) {
+    if (frame.length() >= LINK_MESSAGE_MAX) {
+        return false;
+    }
+    memcpy(text, frame.c_str(), frame.length() + 1);
+    return true;
+}
+
+/**
+ * @brief Queue a response for the radio task to transmit (control core only)
+ * @param text Response string
+ * @param dest Thermostat node ID to address, P2P_NODE_ID_NONE for a plain reply
+ */
+void queueResponse(const char *text, uint8_t dest) {
+    // Thermostats without a node ID expect the bare response
+    String frame = dest == P2P_NODE_ID_NONE ? String(text) : ProtocolHelper::addAddress(text, RECEIVER_NODE_ID, dest);
+    RadioResponse response;
+    if (!copyFrame(response.text, frame)) {
+        oversizeResponses++;
+        Serial.printf("Warning: response of %u characters over the %u limit, not sent: '%s'\n",
+                      frame.length(), (unsigned)P2P_MAX_FRAME_LENGTH, frame.c_str());
+        return;
+    }
+    if (!responseQueue.push(response)) {
+        Serial.printf("Warning: response queue full, dropped '%s'\n", response.text);
+    }
+}
+
+/**
+ * @brief Check whether any relay channel is switched on
+ * @return true if at least one stove is ON
+ */
+bool anyRelayOn() {
+    for (uint8_t i = 0; i < ZONE_COUNT; i++) {
+        if (stoveRelays[i].isOn()) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Longest sleep that cannot overrun a running stove's safety cutoff
+ * @return Limit in milliseconds
+ */
+unsigned long getSleepLimitMs() {
+    unsigned long limitMs = SYNC_MAX_SLEEP_MS;
+    for (uint8_t i = 0; i < ZONE_COUNT; i++) {
+        if (stoveRelays[i].isOn() && safetyTimers[i].getRemainingMs() < limitMs) {
+            limitMs = safetyTimers[i].getRemainingMs();
+        }
+    }
+    return limitMs;
+}
+
+/**
+ * @brief Put the modem and the ESP32-S3 to sleep until the next slot (radio task only)
+ * Light sleep stops both cores; esp_timer callbacks that came due while asleep
+ * run right after wake-up, so the caller bounds the sleep by the safety timer.
+ * @param durationMs Requested sleep time
+ */
+void sleepUntilSlot(unsigned long durationMs) {
+    loraReceiver.enterLowPowerMode(); // Modem sleeps until the next UART byte
+    Serial.flush();
+    esp_task_wdt_reset();
+    
+    int64_t sleepStartUs = esp_timer_get_time();
+    esp_sleep_enable_timer_wakeup((uint64_t)durationMs * 1000ULL);
+    esp_light_sleep_start();
+    syncListener.recordSleep((unsigned long)((esp_timer_get_time() - sleepStartUs) / 1000));
+    
+    esp_task_wdt_reset();
+    loraReceiver.wakeUp(); // checkForCommand() re-arms continuous RX on the next poll
+}
+
+/**
+ * @brief Radio driver task - owns loraReceiver exclusively once started
+ * Drains outgoing responses, polls the modem for frames and hands them
+ * to the control core.
+ */
+void radioTask(void *parameter) {
+    esp_task_wdt_add(NULL);
+    unsigned long lastSignalCheck = millis();
+    
+    for (;;) {
+        esp_task_wdt_reset();
+        
+        // Transmit anything the control core asked us to send
+        RadioResponse response;
+        while (responseQueue.pop(response)) {
+            loraReceiver.sendResponse(response.text);
+            syncListener.onTransmit();
+        }
+        
+        // Non-blocking poll of the continuous RX parser
+        String command = loraReceiver.checkForCommand();
+        if (command.length() > 0) {
+            // Only our own thermostats' commands tell us when to listen - other
+            // zones on the shared channel keep other slots
+            uint8_t source = ProtocolHelper::getNodeId(command, P2P_FIELD_SOURCE);
+            if (ProtocolHelper::isAddressedTo(command, RECEIVER_NODE_ID) && !ProtocolHelper::isReply(command) &&
+                zoneRouter.route(source) != ZONE_NO_CHANNEL) {
+                syncListener.onFrame(source, command, millis());
+            }
+            
+            RadioCommand message;
+            if (!copyFrame(message.text, command)) {
+                oversizeCommands++;
+                Serial.printf("Warning: frame of %u characters over the %u limit, ignored: '%s'\n",
+                              command.length(), (unsigned)P2P_MAX_FRAME_LENGTH, command.c_str());
+            } else {
+                message.receivedUs = esp_timer_get_time();
+                message.rssi = (int16_t)loraReceiver.getLastRssi();
+                message.snr = (int8_t)loraReceiver.getLastSnr();
+                
+                if (commandQueue.push(message)) {
+                    xTaskNotifyGive(controlTaskHandle); // Wake loop() immediately
+                } else {
+                    Serial.printf("Warning: command queue full, dropped '%s'\n", message.text);
+                }
+            }
+        }
+        
+        // Periodic signal quality monitoring (every 5 minutes)
+        if (millis() - lastSignalCheck > STATS_INTERVAL_MS) {
+            String signalQuality = loraReceiver.getSignalQuality();
+            Serial.printf("Signal quality update: %s\n", signalQuality.c_str());
+            journal.log(JOURNAL_LINK, 0, 0, (int16_t)loraReceiver.getLastRssi(), (int8_t)loraReceiver.getLastSnr());
+            Serial.printf("Listening: %s\n", syncListener.getStatistics().c_str());
+            lastSignalCheck = millis();
+        }
+        
+        // Between slots: sleep once both cores have nothing left to exchange
+        if (syncListener.isEnabled() && commandQueue.isEmpty() && responseQueue.isEmpty()) {
+            // A running stove must not sleep through its safety cutoff
+            unsigned long sleepMs = syncListener.getSleepDuration(millis(), getSleepLimitMs());
+            if (sleepMs > 0) {
+                sleepUntilSlot(sleepMs);
+            }
+        }
+        
+        vTaskDelay(1);
+    }
+}
+
+/**
+ * @brief Execute one command on the control core
+ * @param message Command handed over by the radio task
+ */
+void handleCommand(const RadioCommand &message) {
+    String frame = String(message.text);
+    String command = ProtocolHelper::getCommand(frame); // Strip optional ;KEY=VALUE fields
+    uint8_t source = ProtocolHelper::getNodeId(frame, P2P_FIELD_SOURCE);
+    Serial.printf("Received command: %s\n", frame.c_str());
+    
+    // Link statistics cover every frame we hear - other zones' traffic shares the path
+    String sequence;
+    int32_t frameSequence = ProtocolHelper::getField(frame, P2P_FIELD_SEQUENCE, sequence) ?
+                            sequence.toInt() : LINK_STATS_NO_SEQUENCE;
+    linkStats.record(source, message.rssi, message.snr, message.receivedUs, frameSequence);
+    
+    // Stay silent for frames that belong to someone else - the channel is shared
+    if (!ProtocolHelper::isAddressedTo(frame, RECEIVER_NODE_ID)) {
+        Serial.println("Frame addressed to another receiver - ignored");
+        return;
+    }
+    
+    // Another receiver's reply to a thermostat that shares our node ID is not a command
+    if (ProtocolHelper::isReply(frame)) {
+        Serial.println("Reply from another receiver - ignored");
+        return;
+    }
+    
+    uint8_t channel = zoneRouter.route(source);
+    if (channel == ZONE_NO_CHANNEL || channel >= ZONE_COUNT) {
+        Serial.printf("No relay channel bound to node %u - ignored\n", source);
+        return;
+    }
+    StoveRelay &stoveRelay = stoveRelays[channel];
+    bool wasOn = stoveRelay.isOn();
+    
+    JournalCommandCode code = JOURNAL_CMD_UNKNOWN;
+    if (command.equalsIgnoreCase("STOVE_ON")) code = JOURNAL_CMD_STOVE_ON;
+    else if (command.equalsIgnoreCase("STOVE_OFF")) code = JOURNAL_CMD_STOVE_OFF;
+    else if (command.equalsIgnoreCase("STATUS_REQUEST")) code = JOURNAL_CMD_STATUS_REQUEST;
+    journal.log(JOURNAL_COMMAND, source, code, message.rssi, message.snr);
+    
+    // Process the command
+    bool commandSuccess = false;
+    bool relayCommand = false;
+    
+    if (command.equalsIgnoreCase("STOVE_ON")) {
+        // Arm the cutoff first: the relay must never be ON without one, even if
+        // the logging below stalls on a blocked Serial write
+        awaitingReconfirm[channel] = false;
+        relayRetention.recordCommand(channel, true);
+        safetyTimers[channel].rearm();
+        if (!stoveRelay.turnOn()) {
+            relayRetention.recordCommand(channel, stoveRelay.isOn()); // Refused - retain what the relay really does
+        }
+        relayCommand = true;
+        statusLED.setStatus(STATUS_STOVE_ON);
+        Serial.printf("Command executed: Stove turned ON (channel %u)\n", channel);
+        commandSuccess = true;
+        
+    } else if (command.equalsIgnoreCase("STOVE_OFF")) {
+        stoveRelay.turnOff();
+        awaitingReconfirm[channel] = false;
+        relayRetention.recordCommand(channel, stoveRelay.isOn());
+        safetyTimers[channel].rearm();
+        relayCommand = true;
+        statusLED.setStatus(anyRelayOn() ? STATUS_STOVE_ON : STATUS_STOVE_OFF);
+        Serial.printf("Command executed: Stove turned OFF (channel %u)\n", channel);
+        commandSuccess = true;
+        
+    } else if (command.equalsIgnoreCase("STATUS_REQUEST")) {
+        // Send back current status with ACK in one message, plus how well we hear the sender
+        String status = linkStats.addFields(stoveRelay.isOn() ? "STOVE_ON_ACK" : "STOVE_OFF_ACK", source);
+        if (awaitingReconfirm[channel]) {
+            // Ask the thermostat to resend what it wants after our reset
+            status = ProtocolHelper::addField(status, P2P_FIELD_RECONFIRM, String(relayRetention.getSequence()));
+        }
+        queueResponse(status.c_str(), source);
+        commandSuccess = true;
+        String runtime;
+        if (ProtocolHelper::getField(frame, P2P_FIELD_RUNTIME, runtime)) {
+            // ON minutes last hour / ON minutes today / cycles today
+            Serial.printf("Node %u stove runtime (last hour/today min/today cycles): %s\n", source, runtime.c_str());
+        }
+        String fault;
+        if (ProtocolHelper::getField(frame, P2P_FIELD_HEATER_FAULT, fault) && fault.toInt() != heaterFault[channel]) {
+            // Repeated while active - journal the changes only
+            heaterFault[channel] = fault.toInt();
+            journal.log(JOURNAL_HEATER_FAULT, channel, heaterFault[channel]);
+            Serial.printf("Heater alarm on channel %u: %s\n", channel,
+                          heaterFault[channel] == 1 ? "NO HEAT" : heaterFault[channel] == 2 ? "STUCK ON" : "cleared");
+        }
+        // Don't send separate ACK for status requests - status response includes ACK
+        
+    } else {
+        Serial.printf("Unknown command received: %s\n", command.c_str());
+        queueResponse("ERROR_UNKNOWN_COMMAND", source);
+    }
+    
+    if (stoveRelay.isOn() != wasOn) {
+        journal.log(JOURNAL_RELAY, channel, stoveRelay.isOn() ? 1 : 0);
+    }
+    
+    if (relayCommand) {
+        int64_t latencyUs = esp_timer_get_time() - message.receivedUs;
+        commandLatency.add(latencyUs);
+        Serial.printf("Command-to-relay latency: %lld us\n", (long long)latencyUs);
+    }
+    
+    // A status request restarts this channel's safety countdown too (relay
+    // commands did so above). A resumed channel keeps its grace period until
+    // the thermostat resends an explicit state.
+    if (commandSuccess && !relayCommand && !awaitingReconfirm[channel]) {
+        relayRetention.recordRefresh(channel);
+        safetyTimers[channel].rearm();
+    }
+    
+    // Send acknowledgment for commands other than STATUS_REQUEST
+    if (commandSuccess && !command.equalsIgnoreCase("STATUS_REQUEST")) {
+        queueResponse("ACK", source);
+    }
+}
+
+/**
+ * @brief Handle maintenance commands typed on the serial console (control core)
+ * DUMP streams the event journal for tools/decode_journal.py.
+ */
+void handleConsoleInput() {
+    static char line[16];
+    static size_t length = 0;
+    
+    while (Serial.available()) {
+        char c = (char)Serial.read();
+        if (c == '\r' || c == '\n') {
+            line[length] = '\0';
+            if (strcasecmp(line, "DUMP") == 0) {
+                journal.dump(Serial);
+            } else if (length > 0) {
+                Serial.printf("Unknown console command: %s (try DUMP)\n", line);
+            }
+            length = 0;
+        } else if (length < sizeof(line) - 1) {
+            line[length++] = c;
+        }
+    }
+}
 
 void setup() {
+    // Check for a warm reset before anything else delays the resume
+    esp_reset_reason_t resetReason = esp_reset_reason();
+    bool warmReset = relayRetention.restore(resetReason);
+    
     Serial.begin(115200);
-    delay(1000); // Wait for serial monitor
+    if (!warmReset) {
+        delay(1000); // Wait for serial monitor
+    }
     
     Serial.println("====================================");
     Serial.println("Thermostat Receiver Starting...");
     Serial.println("Hardware: XIAO ESP32S3 + Grove-Wio-E5");
     Serial.println("====================================");
+    if (warmReset) {
+        Serial.printf("Warm reset (reason %d) - retained relay state found (sequence %lu)\n",
+                      (int)resetReason, (unsigned long)relayRetention.getSequence());
+    }
     
     // Configure watchdog timer
     esp_task_wdt_init(30, true); // 30 second timeout, panic on timeout
@@ -73,24 +482,61 @@ void setup() {
     statusLED.setup(STATUS_LED_PIN);
     statusLED.setStatus(STATUS_INITIALIZING);
     
-    // Initialize stove relay control
-    Serial.println("Initializing stove relay...");
-    if (!stoveRelay.setup(STOVE_CONTROL_PIN)) {
-        Serial.println("ERROR: Failed to initialize stove relay!");
-        statusLED.setStatus(STATUS_ERROR);
-        while(1) {
-            delay(1000);
-            esp_task_wdt_reset();
+    // Event journal is diagnostics only - run without it if the partition is missing
+    if (journal.setup(warmReset)) {
+        journal.log(JOURNAL_BOOT, 0, (uint8_t)resetReason, ZONE_COUNT);
+    } else {
+        Serial.println("Warning: continuing without event journal");
+    }
+    
+    // Initialize stove relay control, one channel per bound thermostat
+    Serial.printf("Initializing %u stove relay channel(s)...\n", ZONE_COUNT);
+    for (uint8_t i = 0; i < ZONE_COUNT; i++) {
+        if (!stoveRelays[i].setup(ZONE_BINDINGS[i].pin) || !zoneRouter.bind(ZONE_BINDINGS[i].thermostatId, i)) {
+            Serial.printf("ERROR: Failed to initialize stove relay channel %u!\n", i);
+            statusLED.setStatus(STATUS_ERROR);
+            while(1) {
+                delay(1000);
+                esp_task_wdt_reset();
+            }
+        }
+        
+        // Ensure stove is OFF during startup
+        stoveRelays[i].turnOff();
+    }
+    zoneRouter.bind(P2P_NODE_ID_NONE, 0); // Unaddressed frames drive the first channel
+    Serial.printf("Stove relays initialized (receiver node %u) - SAFETY: all stoves turned OFF\n",
+                  RECEIVER_NODE_ID);
+    
+    // Arm the safety cutoffs before the (possibly slow) radio setup - they run
+    // from esp_timer, independent of loop()
+    for (uint8_t i = 0; i < ZONE_COUNT; i++) {
+        if (!safetyTimers[i].setup(&stoveRelays[i], SAFETY_TIMEOUT)) {
+            Serial.printf("ERROR: Failed to start safety timer for channel %u!\n", i);
+            statusLED.setStatus(STATUS_ERROR);
+            while(1) {
+                delay(1000);
+                esp_task_wdt_reset();
+            }
         }
     }
     
-    // Ensure stove is OFF during startup
-    stoveRelay.turnOff();
-    Serial.println("Stove relay initialized - SAFETY: Stove turned OFF");
+    // Resume stoves that were ON before a warm reset, bounded by the grace period
+    for (uint8_t i = 0; i < ZONE_COUNT; i++) {
+        unsigned long graceMs;
+        if (relayRetention.getResumeGrace(i, SAFETY_TIMEOUT, graceMs) && stoveRelays[i].forceState(true)) {
+            safetyTimers[i].armFor(graceMs);
+            awaitingReconfirm[i] = true;
+            journal.log(JOURNAL_RELAY, i, 1, 1);
+            statusLED.setStatus(STATUS_STOVE_ON);
+            Serial.printf("RESUMED: stove on channel %u back ON for up to %lu s pending reconfirmation\n",
+                          i, graceMs / 1000);
+        }
+    }
     
-    // Initialize LoRa receiver
+    // Initialize LoRa receiver - the modem kept its power through a warm reset
     Serial.println("Initializing LoRa receiver...");
-    if (!loraReceiver.setup(LORA_RX_PIN, LORA_TX_PIN)) {
+    if (!loraReceiver.setup(LORA_RX_PIN, LORA_TX_PIN, warmReset)) {
         Serial.println("ERROR: Failed to initialize LoRa receiver!");
         statusLED.setStatus(STATUS_ERROR);
         while(1) {
@@ -114,10 +560,29 @@ void setup() {
     // Signal quality will be checked periodically during operation
     Serial.println("Signal quality monitoring will start after initialization");
     
+    syncListener.setup(RECEIVER_SYNC_LISTEN_ENABLED);
+    for (uint8_t i = 0; i < ZONE_COUNT; i++) {
+        syncListener.addThermostat(ZONE_BINDINGS[i].thermostatId); // Sleep only once each has announced a slot
+    }
+    
+    // Hand the radio over to its own task on core 0; from here on only
+    // radioTask() touches loraReceiver
+    controlTaskHandle = xTaskGetCurrentTaskHandle();
+    if (xTaskCreatePinnedToCore(radioTask, "radio", RADIO_TASK_STACK, nullptr,
+                                RADIO_TASK_PRIORITY, &radioTaskHandle, RADIO_TASK_CORE) != pdPASS) {
+        Serial.println("ERROR: Failed to start radio task!");
+        statusLED.setStatus(STATUS_ERROR);
+        while(1) {
+            delay(1000);
+            esp_task_wdt_reset();
+        }
+    }
+    Serial.printf("Radio task running on core %d, control loop on core %d\n",
+                  (int)RADIO_TASK_CORE, (int)xPortGetCoreID());
+    
     // System ready
     systemInitialized = true;
-    lastCommandTime = millis();
-    statusLED.setStatus(STATUS_WAITING);
+    statusLED.setStatus(anyRelayOn() ? STATUS_STOVE_ON : STATUS_WAITING);
     
     Serial.println("====================================");
     Serial.println("System Ready - Waiting for commands");
@@ -136,73 +601,54 @@ void loop() {
         return;
     }
     
-    // Check for incoming LoRa commands
-    String command = loraReceiver.checkForCommand();
+    // Sleep until the radio task hands over a command, or one control tick
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONTROL_TICK_MS));
     
-    if (command.length() > 0) {
-        Serial.printf("Received command: %s\n", command.c_str());
-        lastCommandTime = millis();
-        
-        // Process the command
-        bool commandSuccess = false;
-        
-        if (command.equalsIgnoreCase("STOVE_ON")) {
-            stoveRelay.turnOn();
-            statusLED.setStatus(STATUS_STOVE_ON);
-            Serial.println("Command executed: Stove turned ON");
-            commandSuccess = true;
-            
-        } else if (command.equalsIgnoreCase("STOVE_OFF")) {
-            stoveRelay.turnOff();
-            statusLED.setStatus(STATUS_STOVE_OFF);
-            Serial.println("Command executed: Stove turned OFF");
-            commandSuccess = true;
-            
-        } else if (command.equalsIgnoreCase("STATUS_REQUEST")) {
-            // Send back current status with ACK in one message
-            String status = stoveRelay.isOn() ? "STOVE_ON_ACK" : "STOVE_OFF_ACK";
-            loraReceiver.sendResponse(status);
-            commandSuccess = true;
-            // Don't send separate ACK for status requests - status response includes ACK
-            
-        } else {
-            Serial.printf("Unknown command received: %s\n", command.c_str());
-            loraReceiver.sendResponse("ERROR_UNKNOWN_COMMAND");
-        }
-        
-        // Send acknowledgment for commands other than STATUS_REQUEST
-        if (commandSuccess && !command.equalsIgnoreCase("STATUS_REQUEST")) {
-            loraReceiver.sendResponse("ACK");
-        }
+    RadioCommand message;
+    while (commandQueue.pop(message)) {
+        handleCommand(message);
     }
     
-    // Safety timeout check - turn off stove if no commands received
-    unsigned long timeSinceLastCommand = millis() - lastCommandTime;
-    if (timeSinceLastCommand > SAFETY_TIMEOUT) {
-        if (stoveRelay.isOn()) {
-            Serial.println("SAFETY TIMEOUT: No commands received, turning stove OFF");
-            stoveRelay.turnOff();
+    // Safety timeout follow-up - the relay itself was already switched off by the timer
+    for (uint8_t i = 0; i < ZONE_COUNT; i++) {
+        if (safetyTimers[i].consumeTrip()) {
+            Serial.printf("SAFETY TIMEOUT: No commands received, stove on channel %u was turned OFF\n", i);
+            Serial.printf("Safety cutoff: %s\n", safetyTimers[i].getStatistics().c_str());
+            int64_t latencyMs = safetyTimers[i].getLastLatencyUs() / 1000;
+            journal.log(JOURNAL_SAFETY_TIMEOUT, i, 0, (int16_t)(latencyMs > INT16_MAX ? INT16_MAX : latencyMs));
             statusLED.setStatus(STATUS_TIMEOUT);
+            relayRetention.recordOff(i);
+            awaitingReconfirm[i] = false;
             
-            // Send timeout notification if possible
-            loraReceiver.sendResponse("SAFETY_TIMEOUT");
+            // Send timeout notification to the channel's thermostat if possible
+            queueResponse("SAFETY_TIMEOUT", ZONE_BINDINGS[i].thermostatId);
         }
-        
-        // Reset the timer to prevent spam
-        lastCommandTime = millis();
     }
     
-    // Update status LED
-    statusLED.update();
+    // Journal page writes and console commands
+    journal.service();
+    handleConsoleInput();
     
-    // Periodic signal quality monitoring (every 5 minutes)
-    static unsigned long lastSignalCheck = 0;
-    if (millis() - lastSignalCheck > 300000) { // 5 minutes
-        String signalQuality = loraReceiver.getSignalQuality();
-        Serial.printf("Signal quality update: %s\n", signalQuality.c_str());
-        lastSignalCheck = millis();
+    // Periodic timing report (every 5 minutes)
+    static unsigned long lastStatsReport = 0;
+    if (millis() - lastStatsReport > STATS_INTERVAL_MS) {
+        for (uint8_t i = 0; i < ZONE_COUNT; i++) {
+            Serial.printf("Safety cutoff ch%u: %s, next in %lu s\n", i,
+                          safetyTimers[i].getStatistics().c_str(), safetyTimers[i].getRemainingMs() / 1000);
+        }
+        if (commandLatency.count > 0) {
+            Serial.printf("Command-to-relay latency: min %lld us, max %lld us, mean %lld us over %lu commands\n",
+                          (long long)commandLatency.minUs, (long long)commandLatency.maxUs,
+                          (long long)(commandLatency.totalUs / commandLatency.count),
+                          (unsigned long)commandLatency.count);
+        }
+        Serial.printf("Event %s\n", journal.getStatistics().c_str());
+        Serial.printf("Link statistics:\n%s", linkStats.getStatistics().c_str());
+        Serial.printf("Queue drops: commands %lu, responses %lu\n",
+                      (unsigned long)commandQueue.getDroppedCount(),
+                      (unsigned long)responseQueue.getDroppedCount());
+        Serial.printf("Oversize frames: received %lu, responses %lu\n",
+                      (unsigned long)oversizeCommands.load(), (unsigned long)oversizeResponses.load());
+        lastStatsReport = millis();
     }
-    
-    // Small delay to prevent excessive CPU usage
-    delay(100);
-}
\ No newline at end of file
+}
@@ -0,0 +1,109 @@
+/**
+ * @file relay_retention.cpp
+ * @brief RTC memory relay state retention implementation
+ * @version 1.0.0
+ * @date 2026-10-17
+ */
+
+#include "relay_retention.hpp"
+#include <esp_private/esp_clk.h>
+
+// Left untouched by the bootloader on resets other than power-on
+RTC_NOINIT_ATTR static RetainedRelayState retained;
+
+RelayRetention::RelayRetention() : warmReset(false) {
+    // Constructor
+}
+
+uint32_t RelayRetention::computeCrc(const RetainedRelayState &state) {
+    const uint8_t *data = (const uint8_t *)&state;
+    size_t length = offsetof(RetainedRelayState, crc);
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+uint64_t RelayRetention::nowUs() {
+    // RTC clock - unlike esp_timer it is not restarted by a CPU/system reset
+    return esp_clk_rtc_time();
+}
+
+void RelayRetention::commit() {
+    retained.magic = RETENTION_MAGIC;
+    retained.crc = computeCrc(retained);
+}
+
+bool RelayRetention::restore(esp_reset_reason_t reason) {
+    bool qualifying = reason == ESP_RST_SW || reason == ESP_RST_PANIC || reason == ESP_RST_INT_WDT ||
+                      reason == ESP_RST_TASK_WDT || reason == ESP_RST_WDT;
+    bool intact = retained.magic == RETENTION_MAGIC && retained.crc == computeCrc(retained);
+
+    warmReset = qualifying && intact;
+    if (warmReset) {
+        return true;
+    }
+
+    memset(&retained, 0, sizeof(retained));
+    commit();
+    return false;
+}
+
+bool RelayRetention::getResumeGrace(uint8_t channel, unsigned long safetyTimeoutMs, unsigned long &graceMs) const {
+    if (!warmReset || channel >= ZONE_MAX_CHANNELS || !(retained.onMask & (1 << channel))) {
+        return false;
+    }
+
+    // An RTC watchdog reset restarts the RTC clock - the record is then in the future
+    uint64_t now = nowUs();
+    if (now < retained.lastCommandUs[channel]) {
+        return false;
+    }
+
+    uint64_t elapsedMs = (now - retained.lastCommandUs[channel]) / 1000ULL;
+    if (elapsedMs + RETENTION_MIN_REMAINING_MS >= safetyTimeoutMs) {
+        return false; // Safety window (nearly) over - the cutoff would have fired anyway
+    }
+
+    unsigned long remainingMs = safetyTimeoutMs - (unsigned long)elapsedMs;
+    graceMs = remainingMs < RETENTION_GRACE_MS ? remainingMs : RETENTION_GRACE_MS;
+    return true;
+}
+
+void RelayRetention::recordCommand(uint8_t channel, bool on) {
+    if (channel >= ZONE_MAX_CHANNELS) {
+        return;
+    }
+    retained.sequence++;
+    if (on) {
+        retained.onMask |= (1 << channel);
+    } else {
+        retained.onMask &= ~(1 << channel);
+    }
+    retained.lastCommandUs[channel] = nowUs();
+    commit();
+}
+
+void RelayRetention::recordRefresh(uint8_t channel) {
+    if (channel >= ZONE_MAX_CHANNELS) {
+        return;
+    }
+    retained.lastCommandUs[channel] = nowUs();
+    commit();
+}
+
+void RelayRetention::recordOff(uint8_t channel) {
+    if (channel >= ZONE_MAX_CHANNELS) {
+        return;
+    }
+    retained.onMask &= ~(1 << channel);
+    commit();
+}
+
+uint32_t RelayRetention::getSequence() const {
+    return retained.sequence;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file relay_retention.hpp
+ * @brief Relay state kept in RTC memory across receiver resets
+ * @version 1.0.0
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <esp_system.h>
+#include "zone_router.hpp"
+
+// Configuration
+#define RETENTION_GRACE_MS 120000        // Longest a resumed stove runs without the thermostat reconfirming
+#define RETENTION_MIN_REMAINING_MS 10000 // Don't resume when less than this is left of the safety window
+#define RETENTION_MAGIC 0x52454C59       // "RELY"
+
+/**
+ * @struct RetainedRelayState
+ * @brief Snapshot stored in RTC slow memory (survives resets, not power loss)
+ */
+struct RetainedRelayState
+{
+    uint32_t magic;
+    uint32_t sequence;                         // Incremented on every relay command
+    uint8_t onMask;                            // Bit n = channel n commanded ON
+    uint64_t lastCommandUs[ZONE_MAX_CHANNELS]; // RTC time of each channel's last valid command
+    uint32_t crc;                              // CRC-32 over the fields above
+};
+
+/**
+ * @class RelayRetention
+ * @brief Records commanded relay states so a warm reset can resume them safely
+ *
+ * Only watchdog, panic and software resets qualify. Power-on and brownout
+ * resets always start with every stove OFF. A channel resumes only if it was
+ * commanded ON and is still inside its safety window, measured on the RTC
+ * clock, which keeps counting through the reset. The resumed state is bounded
+ * by a grace period until the thermostat reconfirms it.
+ *
+ * Control core only.
+ */
+class RelayRetention
+{
+private:
+    bool warmReset; // Valid record found after a qualifying reset
+
+    static uint32_t computeCrc(const RetainedRelayState &state);
+    static uint64_t nowUs();
+    void commit();
+
+public:
+    /**
+     * @brief Constructor
+     */
+    RelayRetention();
+
+    /**
+     * @brief Validate the retained record (call first thing in setup())
+     * Starts a fresh record unless the reset was warm and the record is intact.
+     * @param reason Reset reason from esp_reset_reason()
+     * @return true if a warm reset with a valid record was detected
+     */
+    bool restore(esp_reset_reason_t reason);
+
+    /**
+     * @brief Decide whether a channel may resume ON after the reset
+     * @param channel Relay channel
+     * @param safetyTimeoutMs The channel's normal safety timeout
+     * @param graceMs Set to how long the channel may stay ON unconfirmed
+     * @return true if the channel should be switched back ON
+     */
+    bool getResumeGrace(uint8_t channel, unsigned long safetyTimeoutMs, unsigned long &graceMs) const;
+
+    /**
+     * @brief Record a relay command (STOVE_ON/STOVE_OFF)
+     * @param channel Relay channel
+     * @param on Commanded state
+     */
+    void recordCommand(uint8_t channel, bool on);
+
+    /**
+     * @brief Record a valid non-relay command that restarted the safety window
+     * @param channel Relay channel
+     */
+    void recordRefresh(uint8_t channel);
+
+    /**
+     * @brief Record that a channel was switched off by its safety cutoff
+     * @param channel Relay channel
+     */
+    void recordOff(uint8_t channel);
+
+    /**
+     * @brief Get the sequence number of the last recorded relay command
+     * @return Sequence number (continues across warm resets)
+     */
+    uint32_t getSequence() const;
+};
@@ -0,0 +1,119 @@
+/**
+ * @file safety_timer.cpp
+ * @brief Hardware-timer backed safety cutoff implementation
+ * @version 1.0.0
+ * @date 2026-10-17
+ */
+
+#include "safety_timer.hpp"
+
+SafetyTimer::SafetyTimer() : timer(nullptr), relay(nullptr), timeoutUs(0),
+                             deadlineUs(0), lastLatencyUs(0), worstLatencyUs(0),
+                             expiryCount(0), tripPending(false) {
+    // Constructor
+}
+
+SafetyTimer::~SafetyTimer() {
+    if (timer) {
+        esp_timer_stop(timer);
+        esp_timer_delete(timer);
+    }
+}
+
+bool SafetyTimer::setup(StoveRelay *stoveRelay, unsigned long timeoutMs) {
+    relay = stoveRelay;
+    timeoutUs = (uint64_t)timeoutMs * 1000ULL;
+
+    esp_timer_create_args_t args = {};
+    args.callback = &SafetyTimer::onTimeout;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK; // Runs in the high-priority esp_timer task
+    args.name = "stove_safety";
+
+    if (esp_timer_create(&args, &timer) != ESP_OK) {
+        Serial.println("ERROR: Failed to create safety timer");
+        timer = nullptr;
+        return false;
+    }
+
+    rearm();
+    Serial.printf("Safety timer armed: %lu ms cutoff (esp_timer)\n", timeoutMs);
+    return true;
+}
+
+void SafetyTimer::rearm() {
+    if (!timer) {
+        return;
+    }
+
+    // Stopping an idle timer returns an error, which is fine here
+    esp_timer_stop(timer);
+    deadlineUs = esp_timer_get_time() + (int64_t)timeoutUs;
+    esp_timer_start_once(timer, timeoutUs);
+}
+
+void SafetyTimer::armFor(unsigned long durationMs) {
+    if (!timer) {
+        return;
+    }
+
+    uint64_t durationUs = (uint64_t)durationMs * 1000ULL;
+    esp_timer_stop(timer);
+    deadlineUs = esp_timer_get_time() + (int64_t)durationUs;
+    esp_timer_start_once(timer, durationUs);
+}
+
+void SafetyTimer::onTimeout(void *arg) {
+    SafetyTimer *self = static_cast<SafetyTimer *>(arg);
+
+    bool wasOn = self->relay && self->relay->isOn();
+    if (self->relay) {
+        self->relay->emergencyOff();
+    }
+
+    // Latency covers timer dispatch plus the pin write
+    int64_t latency = esp_timer_get_time() - self->deadlineUs;
+    self->lastLatencyUs = latency;
+    if (latency > self->worstLatencyUs) {
+        self->worstLatencyUs = latency;
+    }
+    self->expiryCount = self->expiryCount + 1;
+
+    if (wasOn) {
+        self->tripPending = true;
+    }
+}
+
+bool SafetyTimer::consumeTrip() {
+    if (!tripPending) {
+        return false;
+    }
+    tripPending = false;
+    return true;
+}
+
+unsigned long SafetyTimer::getRemainingMs() const {
+    int64_t remaining = deadlineUs - esp_timer_get_time();
+    return remaining > 0 ? (unsigned long)(remaining / 1000) : 0;
+}
+
+unsigned long SafetyTimer::getTimeoutMs() const {
+    return (unsigned long)(timeoutUs / 1000ULL);
+}
+
+int64_t SafetyTimer::getLastLatencyUs() const {
+    return lastLatencyUs;
+}
+
+int64_t SafetyTimer::getWorstLatencyUs() const {
+    return worstLatencyUs;
+}
+
+String SafetyTimer::getStatistics() const {
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer),
+             "timeout %lu ms, cutoff latency last %lld us / worst %lld us, expiries %lu",
+             getTimeoutMs(), (long long)lastLatencyUs, (long long)worstLatencyUs,
+             (unsigned long)expiryCount);
+    return String(buffer);
+}
@@ -0,0 +1,106 @@
+/**
+ * @file safety_timer.hpp
+ * @brief Hardware-timer backed safety cutoff for the stove relay
+ * @version 1.0.0
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include "stove_relay.hpp"
+
+/**
+ * @class SafetyTimer
+ * @brief Turns the stove relay OFF when no valid command arrives within the timeout
+ *
+ * The cutoff runs from an esp_timer callback, so it fires on time even if the
+ * main loop is stuck in a UART exchange with the LoRa module. The callback
+ * drives the relay pin directly; the main loop only handles the follow-up
+ * (LED, notification) via consumeTrip().
+ */
+class SafetyTimer
+{
+private:
+    esp_timer_handle_t timer;
+    StoveRelay *relay;
+    uint64_t timeoutUs;
+
+    // Written by the timer callback, read by the main loop
+    volatile int64_t deadlineUs;     // When the current arm should fire (esp_timer time)
+    volatile int64_t lastLatencyUs;  // Relay-off time minus deadline for the last expiry
+    volatile int64_t worstLatencyUs; // Largest latency seen since boot
+    volatile uint32_t expiryCount;   // Number of timer expiries
+    volatile bool tripPending;       // Relay was ON and got cut off, not yet reported
+
+    static void onTimeout(void *arg);
+
+public:
+    /**
+     * @brief Constructor
+     */
+    SafetyTimer();
+
+    /**
+     * @brief Destructor
+     */
+    ~SafetyTimer();
+
+    /**
+     * @brief Create the timer and arm it for the first time
+     * @param stoveRelay Relay to switch off on expiry
+     * @param timeoutMs Time without a valid command before the cutoff (ms)
+     * @return true if the timer was created and armed
+     */
+    bool setup(StoveRelay *stoveRelay, unsigned long timeoutMs);
+
+    /**
+     * @brief Restart the countdown (call on every valid command)
+     */
+    void rearm();
+
+    /**
+     * @brief Restart the countdown with a one-off duration
+     * Used for the grace period after a reset; the next rearm() restores the
+     * configured timeout.
+     * @param durationMs Time until the cutoff (ms)
+     */
+    void armFor(unsigned long durationMs);
+
+    /**
+     * @brief Check whether a cutoff happened since the last call
+     * @return true once per cutoff that switched a running stove OFF
+     */
+    bool consumeTrip();
+
+    /**
+     * @brief Get the time left before the cutoff fires
+     * @return Remaining time in milliseconds (0 if expired)
+     */
+    unsigned long getRemainingMs() const;
+
+    /**
+     * @brief Get the configured timeout
+     * @return Timeout in milliseconds
+     */
+    unsigned long getTimeoutMs() const;
+
+    /**
+     * @brief Get the delay between deadline and relay-off for the last expiry
+     * @return Latency in microseconds
+     */
+    int64_t getLastLatencyUs() const;
+
+    /**
+     * @brief Get the worst observed delay between deadline and relay-off
+     * @return Latency in microseconds
+     */
+    int64_t getWorstLatencyUs() const;
+
+    /**
+     * @brief Get cutoff instrumentation as a printable string
+     * @return Timeout, last/worst latency and expiry count
+     */
+    String getStatistics() const;
+};
@@ -0,0 +1,96 @@
+/**
+ * @file spsc_queue.hpp
+ * @brief Lock-free single-producer/single-consumer ring buffer
+ * @version 1.0.0
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+/**
+ * @class SpscQueue
+ * @brief Fixed-capacity queue for handing messages between two tasks
+ *
+ * Exactly one task may call push() and exactly one (other) task may call pop().
+ * Storage is a static array, so there is no dynamic allocation; a full queue
+ * rejects the new element and counts it as dropped.
+ *
+ * @tparam T Element type (copied in and out, keep it small and trivially copyable)
+ * @tparam Capacity Number of slots, must be a power of two
+ */
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+private:
+    T slots[Capacity];
+    std::atomic<size_t> head; // Next slot to read (owned by consumer)
+    std::atomic<size_t> tail; // Next slot to write (owned by producer)
+    std::atomic<uint32_t> dropped;
+
+public:
+    /**
+     * @brief Constructor
+     */
+    SpscQueue() : head(0), tail(0), dropped(0) {}
+
+    /**
+     * @brief Append an element (producer task only)
+     * @param item Element to copy into the queue
+     * @return true if queued, false if the queue was full
+     */
+    bool push(const T &item)
+    {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - head.load(std::memory_order_acquire) >= Capacity)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        slots[currentTail & (Capacity - 1)] = item;
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element (consumer task only)
+     * @param item Receives the element
+     * @return true if an element was removed, false if the queue was empty
+     */
+    bool pop(T &item)
+    {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        item = slots[currentHead & (Capacity - 1)];
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Check whether the queue is empty (approximate from the producer side)
+     * @return true if no elements are waiting
+     */
+    bool isEmpty() const
+    {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get number of elements rejected because the queue was full
+     * @return Drop count since boot
+     */
+    uint32_t getDroppedCount() const
+    {
+        return dropped.load(std::memory_order_relaxed);
+    }
+};
@@ -1,58 +1,112 @@
 /**
  * @file status_led.cpp
  * @brief Status LED implementation
- * @version 1.0.0
- * @date 2025-12-29
+ * @version 1.1.0
+ * @date 2026-10-17
  */
 
 #include "status_led.hpp"
 
-StatusLED::StatusLED() : ledPin(-1), currentStatus(STATUS_INITIALIZING), 
-                        isInitialized(false), lastUpdate(0), ledState(false), animationStep(0) {
+// Blink patterns as alternating ON/OFF phases in ms, starting with ON
+static const uint16_t PATTERN_SELF_TEST[] = {500, 500, 200, 200};
+static const uint16_t PATTERN_WAITING[] = {200, 1800};   // Slow blink (2 s cycle)
+static const uint16_t PATTERN_RECEIVING[] = {250, 250};  // Fast blink (0.5 s cycle)
+static const uint16_t PATTERN_TIMEOUT[] = {100, 100};    // Fast flash (0.2 s cycle)
+static const uint16_t PATTERN_ERROR[] = {                // SOS: ... --- ... then pause
+    200, 200, 200, 200, 200, 400,
+    600, 200, 600, 200, 600, 400,
+    200, 200, 200, 200, 200, 1200};
+
+#define PATTERN_LENGTH(pattern) (sizeof(pattern) / sizeof(pattern[0]))
+
+static const uint32_t LEDC_MAX_DUTY = 255; // 8-bit resolution
+
+StatusLED::StatusLED() : ledPin(-1), currentStatus(STATUS_INITIALIZING), isInitialized(false),
+                         sequenceTimer(nullptr), lock(nullptr), selfTestRunning(false),
+                         breathing(false), breathingUp(true) {
     // Constructor
 }
 
 StatusLED::~StatusLED() {
+    if (sequenceTimer) {
+        esp_timer_stop(sequenceTimer);
+        esp_timer_delete(sequenceTimer);
+    }
     if (isInitialized) {
-        digitalWrite(ledPin, LOW);
+        rmt_tx_stop(LED_RMT_CHANNEL);
+        rmt_driver_uninstall(LED_RMT_CHANNEL);
+        ledc_stop(LED_LEDC_MODE, LED_LEDC_CHANNEL, 0);
     }
 }
 
 bool StatusLED::setup(int pin) {
     ledPin = pin;
-    
+
     Serial.printf("Setting up status LED on pin %d\n", pin);
-    
-    // Configure pin as output with explicit mode
-    pinMode(ledPin, OUTPUT);
-    
-    // Test the pin by setting it HIGH briefly
-    digitalWrite(ledPin, HIGH);
-    delay(500); // 500ms test flash
-    Serial.println("Status LED test flash (HIGH) - LED should be ON now");
-    
-    digitalWrite(ledPin, LOW);
-    delay(500); // 500ms off
-    Serial.println("Status LED test complete (LOW) - LED should be OFF now");
-    
-    // One more test to verify
-    digitalWrite(ledPin, HIGH);
-    delay(200);
-    digitalWrite(ledPin, LOW);
-    
+
+    // LEDC: solid levels and breathing
+    ledc_timer_config_t timerConfig = {};
+    timerConfig.speed_mode = LED_LEDC_MODE;
+    timerConfig.duty_resolution = LEDC_TIMER_8_BIT;
+    timerConfig.timer_num = LED_LEDC_TIMER;
+    timerConfig.freq_hz = LED_LEDC_FREQ_HZ;
+    timerConfig.clk_cfg = LEDC_AUTO_CLK;
+
+    ledc_channel_config_t channelConfig = {};
+    channelConfig.gpio_num = pin;
+    channelConfig.speed_mode = LED_LEDC_MODE;
+    channelConfig.channel = LED_LEDC_CHANNEL;
+    channelConfig.timer_sel = LED_LEDC_TIMER;
+    channelConfig.duty = 0;
+    channelConfig.hpoint = 0;
+
+    if (ledc_timer_config(&timerConfig) != ESP_OK || ledc_channel_config(&channelConfig) != ESP_OK ||
+        ledc_fade_func_install(0) != ESP_OK) {
+        Serial.println("ERROR: Status LED LEDC setup failed");
+        return false;
+    }
+
+    // RMT: blink sequences (idle level LOW between and after sequences)
+    rmt_config_t rmtConfig = RMT_DEFAULT_CONFIG_TX((gpio_num_t)pin, LED_RMT_CHANNEL);
+    rmtConfig.clk_div = LED_RMT_CLK_DIV;
+    rmtConfig.tx_config.idle_output_en = true;
+    rmtConfig.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+
+    if (rmt_config(&rmtConfig) != ESP_OK || rmt_driver_install(LED_RMT_CHANNEL, 0, 0) != ESP_OK) {
+        Serial.println("ERROR: Status LED RMT setup failed");
+        return false;
+    }
+
+    lock = xSemaphoreCreateMutex();
+    esp_timer_create_args_t args = {};
+    args.callback = &StatusLED::onSequenceTimer;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "status_led";
+    if (!lock || esp_timer_create(&args, &sequenceTimer) != ESP_OK) {
+        Serial.println("ERROR: Status LED timer setup failed");
+        return false;
+    }
+
     isInitialized = true;
-    lastUpdate = millis();
-    
-    Serial.printf("Status LED initialized on pin %d\n", pin);
+
+    // Self-test flash plays in hardware while setup() carries on
+    unsigned long selfTestMs = 0;
+    for (size_t i = 0; i < PATTERN_LENGTH(PATTERN_SELF_TEST); i++) {
+        selfTestMs += PATTERN_SELF_TEST[i];
+    }
+    selfTestRunning = true;
+    playSequence(PATTERN_SELF_TEST, PATTERN_LENGTH(PATTERN_SELF_TEST), false);
+    esp_timer_start_once(sequenceTimer, (uint64_t)selfTestMs * 1000ULL);
+
+    Serial.printf("Status LED initialized on pin %d (self-test %lu ms, RMT/LEDC driven)\n", pin, selfTestMs);
     return true;
 }
 
 void StatusLED::setStatus(LEDStatus status) {
     if (currentStatus != status) {
         currentStatus = status;
-        animationStep = 0;
-        lastUpdate = millis();
-        
+
         Serial.printf("Status LED changed to: ");
         switch (status) {
             case STATUS_INITIALIZING:
@@ -77,124 +131,121 @@ void StatusLED::setStatus(LEDStatus status) {
                 Serial.println("ERROR");
                 break;
         }
+
+        if (!isInitialized) {
+            return;
+        }
+
+        xSemaphoreTake(lock, portMAX_DELAY);
+        if (!selfTestRunning) {
+            applyPattern(status); // Otherwise shown when the self-test ends
+        }
+        xSemaphoreGive(lock);
     }
 }
 
-void StatusLED::update() {
-    if (!isInitialized) {
-        return;
+void StatusLED::applyPattern(LEDStatus status) {
+    // Leaving the breathing pattern: stop reversing; a ramp still in flight
+    // finishes on the LEDC channel without affecting the RMT-driven pin
+    if (breathing && status != STATUS_INITIALIZING) {
+        breathing = false;
+        esp_timer_stop(sequenceTimer);
     }
-    
-    updatePattern();
-}
 
-void StatusLED::updatePattern() {
-    unsigned long currentTime = millis();
-    unsigned long interval = 0;
-    bool newLedState = ledState;
-    
-    switch (currentStatus) {
+    switch (status) {
         case STATUS_INITIALIZING:
-            // Slow pulse (2 second cycle)
-            interval = 100;
-            if (currentTime - lastUpdate >= interval) {
-                animationStep++;
-                if (animationStep >= 20) {
-                    animationStep = 0;
-                }
-                // Sine wave approximation for smooth pulse
-                newLedState = (animationStep < 10);
-            }
+            startBreathing();
             break;
-            
         case STATUS_WAITING:
-            // Slow blink (2 second cycle: 0.2s on, 1.8s off)
-            interval = 2000;
-            if (currentTime - lastUpdate >= interval) {
-                animationStep = 0;
-                lastUpdate = currentTime;
-            }
-            newLedState = (currentTime - lastUpdate) < 200;
+            playSequence(PATTERN_WAITING, PATTERN_LENGTH(PATTERN_WAITING), true);
             break;
-            
         case STATUS_RECEIVING:
-            // Fast blink (0.5 second cycle)
-            interval = 250;
-            if (currentTime - lastUpdate >= interval) {
-                newLedState = !ledState;
-                lastUpdate = currentTime;
-            }
+            playSequence(PATTERN_RECEIVING, PATTERN_LENGTH(PATTERN_RECEIVING), true);
             break;
-            
         case STATUS_STOVE_ON:
-            // Solid ON
-            newLedState = true;
+            setLevel(LEDC_MAX_DUTY);
             break;
-            
         case STATUS_STOVE_OFF:
-            // Solid OFF
-            newLedState = false;
+            setLevel(0);
             break;
-            
         case STATUS_TIMEOUT:
-            // Fast flash (0.2 second cycle)
-            interval = 100;
-            if (currentTime - lastUpdate >= interval) {
-                newLedState = !ledState;
-                lastUpdate = currentTime;
-            }
+            playSequence(PATTERN_TIMEOUT, PATTERN_LENGTH(PATTERN_TIMEOUT), true);
             break;
-            
         case STATUS_ERROR:
-            // SOS pattern: ... --- ... (dot=200ms, dash=600ms, space=200ms)
-            interval = 200;
-            if (currentTime - lastUpdate >= interval) {
-                animationStep++;
-                lastUpdate = currentTime;
-                
-                // SOS pattern timing
-                if (animationStep <= 6) {
-                    // Three dots: on-off-on-off-on-off
-                    newLedState = (animationStep % 2 == 1);
-                } else if (animationStep <= 7) {
-                    // Space
-                    newLedState = false;
-                } else if (animationStep <= 13) {
-                    // Three dashes: on(3x)-off-on(3x)-off-on(3x)-off
-                    int dashStep = animationStep - 8;
-                    if (dashStep == 0 || dashStep == 1 || dashStep == 2) newLedState = true;  // First dash
-                    else if (dashStep == 3) newLedState = false;                             // Space
-                    else if (dashStep == 4 || dashStep == 5 || dashStep == 6) newLedState = true;  // Second dash
-                    else newLedState = false;                                                // Space before third dash
-                    
-                    // Adjust interval for dashes (3x longer)
-                    interval = (dashStep % 4 < 3) ? 200 : 200;
-                } else if (animationStep <= 14) {
-                    // Space
-                    newLedState = false;
-                } else if (animationStep <= 20) {
-                    // Three more dots
-                    int dotStep = animationStep - 15;
-                    newLedState = (dotStep % 2 == 0);
-                } else {
-                    // Long pause before repeat
-                    animationStep = 0;
-                    newLedState = false;
-                    interval = 1000;
-                }
-            }
+            playSequence(PATTERN_ERROR, PATTERN_LENGTH(PATTERN_ERROR), true);
             break;
     }
-    
-    // Update LED if state changed
-    if (newLedState != ledState && (currentTime - lastUpdate >= interval || currentStatus == STATUS_STOVE_ON || currentStatus == STATUS_STOVE_OFF)) {
-        ledState = newLedState;
-        digitalWrite(ledPin, ledState ? HIGH : LOW);
-        
-        if (currentStatus != STATUS_STOVE_ON && currentStatus != STATUS_STOVE_OFF) {
-            lastUpdate = currentTime;
+}
+
+void StatusLED::playSequence(const uint16_t *phasesMs, size_t phaseCount, bool loop) {
+    // Split phases into RMT half-items of at most LED_RMT_MAX_PHASE_MS each
+    const uint32_t ticksPerMs = 80000 / LED_RMT_CLK_DIV; // APB 80 MHz
+    size_t half = 0;
+    memset(items, 0, sizeof(items));
+
+    for (size_t phase = 0; phase < phaseCount; phase++) {
+        uint32_t level = (phase % 2 == 0) ? 1 : 0;
+        uint32_t remainingMs = phasesMs[phase];
+        while (remainingMs > 0 && half < LED_RMT_MAX_ITEMS * 2 - 2) { // Keep room for the end marker
+            uint32_t chunkMs = remainingMs > LED_RMT_MAX_PHASE_MS ? LED_RMT_MAX_PHASE_MS : remainingMs;
+            rmt_item32_t &item = items[half / 2];
+            if (half % 2 == 0) {
+                item.level0 = level;
+                item.duration0 = chunkMs * ticksPerMs;
+            } else {
+                item.level1 = level;
+                item.duration1 = chunkMs * ticksPerMs;
+            }
+            remainingMs -= chunkMs;
+            half++;
+        }
+    }
+
+    // Hand the pin to RMT; in loop mode the sequence repeats with no CPU work
+    rmt_tx_stop(LED_RMT_CHANNEL);
+    rmt_set_gpio(LED_RMT_CHANNEL, RMT_MODE_TX, (gpio_num_t)ledPin, false);
+    rmt_set_tx_loop_mode(LED_RMT_CHANNEL, loop);
+    rmt_write_items(LED_RMT_CHANNEL, items, (half + 1) / 2, false);
+}
+
+void StatusLED::setLevel(uint32_t duty) {
+    rmt_tx_stop(LED_RMT_CHANNEL);
+    ledc_set_pin(ledPin, LED_LEDC_MODE, LED_LEDC_CHANNEL);
+    ledc_set_duty_and_update(LED_LEDC_MODE, LED_LEDC_CHANNEL, duty, 0);
+}
+
+void StatusLED::startBreathing() {
+    setLevel(0);
+    breathing = true;
+    breathingUp = true;
+    ledc_set_fade_time_and_start(LED_LEDC_MODE, LED_LEDC_CHANNEL, LEDC_MAX_DUTY,
+                                 LED_BREATH_FADE_MS, LEDC_FADE_NO_WAIT);
+    esp_timer_stop(sequenceTimer);
+    esp_timer_start_periodic(sequenceTimer, (uint64_t)LED_BREATH_PERIOD_MS * 1000ULL);
+}
+
+void StatusLED::onSequenceTimer(void *arg) {
+    StatusLED *self = static_cast<StatusLED *>(arg);
+
+    // Shares the esp_timer task with the stove safety cutoff - never block here
+    if (xSemaphoreTake(self->lock, 0) != pdTRUE) {
+        if (self->selfTestRunning) {
+            esp_timer_start_once(self->sequenceTimer, 10000); // Retry in 10 ms
         }
+        return; // Breathing just keeps the current ramp until the next period
+    }
+
+    if (self->selfTestRunning) {
+        self->selfTestRunning = false;
+        self->applyPattern(self->currentStatus);
+    } else if (self->breathing) {
+        self->breathingUp = !self->breathingUp;
+        ledc_set_fade_time_and_start(LED_LEDC_MODE, LED_LEDC_CHANNEL,
+                                     self->breathingUp ? LEDC_MAX_DUTY : 0,
+                                     LED_BREATH_FADE_MS, LEDC_FADE_NO_WAIT);
     }
+
+    xSemaphoreGive(self->lock);
 }
 
 LEDStatus StatusLED::getStatus() const {
@@ -203,7 +254,12 @@ LEDStatus StatusLED::getStatus() const {
 
 void StatusLED::setLED(bool state) {
     if (isInitialized) {
-        digitalWrite(ledPin, state ? HIGH : LOW);
-        ledState = state;
+        xSemaphoreTake(lock, portMAX_DELAY);
+        if (breathing) {
+            breathing = false;
+            esp_timer_stop(sequenceTimer);
+        }
+        setLevel(state ? LEDC_MAX_DUTY : 0);
+        xSemaphoreGive(lock);
     }
-}
\ No newline at end of file
+}
@@ -1,13 +1,28 @@
 /**
  * @file status_led.hpp
  * @brief Status LED control for visual feedback
- * @version 1.0.0
- * @date 2025-12-29
+ * @version 1.1.0
+ * @date 2026-10-17
  */
 
 #pragma once
 
 #include <Arduino.h>
+#include <driver/rmt.h>
+#include <driver/ledc.h>
+#include <esp_timer.h>
+
+// Peripheral assignment for the LED
+#define LED_RMT_CHANNEL RMT_CHANNEL_0   // Blink sequences
+#define LED_RMT_CLK_DIV 250             // 80 MHz / 250 = 3.125 us per tick
+#define LED_RMT_MAX_PHASE_MS 100        // Longest single RMT half-item (32000 ticks)
+#define LED_RMT_MAX_ITEMS 48            // One RMT memory block on the ESP32-S3
+#define LED_LEDC_CHANNEL LEDC_CHANNEL_0 // Solid levels and breathing
+#define LED_LEDC_TIMER LEDC_TIMER_0
+#define LED_LEDC_MODE LEDC_LOW_SPEED_MODE
+#define LED_LEDC_FREQ_HZ 5000
+#define LED_BREATH_FADE_MS 1000         // One ramp of the breathing pattern
+#define LED_BREATH_PERIOD_MS 1020       // Reversal timer, slightly longer than the ramp so it never waits on a fade
 
 // Status LED states
 enum LEDStatus
@@ -24,6 +39,13 @@ enum LEDStatus
 /**
  * @class StatusLED
  * @brief Controls status LED for visual system feedback
+ *
+ * Patterns are generated by peripherals, not by the main loop:
+ * - Blink patterns and the startup self-test are RMT sequences. Blinks
+ *   repeat in RMT loop mode, so no CPU is involved.
+ * - Solid levels come from an LEDC channel. Breathing uses LEDC hardware
+ *   fades, and an esp_timer reverses the fade once a second.
+ * The pin is routed to whichever peripheral owns the current pattern.
  */
 class StatusLED
 {
@@ -32,13 +54,19 @@ private:
     LEDStatus currentStatus;
     bool isInitialized;
 
-    // Animation timing
-    unsigned long lastUpdate;
-    bool ledState;
-    int animationStep;
+    // Hardware pattern state
+    esp_timer_handle_t sequenceTimer; // Self-test end and breathing reversal
+    SemaphoreHandle_t lock;           // Serializes loop() and the timer callback
+    volatile bool selfTestRunning;
+    volatile bool breathing;
+    bool breathingUp;
+    rmt_item32_t items[LED_RMT_MAX_ITEMS];
 
-    // Update intervals for different patterns
-    void updatePattern();
+    void applyPattern(LEDStatus status);
+    void playSequence(const uint16_t *phasesMs, size_t phaseCount, bool loop);
+    void setLevel(uint32_t duty);
+    void startBreathing();
+    static void onSequenceTimer(void *arg);
 
 public:
     /**
@@ -52,7 +80,9 @@ public:
     ~StatusLED();
 
     /**
-     * @brief Initialize the status LED
+     * @brief Initialize the status LED and start the self-test flash
+     * Returns immediately; the self-test plays in hardware and any status set
+     * meanwhile is shown when it ends.
      * @param pin Digital pin for LED control
      * @return true if initialization successful
      */
@@ -64,11 +94,6 @@ public:
      */
     void setStatus(LEDStatus status);
 
-    /**
-     * @brief Update LED animation (call in main loop)
-     */
-    void update();
-
     /**
      * @brief Get current status
      * @return Current LED status
@@ -80,4 +105,4 @@ public:
      * @param state true for ON, false for OFF
      */
     void setLED(bool state);
-};
\ No newline at end of file
+};
@@ -142,6 +142,18 @@ bool StoveRelay::forceState(bool state) {
     return true;
 }
 
+void StoveRelay::emergencyOff() {
+    if (!isInitialized) {
+        return;
+    }
+    
+    digitalWrite(controlPin, LOW);
+    if (currentState) {
+        currentState = false;
+        lastStateChange = millis();
+    }
+}
+
 bool StoveRelay::isReady() const {
     return isInitialized && (controlPin >= 0);
 }
\ No newline at end of file
@@ -20,9 +20,9 @@ class StoveRelay
 {
 private:
     int controlPin;
-    bool currentState;
+    volatile bool currentState; // Also cleared by the safety timer task
     bool isInitialized;
-    unsigned long lastStateChange;
+    volatile unsigned long lastStateChange;
 
     // Safety features
     const unsigned long MIN_STATE_CHANGE_INTERVAL = 2000; // 2 seconds minimum between changes
@@ -82,6 +82,12 @@ public:
      */
     bool forceState(bool state);
 
+    /**
+     * @brief Drive the pin LOW immediately without logging or delays
+     * Safe to call from the safety timer callback while the main loop is busy.
+     */
+    void emergencyOff();
+
     /**
      * @brief Check if relay is properly initialized
      * @return true if initialized and ready
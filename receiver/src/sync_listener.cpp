@@ -0,0 +1,201 @@
+/**
+ * @file sync_listener.cpp
+ * @brief Slot-synchronized duty-cycled listening implementation
+ * @version 1.0.0
+ * @date 2026-10-17
+ */
+
+#include "sync_listener.hpp"
+
+SyncListener::SyncListener() : enabled(false), slotCount(0), lastFrameMs(0),
+                               missedTotal(0), resyncCount(0), sleepCount(0),
+                               accountStartMs(0), sleepMs(0), txFrames(0) {
+    // Constructor
+}
+
+void SyncListener::setup(bool enable) {
+    enabled = enable;
+    for (uint8_t i = 0; i < slotCount; i++) {
+        slots[i].synced = false;
+    }
+    accountStartMs = millis();
+    Serial.printf("Listening mode: %s\n", enable ? "synchronized slots" : "continuous RX");
+}
+
+SyncListener::Slot *SyncListener::findSlot(uint8_t sourceId) {
+    for (uint8_t i = 0; i < slotCount; i++) {
+        if (slots[i].sourceId == sourceId) {
+            return &slots[i];
+        }
+    }
+    if (slotCount >= SYNC_MAX_THERMOSTATS) {
+        return nullptr;
+    }
+    Slot &slot = slots[slotCount++];
+    slot.sourceId = sourceId;
+    slot.synced = false;
+    slot.expectedSlotMs = 0;
+    slot.slotIntervalMs = P2P_SYNC_SLOT_INTERVAL_MS;
+    slot.missedInRow = 0;
+    return &slot;
+}
+
+bool SyncListener::addThermostat(uint8_t sourceId) {
+    return findSlot(sourceId) != nullptr;
+}
+
+void SyncListener::onFrame(uint8_t sourceId, const String &frame, unsigned long nowMs) {
+    lastFrameMs = nowMs;
+
+    Slot *slot = findSlot(sourceId);
+    if (!slot) {
+        Serial.printf("Warning: no room to track the slots of node %u\n", sourceId);
+        return;
+    }
+
+    String nextSlot;
+    if (!ProtocolHelper::getField(frame, P2P_FIELD_NEXT_SLOT, nextSlot)) {
+        // Sender is not announcing slots - nothing to synchronize to
+        slot->synced = false;
+        return;
+    }
+
+    unsigned long announcedMs = (unsigned long)nextSlot.toInt() * 1000UL;
+    if (announcedMs == 0) {
+        slot->synced = false;
+        return;
+    }
+
+    // The announcement was computed when the sender started transmitting,
+    // roughly one airtime before we finished receiving it
+    slot->expectedSlotMs = nowMs - P2P_TX_AIRTIME_MS + announcedMs;
+    slot->slotIntervalMs = announcedMs;
+    slot->missedInRow = 0;
+
+    if (!slot->synced) {
+        slot->synced = true;
+        resyncCount++;
+        Serial.printf("Slot sync acquired: node %u, next slot in %lu s\n", sourceId, announcedMs / 1000);
+    }
+}
+
+void SyncListener::onTransmit() {
+    txFrames++;
+}
+
+unsigned long SyncListener::getSleepDuration(unsigned long nowMs, unsigned long limitMs) {
+    if (!enabled || !isSynced()) {
+        return 0;
+    }
+
+    long untilSlot = 0;
+    for (uint8_t i = 0; i < slotCount; i++) {
+        Slot &slot = slots[i];
+
+        // Expected slot came and went without a frame
+        if ((long)(nowMs - slot.expectedSlotMs) > (long)SYNC_SLOT_WINDOW_MS) {
+            slot.missedInRow++;
+            missedTotal++;
+            if (slot.missedInRow >= SYNC_MAX_MISSED_SLOTS) {
+                slot.synced = false;
+                Serial.printf("Slot sync with node %u lost after %lu missed slots - continuous RX until resync\n",
+                              slot.sourceId, (unsigned long)slot.missedInRow);
+                return 0;
+            }
+            slot.expectedSlotMs += slot.slotIntervalMs;
+            Serial.printf("Missed slot of node %u (%lu in a row), expecting next in %ld s\n", slot.sourceId,
+                          (unsigned long)slot.missedInRow, (long)(slot.expectedSlotMs - nowMs) / 1000);
+        }
+
+        // Wake for whichever thermostat transmits first
+        long untilThis = (long)(slot.expectedSlotMs - nowMs);
+        if (i == 0 || untilThis < untilSlot) {
+            untilSlot = untilThis;
+        }
+    }
+
+    // Keep listening while the current slot may still carry retries
+    if (nowMs - lastFrameMs < SYNC_SLOT_LINGER_MS) {
+        return 0;
+    }
+
+    long untilWake = untilSlot - (long)SYNC_GUARD_MS;
+    if (untilWake < (long)SYNC_MIN_SLEEP_MS) {
+        return 0;
+    }
+
+    unsigned long duration = (unsigned long)untilWake;
+    if (duration > SYNC_MAX_SLEEP_MS) duration = SYNC_MAX_SLEEP_MS;
+    if (duration > limitMs) duration = limitMs;
+    return duration < SYNC_MIN_SLEEP_MS ? 0 : duration;
+}
+
+void SyncListener::recordSleep(unsigned long sleptMs) {
+    sleepMs += sleptMs;
+    sleepCount++;
+}
+
+bool SyncListener::isEnabled() const {
+    return enabled;
+}
+
+bool SyncListener::isSynced() const {
+    if (slotCount == 0) {
+        return false;
+    }
+    for (uint8_t i = 0; i < slotCount; i++) {
+        if (!slots[i].synced) {
+            return false;
+        }
+    }
+    return true;
+}
+
+float SyncListener::estimateContinuousCurrentMa() const {
+    unsigned long elapsedMs = millis() - accountStartMs;
+    if (elapsedMs == 0) {
+        return CURRENT_ESP32S3_ACTIVE_MA + CURRENT_WIO_E5_RX_MA;
+    }
+
+    float txMs = (float)txFrames * P2P_TX_AIRTIME_MS;
+    if (txMs > elapsedMs) txMs = elapsedMs;
+    float rxMs = elapsedMs - txMs;
+
+    return CURRENT_ESP32S3_ACTIVE_MA +
+           (CURRENT_WIO_E5_RX_MA * rxMs + CURRENT_WIO_E5_TX_MA * txMs) / elapsedMs;
+}
+
+float SyncListener::estimateAverageCurrentMa() const {
+    unsigned long elapsedMs = millis() - accountStartMs;
+    if (elapsedMs == 0) {
+        return estimateContinuousCurrentMa();
+    }
+
+    float asleepMs = (float)sleepMs;
+    if (asleepMs > elapsedMs) asleepMs = elapsedMs;
+    float awakeMs = elapsedMs - asleepMs;
+    float txMs = (float)txFrames * P2P_TX_AIRTIME_MS;
+    if (txMs > awakeMs) txMs = awakeMs;
+    float rxMs = awakeMs - txMs;
+
+    float chargeMaMs = CURRENT_ESP32S3_ACTIVE_MA * awakeMs +
+                       CURRENT_ESP32S3_LIGHT_SLEEP_MA * asleepMs +
+                       CURRENT_WIO_E5_RX_MA * rxMs +
+                       CURRENT_WIO_E5_TX_MA * txMs +
+                       CURRENT_WIO_E5_SLEEP_MA * asleepMs;
+    return chargeMaMs / elapsedMs;
+}
+
+String SyncListener::getStatistics() const {
+    unsigned long elapsedMs = millis() - accountStartMs;
+    float awakePercent = elapsedMs > 0 ? 100.0f * (1.0f - (float)sleepMs / elapsedMs) : 100.0f;
+
+    char buffer[192];
+    snprintf(buffer, sizeof(buffer),
+             "mode %s (%s), awake %.1f%%, sleeps %lu, missed slots %lu, resyncs %lu, "
+             "est. current continuous %.1f mA / measured %.1f mA",
+             enabled ? "synchronized" : "continuous", isSynced() ? "synced" : "unsynced",
+             awakePercent, (unsigned long)sleepCount, (unsigned long)missedTotal,
+             (unsigned long)resyncCount, estimateContinuousCurrentMa(), estimateAverageCurrentMa());
+    return String(buffer);
+}
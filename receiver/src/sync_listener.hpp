@@ -0,0 +1,165 @@
+/**
+ * @file sync_listener.hpp
+ * @brief Slot-synchronized duty-cycled listening for the receiver
+ * @version 1.0.0
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "../../shared/protocol_common.hpp"
+
+// Configuration flags
+#define RECEIVER_SYNC_LISTEN_ENABLED false // Sleep between the thermostat's announced slots (needs LORA_TX_SYNC_SLOTS_ENABLED)
+#define SYNC_GUARD_MS 3000                 // Wake this long before a slot (clock drift, modem wake, RX arm)
+#define SYNC_SLOT_LINGER_MS 10000          // Stay in RX after the last frame of a slot (retries, follow-up command)
+#define SYNC_SLOT_WINDOW_MS 20000          // No frame by slot + window counts as a missed slot
+#define SYNC_MAX_MISSED_SLOTS 3            // Fall back to continuous RX after this many misses in a row
+#define SYNC_MIN_SLEEP_MS 2000             // Shorter gaps are not worth a modem sleep/wake cycle
+#define SYNC_MAX_SLEEP_MS 20000            // Wake at least this often to feed the task watchdog
+#define SYNC_MAX_THERMOSTATS 8             // Thermostats whose slots are tracked (bound IDs, unaddressed frames)
+
+// Nominal supply currents used for the energy estimate
+// Wio-E5 figures from doc/HARDWARE_GUIDE.md, ESP32-S3 figures from its datasheet
+#define CURRENT_ESP32S3_ACTIVE_MA 40.0f
+#define CURRENT_ESP32S3_LIGHT_SLEEP_MA 0.24f
+#define CURRENT_WIO_E5_RX_MA 15.0f
+#define CURRENT_WIO_E5_TX_MA 40.0f
+#define CURRENT_WIO_E5_SLEEP_MA 0.021f
+
+/**
+ * @class SyncListener
+ * @brief Tracks the thermostats' transmit slots and decides when the radio may sleep
+ *
+ * Every thermostat frame carries the seconds until its next transmit slot
+ * (P2P_FIELD_NEXT_SLOT). Each thermostat keeps its own slots, so they are
+ * tracked per source node ID. After the last frame of a slot the receiver can
+ * put the Wio-E5 and the ESP32-S3 to sleep until just before the earliest
+ * next slot. Missed slots are predicted forward from the last announced
+ * interval; after SYNC_MAX_MISSED_SLOTS misses in a row that thermostat drops
+ * sync and the radio stays in continuous RX until it is heard again. The
+ * radio also stays in continuous RX until every thermostat added with
+ * addThermostat() has announced a slot.
+ *
+ * Only frames from this receiver's own thermostats may be passed in: other
+ * zones' traffic on the shared channel follows other slots.
+ *
+ * The class only keeps time and makes decisions; the radio task owns the
+ * modem and performs the actual sleep.
+ */
+class SyncListener
+{
+private:
+    /**
+     * @struct Slot
+     * @brief Slot schedule of one thermostat
+     */
+    struct Slot
+    {
+        uint8_t sourceId;
+        bool synced;
+        unsigned long expectedSlotMs; // millis() at which the next slot should start
+        unsigned long slotIntervalMs; // Last announced slot spacing
+        uint32_t missedInRow;
+    };
+
+    bool enabled;
+    Slot slots[SYNC_MAX_THERMOSTATS];
+    uint8_t slotCount;
+    unsigned long lastFrameMs; // millis() of the last frame from one of our thermostats
+
+    // Sync bookkeeping
+    uint32_t missedTotal;
+    uint32_t resyncCount;
+    uint32_t sleepCount;
+
+    // State timing for the current estimate
+    unsigned long accountStartMs;
+    uint64_t sleepMs;
+    uint32_t txFrames;
+
+    /**
+     * @brief Find a thermostat's slot, adding it if there is room
+     * @return Slot, nullptr if unknown and the table is full
+     */
+    Slot *findSlot(uint8_t sourceId);
+
+public:
+    /**
+     * @brief Constructor
+     */
+    SyncListener();
+
+    /**
+     * @brief Start time accounting and select the listening mode
+     * @param enable true for synchronized listening, false for continuous RX
+     */
+    void setup(bool enable);
+
+    /**
+     * @brief Expect slot announcements from a thermostat
+     * The radio stays in continuous RX until it has announced a slot.
+     * @param sourceId Thermostat node ID
+     * @return true if tracked, false if SYNC_MAX_THERMOSTATS are already tracked
+     */
+    bool addThermostat(uint8_t sourceId);
+
+    /**
+     * @brief Note a frame from one of our thermostats and pick up its slot announcement
+     * @param sourceId Sender node ID (P2P_NODE_ID_NONE for unaddressed frames)
+     * @param frame Decoded frame, e.g. "STATUS_REQUEST;S=2;D=1;NS=60"
+     * @param nowMs millis() when the frame was parsed
+     */
+    void onFrame(uint8_t sourceId, const String &frame, unsigned long nowMs);
+
+    /**
+     * @brief Note a transmitted response (for the airtime estimate)
+     */
+    void onTransmit();
+
+    /**
+     * @brief Decide whether the radio may sleep now
+     * Also advances the expected slot when one passed without a frame.
+     * @param nowMs Current millis()
+     * @param limitMs Upper bound on the sleep (e.g. time left on the safety timer)
+     * @return Milliseconds to sleep, 0 to keep listening
+     */
+    unsigned long getSleepDuration(unsigned long nowMs, unsigned long limitMs);
+
+    /**
+     * @brief Account for a completed sleep
+     * @param sleptMs Time actually spent asleep
+     */
+    void recordSleep(unsigned long sleptMs);
+
+    /**
+     * @brief Check whether synchronized listening is enabled
+     * @return true if enabled
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Check whether every tracked thermostat's slot schedule is known
+     * @return true if synchronized
+     */
+    bool isSynced() const;
+
+    /**
+     * @brief Estimate average supply current for continuous RX
+     * @return Current in mA
+     */
+    float estimateContinuousCurrentMa() const;
+
+    /**
+     * @brief Estimate average supply current from measured awake/sleep time
+     * @return Current in mA
+     */
+    float estimateAverageCurrentMa() const;
+
+    /**
+     * @brief Get sync state, duty cycle and current estimates as a printable string
+     * @return Statistics string
+     */
+    String getStatistics() const;
+};
@@ -0,0 +1,34 @@
+/**
+ * @file zone_router.cpp
+ * @brief Thermostat node ID to relay channel routing table implementation
+ * @version 1.0.0
+ * @date 2026-10-17
+ */
+
+#include "zone_router.hpp"
+
+ZoneRouter::ZoneRouter() : channelCount(0) {
+    memset(channelBySource, ZONE_NO_CHANNEL, sizeof(channelBySource));
+}
+
+bool ZoneRouter::bind(uint8_t sourceId, uint8_t channel) {
+    if (sourceId == P2P_NODE_ID_BROADCAST || channel >= ZONE_MAX_CHANNELS) {
+        Serial.printf("ERROR: Cannot bind node %u to channel %u\n", sourceId, channel);
+        return false;
+    }
+
+    channelBySource[sourceId] = channel;
+    if (channel + 1 > channelCount) {
+        channelCount = channel + 1;
+    }
+    Serial.printf("Zone routing: node %u -> channel %u\n", sourceId, channel);
+    return true;
+}
+
+uint8_t ZoneRouter::route(uint8_t sourceId) const {
+    return channelBySource[sourceId];
+}
+
+uint8_t ZoneRouter::getChannelCount() const {
+    return channelCount;
+}
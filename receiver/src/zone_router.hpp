@@ -0,0 +1,57 @@
+/**
+ * @file zone_router.hpp
+ * @brief Thermostat node ID to relay channel routing table
+ * @version 1.0.0
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "../../shared/protocol_common.hpp"
+
+#define ZONE_MAX_CHANNELS 4 // Relay channels one receiver can drive
+#define ZONE_NO_CHANNEL 0xFF
+
+/**
+ * @class ZoneRouter
+ * @brief Maps the source node ID of a frame to the relay channel it controls
+ *
+ * One byte per possible node ID (256 bytes total) gives a constant-time
+ * lookup with no search and no heap. Several thermostats can be bound to
+ * different channels. A channel may also be bound to more than one ID,
+ * e.g. to P2P_NODE_ID_NONE so that unaddressed frames still reach it.
+ */
+class ZoneRouter
+{
+private:
+    uint8_t channelBySource[256];
+    uint8_t channelCount;
+
+public:
+    /**
+     * @brief Constructor - starts with no bindings
+     */
+    ZoneRouter();
+
+    /**
+     * @brief Bind a thermostat node ID to a relay channel
+     * @param sourceId Thermostat node ID (P2P_NODE_ID_NONE for unaddressed frames)
+     * @param channel Relay channel index (< ZONE_MAX_CHANNELS)
+     * @return true if bound, false for broadcast ID or invalid channel
+     */
+    bool bind(uint8_t sourceId, uint8_t channel);
+
+    /**
+     * @brief Look up the channel controlled by a thermostat
+     * @param sourceId Source node ID from the frame
+     * @return Channel index, ZONE_NO_CHANNEL if the ID is not bound
+     */
+    uint8_t route(uint8_t sourceId) const;
+
+    /**
+     * @brief Get the number of channels with at least one binding
+     * @return Highest bound channel index + 1
+     */
+    uint8_t getChannelCount() const;
+};
@@ -57,6 +57,36 @@ enum class LoRaCommunicationMode
 // P2P command prefix for protocol identification
 #define P2P_MSG_PREFIX "THERMO" // 6 chars prefix to identify our messages
 
+// Optional frame fields appended to a command/response: "STOVE_ON;NS=60"
+// Receivers that predate a field simply see it as part of an unknown suffix.
+#define P2P_FIELD_SEPARATOR ';'
+#define P2P_FIELD_NEXT_SLOT "NS"    // Seconds until the sender's next scheduled transmission
+#define P2P_FIELD_SOURCE "S"        // Node ID of the sender
+#define P2P_FIELD_DEST "D"          // Node ID of the addressee
+#define P2P_FIELD_RECONFIRM "RC"    // Receiver resumed after a reset: resend the intended state (value = its sequence number)
+#define P2P_FIELD_SEQUENCE "Q"      // Sender's 16-bit frame counter, incremented per transmission (loss estimate)
+#define P2P_FIELD_LINK_RSSI "RS"    // Status reply: smoothed RSSI of the thermostat's frames (dBm)
+#define P2P_FIELD_LINK_SNR "SN"     // Status reply: smoothed SNR of the thermostat's frames (dB)
+#define P2P_FIELD_LINK_ERRORS "PE"  // Status reply: recent packet error rate (%)
+#define P2P_FIELD_RUNTIME "RT"      // Status request, hourly: stove ON minutes last hour/today, cycles today
+#define P2P_FIELD_HEATER_FAULT "HF" // Status request: heater alarm, 1 = no heat, 2 = stuck ON, 0 = cleared
+
+// Longest frame (without the THERMO prefix) a node may send or accept. The widest today, a
+// status request or reply with every field at full width, is about 100 characters.
+#define P2P_MAX_FRAME_LENGTH 128
+
+// Node addressing for multi-zone setups (IDs 1..254). Thermostats and receivers share
+// one ID space, so a thermostat and a receiver may both be node 1: frames addressed to
+// us are told apart by what they carry, a command or a reply (see isReply).
+#define P2P_NODE_ID_NONE 0          // Unaddressed frame from a sender without a node ID
+#define P2P_NODE_ID_BROADCAST 255   // Addressed to every node
+#define P2P_DEFAULT_THERMOSTAT_ID 1 // Node ID a thermostat ships with
+#define P2P_DEFAULT_RECEIVER_ID 1   // Node ID a receiver ships with
+
+// Synchronized listening (thermostat transmits only in announced slots)
+#define P2P_SYNC_SLOT_INTERVAL_MS 60000 // Default spacing between thermostat transmit slots
+#define P2P_TX_AIRTIME_MS 1500          // Approximate SF12/125 kHz airtime of a short frame
+
 // LoRaWAN Configuration Constants
 // Note: These should match between transmitter and receiver
 
@@ -164,10 +194,11 @@ public:
      */
     static bool isValidCommand(const String &command)
     {
-        return (command == CMD_STOVE_ON ||
-                command == CMD_STOVE_OFF ||
-                command == CMD_STATUS_REQUEST ||
-                command == CMD_PING);
+        String name = getCommand(command); // May already carry fields
+        return (name == CMD_STOVE_ON ||
+                name == CMD_STOVE_OFF ||
+                name == CMD_STATUS_REQUEST ||
+                name == CMD_PING);
     }
     /**
      * @brief Validate if a response is recognized
@@ -180,6 +211,23 @@ public:
                 response == RESP_PONG || response == RESP_STATUS ||
                 response.startsWith("STATUS:") || response == "SENT");
     }
+    /**
+     * @brief Check whether a frame is a receiver's reply rather than a command
+     * A receiver hears the other receivers' replies, which may be addressed to a
+     * thermostat with the same node ID as itself.
+     * @param frame Received frame, may carry fields
+     * @return true if the frame is a reply (acknowledgment, status or error)
+     */
+    static bool isReply(const String &frame)
+    {
+        String name = getCommand(frame);
+        if (isValidCommand(name))
+        {
+            return false;
+        }
+        return (isValidResponse(name) || name == RESP_ACK || name == RESP_NACK || name == RESP_ERROR ||
+                name == RESP_TIMEOUT || name == RESP_UNKNOWN);
+    }
     /**
      * @brief Create a P2P message with prefix for identification
      * @param command Command string
@@ -206,6 +254,162 @@ public:
         return ""; // Invalid prefix
     }
 
+    /**
+     * @brief Get the command part of a frame (everything before the first field)
+     * @param frame Received frame, e.g. "STOVE_ON;NS=60"
+     * @return Command without fields, e.g. "STOVE_ON"
+     */
+    static String getCommand(const String &frame)
+    {
+        int separator = frame.indexOf(P2P_FIELD_SEPARATOR);
+        return separator >= 0 ? frame.substring(0, separator) : frame;
+    }
+
+    /**
+     * @brief Append a KEY=VALUE field to a frame
+     * @param frame Command or response string
+     * @param key Field name (short, no separator or '=')
+     * @param value Field value
+     * @return Frame with the field appended
+     */
+    static String addField(const String &frame, const char *key, const String &value)
+    {
+        return frame + P2P_FIELD_SEPARATOR + key + "=" + value;
+    }
+
+    /**
+     * @brief Look up a KEY=VALUE field in a frame
+     * @param frame Received frame
+     * @param key Field name to find
+     * @param value Receives the field value when found
+     * @return true if the field is present
+     */
+    static bool getField(const String &frame, const char *key, String &value)
+    {
+        String needle = String(P2P_FIELD_SEPARATOR) + key + "=";
+        int start = frame.indexOf(needle);
+        if (start < 0)
+        {
+            return false;
+        }
+        start += needle.length();
+        int end = frame.indexOf(P2P_FIELD_SEPARATOR, start);
+        value = end >= 0 ? frame.substring(start, end) : frame.substring(start);
+        return true;
+    }
+
+    /**
+     * @brief Add source and destination node IDs to a frame
+     * @param frame Command or response string
+     * @param source Sender node ID (P2P_NODE_ID_NONE to leave out)
+     * @param dest Addressee node ID (P2P_NODE_ID_NONE to leave out)
+     * @return Frame with S/D fields appended
+     */
+    static String addAddress(const String &frame, uint8_t source, uint8_t dest)
+    {
+        String addressed = frame;
+        if (source != P2P_NODE_ID_NONE)
+        {
+            addressed = addField(addressed, P2P_FIELD_SOURCE, String(source));
+        }
+        if (dest != P2P_NODE_ID_NONE)
+        {
+            addressed = addField(addressed, P2P_FIELD_DEST, String(dest));
+        }
+        return addressed;
+    }
+
+    /**
+     * @brief Read a node ID field from a frame
+     * @param frame Received frame
+     * @param key P2P_FIELD_SOURCE or P2P_FIELD_DEST
+     * @return Node ID, P2P_NODE_ID_NONE if absent or out of range
+     */
+    static uint8_t getNodeId(const String &frame, const char *key)
+    {
+        String value;
+        if (!getField(frame, key, value))
+        {
+            return P2P_NODE_ID_NONE;
+        }
+        long id = value.toInt();
+        return (id > 0 && id <= P2P_NODE_ID_BROADCAST) ? (uint8_t)id : P2P_NODE_ID_NONE;
+    }
+
+    /**
+     * @brief Check whether a frame is meant for a node
+     * Unaddressed and broadcast frames are accepted by every node.
+     * @param frame Received frame
+     * @param nodeId Our node ID
+     * @return true if the frame should be processed
+     */
+    static bool isAddressedTo(const String &frame, uint8_t nodeId)
+    {
+        uint8_t dest = getNodeId(frame, P2P_FIELD_DEST);
+        return dest == P2P_NODE_ID_NONE || dest == P2P_NODE_ID_BROADCAST || dest == nodeId;
+    }
+
+    /**
+     * @brief Build the frame a thermostat sends for a command
+     * Adds the S/D address, the Q sequence number and, when a slot is announced, NS.
+     * @param command Command, e.g. "STOVE_ON"
+     * @param source Sender node ID (P2P_NODE_ID_NONE to leave out)
+     * @param dest Addressee node ID (P2P_NODE_ID_NONE to leave out)
+     * @param sequence Sender's frame counter
+     * @param nextSlotSeconds Seconds until the sender's next slot, negative to leave out
+     * @return Frame to transmit, e.g. "STOVE_ON;S=2;D=1;Q=7;NS=60"
+     */
+    static String buildCommandFrame(const String &command, uint8_t source, uint8_t dest, uint16_t sequence,
+                                    long nextSlotSeconds)
+    {
+        String frame = addAddress(command, source, dest);
+        frame = addField(frame, P2P_FIELD_SEQUENCE, String((unsigned int)sequence));
+        if (nextSlotSeconds >= 0)
+        {
+            frame = addField(frame, P2P_FIELD_NEXT_SLOT, String(nextSlotSeconds));
+        }
+        return frame;
+    }
+
+    /**
+     * @brief Check whether a received frame is the reply to our own command
+     * Other zones' exchanges on the shared channel are heard too. A reply must be
+     * addressed to us and, if we addressed a receiver, come from that receiver
+     * (a reply without a source, from an older receiver, is accepted). Another
+     * thermostat's command to a receiver with our node ID is not a reply.
+     * @param reply Received frame
+     * @param nodeId Our node ID
+     * @param peerId Receiver our command was addressed to (P2P_NODE_ID_NONE if unaddressed)
+     * @return true if the frame answers our command
+     */
+    static bool isReplyFor(const String &reply, uint8_t nodeId, uint8_t peerId)
+    {
+        if (!isAddressedTo(reply, nodeId) || isValidCommand(reply))
+        {
+            return false;
+        }
+        uint8_t source = getNodeId(reply, P2P_FIELD_SOURCE);
+        return peerId == P2P_NODE_ID_NONE || source == P2P_NODE_ID_NONE || source == peerId;
+    }
+
+    /**
+     * @brief Time on air of a P2P frame with the radio settings above
+     * Semtech LoRa formula: explicit header, CRC on, coding rate 4/5, low data
+     * rate optimization once a symbol is longer than 16 ms (SF11/SF12 at 125 kHz).
+     * @param payloadBytes Frame length in bytes
+     * @return Airtime in milliseconds (about 1.9 s for 30 bytes at SF12)
+     */
+    static unsigned long getAirtimeMs(size_t payloadBytes)
+    {
+        const long sf = atol(P2P_SPREADING_FACTOR + 2); // "SF12"
+        const float symbolMs = (float)(1L << sf) / atol(P2P_BANDWIDTH);
+        const long bitsPerBlock = 4 * (sf - (symbolMs > 16.0f ? 2 : 0));
+        long bits = 8 * (long)payloadBytes - 4 * sf + 28 + 16;
+        long blocks = bits > 0 ? (bits + bitsPerBlock - 1) / bitsPerBlock : 0;
+        float symbols = atol(P2P_PREAMBLE_LENGTH) + 4.25f + 8 + blocks * 5;
+        return (unsigned long)(symbols * symbolMs + 0.5f);
+    }
+
     /**
      * @brief Check if message is a valid P2P thermostat message
      * @param message Message to check
@@ -0,0 +1,624 @@
+/**
+ * @file wio_e5_modem.hpp
+ * @brief Grove-Wio-E5 AT command driver shared by the thermostat and the receiver
+ * @version 1.0.0
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "protocol_common.hpp"
+
+// Modem timing, identical for both roles
+#define WIO_E5_RESPONSE_SILENCE_MS 500 // Quiet time that ends a response
+#define WIO_E5_ECHO_WAIT_MS 2000       // Longest wait for the reply after a bare echo
+#define WIO_E5_RX_DONE_WAIT_MS 11000   // Longest wait for "RX DONE" or a frame (SF12 RX window)
+#define WIO_E5_SETTLE_MS 10            // Let stray bytes arrive before a command is sent
+#define WIO_E5_TX_MARGIN_MS 2000       // AT+TEST=TXLRPKT time beyond the frame's airtime (echo, UART, TX DONE)
+#define WIO_E5_RESET_BOOT_MS 3000      // Module boot time after AT+RESET
+#define WIO_E5_CONNECT_RETRY_MS 2000   // Pause between AT probes while the module boots
+#define WIO_E5_BAUD_ATTEMPTS 5         // AT probes per candidate baud rate during the search
+#define WIO_E5_JOIN_ATTEMPTS 3
+
+/**
+ * @class WioE5Modem
+ * @brief AT command layer for one Grove-Wio-E5 module
+ *
+ * Covers what both boards do the same way: the command/response exchange,
+ * finding the module (fixed baud rate or baud search), reset, P2P setup,
+ * LoRaWAN join, P2P transmit, listening for a reply and low-power control.
+ * Role-specific behavior
+ * (continuous receive on the receiver, request/response on the thermostat)
+ * stays in LoRaReceiver and LoRaTransmitter, which own one of these.
+ *
+ * @tparam Port   UART type: HardwareSerial on the boards, a simulated modem
+ *                with the same available/read/write/println/begin/end calls
+ *                on the host
+ * @tparam Policy Role settings, with static members:
+ *                - BAUD_SEARCH (bool), FIXED_BAUD (long)
+ *                - BOOT_WAIT_MS: wait after opening the UART before the first AT
+ *                - CONNECT_TIMEOUT_MS: give up finding the module after this
+ *                - feedWatchdog(): called during every long wait
+ */
+template <typename Port, typename Policy>
+class WioE5Modem
+{
+private:
+    Port *port;
+    long baudRate;
+    int rxPin;
+    int txPin;
+
+    void wait(unsigned long ms)
+    {
+        // Sleep in slices so the task watchdog stays fed
+        unsigned long start = millis();
+        while (millis() - start < ms)
+        {
+            Policy::feedWatchdog();
+            unsigned long left = ms - (millis() - start);
+            delay(left > 500 ? 500 : left);
+        }
+    }
+
+    static bool isSuccess(const String &command, const String &response, const String &expected)
+    {
+        // The module may echo the command before replying, e.g. "AT\r\nOK" or "AT\r\n+AT: OK"
+        if (response.indexOf(expected) >= 0)
+        {
+            return true;
+        }
+        return expected == "OK" && (response.indexOf("+OK") >= 0 ||
+                                    response.indexOf("\nOK") >= 0 ||
+                                    response.indexOf("+AT: OK") >= 0 ||
+                                    (response.indexOf("OK") >= 0 && response.length() > command.length()));
+    }
+
+    static bool hasReceivedFrame(const String &response)
+    {
+        // A whole +TEST: RX "hex" line, closing quote included
+        int rx = response.indexOf("+TEST: RX \"");
+        return rx >= 0 && response.indexOf('"', rx + 11) >= 0;
+    }
+
+    static bool takeReceivedFrame(String &pending, String &frame)
+    {
+        // Remove the first whole +TEST: RX "hex" line and decode it
+        int rx = pending.indexOf("+TEST: RX \"");
+        int endQuote = rx >= 0 ? pending.indexOf('"', rx + 11) : -1;
+        if (endQuote < 0)
+        {
+            return false;
+        }
+        frame = ProtocolHelper::hexToAscii(pending.substring(rx + 11, endQuote));
+        pending = pending.substring(endQuote + 1);
+        return true;
+    }
+
+    static void reportFailure(const String &command, const String &response, const String &expected)
+    {
+        Serial.printf("Command failed - expected '%s' but got '%s'\n", expected.c_str(), response.c_str());
+        if (response.length() == 0)
+        {
+            Serial.println("  No response received - check connections and power");
+            return;
+        }
+
+        Serial.print("  Received data: ");
+        for (unsigned int i = 0; i < response.length() && i < 50; i++)
+        {
+            Serial.printf("0x%02X ", (unsigned char)response.charAt(i));
+        }
+        Serial.println();
+
+        String responseUpper = response;
+        responseUpper.toUpperCase();
+        String commandUpper = command;
+        commandUpper.toUpperCase();
+        if (responseUpper.startsWith(commandUpper) && response.indexOf("OK") < 0)
+        {
+            Serial.println("  (Echo received but no OK - module may need reset or longer timeout)");
+        }
+        else if (response.indexOf(command) < 0)
+        {
+            Serial.println("  (Unexpected response - may indicate wrong baud rate)");
+        }
+    }
+
+    bool probeAt(long baud, bool firstRate, unsigned long startTime)
+    {
+        if (!firstRate)
+        {
+            port->end();
+            delay(500);
+        }
+        port->begin(baud, SERIAL_8N1, rxPin, txPin);
+        wait(firstRate ? Policy::BOOT_WAIT_MS : WIO_E5_CONNECT_RETRY_MS);
+
+        int attempt = 0;
+        while (millis() - startTime < Policy::CONNECT_TIMEOUT_MS)
+        {
+            attempt++;
+            if (Policy::BAUD_SEARCH && attempt > WIO_E5_BAUD_ATTEMPTS)
+            {
+                break; // Try the next candidate rate
+            }
+            Serial.printf("  Attempt %d at %ld baud (elapsed: %lu ms)...\n", attempt, baud, millis() - startTime);
+            Policy::feedWatchdog();
+
+            sendWakeBytes();
+            if (sendATCommand("AT", "OK", 2000))
+            {
+                Serial.printf("SUCCESS! Module responding at %ld baud\n", baud);
+                baudRate = baud;
+                return true;
+            }
+            wait(WIO_E5_CONNECT_RETRY_MS);
+        }
+        return false;
+    }
+
+public:
+    /**
+     * @brief Constructor
+     */
+    WioE5Modem() : port(nullptr), baudRate(0), rxPin(-1), txPin(-1)
+    {
+    }
+
+    /**
+     * @brief Use a UART for all further commands (not opened here)
+     * @param serialPort UART connected to the module
+     * @param rx UART RX pin (module TX)
+     * @param tx UART TX pin (module RX)
+     */
+    void attach(Port *serialPort, int rx, int tx)
+    {
+        port = serialPort;
+        rxPin = rx;
+        txPin = tx;
+    }
+
+    /**
+     * @brief Get the baud rate the module answered at
+     * @return Baud rate, 0 before a successful connect()/resume()
+     */
+    long getBaudRate() const
+    {
+        return baudRate;
+    }
+
+    /**
+     * @brief Open the UART and wait for the module to answer AT
+     * Uses Policy::FIXED_BAUD, or tries 19200/9600/115200 when Policy::BAUD_SEARCH
+     * is set. Waits for the module to boot and keeps probing until
+     * Policy::CONNECT_TIMEOUT_MS has passed.
+     * @return true if the module responded
+     */
+    bool connect()
+    {
+        if (!port)
+        {
+            return false;
+        }
+
+        unsigned long startTime = millis();
+        if (!Policy::BAUD_SEARCH)
+        {
+            Serial.printf("Using fixed baud rate: %ld (baud search disabled)\n", (long)Policy::FIXED_BAUD);
+            return probeAt(Policy::FIXED_BAUD, true, startTime);
+        }
+
+        const long baudRates[] = {19200, 9600, 115200};
+        for (size_t i = 0; i < sizeof(baudRates) / sizeof(baudRates[0]); i++)
+        {
+            if (millis() - startTime >= Policy::CONNECT_TIMEOUT_MS)
+            {
+                Serial.println("Initialization timeout reached");
+                break;
+            }
+            Serial.printf("\nTrying baud rate: %ld\n", baudRates[i]);
+            if (probeAt(baudRates[i], i == 0, startTime))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Reattach to a module that is already running (no boot wait)
+     * Only possible with a fixed baud rate.
+     * @param attempts AT probes before giving up
+     * @return true if the module responded
+     */
+    bool resume(int attempts)
+    {
+        if (!port || Policy::BAUD_SEARCH)
+        {
+            return false;
+        }
+
+        port->begin(Policy::FIXED_BAUD, SERIAL_8N1, rxPin, txPin);
+        for (int attempt = 1; attempt <= attempts; attempt++)
+        {
+            sendWakeBytes();
+            if (sendATCommand("AT", "OK", 500)) // Also ends a pending RX
+            {
+                baudRate = Policy::FIXED_BAUD;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Send the wake-up bytes that end the module's auto low-power sleep
+     */
+    void sendWakeBytes()
+    {
+        if (!port)
+        {
+            return;
+        }
+        clearSerialBuffer();
+        for (int i = 0; i < 4; i++)
+        {
+            port->write((uint8_t)0xFF);
+        }
+        delay(50);
+        clearSerialBuffer();
+    }
+
+    /**
+     * @brief Discard everything the module has sent so far
+     */
+    void clearSerialBuffer()
+    {
+        if (!port)
+        {
+            return;
+        }
+        unsigned long startTime = millis();
+        while (port->available() && (millis() - startTime < 1000))
+        {
+            port->read();
+        }
+    }
+
+    /**
+     * @brief Collect the module's reply to the last command
+     * Ends after WIO_E5_RESPONSE_SILENCE_MS of quiet, but keeps waiting when
+     * only the echo of a TX/RX command (or a bare echo) has arrived so far.
+     * An RX echo waits until a complete frame line, even one split by a pause.
+     * A TX echo waits for "TX DONE" until the timeout, which the caller sizes
+     * from the frame's airtime.
+     * @param timeout Overall limit (ms)
+     * @return Trimmed response, empty if nothing arrived
+     */
+    String readResponse(int timeout = 5000)
+    {
+        if (!port)
+        {
+            return "";
+        }
+
+        String response = "";
+        unsigned long startTime = millis();
+        unsigned long lastDataTime = millis();
+
+        while (millis() - startTime < (unsigned long)timeout)
+        {
+            Policy::feedWatchdog();
+
+            // Drain everything buffered - the UART delivers ~1 byte/ms at 9600 baud
+            bool gotData = false;
+            while (port->available())
+            {
+                response += (char)port->read();
+                gotData = true;
+            }
+            if (gotData)
+            {
+                lastDataTime = millis();
+            }
+            else if (response.length() > 0)
+            {
+                unsigned long silenceTime = millis() - lastDataTime;
+                if (silenceTime > WIO_E5_RESPONSE_SILENCE_MS)
+                {
+                    bool waitTx = response.indexOf("TXLRPKT") >= 0 && response.indexOf("TX DONE") < 0;
+                    bool waitRx = response.indexOf("RXLRPKT") >= 0 && response.indexOf("RX DONE") < 0 &&
+                                  response.indexOf("RXLRPKT,") < 0 && !hasReceivedFrame(response) &&
+                                  silenceTime < WIO_E5_RX_DONE_WAIT_MS;
+                    bool waitEcho = response.length() <= 10 && response.indexOf("OK") < 0 &&
+                                    response.indexOf("DONE") < 0 && silenceTime < WIO_E5_ECHO_WAIT_MS;
+                    if (!waitTx && !waitRx && !waitEcho)
+                    {
+                        break;
+                    }
+                }
+            }
+            delay(gotData ? 1 : 10);
+        }
+
+        response.trim();
+        return response;
+    }
+
+    /**
+     * @brief Send an AT command and check the reply
+     * @param command Command without line ending
+     * @param expectedResponse Text that must appear in the reply, empty to not wait
+     * @param timeout Reply timeout (ms)
+     * @return true if the expected text arrived (always true when none is expected)
+     */
+    bool sendATCommand(const String &command, const String &expectedResponse = "OK", int timeout = 5000)
+    {
+        if (!port)
+        {
+            return false;
+        }
+
+        clearSerialBuffer();
+        delay(WIO_E5_SETTLE_MS);
+        clearSerialBuffer();
+
+        unsigned long startTime = millis();
+        port->println(command);
+        Serial.printf("TX: %s\n", command.c_str());
+
+        if (expectedResponse.length() == 0)
+        {
+            return true;
+        }
+
+        String response = readResponse(timeout);
+        Serial.printf("RX: %s (took %lu ms)\n", response.c_str(), millis() - startTime);
+
+        bool success = isSuccess(command, response, expectedResponse);
+        if (!success)
+        {
+            reportFailure(command, response, expectedResponse);
+        }
+        return success;
+    }
+
+    /**
+     * @brief Turn off command echo
+     * @return true if the module confirmed
+     */
+    bool disableEcho()
+    {
+        Serial.println("Disabling echo mode...");
+        if (sendATCommand("ATE0", "OK", 2000))
+        {
+            Serial.println("Echo disabled successfully");
+            return true;
+        }
+        Serial.println("Warning: Could not disable echo (continuing anyway)");
+        return false;
+    }
+
+    /**
+     * @brief Reset the module and wait until it answers again
+     * @return true if the module responded after the reset
+     */
+    bool reset()
+    {
+        Serial.println("Resetting Grove-Wio-E5 module...");
+        if (!sendATCommand("AT+RESET", "", 2000))
+        {
+            return false;
+        }
+        wait(WIO_E5_RESET_BOOT_MS);
+        clearSerialBuffer(); // Boot messages
+        return sendATCommand("AT", "OK", 3000);
+    }
+
+    /**
+     * @brief Enter TEST mode and apply the shared P2P radio settings
+     * @return true if both steps were confirmed
+     */
+    bool configureP2P()
+    {
+        Serial.println("Configuring P2P mode...");
+
+        // Replies are "+MODE: TEST" and "+TEST: RFCFG ...", not "OK"
+        if (!sendATCommand("AT+MODE=TEST", "TEST"))
+        {
+            Serial.println("Failed to enter TEST mode");
+            return false;
+        }
+
+        String rfConfigCommand = "AT+TEST=RFCFG," + String(P2P_FREQUENCY) + "," + P2P_SPREADING_FACTOR + "," +
+                                 P2P_BANDWIDTH + "," + P2P_CODING_RATE + "," + P2P_PREAMBLE_LENGTH + "," +
+                                 P2P_TX_POWER;
+        if (!sendATCommand(rfConfigCommand, "RFCFG"))
+        {
+            Serial.println("Failed to configure P2P RF parameters");
+            return false;
+        }
+
+        Serial.println("P2P mode configured successfully");
+        Serial.printf("Frequency: %d MHz, SF: %s, BW: %s, CR: %s, Power: %s dBm\n",
+                      P2P_FREQUENCY, P2P_SPREADING_FACTOR, P2P_BANDWIDTH, P2P_CODING_RATE, P2P_TX_POWER);
+        return true;
+    }
+
+    /**
+     * @brief Join the LoRaWAN network (OTAA), retrying up to WIO_E5_JOIN_ATTEMPTS times
+     * Enables auto low-power mode once joined.
+     * @return true if the network was joined
+     */
+    bool joinNetwork()
+    {
+        Serial.println("Attempting to join LoRaWAN network...");
+
+        for (int attempt = 1; attempt <= WIO_E5_JOIN_ATTEMPTS; attempt++)
+        {
+            Serial.printf("Join attempt %d/%d\n", attempt, WIO_E5_JOIN_ATTEMPTS);
+
+            if (!sendATCommand("AT+JOIN", "OK", 3000))
+            {
+                Serial.printf("Join command failed on attempt %d\n", attempt);
+                if (attempt < WIO_E5_JOIN_ATTEMPTS)
+                {
+                    wait(5000);
+                }
+                continue;
+            }
+
+            // Join confirmation can take up to LORAWAN_JOIN_TIMEOUT
+            unsigned long startTime = millis();
+            bool joinStarted = false;
+            bool joinFailed = false;
+            while (!joinFailed && millis() - startTime < LORAWAN_JOIN_TIMEOUT)
+            {
+                String response = readResponse(1000);
+                if (response.indexOf("+JOIN: Start") >= 0)
+                {
+                    joinStarted = true;
+                    Serial.println("Join process started...");
+                }
+                if (response.indexOf("+JOIN: Network joined") >= 0)
+                {
+                    Serial.printf("Successfully joined LoRaWAN network (%lu ms)\n", millis() - startTime);
+                    setAutoLowPowerMode(true);
+                    return true;
+                }
+                joinFailed = response.indexOf("+JOIN: Join failed") >= 0;
+            }
+
+            if (joinFailed)
+            {
+                Serial.printf("Join failed on attempt %d\n", attempt);
+            }
+            else
+            {
+                Serial.printf(joinStarted ? "Join timeout on attempt %d\n" : "Join process never started on attempt %d\n",
+                              attempt);
+            }
+            if (attempt < WIO_E5_JOIN_ATTEMPTS)
+            {
+                Serial.println("Waiting before next join attempt...");
+                wait(10000);
+            }
+        }
+
+        Serial.println("All join attempts failed");
+        return false;
+    }
+
+    /**
+     * @brief Transmit one P2P frame and wait for "TX DONE"
+     * @param message ASCII frame (hex-encoded here)
+     * @return true if the module reported the transmission complete
+     */
+    bool sendP2PMessage(const String &message)
+    {
+        String hexMessage = ProtocolHelper::asciiToHex(message);
+        String command = "AT+TEST=TXLRPKT,\"" + hexMessage + "\"";
+
+        // The module echoes the command first, then reports TX DONE after the airtime
+        if (!sendATCommand(command, "TX DONE", (int)getTxTimeoutMs(message)))
+        {
+            Serial.println("P2P transmission failed");
+            return false;
+        }
+        Serial.printf("P2P TX: %s\n", message.c_str());
+        return true;
+    }
+
+    /**
+     * @brief Listen for the reply to our own frame, skipping other nodes' traffic
+     * After AT+TEST=RXLRPKT the module stays in receive mode and reports every
+     * frame it hears. On a shared channel a frame that isn't ours doesn't end
+     * the window: listening goes on for whatever is left of it.
+     * @param nodeId Our node ID
+     * @param peerId Node our frame was addressed to (P2P_NODE_ID_NONE if unaddressed)
+     * @param windowMs Listen window (ms)
+     * @return Decoded reply including its fields, empty if none arrived in the window
+     */
+    String receiveReply(uint8_t nodeId, uint8_t peerId, unsigned long windowMs)
+    {
+        if (!port)
+        {
+            return "";
+        }
+        clearSerialBuffer();
+        port->println("AT+TEST=RXLRPKT");
+        Serial.println("TX: AT+TEST=RXLRPKT");
+
+        String pending = "";
+        String frame;
+        unsigned long startTime = millis();
+        while (millis() - startTime < windowMs)
+        {
+            Policy::feedWatchdog();
+            bool gotData = false;
+            while (port->available())
+            {
+                pending += (char)port->read();
+                gotData = true;
+            }
+            while (takeReceivedFrame(pending, frame))
+            {
+                if (ProtocolHelper::isReplyFor(frame, nodeId, peerId))
+                {
+                    Serial.printf("P2P RX: %s\n", frame.c_str());
+                    return frame;
+                }
+                Serial.printf("Ignoring frame for another node: %s\n", frame.c_str());
+            }
+            delay(gotData ? 1 : 10);
+        }
+        Serial.println("No P2P reply received within timeout");
+        return "";
+    }
+
+    /**
+     * @brief Longest wait for "TX DONE" after sending a P2P frame
+     * @param message ASCII frame (the module sends it as raw bytes)
+     * @return Airtime at the configured spreading factor plus WIO_E5_TX_MARGIN_MS
+     */
+    static unsigned long getTxTimeoutMs(const String &message)
+    {
+        return ProtocolHelper::getAirtimeMs(message.length()) + WIO_E5_TX_MARGIN_MS;
+    }
+
+    /**
+     * @brief Put the module to sleep until the next UART byte
+     * @return true if the module confirmed
+     */
+    bool enterLowPowerMode()
+    {
+        Serial.println("Entering LoRa low power mode...");
+        return sendATCommand("AT+LOWPOWER", "LOWPOWER", 3000); // Reply: "+LOWPOWER: SLEEP"
+    }
+
+    /**
+     * @brief Wake the module from AT+LOWPOWER sleep
+     * @return true if the module answers again
+     */
+    bool wakeUp()
+    {
+        Serial.println("Waking up LoRa module...");
+        sendWakeBytes();
+        return sendATCommand("AT", "OK", 3000);
+    }
+
+    /**
+     * @brief Let the module sleep on its own between commands
+     * @param enable true to enable auto low-power mode
+     * @return true if the module confirmed (some firmware versions don't support it)
+     */
+    bool setAutoLowPowerMode(bool enable)
+    {
+        Serial.printf("Setting auto low power mode: %s\n", enable ? "ON" : "OFF");
+        String command = "AT+LOWPOWER=AUTOMODE,";
+        command += enable ? "ON" : "OFF";
+        return sendATCommand(command, "AUTOMODE", 3000); // Reply: "+LOWPOWER: AUTOMODE ON"
+    }
+};
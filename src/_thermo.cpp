@@ -35,7 +35,7 @@
 #include "secrets.h"
 #include "encoder.hpp"
 #include "rtc.hpp"
-#include "temp_sensor.hpp"
+#include "sensor_array.hpp"
 #include "stove.hpp"
 #include "display.hpp"
 #include "lora_transmitter.hpp"
@@ -43,6 +43,7 @@
 // Forward declarations for button handlers
 void handleButtonPress();
 void handleButtonRelease();
+void handleScreenTap();
 
 // LoRa transmitter instance and configuration
 LoRaTransmitter loraTransmitter;
@@ -74,6 +75,25 @@ static const unsigned long TEMP_POLL_ACTIVE_INTERVAL = 5 * 1000; // 5 seconds wh
 static unsigned long lastTempPoll = 0;
 static bool deepPowerSaveMode = false;
 
+// A tap on the screen shows the stove's runtime in STATUS_AREA for a few seconds
+static const unsigned long RUNTIME_DISPLAY_MS = 8000;
+static unsigned long runtimeShownAt = 0;
+
+// MPC mode: the outdoor forecast is downloaded at startup and then refreshed while idle
+static unsigned long lastForecastRefresh = 0;
+
+/**
+ * @brief Download a new outdoor forecast and hand it to the stove (blocks while WiFi is up)
+ */
+static void refreshForecast()
+{
+    if (rtc.downloadForecast(STOVE_FORECAST_PATH))
+    {
+        stove.loadForecast();
+    }
+    lastForecastRefresh = millis(); // Also after a failure, so a dead network isn't retried every pass
+}
+
 /**
  * per https://docs.m5stack.com/en/core/M5Dial#pinmap:
  * https://m5stack-doc.oss-cn-shenzhen.aliyuncs.com/684/S007_PinMap_01.jpg
@@ -120,11 +140,9 @@ int updateTime()
     return rtc.getDayOfWeek() * 24 + rtc.getHour(); // hour of the week
 }
 
-float updateTemperature()
+float updateTemperature(float temperature)
 {
-    float temperature = tempSensor.readTemperatureFahrenheit();
-
-    if (!tempSensor.isValidReading(temperature))
+    if (!sensorArray.isValidReading(temperature))
     {
         Serial.println("Invalid temperature reading");
         display.showText(STATUS_AREA, "Temperature Sensor Error");
@@ -228,9 +246,9 @@ void setup()
     yield(); // Feed watchdog
     rtc.setup();
 
-    // Initialize temperature sensor
+    // Initialize temperature sensors (every MCP9808 on the bus)
     yield(); // Feed watchdog
-    if (!tempSensor.setup())
+    if (!sensorArray.setup())
     {
         Serial.println("Failed to initialize temperature sensor!\n");
         display.showText(STATUS_AREA, "Temp Sensor Init Failed.");
@@ -238,8 +256,11 @@ void setup()
     }
     else
     {
-        Serial.printf("Temperature sensor initialized successfully at 0x%02X\n", tempSensor.getI2CAddress());
-        Serial.printf("Current resolution: %s\n\n", tempSensor.getResolutionString());
+        for (size_t i = 0; i < sensorArray.getSensorCount(); i++)
+        {
+            Serial.printf("Temperature sensor initialized successfully at 0x%02X\n", sensorArray.getI2CAddress(i));
+        }
+        Serial.printf("Current resolution: %s\n\n", sensorArray.getResolutionString());
     }
 
     // Initialize stove control (loads configuration from temps.csv)
@@ -249,6 +270,11 @@ void setup()
     delay(250);
     yield(); // Feed watchdog
     stove.setup();
+    if (stove.getControlMode() == STOVE_CONTROL_MPC)
+    {
+        display.showText(STATUS_AREA, "Getting forecast...");
+        refreshForecast();
+    }
 
     // Initialize LoRa transmitter (optional)
     yield(); // Feed watchdog
@@ -265,6 +291,12 @@ void setup()
         stove.setLoRaTransmitter(&loraTransmitter);
         stove.setLoRaControlEnabled(true);
 
+        if (LORA_TX_SYNC_SLOTS_ENABLED)
+        {
+            // Only transmit in announced slots so the receiver can sleep in between
+            loraTransmitter.setSlotInterval(P2P_SYNC_SLOT_INTERVAL_MS);
+        }
+
         // Get current mode for display
         LoRaCommunicationMode currentMode = loraTransmitter.getCurrentMode();
         String modeStr = (currentMode == LoRaCommunicationMode::P2P) ? "P2P" : "LoRaWAN";
@@ -321,9 +353,9 @@ void handleButtonPress()
     String result = stove.resetBaseTemperature();
     Serial.println("Base temp reset result: " + result);
 
-    // Update display immediately to show the reset
-    float curTemp = tempSensor.readTemperatureFahrenheit();
-    if (tempSensor.isValidReading(curTemp))
+    // Update display immediately to show the reset (last reading - no waiting on the sensor)
+    float curTemp = sensorArray.getLastTemperatureFahrenheit();
+    if (sensorArray.isValidReading(curTemp))
     {
         display.showText(TEMP, String(curTemp, 1) + "F");
         float targetTemp = stove.getCurrentDesiredTemperature();
@@ -340,6 +372,28 @@ void handleButtonRelease()
     Serial.println("Button released");
 }
 
+// Screen tap: today's stove runtime on the display, the full rollup on Serial
+void handleScreenTap()
+{
+    recentActivity = true;
+    lastActivityTime = millis();
+
+    const RuntimeStats &runtime = stove.getRuntimeStats();
+    RuntimeSummary today = runtime.getSummary(RUNTIME_DAY);
+    display.showText(STATUS_AREA, "Today " + String(today.onHours, 1) + "h " + String(today.cycles) + "x " +
+                                      String(today.dutyPercent, 0) + "%");
+    runtimeShownAt = millis();
+
+    static const char *const periodNames[] = {"This hour", "Last hour", "Today", "Yesterday", "This week", "Last week"};
+    for (int i = 0; i < 6; i++)
+    {
+        RuntimeSummary summary = runtime.getSummary((RuntimePeriod)(i / 2), i % 2);
+        Serial.printf("%-10s %5.1f h ON, %3u cycles, %5.1f min/cycle, %3.0f%% duty\n", periodNames[i],
+                      summary.onHours, summary.cycles, summary.averageCycleMinutes, summary.dutyPercent);
+    }
+    Serial.printf("Total      %.1f h ON, %lu cycles\n", runtime.getTotalOnHours(), (unsigned long)runtime.getTotalCycles());
+}
+
 // Button interrupt handler (replaces polling)
 void handleButtonInterrupts()
 {
@@ -353,6 +407,11 @@ void handleButtonInterrupts()
     {
         handleButtonRelease();
     }
+
+    if (M5.Touch.getDetail().wasClicked())
+    {
+        handleScreenTap();
+    }
 }
 
 void loop()
@@ -374,24 +433,47 @@ void loop()
     // Check if it's time for temperature polling
     bool timeForTempPoll = (currentTime - lastTempPoll >= tempPollInterval);
 
-    // Wake up sensor before temperature reading if needed
-    if (timeForTempPoll && !tempSensor.getAwakeStatus())
+    // Start a conversion when a poll is due; the result is picked up on a later pass,
+    // once every sensor has completed a full conversion (up to 260 ms after a wake)
+    static bool conversionPending = false;
+    if (timeForTempPoll && !conversionPending)
     {
-        tempSensor.wakeUp();
-        delay(10); // Allow sensor to stabilize
-        Serial.println("Temperature sensor woken for periodic poll");
+        sensorArray.startConversion();
+        conversionPending = true;
+        lastTempPoll = currentTime;
+    }
+
+    // Clock service: the RTC is read once a minute, and the clock display and
+    // setpoint follow that one notification rather than reading the time each pass
+    static int hourOfWeek = -1;
+    if (rtc.serviceMinute())
+    {
+        hourOfWeek = updateTime();
+        stove.onMinute(rtc.getClockMinuteOfWeek());
     }
 
-    // Read current values (time always, temperature only when needed)
-    static int hourOfWeek = updateTime();
+    if (isInactive && stove.getControlMode() == STOVE_CONTROL_MPC &&
+        currentTime - lastForecastRefresh >= STOVE_FORECAST_REFRESH_MS)
+    {
+        refreshForecast();
+    }
     static float curTemp = 999.0; // Initialize with invalid value
 
-    if (timeForTempPoll)
+    float reading;
+    bool temperatureUpdated = conversionPending && sensorArray.pollTemperatureFahrenheit(reading);
+    if (temperatureUpdated)
     {
-        curTemp = updateTemperature();
-        lastTempPoll = currentTime;
+        conversionPending = false;
+        curTemp = updateTemperature(reading);
         Serial.printf("Periodic temperature poll: %.1f°F (interval: %lus)\n",
                       curTemp, tempPollInterval / 1000);
+
+        // Sleep the sensors until the next poll, at the resolution the next reading needs
+        sensorArray.shutdown();
+        if (sensorArray.isValidReading(curTemp))
+        {
+            sensorArray.setResolutionForDistance(stove.getDecisionDistance(curTemp));
+        }
     }
 
     // Skip stove control if time is not yet available
@@ -443,15 +525,18 @@ void loop()
         display.showText(STATUS_AREA, "Base: " + String(newBase, 1) + "F");
     }
 
+    bool runtimeShown = runtimeShownAt != 0 && millis() - runtimeShownAt < RUNTIME_DISPLAY_MS;
+    HeaterFault heaterFault = stove.getHeaterMonitor().getFault(); // Shown over everything else
+
     // Update stove status (handles both manual and automatic modes)
     // Only update if we have a valid temperature reading
     static bool stoveOn = false;
-    if (tempSensor.isValidReading(curTemp))
+    if (sensorArray.isValidReading(curTemp))
     {
         stoveOn = updateStove(curTemp, hourOfWeek);
 
         // Update displays immediately when temperature is polled
-        if (timeForTempPoll)
+        if (temperatureUpdated)
         {
             // Show current temperature
             display.showText(TEMP, String(curTemp, 1) + "F");
@@ -473,7 +558,15 @@ void loop()
 
             // Show LoRa/networking status in STATUS_AREA
             String loraStatus = stove.getLastLoRaResponse();
-            if (loraStatus.length() > 0 && loraStatus != "No transmitter")
+            if (heaterFault != HEATER_OK)
+            {
+                display.showText(STATUS_AREA, String("ALARM: ") + HeaterMonitor::getFaultName(heaterFault));
+            }
+            else if (runtimeShown)
+            {
+                // Leave the runtime figures up
+            }
+            else if (loraStatus.length() > 0 && loraStatus != "No transmitter")
             {
                 String humanStatus = translateLoRaStatus(loraStatus);
                 display.showText(STATUS_AREA, humanStatus);
@@ -498,7 +591,7 @@ void loop()
     { // Update less frequently when inactive
         // Update temperature display
         float displayTemp = curTemp;
-        if (!isnan(displayTemp) && tempSensor.isValidReading(displayTemp))
+        if (!isnan(displayTemp) && sensorArray.isValidReading(displayTemp))
         {
             display.showText(TEMP, String(displayTemp, 1) + "F");
         }
@@ -509,7 +602,7 @@ void loop()
         {
             display.showText(STOVE, currentState);
         }
-        else if (!isnan(displayTemp) && tempSensor.isValidReading(displayTemp))
+        else if (!isnan(displayTemp) && sensorArray.isValidReading(displayTemp))
         {
             float targetTemp = stove.getCurrentDesiredTemperature();
             float tempDiff = targetTemp - displayTemp;
@@ -519,7 +612,15 @@ void loop()
 
         // Update LoRa/networking status in STATUS_AREA
         String loraStatus = stove.getLastLoRaResponse();
-        if (loraStatus.length() > 0 && loraStatus != "No transmitter")
+        if (heaterFault != HEATER_OK)
+        {
+            display.showText(STATUS_AREA, String("ALARM: ") + HeaterMonitor::getFaultName(heaterFault));
+        }
+        else if (runtimeShown)
+        {
+            // Leave the runtime figures up
+        }
+        else if (loraStatus.length() > 0 && loraStatus != "No transmitter")
         {
             String humanStatus = translateLoRaStatus(loraStatus);
             if (isInactive)
@@ -559,14 +660,6 @@ void loop()
             Serial.println(String(loopCounter) + ") Entering power save mode (CPU 40MHz, periodic temp polling)\n");
         }
 
-        // Put sensor to sleep after temperature reading (if we just polled)
-        if (timeForTempPoll && tempSensor.getAwakeStatus())
-        {
-            delay(100); // Allow any pending operations to complete
-            tempSensor.shutdown();
-            Serial.printf("Temperature sensor was shutdown at %s for 2 minutes...\n", rtc.getFormattedTime().c_str());
-        }
-
         // Enter deep power save mode after being in power save mode for at least 30 seconds
         if (!deepPowerSaveMode && (millis() - powerSaveModeStartTime > 30000))
         {
@@ -574,7 +667,10 @@ void loop()
             Serial.println("Entering deep power save mode - for 2 minutes");
         }
 
-        delay(1000); // Sleep longer between loops when inactive
+        if (!conversionPending)
+        {
+            delay(1000); // Sleep longer between loops when inactive
+        }
     }
     else
     {
@@ -586,13 +682,6 @@ void loop()
             powerSaveModeStartTime = 0;
             Serial.println("Exit power save mode (CPU 80MHz) to check temperature");
         }
-
-        // Ensure sensor is awake during active periods
-        if (!tempSensor.getAwakeStatus())
-        {
-            tempSensor.wakeUp();
-            Serial.println("Temperature sensor woken");
-        }
     }
 
     // Note: stove status display is handled inside updateStove()
@@ -600,7 +689,11 @@ void loop()
     // For now, just print stove status - actual GPIO control would need specific pin setup
 
     // Adaptive delay based on power mode
-    if (deepPowerSaveMode)
+    if (conversionPending)
+    {
+        delay(min(sensorArray.getMsUntilReady(), 50UL)); // Back as soon as the conversion is done
+    }
+    else if (deepPowerSaveMode)
     {
         delay(500); // Longer sleep in deep power save mode
     }
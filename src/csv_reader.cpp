@@ -0,0 +1,269 @@
+/**
+ * @file csv_reader.cpp
+ * @brief Streaming config file reader implementation
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include "csv_reader.hpp"
+
+CsvReader::CsvReader(CsvReadFunction readFunction, void *context, CsvErrorFunction errorFunction)
+    : readFunction(readFunction), errorFunction(errorFunction), context(context), chunkLength(0), chunkPosition(0), endOfInput(false),
+      readFailed(false), lineLength(0), lineNumber(0), lineTruncated(false), fields(0), errorCount(0)
+{
+    line[0] = '\0';
+    lastError.line = 0;
+    lastError.column = 0;
+    lastError.message = "";
+}
+
+bool CsvReader::readLine()
+{
+    lineLength = 0;
+    lineTruncated = false;
+    bool gotAny = false;
+
+    while (true)
+    {
+        if (chunkPosition >= chunkLength)
+        {
+            if (endOfInput)
+            {
+                break;
+            }
+            int count = readFunction(context, chunk, sizeof(chunk));
+            if (count <= 0)
+            {
+                endOfInput = true;
+                readFailed = count < 0;
+                break;
+            }
+            chunkLength = (size_t)count;
+            chunkPosition = 0;
+        }
+
+        char c = (char)chunk[chunkPosition++];
+        gotAny = true;
+        if (c == '\n')
+        {
+            break;
+        }
+        if (c == '\r' || c == '\0')
+        {
+            continue; // Windows line endings; NULs would cut the line short
+        }
+        if (lineLength < CSV_MAX_LINE)
+        {
+            line[lineLength++] = c;
+        }
+        else
+        {
+            lineTruncated = true;
+        }
+    }
+
+    line[lineLength] = '\0';
+    if (gotAny)
+    {
+        lineNumber++;
+    }
+    return gotAny;
+}
+
+void CsvReader::split()
+{
+    fields = 0;
+    size_t position = 0;
+
+    while (true)
+    {
+        // Last allowed field takes the rest of the line
+        const char *comma = (fields + 1 < CSV_MAX_FIELDS) ? (const char *)memchr(line + position, ',', lineLength - position) : nullptr;
+        size_t end = comma ? (size_t)(comma - line) : lineLength;
+
+        size_t start = position;
+        while (start < end && isspace((unsigned char)line[start]))
+        {
+            start++;
+        }
+        size_t stop = end;
+        while (stop > start && isspace((unsigned char)line[stop - 1]))
+        {
+            stop--;
+        }
+
+        fieldStart[fields] = (uint16_t)start;
+        fieldLength[fields] = (uint16_t)(stop - start);
+        fields++;
+
+        if (!comma)
+        {
+            break;
+        }
+        position = end + 1;
+    }
+}
+
+bool CsvReader::next()
+{
+    while (readLine())
+    {
+        if (lineTruncated)
+        {
+            fail(CSV_MAX_FIELDS, "line too long");
+            continue;
+        }
+
+        size_t first = 0;
+        while (first < lineLength && isspace((unsigned char)line[first]))
+        {
+            first++;
+        }
+        if (first == lineLength || line[first] == '#')
+        {
+            continue; // Blank or comment
+        }
+
+        split();
+        return true;
+    }
+
+    fields = 0;
+    return false;
+}
+
+size_t CsvReader::getFieldCount() const
+{
+    return fields;
+}
+
+const char *CsvReader::getField(size_t index, size_t &length) const
+{
+    if (index >= fields)
+    {
+        length = 0;
+        return nullptr;
+    }
+    length = fieldLength[index];
+    return line + fieldStart[index];
+}
+
+bool CsvReader::fieldEquals(size_t index, const char *keyword) const
+{
+    size_t length;
+    const char *text = getField(index, length);
+    if (!text || strlen(keyword) != length)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++)
+    {
+        if (tolower((unsigned char)text[i]) != tolower((unsigned char)keyword[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CsvReader::getInt(size_t index, long &value)
+{
+    size_t length;
+    const char *text = getField(index, length);
+    if (!text || length == 0)
+    {
+        fail(index, "missing number");
+        return false;
+    }
+
+    char *end;
+    value = strtol(text, &end, 10);
+    if (end != text + length)
+    {
+        fail(index, "expected a whole number");
+        return false;
+    }
+    return true;
+}
+
+bool CsvReader::getFloat(size_t index, float &value)
+{
+    size_t length;
+    const char *text = getField(index, length);
+    if (!text || length == 0)
+    {
+        fail(index, "missing number");
+        return false;
+    }
+
+    // Fields end at a comma or the line's NUL, both of which stop strtof
+    char *end;
+    value = strtof(text, &end);
+    if (end != text + length || value != value)
+    {
+        fail(index, "expected a number");
+        return false;
+    }
+    return true;
+}
+
+bool CsvReader::getRest(size_t index, char *buffer, size_t size)
+{
+    size_t length;
+    const char *text = getField(index, length);
+    if (!text || length == 0)
+    {
+        fail(index, "missing value");
+        return false;
+    }
+
+    size_t stop = lineLength;
+    while (stop > fieldStart[index] && isspace((unsigned char)line[stop - 1]))
+    {
+        stop--;
+    }
+    size_t restLength = stop - fieldStart[index];
+    if (restLength + 1 > size)
+    {
+        fail(index, "value too long");
+        return false;
+    }
+    memcpy(buffer, text, restLength);
+    buffer[restLength] = '\0';
+    return true;
+}
+
+void CsvReader::fail(size_t index, const char *message)
+{
+    lastError.line = lineNumber;
+    lastError.column = (index < fields && index < CSV_MAX_FIELDS) ? (uint16_t)(fieldStart[index] + 1) : 0;
+    lastError.message = message;
+    errorCount++;
+    if (errorFunction)
+    {
+        errorFunction(context, lastError);
+    }
+}
+
+uint32_t CsvReader::getLineNumber() const
+{
+    return lineNumber;
+}
+
+const CsvError &CsvReader::getLastError() const
+{
+    return lastError;
+}
+
+uint32_t CsvReader::getErrorCount() const
+{
+    return errorCount;
+}
+
+bool CsvReader::hasReadError() const
+{
+    return readFailed;
+}
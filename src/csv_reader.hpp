@@ -0,0 +1,179 @@
+/**
+ * @file csv_reader.hpp
+ * @brief Streaming, allocation-free reader for the comma-separated config files
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Plain C++ with no Arduino dependencies, so the same parser runs on the
+ * device and on a PC (tools, fuzzing).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Limits
+#define CSV_MAX_LINE 160       // Longest line, excluding the newline
+#define CSV_MAX_FIELDS 8       // Later commas stay inside the last field (free-text descriptions)
+#define CSV_READ_CHUNK 64      // Bytes pulled from the source at a time
+
+/**
+ * @brief Data source: copy up to size bytes into buffer
+ * @return Bytes copied, 0 at end of file, negative on a read error
+ */
+typedef int (*CsvReadFunction)(void *context, uint8_t *buffer, size_t size);
+
+struct CsvError;
+
+/**
+ * @brief Called for every error as it is recorded (e.g. to log it)
+ */
+typedef void (*CsvErrorFunction)(void *context, const CsvError &error);
+
+/**
+ * @struct CsvError
+ * @brief Where and why a config line was rejected
+ */
+struct CsvError
+{
+    uint32_t line;       // 1-based line number
+    uint16_t column;     // 1-based column of the offending field, 0 for the whole line
+    const char *message; // Static string
+};
+
+/**
+ * @class CsvReader
+ * @brief Pulls one record at a time from a data source through fixed buffers
+ *
+ * Blank lines and lines starting with '#' are skipped. Fields are split on
+ * commas and trimmed of surrounding spaces; they are views into the line
+ * buffer, valid until the next call to next(). Nothing is allocated; the
+ * reader's memory is two small fixed buffers.
+ *
+ * Typed getters record an error (line, column, message) on bad input, so a
+ * caller can reject a line and report exactly where it went wrong.
+ */
+class CsvReader
+{
+private:
+    CsvReadFunction readFunction;
+    CsvErrorFunction errorFunction;
+    void *context;
+
+    uint8_t chunk[CSV_READ_CHUNK];
+    size_t chunkLength;
+    size_t chunkPosition;
+    bool endOfInput;
+    bool readFailed;
+
+    char line[CSV_MAX_LINE + 1];
+    size_t lineLength;
+    uint32_t lineNumber;
+    bool lineTruncated;
+
+    uint16_t fieldStart[CSV_MAX_FIELDS];
+    uint16_t fieldLength[CSV_MAX_FIELDS];
+    size_t fields;
+
+    CsvError lastError;
+    uint32_t errorCount;
+
+    bool readLine();
+    void split();
+
+public:
+    /**
+     * @brief Constructor
+     * @param readFunction Data source
+     * @param context Passed to readFunction and errorFunction (e.g. a File pointer)
+     * @param errorFunction Optional error callback
+     */
+    CsvReader(CsvReadFunction readFunction, void *context, CsvErrorFunction errorFunction = nullptr);
+
+    /**
+     * @brief Advance to the next record
+     * Lines longer than CSV_MAX_LINE are reported as errors and skipped.
+     * @return false at end of input or on a read error
+     */
+    bool next();
+
+    /**
+     * @brief Number of fields in the current record
+     * @return Field count (1 for a line without commas)
+     */
+    size_t getFieldCount() const;
+
+    /**
+     * @brief Raw view of a field (not NUL-terminated)
+     * @param index Field index
+     * @param length Receives the length
+     * @return Start of the field, or nullptr if there is no such field
+     */
+    const char *getField(size_t index, size_t &length) const;
+
+    /**
+     * @brief Case-insensitive comparison of a field with a keyword
+     * @param index Field index
+     * @param keyword Keyword
+     * @return true if the field exists and matches
+     */
+    bool fieldEquals(size_t index, const char *keyword) const;
+
+    /**
+     * @brief Parse a field as a whole integer
+     * @param index Field index
+     * @param value Receives the value
+     * @return false (and records an error) if missing or not a number
+     */
+    bool getInt(size_t index, long &value);
+
+    /**
+     * @brief Parse a field as a decimal number
+     * @param index Field index
+     * @param value Receives the value
+     * @return false (and records an error) if missing or not a number
+     */
+    bool getFloat(size_t index, float &value);
+
+    /**
+     * @brief Copy the line from a field to its end, commas included
+     * For values that contain commas, such as POSIX timezone strings.
+     * @param index First field to copy
+     * @param buffer Destination
+     * @param size Destination size, including the terminating NUL
+     * @return false (and records an error) if missing or too long
+     */
+    bool getRest(size_t index, char *buffer, size_t size);
+
+    /**
+     * @brief Record an error against a field of the current line
+     * @param index Field index, or CSV_MAX_FIELDS for the whole line
+     * @param message Static description
+     */
+    void fail(size_t index, const char *message);
+
+    /**
+     * @brief Current 1-based line number
+     * @return Line number
+     */
+    uint32_t getLineNumber() const;
+
+    /**
+     * @brief Most recent error
+     * @return Error (line 0 if there was none)
+     */
+    const CsvError &getLastError() const;
+
+    /**
+     * @brief Number of errors recorded so far
+     * @return Error count
+     */
+    uint32_t getErrorCount() const;
+
+    /**
+     * @brief Whether the data source reported a read error
+     * @return true if reading stopped early
+     */
+    bool hasReadError() const;
+};
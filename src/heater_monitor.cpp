@@ -0,0 +1,264 @@
+/**
+ * @file heater_monitor.cpp
+ * @brief Heater-fault and stuck-relay detection implementation
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "heater_monitor.hpp"
+
+#define MINUTES_PER_HOUR 60.0f
+
+// Position sums for x = 0..n-1
+static float sumX(uint8_t n)
+{
+    return n * (n - 1) / 2.0f;
+}
+
+static float sumXX(uint8_t n)
+{
+    return (n - 1) * n * (2.0f * n - 1) / 6.0f;
+}
+
+SlidingRegression::SlidingRegression()
+{
+    clear();
+}
+
+void SlidingRegression::clear()
+{
+    reference = 0;
+    head = 0;
+    count = 0;
+    sumY = 0;
+    sumXY = 0;
+}
+
+void SlidingRegression::resync()
+{
+    sumY = 0;
+    sumXY = 0;
+    for (uint8_t x = 0; x < count; x++)
+    {
+        float y = values[(head + x) % HEATER_MONITOR_WINDOW];
+        sumY += y;
+        sumXY += x * y;
+    }
+}
+
+void SlidingRegression::add(float value)
+{
+    if (count == 0)
+    {
+        reference = value;
+    }
+    float y = value - reference;
+
+    if (count < HEATER_MONITOR_WINDOW)
+    {
+        values[count] = y;
+        sumY += y;
+        sumXY += count * y;
+        count++;
+        return;
+    }
+
+    // Every remaining sample moves one position left; the new one lands at n-1
+    float oldest = values[head];
+    values[head] = y;
+    head = (head + 1) % HEATER_MONITOR_WINDOW;
+    sumXY += -(sumY - oldest) + (HEATER_MONITOR_WINDOW - 1) * y;
+    sumY += y - oldest;
+
+    if (head == 0)
+    {
+        resync();
+    }
+}
+
+bool SlidingRegression::isFull() const
+{
+    return count == HEATER_MONITOR_WINDOW;
+}
+
+float SlidingRegression::getSlope() const
+{
+    if (count < 2)
+    {
+        return 0;
+    }
+    float sx = sumX(count);
+    return (count * sumXY - sx * sumY) / (count * sumXX(count) - sx * sx);
+}
+
+HeaterMonitor::HeaterMonitor()
+{
+    reset();
+}
+
+void HeaterMonitor::reset()
+{
+    trend.clear();
+    stoveOn = false;
+    started = false;
+    stateStartMs = 0;
+    lastSampleMs = 0;
+    rate = 0;
+    rateValid = false;
+    expectedRate = 0;
+    learnedPeriods = 0;
+    fault = HEATER_OK;
+    suspected = HEATER_OK;
+    suspectCount = 0;
+}
+
+void HeaterMonitor::endPeriod()
+{
+    // Learn the usual heating rate from ON periods that ended healthy
+    if (stoveOn && rateValid && fault == HEATER_OK && suspected == HEATER_OK && rate > 0)
+    {
+        expectedRate = learnedPeriods == 0 ? rate : expectedRate + HEATER_MONITOR_LEARN_ALPHA * (rate - expectedRate);
+        if (learnedPeriods < UINT16_MAX)
+        {
+            learnedPeriods++;
+        }
+    }
+
+    trend.clear();
+    rate = 0;
+    rateValid = false;
+    suspected = HEATER_OK;
+    suspectCount = 0;
+}
+
+HeaterFault HeaterMonitor::classify(HeaterFault current) const
+{
+    if (stoveOn)
+    {
+        bool historyTrusted = learnedPeriods >= HEATER_MONITOR_MIN_HISTORY && expectedRate > 0;
+        float minimum = historyTrusted ? expectedRate * HEATER_MONITOR_MIN_RATE_FRACTION : 0;
+        if (current == HEATER_NO_HEAT)
+        {
+            minimum = historyTrusted ? minimum / HEATER_MONITOR_CLEAR_RATIO : HEATER_MONITOR_NO_HEAT_CLEAR_F;
+        }
+        return rate < minimum ? HEATER_NO_HEAT : HEATER_OK;
+    }
+
+    // A sunny afternoon can warm the room too, so a known stove rate raises the bar
+    float limit = HEATER_MONITOR_STUCK_RATE_F;
+    if (learnedPeriods >= HEATER_MONITOR_MIN_HISTORY && expectedRate * 0.5f > limit)
+    {
+        limit = expectedRate * 0.5f;
+    }
+    if (current == HEATER_STUCK_ON)
+    {
+        limit *= HEATER_MONITOR_CLEAR_RATIO;
+    }
+    return rate > limit ? HEATER_STUCK_ON : HEATER_OK;
+}
+
+bool HeaterMonitor::observe(float temperature, bool on, unsigned long nowMs)
+{
+    HeaterFault previous = fault;
+
+    if (!started || on != stoveOn)
+    {
+        if (started)
+        {
+            endPeriod();
+        }
+        started = true;
+        stoveOn = on;
+        stateStartMs = nowMs;
+        lastSampleMs = nowMs;
+        // A NO_HEAT alarm ends with the ON period; STUCK_ON only when the trend clears
+        if (fault == HEATER_NO_HEAT)
+        {
+            fault = HEATER_OK;
+        }
+        return fault != previous;
+    }
+
+    if (nowMs - lastSampleMs < HEATER_MONITOR_SAMPLE_MS)
+    {
+        return false;
+    }
+    if (nowMs - lastSampleMs > 3 * HEATER_MONITOR_SAMPLE_MS)
+    {
+        trend.clear(); // Missed samples (stall): the spacing would be wrong
+    }
+    lastSampleMs = nowMs;
+
+    unsigned long settleMs = (stoveOn ? HEATER_MONITOR_ON_SETTLE_MIN : HEATER_MONITOR_OFF_SETTLE_MIN) * 60000UL;
+    if (nowMs - stateStartMs < settleMs)
+    {
+        return false;
+    }
+
+    trend.add(temperature);
+    if (!trend.isFull())
+    {
+        return false;
+    }
+    rate = trend.getSlope() * MINUTES_PER_HOUR;
+    rateValid = true;
+
+    HeaterFault verdict = classify(fault);
+    if (verdict == HEATER_OK)
+    {
+        suspected = HEATER_OK;
+        suspectCount = 0;
+        fault = HEATER_OK;
+    }
+    else if (verdict == suspected)
+    {
+        if (suspectCount < HEATER_MONITOR_CONFIRM)
+        {
+            suspectCount++;
+        }
+        if (suspectCount >= HEATER_MONITOR_CONFIRM)
+        {
+            fault = verdict;
+        }
+    }
+    else
+    {
+        suspected = verdict;
+        suspectCount = 1;
+    }
+
+    return fault != previous;
+}
+
+HeaterFault HeaterMonitor::getFault() const
+{
+    return fault;
+}
+
+float HeaterMonitor::getRate() const
+{
+    return rateValid ? rate : 0;
+}
+
+float HeaterMonitor::getExpectedRate() const
+{
+    return expectedRate;
+}
+
+uint16_t HeaterMonitor::getLearnedPeriods() const
+{
+    return learnedPeriods;
+}
+
+const char *HeaterMonitor::getFaultName(HeaterFault fault)
+{
+    switch (fault)
+    {
+    case HEATER_NO_HEAT:
+        return "NO HEAT";
+    case HEATER_STUCK_ON:
+        return "STUCK ON";
+    default:
+        return "OK";
+    }
+}
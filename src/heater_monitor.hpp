@@ -0,0 +1,176 @@
+/**
+ * @file heater_monitor.hpp
+ * @brief Heater-fault and stuck-relay detection from the room's temperature trend
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Plain C++ with no Arduino dependencies (builds on a PC).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Detector configuration
+#define HEATER_MONITOR_SAMPLE_MS 60000UL      // One trend sample per minute
+#define HEATER_MONITOR_WINDOW 20              // Samples in the regression window (20 minutes)
+#define HEATER_MONITOR_ON_SETTLE_MIN 10       // Stove warm-up ignored after an ON command
+#define HEATER_MONITOR_OFF_SETTLE_MIN 60      // Stove body still releasing heat after OFF
+#define HEATER_MONITOR_MIN_RATE_FRACTION 0.25f // NO_HEAT below this fraction of the usual heating rate
+#define HEATER_MONITOR_STUCK_RATE_F 1.0f      // STUCK_ON when rising faster than this while OFF (°F/h)
+#define HEATER_MONITOR_CONFIRM 10             // Consecutive bad windows (minutes) before an alarm
+#define HEATER_MONITOR_CLEAR_RATIO 0.5f       // A confirmed alarm clears only this far past its threshold
+#define HEATER_MONITOR_NO_HEAT_CLEAR_F 0.5f   // Without a learned rate, NO_HEAT clears only above this (°F/h)
+#define HEATER_MONITOR_LEARN_ALPHA 0.2f       // EWMA weight of each healthy ON period's rate
+#define HEATER_MONITOR_MIN_HISTORY 3          // ON periods learned before the usual rate is trusted
+
+/**
+ * @enum HeaterFault
+ * @brief What the temperature trend says about the stove
+ */
+enum HeaterFault
+{
+    HEATER_OK,       // Trend matches the commanded state
+    HEATER_NO_HEAT,  // ON and acknowledged, but the room isn't warming (stove didn't light, out of fuel)
+    HEATER_STUCK_ON  // OFF, but the room keeps warming (relay welded or stuck)
+};
+
+/**
+ * @class SlidingRegression
+ * @brief Least-squares slope of the last HEATER_MONITOR_WINDOW evenly spaced samples
+ *
+ * Adding a sample is O(1): sample positions are fixed (0..n-1), so sliding the
+ * window only shifts the running sums. The sums are rebuilt from the ring once
+ * per lap to keep rounding from accumulating.
+ */
+class SlidingRegression
+{
+private:
+    float values[HEATER_MONITOR_WINDOW]; // Relative to reference
+    float reference;                     // First sample, keeps the sums small
+    uint8_t head;                        // Oldest sample once the window is full
+    uint8_t count;
+    float sumY;
+    float sumXY;
+
+    void resync();
+
+public:
+    /**
+     * @brief Constructor
+     */
+    SlidingRegression();
+
+    /**
+     * @brief Drop all samples
+     */
+    void clear();
+
+    /**
+     * @brief Add the next sample, dropping the oldest once the window is full
+     * @param value Sample value
+     */
+    void add(float value);
+
+    /**
+     * @brief Check whether the window is full
+     * @return true once HEATER_MONITOR_WINDOW samples are in
+     */
+    bool isFull() const;
+
+    /**
+     * @brief Least-squares slope
+     * @return Change per sample, 0 with fewer than two samples
+     */
+    float getSlope() const;
+};
+
+/**
+ * @class HeaterMonitor
+ * @brief Compares the room's warming rate with the stove's commanded state
+ *
+ * Once a minute the room temperature goes into a sliding regression, restarted
+ * whenever the stove changes state and fed only after the settle time. With
+ * the stove ON, the slope is compared with the rate seen in earlier healthy
+ * ON periods (an EWMA, one value per period). Until HEATER_MONITOR_MIN_HISTORY
+ * periods have been seen, only a falling temperature counts as NO_HEAT, and
+ * it clears above HEATER_MONITOR_NO_HEAT_CLEAR_F. With the stove OFF and
+ * settled, a room that keeps warming means the relay is stuck. Either
+ * condition must hold for HEATER_MONITOR_CONFIRM windows in a row before it
+ * is reported. It clears once a window is clearly normal again
+ * (HEATER_MONITOR_CLEAR_RATIO), so a rate hovering at the threshold doesn't
+ * flap the alarm; a NO_HEAT alarm also ends with its ON period.
+ * ON periods shorter than the settle time plus one window are not judged.
+ */
+class HeaterMonitor
+{
+private:
+    SlidingRegression trend;
+    bool stoveOn;
+    bool started;
+    unsigned long stateStartMs;
+    unsigned long lastSampleMs;
+
+    float rate;           // Latest window slope (°F/h), valid once the window is full
+    bool rateValid;
+    float expectedRate;   // Usual ON heating rate (°F/h)
+    uint16_t learnedPeriods;
+
+    HeaterFault fault;
+    HeaterFault suspected;
+    uint8_t suspectCount;
+
+    void endPeriod();
+    HeaterFault classify(HeaterFault current) const;
+
+public:
+    /**
+     * @brief Constructor
+     */
+    HeaterMonitor();
+
+    /**
+     * @brief Forget the learned rate and any alarm
+     */
+    void reset();
+
+    /**
+     * @brief Feed one observation (call on every control update)
+     * @param temperature Room temperature (°F)
+     * @param on Whether the stove is acknowledged ON
+     * @param nowMs Monotonic time (ms)
+     * @return true if the reported fault changed
+     */
+    bool observe(float temperature, bool on, unsigned long nowMs);
+
+    /**
+     * @brief Current alarm
+     * @return HEATER_OK unless a fault is confirmed
+     */
+    HeaterFault getFault() const;
+
+    /**
+     * @brief Room warming rate over the last full window
+     * @return °F per hour, 0 until a window has filled in the current state
+     */
+    float getRate() const;
+
+    /**
+     * @brief Usual warming rate with the stove ON, learned from healthy periods
+     * @return °F per hour, 0 until an ON period has been learned
+     */
+    float getExpectedRate() const;
+
+    /**
+     * @brief Number of ON periods the usual rate was learned from
+     * @return Period count
+     */
+    uint16_t getLearnedPeriods() const;
+
+    /**
+     * @brief Short printable name of a fault
+     * @param fault Fault
+     * @return "OK", "NO HEAT" or "STUCK ON"
+     */
+    static const char *getFaultName(HeaterFault fault);
+};
@@ -17,7 +17,15 @@ LoRaTransmitter::LoRaTransmitter() :
     successfulTransmissions(0),
     failedTransmissions(0),
     totalRetries(0),
-    lastError("")
+    lastError(""),
+    slotIntervalMs(0),
+    nextSlotTime(0),
+    announcedSlotTime(0),
+    slotOpen(false),
+    nodeId(LORA_TX_NODE_ID),
+    destinationId(P2P_NODE_ID_NONE),
+    lastResponseFrame(""),
+    frameSequence(0)
 {
     // Constructor
 }
@@ -39,108 +47,13 @@ bool LoRaTransmitter::setup(int rxPin, int txPin, const LoRaWANConfig &loraConfi
     
     // Initialize UART for Grove-Wio-E5
     loraSerial = new HardwareSerial(1); // Use UART1
+    modem.attach(loraSerial, rxPin, txPin);
     
     Serial.println("Initializing LoRa module - patient connection mode enabled");
     Serial.printf("Initialization timeout: %d seconds\n", LORA_TX_INIT_TIMEOUT_MS / 1000);
-    delay(2000); // Allow module to boot
-    
-    bool communicationEstablished = false;
     unsigned long initStartTime = millis();
     
-#if LORA_TX_DISABLE_BAUD_SEARCH
-    // Use fixed baud rate - no search
-    Serial.printf("Using fixed baud rate: %d (baud search disabled)\n", LORA_TX_FIXED_BAUD_RATE);
-    loraSerial->begin(LORA_TX_FIXED_BAUD_RATE, SERIAL_8N1, rxPin, txPin);
-    
-    // Give module MUCH more time to fully boot - some modules need 5+ seconds
-    // Break up delay with watchdog resets to prevent timeout
-    Serial.println("Waiting for module to fully boot (5 seconds)...");
-    for (int i = 0; i < 10; i++) {
-        delay(500);
-        esp_task_wdt_reset();
-    }
-    
-    // Send multiple wake-up commands to ensure module is responsive
-    Serial.println("Sending wake-up sequence...");
-    for (int i = 0; i < 5; i++) {
-        clearSerialBuffer();
-        loraSerial->println();
-        delay(200);
-    }
-    clearSerialBuffer();
-    delay(500);
-    
-    // Try to connect with extended timeout - no rush
-    int attempt = 0;
-    while (!communicationEstablished && (millis() - initStartTime < LORA_TX_INIT_TIMEOUT_MS)) {
-        attempt++;
-        Serial.printf("Connection attempt %d (elapsed: %lu ms)...\n", 
-                     attempt, millis() - initStartTime);
-        esp_task_wdt_reset(); // Reset watchdog during attempts
-        
-        // Send wake-up bytes in case module is in low-power auto mode
-        // Based on andresoliva/LoRa-E5 library wake-up sequence
-        clearSerialBuffer();
-        loraSerial->write(0xFF);
-        loraSerial->write(0xFF);
-        loraSerial->write(0xFF);
-        loraSerial->write(0xFF);
-        delay(100);
-        clearSerialBuffer();
-        
-        if (sendATCommand("AT", "OK", 2000)) {
-            Serial.printf("SUCCESS! Module responding at %d baud\n", LORA_TX_FIXED_BAUD_RATE);
-            communicationEstablished = true;
-            break;
-        }
-        delay(2000); // Patient delay between attempts
-    }
-#else
-    // Try multiple baud rates - Grove-Wio-E5 can be 9600, 19200, or 115200
-    const int baudRates[] = {19200, 9600, 115200};
-    
-    for (int baud : baudRates) {
-        if (millis() - initStartTime >= LORA_TX_INIT_TIMEOUT_MS) {
-            Serial.println("Initialization timeout reached");
-            break;
-        }
-        
-        Serial.printf("\nTrying baud rate: %d\n", baud);
-        esp_task_wdt_reset(); // Reset watchdog before trying new baud rate
-        
-        if (baud != 19200) {
-            loraSerial->end(); // End previous attempt (skip for first attempt)
-            delay(500);
-        }
-        loraSerial->begin(baud, SERIAL_8N1, rxPin, txPin);
-        
-        delay(1000); // Wait for module to stabilize
-        
-        // Test communication with multiple patient attempts
-        clearSerialBuffer();
-        for (int attempt = 1; attempt <= 5; attempt++) {
-            if (millis() - initStartTime >= LORA_TX_INIT_TIMEOUT_MS) {
-                Serial.println("Initialization timeout reached");
-                break;
-            }
-            
-            Serial.printf("  Attempt %d at %d baud (elapsed: %lu ms)...\n", 
-                         attempt, baud, millis() - initStartTime);
-            esp_task_wdt_reset(); // Reset watchdog during attempts
-            
-            if (sendATCommand("AT", "OK", 2000)) {
-                Serial.printf("SUCCESS! Module responding at %d baud\n", baud);
-                communicationEstablished = true;
-                break;
-            }
-            delay(2000); // Patient delay between attempts
-        }
-        
-        if (communicationEstablished) break;
-    }
-#endif
-    
-    if (!communicationEstablished) {
+    if (!modem.connect()) {
         lastError = "Failed to communicate with Grove-Wio-E5 module after " + 
                    String((millis() - initStartTime) / 1000) + " seconds";
         Serial.println(lastError);
@@ -152,16 +65,7 @@ bool LoRaTransmitter::setup(int rxPin, int txPin, const LoRaWANConfig &loraConfi
     }
     
     Serial.println("Grove-Wio-E5 communication established");
-    
-    // Disable echo to prevent command echoing
-    Serial.println("Disabling echo mode...");
-    clearSerialBuffer();
-    delay(100);
-    if (sendATCommand("ATE0", "OK", 2000)) {
-        Serial.println("Echo disabled successfully");
-    } else {
-        Serial.println("Warning: Could not disable echo (continuing anyway)");
-    }
+    modem.disableEcho();
     
     // Reset module to ensure clean state
     if (!reset()) {
@@ -173,7 +77,6 @@ bool LoRaTransmitter::setup(int rxPin, int txPin, const LoRaWANConfig &loraConfi
     // Try P2P mode first (default)
     currentMode = LoRaCommunicationMode::P2P;
     if (configureP2P()) {
-        Serial.println("P2P mode configured successfully");
         isInitialized = true;
         clearStatistics();
         return true;
@@ -207,36 +110,7 @@ bool LoRaTransmitter::setup(int rxPin, int txPin, const LoRaWANConfig &loraConfi
 
 bool LoRaTransmitter::configureP2P()
 {
-    Serial.println("Configuring P2P mode...");
-    
-    // Enter TEST mode for P2P communication
-    // Success response is "+MODE: TEST", not "OK"
-    if (!sendATCommand("AT+MODE=TEST", "TEST")) {
-        Serial.println("Failed to enter TEST mode");
-        return false;
-    }
-    
-    // Configure RF parameters for P2P
-    String rfConfigCommand = "AT+TEST=RFCFG," + 
-                           String(P2P_FREQUENCY) + "," +
-                           String(P2P_SPREADING_FACTOR) + "," +
-                           String(P2P_BANDWIDTH) + "," +
-                           String(P2P_CODING_RATE) + "," +
-                           String(P2P_PREAMBLE_LENGTH) + "," +
-                           String(P2P_POWER);
-    
-    // Success response is "+TEST: RFCFG ...", not "OK"
-    if (!sendATCommand(rfConfigCommand, "RFCFG")) {
-        Serial.println("Failed to configure P2P RF parameters");
-        return false;
-    }
-    
-    Serial.println("P2P mode configured successfully");
-    Serial.printf("Frequency: %lu Hz, SF: %d, BW: %d, CR: %d, Power: %d dBm\n",
-                  P2P_FREQUENCY, P2P_SPREADING_FACTOR, P2P_BANDWIDTH, 
-                  P2P_CODING_RATE, P2P_POWER);
-    
-    return true;
+    return modem.configureP2P();
 }
 
 bool LoRaTransmitter::configureLoRaWAN()
@@ -314,112 +188,17 @@ bool LoRaTransmitter::joinNetwork()
         return true;
     }
     
-    Serial.println("Attempting to join LoRaWAN network...");
-    
-    // Enhanced join process with multiple attempts (inspired by Grove-Wio-E5 examples)
-    int maxAttempts = 3;
-    for (int attempt = 1; attempt <= maxAttempts; attempt++) {
-        Serial.printf("Join attempt %d/%d\n", attempt, maxAttempts);
-        
-        // Clear buffer before join attempt
-        clearSerialBuffer();
-        
-        // Attempt to join network with timing measurement
-        unsigned long joinTime = 0;
-        if (!sendATCommandWithTiming("AT+JOIN", "OK", 3000, joinTime)) {
-            Serial.printf("Join command failed on attempt %d (took %lu ms)\n", attempt, joinTime);
-            if (attempt < maxAttempts) {
-                delay(5000); // Wait before retry
-                continue;
-            }
-            return false;
-        }
-        
-        // Wait for join confirmation (this can take up to 30 seconds)
-        unsigned long startTime = millis();
-        bool joinStarted = false;
-        
-        while (millis() - startTime < LORAWAN_JOIN_TIMEOUT) {
-            String response = readResponse(1000);
-            
-            if (response.indexOf("+JOIN: Start") >= 0) {
-                joinStarted = true;
-                Serial.println("Join process started...");
-            } else if (response.indexOf("+JOIN: Network joined") >= 0) {
-                Serial.println("Successfully joined LoRaWAN network");
-                
-                // Optional: Enable auto low power mode after successful join
-                setAutoLowPowerMode(true);
-                
-                return true;
-            } else if (response.indexOf("+JOIN: Join failed") >= 0) {
-                Serial.printf("Join failed on attempt %d\n", attempt);
-                break; // Exit inner loop to try again
-            }
-            delay(1000);
-        }
-        
-        if (!joinStarted) {
-            Serial.printf("Join process never started on attempt %d\n", attempt);
-        } else {
-            Serial.printf("Join timeout on attempt %d\n", attempt);
-        }
-        
-        if (attempt < maxAttempts) {
-            Serial.println("Waiting before next join attempt...");
-            delay(10000); // Wait longer between attempts
-        }
-    }
-    
-    Serial.println("All join attempts failed");
-    return false;
+    return modem.joinNetwork();
 }
 
 bool LoRaTransmitter::sendP2PMessage(const String &message)
 {
-    // Convert message to hex format
-    String hexMessage = ProtocolHelper::asciiToHex(message);
-    
-    // Send P2P message using AT+TEST=TXLRPKT
-    // Module first echoes command, then sends TX DONE after transmission
-    String command = "AT+TEST=TXLRPKT,\"" + hexMessage + "\"";
-    
-    // Use extended timeout to wait for actual TX DONE response (not just echo)
-    if (!sendATCommand(command, "TX DONE", 5000)) {
-        Serial.println("P2P transmission failed");
-        return false;
-    }
-    
-    Serial.printf("P2P message sent: %s (hex: %s)\n", message.c_str(), hexMessage.c_str());
-    return true;
+    return modem.sendP2PMessage(message);
 }
 
-String LoRaTransmitter::receiveP2PMessage(int timeout)
+String LoRaTransmitter::receiveP2PMessage(uint8_t peerId, int timeout)
 {
-    // Enter receive mode and get the full response
-    clearSerialBuffer();
-    loraSerial->println("AT+TEST=RXLRPKT");
-    Serial.println("TX: AT+TEST=RXLRPKT");
-    
-    String response = readResponse(timeout);
-    Serial.printf("RX: %s\n", response.c_str());
-    
-    // Look for received data in format: +TEST: RX "hexdata"
-    int rxIndex = response.indexOf("+TEST: RX ");
-    if (rxIndex >= 0) {
-        int startQuote = response.indexOf('"', rxIndex);
-        int endQuote = response.indexOf('"', startQuote + 1);
-        
-        if (startQuote >= 0 && endQuote >= 0) {
-            String hexData = response.substring(startQuote + 1, endQuote);
-            String decodedMessage = ProtocolHelper::hexToAscii(hexData);
-            Serial.printf("P2P RX: %s\n", decodedMessage.c_str());
-            return decodedMessage;
-        }
-    }
-    
-    Serial.println("No P2P message received within timeout");
-    return "";
+    return modem.receiveReply(nodeId, peerId, timeout);
 }
 
 bool LoRaTransmitter::enterP2PReceiveMode()
@@ -429,6 +208,8 @@ bool LoRaTransmitter::enterP2PReceiveMode()
 
 String LoRaTransmitter::sendCommand(const String &command, uint8_t port, bool confirmed, int maxRetries)
 {
+    lastResponseFrame = "";
+    
     if (!isInitialized) {
         lastError = "Transmitter not initialized";
         Serial.println(lastError);
@@ -455,11 +236,19 @@ String LoRaTransmitter::sendCommand(const String &command, uint8_t port, bool co
             
             lastTransmissionTime = millis();
             
-            if (sendP2PMessage(command)) {
+            // Address the frame, and tell the receiver when to wake up for the next slot
+            long nextSlot = slotOpen ? (long)getSecondsToAnnouncedSlot() : -1;
+            String frame = ProtocolHelper::buildCommandFrame(command, nodeId, destinationId, frameSequence++, nextSlot);
+            
+            if (sendP2PMessage(frame)) {
                 if (confirmed) {
-                    // Wait for response in P2P mode
-                    String response = receiveP2PMessage(P2P_RX_TIMEOUT);
+                    // Wait for our reply; other zones' frames on the shared channel don't end the window
+                    String response = receiveP2PMessage(destinationId, P2P_RX_TIMEOUT);
+                    String fullResponse = response;
+                    response = ProtocolHelper::getCommand(response);
+                    
                     if (response.length() > 0 && ProtocolHelper::isValidResponse(response)) {
+                        lastResponseFrame = fullResponse;
                         lastAckTime = millis();
                         successfulTransmissions++;
                         return response;
@@ -599,82 +388,14 @@ bool LoRaTransmitter::isReady()
 
 bool LoRaTransmitter::reset()
 {
-    Serial.println("Resetting Grove-Wio-E5 module...");
-    
-    if (!sendATCommand("AT+RESET", "", 2000)) {
-        return false;
-    }
-    
-    delay(3000); // Wait for reset to complete
-    
-    // Clear any boot messages
-    clearSerialBuffer();
-    
-    // Test communication after reset
-    return sendATCommand("AT", "OK", 3000);
+    return modem.reset();
 }
 
 // Private helper methods
 
 bool LoRaTransmitter::sendATCommand(const String &command, const String &expectedResponse, int timeout)
 {
-    if (!loraSerial) {
-        return false;
-    }
-    
-    // Enhanced buffer clearing (inspired by Grove-Wio-E5 examples)
-    clearSerialBuffer();
-    delay(50); // Allow any pending data to arrive
-    clearSerialBuffer(); // Clear again for better reliability
-    
-    // Send command
-    loraSerial->println(command);
-    Serial.printf("TX: %s\n", command.c_str());
-    
-    if (expectedResponse.length() == 0) {
-        return true; // No response expected
-    }
-    
-    // Wait for response
-    String response = readResponse(timeout);
-    Serial.printf("RX: %s\n", response.c_str());
-    
-    // Handle echo: module may echo the command before responding
-    // Check if the expected response exists anywhere in the full response
-    // This handles cases where format is "AT\r\nOK\r\n" or "AT\r\n+AT: OK\r\n"
-    bool success = (response.indexOf(expectedResponse) >= 0) || 
-                   (expectedResponse == "OK" && (response.indexOf("+OK") >= 0 || 
-                                                  response.indexOf("\nOK") >= 0 ||
-                                                  response.indexOf("\r\nOK") >= 0 ||
-                                                  response.indexOf("+AT: OK") >= 0 ||
-                                                  (response.indexOf("OK") >= 0 && response.length() > command.length())));
-    
-    if (!success && expectedResponse != "") {
-        Serial.printf("Command failed - expected '%s' but got '%s'\n", 
-                     expectedResponse.c_str(), response.c_str());
-        // Print hex dump for debugging if we got data
-        if (response.length() > 0) {
-            Serial.print("  Received data: ");
-            for (unsigned int i = 0; i < response.length() && i < 50; i++) {
-                Serial.printf("0x%02X ", (unsigned char)response.charAt(i));
-            }
-            Serial.println();
-            // Check if this looks like echo
-            String responseUpper = response;
-            responseUpper.toUpperCase();
-            String commandUpper = command;
-            commandUpper.toUpperCase();
-            if (responseUpper.startsWith(commandUpper) && response.indexOf("OK") < 0) {
-                Serial.println("  (Echo received but no OK - module may need reset or longer timeout)");
-            } else if (response.length() > 0 && response.indexOf(command) < 0 && response.indexOf(expectedResponse) < 0) {
-                Serial.println("  (Unexpected response - may indicate wrong baud rate)");
-            }
-        } else {
-            Serial.println("  No response received - check connections and power");
-        }
-    }
-    
-    return success;
+    return modem.sendATCommand(command, expectedResponse, timeout);
 }
 
 bool LoRaTransmitter::sendATCommandWithTiming(const String &command, const String &expectedResponse, int timeout, unsigned long &commandTime)
@@ -687,68 +408,12 @@ bool LoRaTransmitter::sendATCommandWithTiming(const String &command, const Strin
 
 String LoRaTransmitter::readResponse(int timeout)
 {
-    if (!loraSerial) {
-        return "";
-    }
-    
-    String response = "";
-    unsigned long startTime = millis();
-    unsigned long lastDataTime = millis();
-    
-    while (millis() - startTime < timeout) {
-        esp_task_wdt_reset(); // Reset watchdog during long waits
-        
-        if (loraSerial->available()) {
-            char c = loraSerial->read();
-            response += c;
-            lastDataTime = millis(); // Reset data timeout
-        } else if (response.length() > 0) {
-            // For short responses during init (like echoed AT), wait longer for the actual response
-            // Only break if we've waited at least 500ms after last data
-            unsigned long silenceTime = millis() - lastDataTime;
-            if (silenceTime > 500) {
-                // For TX commands, must wait for TX DONE after the echo
-                if (response.indexOf("TXLRPKT") >= 0 && response.indexOf("TX DONE") < 0 && silenceTime < 3000) {
-                    // Keep waiting for TX DONE after transmission completes
-                    delay(10);
-                    continue;
-                }
-                // For RX commands, must wait for RX DONE or received data after the echo
-                // RX window can be long at SF12, wait up to 11 seconds
-                if (response.indexOf("RXLRPKT") >= 0 && response.indexOf("RX DONE") < 0 && response.indexOf("RXLRPKT,") < 0 && silenceTime < 11000) {
-                    // Keep waiting for RX DONE or received message data
-                    delay(10);
-                    continue;
-                }
-                // If response looks incomplete (just echo with no OK/DONE), wait longer
-                if (response.length() <= 10 && response.indexOf("OK") < 0 && response.indexOf("DONE") < 0 && silenceTime < 2000) {
-                    // Keep waiting for completion messages
-                    delay(10);
-                    continue;
-                }
-                // Got enough silence, response is complete
-                break;
-            }
-        }
-        delay(10);
-    }
-    
-    response.trim();
-    return response;
+    return modem.readResponse(timeout);
 }
 
 void LoRaTransmitter::clearSerialBuffer()
 {
-    if (!loraSerial) {
-        return;
-    }
-    
-    // Enhanced buffer clearing with timeout (inspired by Grove-Wio-E5 examples)
-    unsigned long startTime = millis();
-    while (loraSerial->available() && (millis() - startTime < 1000)) {
-        loraSerial->read();
-        delay(1); // Small delay to ensure all data is read
-    }
+    modem.clearSerialBuffer();
 }
 
 String LoRaTransmitter::createHexMessage(const String &command, uint8_t port)
@@ -828,27 +493,17 @@ bool LoRaTransmitter::waitForTransmissionComplete(unsigned long &txTime, unsigne
 
 bool LoRaTransmitter::enterLowPowerMode()
 {
-    Serial.println("Entering LoRa transmitter low power mode...");
-    return sendATCommand("AT+LOWPOWER", "OK", 3000);
+    return modem.enterLowPowerMode();
 }
 
 bool LoRaTransmitter::wakeUp()
 {
-    Serial.println("Waking up LoRa transmitter...");
-    // Send any character to wake up
-    if (loraSerial) {
-        loraSerial->println("AT");
-        delay(100);
-    }
-    return sendATCommand("AT", "OK", 3000);
+    return modem.wakeUp();
 }
 
 bool LoRaTransmitter::setAutoLowPowerMode(bool enable)
 {
-    String command = "AT+LOWPOWER=AUTOMODE,";
-    command += enable ? "ON" : "OFF";
-    Serial.printf("Setting transmitter auto low power mode: %s\n", enable ? "ON" : "OFF");
-    return sendATCommand(command, "OK", 3000);
+    return modem.setAutoLowPowerMode(enable);
 }
 
 String LoRaTransmitter::getStatistics()
@@ -1035,4 +690,83 @@ String LoRaTransmitter::sendCommandWithFallback(const String &command, int maxRe
     lastError = "Both P2P and LoRaWAN modes failed";
     Serial.println(lastError);
     return "";
-}
\ No newline at end of file
+}
+
+void LoRaTransmitter::setSlotInterval(unsigned long intervalMs)
+{
+    slotIntervalMs = intervalMs;
+    nextSlotTime = millis();
+    slotOpen = false;
+    
+    if (intervalMs > 0) {
+        Serial.printf("Slot-synchronized transmission: one slot every %lu s\n", intervalMs / 1000);
+    } else {
+        Serial.println("Slot-synchronized transmission disabled");
+    }
+}
+
+bool LoRaTransmitter::isSlotSyncEnabled() const
+{
+    return slotIntervalMs > 0;
+}
+
+bool LoRaTransmitter::beginSlot()
+{
+    if (slotIntervalMs == 0) {
+        return true;
+    }
+    
+    unsigned long now = millis();
+    if ((long)(now - nextSlotTime) < 0) {
+        return false;
+    }
+    
+    // Keep the cadence; skip slots we overran (long retries, display work)
+    announcedSlotTime = nextSlotTime + slotIntervalMs;
+    while ((long)(announcedSlotTime - now) < (long)(slotIntervalMs / 2)) {
+        announcedSlotTime += slotIntervalMs;
+    }
+    slotOpen = true;
+    return true;
+}
+
+unsigned long LoRaTransmitter::getSecondsToAnnouncedSlot()
+{
+    // Retries can run a slot past the slot it announced; move on to the next one
+    unsigned long now = millis();
+    while ((long)(announcedSlotTime - now) < (long)P2P_TX_AIRTIME_MS) {
+        announcedSlotTime += slotIntervalMs;
+    }
+    return (announcedSlotTime - now) / 1000;
+}
+
+void LoRaTransmitter::endSlot()
+{
+    if (!slotOpen) {
+        return;
+    }
+    
+    nextSlotTime = announcedSlotTime;
+    slotOpen = false;
+}
+
+void LoRaTransmitter::setNodeId(uint8_t id)
+{
+    nodeId = id;
+    Serial.printf("Thermostat node ID: %u\n", id);
+}
+
+void LoRaTransmitter::setDestination(uint8_t id)
+{
+    destinationId = id;
+}
+
+uint8_t LoRaTransmitter::getDestination() const
+{
+    return destinationId;
+}
+
+String LoRaTransmitter::getLastResponseFrame() const
+{
+    return lastResponseFrame;
+}
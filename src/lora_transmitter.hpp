@@ -8,12 +8,29 @@
 #pragma once
 
 #include <M5Unified.h>
+#include <esp_task_wdt.h>
 #include "../shared/protocol_common.hpp"
+#include "../shared/wio_e5_modem.hpp"
 
 // Configuration flags
-#define LORA_TX_DISABLE_BAUD_SEARCH true // Set to true to skip baud rate search and use fixed 9600
-#define LORA_TX_FIXED_BAUD_RATE 9600     // Baud rate to use when DISABLE_BAUD_SEARCH is true
-#define LORA_TX_INIT_TIMEOUT_MS 180000   // Allow up to 3 minutes for connection (patient initialization)
+#define LORA_TX_DISABLE_BAUD_SEARCH true          // Set to true to skip baud rate search and use fixed 9600
+#define LORA_TX_FIXED_BAUD_RATE 9600              // Baud rate to use when DISABLE_BAUD_SEARCH is true
+#define LORA_TX_INIT_TIMEOUT_MS 180000            // Allow up to 3 minutes for connection (patient initialization)
+#define LORA_TX_SYNC_SLOTS_ENABLED false          // Transmit only in announced slots so the receiver can sleep between them
+#define LORA_TX_NODE_ID P2P_DEFAULT_THERMOSTAT_ID // This thermostat's node ID (P2P_NODE_ID_NONE for unaddressed frames)
+
+/**
+ * @struct TransmitterModemPolicy
+ * @brief WioE5Modem settings for the thermostat
+ */
+struct TransmitterModemPolicy
+{
+    static const bool BAUD_SEARCH = !LORA_TX_DISABLE_BAUD_SEARCH;
+    static const long FIXED_BAUD = LORA_TX_FIXED_BAUD_RATE;
+    static const unsigned long BOOT_WAIT_MS = 7000; // Module powers up together with the M5Dial
+    static const unsigned long CONNECT_TIMEOUT_MS = LORA_TX_INIT_TIMEOUT_MS;
+    static void feedWatchdog() { esp_task_wdt_reset(); }
+};
 
 /**
  * @class LoRaTransmitter
@@ -27,6 +44,7 @@ class LoRaTransmitter
 {
 private:
     HardwareSerial *loraSerial;
+    WioE5Modem<HardwareSerial, TransmitterModemPolicy> modem; // Shared AT command layer
     int rxPin;
     int txPin;
     bool isInitialized;
@@ -41,7 +59,20 @@ private:
     int totalRetries;
     String lastError;
 
-    // AT command handling with enhanced features from Grove-Wio-E5 examples
+    // Slot-synchronized transmission (P2P only)
+    unsigned long slotIntervalMs;    // 0 = transmit whenever needed
+    unsigned long nextSlotTime;      // millis() when the next slot opens
+    unsigned long announcedSlotTime; // Slot announced by frames sent in the current slot
+    bool slotOpen;
+    unsigned long getSecondsToAnnouncedSlot();
+
+    // Multi-zone addressing (P2P only)
+    uint8_t nodeId;        // Our node ID, sent as the source of every frame
+    uint8_t destinationId; // Receiver addressed by the next commands
+    String lastResponseFrame; // Last accepted P2P response including its ;KEY=VALUE fields
+    uint16_t frameSequence;   // Sent with every P2P frame so receivers can count lost packets
+
+    // AT command handling (delegates to modem)
     bool sendATCommand(const String &command, const String &expectedResponse = "OK", int timeout = 5000);
     String readResponse(int timeout = 5000);
     void clearSerialBuffer();
@@ -57,7 +88,7 @@ private:
 
     // P2P communication methods
     bool sendP2PMessage(const String &message);
-    String receiveP2PMessage(int timeout = 2000);
+    String receiveP2PMessage(uint8_t peerId, int timeout = P2P_RX_TIMEOUT);
     bool enterP2PReceiveMode();
 
     // Message handling
@@ -222,4 +253,56 @@ public:
      * @return Device info string
      */
     String getDeviceInfo();
+
+    /**
+     * @brief Enable slot-synchronized transmission
+     * Frames sent inside a slot carry the seconds until the next slot
+     * (P2P_FIELD_NEXT_SLOT) so the receiver can sleep in between.
+     * @param intervalMs Slot spacing in milliseconds, 0 to disable
+     */
+    void setSlotInterval(unsigned long intervalMs);
+
+    /**
+     * @brief Check if slot-synchronized transmission is enabled
+     * @return true if enabled
+     */
+    bool isSlotSyncEnabled() const;
+
+    /**
+     * @brief Open the current transmit slot if it is due
+     * @return true if transmitting is allowed now (always true when disabled)
+     */
+    bool beginSlot();
+
+    /**
+     * @brief Close the current slot and commit to the announced next one
+     */
+    void endSlot();
+
+    /**
+     * @brief Set this thermostat's node ID
+     * @param id Node ID 1..254, P2P_NODE_ID_NONE for unaddressed frames
+     */
+    void setNodeId(uint8_t id);
+
+    /**
+     * @brief Select the receiver addressed by following commands
+     * Responses from other receivers, or addressed to other thermostats, are ignored.
+     * @param id Receiver node ID, P2P_NODE_ID_NONE to address any receiver
+     */
+    void setDestination(uint8_t id);
+
+    /**
+     * @brief Get the receiver currently addressed
+     * @return Receiver node ID
+     */
+    uint8_t getDestination() const;
+
+    /**
+     * @brief Get the last accepted P2P response with its optional fields
+     * sendCommand() returns the bare response; use this to read fields such as
+     * P2P_FIELD_RECONFIRM.
+     * @return Full response frame, empty if none yet
+     */
+    String getLastResponseFrame() const;
 };
\ No newline at end of file
@@ -0,0 +1,295 @@
+/**
+ * @file mpc_controller.cpp
+ * @brief Receding-horizon planner implementation
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include <math.h>
+#include "mpc_controller.hpp"
+
+static const unsigned long HOUR_MS = 3600000UL;
+static const unsigned long STEP_MS = MPC_STEP_MIN * 60000UL;
+static const float STEP_HOURS = MPC_STEP_MIN / 60.0f;
+
+OutdoorForecast::OutdoorForecast() : hours(0), startMs(0)
+{
+}
+
+void OutdoorForecast::reset(unsigned long start)
+{
+    hours = 0;
+    startMs = start;
+}
+
+bool OutdoorForecast::add(float temperatureF)
+{
+    if (hours >= MPC_FORECAST_MAX_HOURS)
+    {
+        return false;
+    }
+    temperature[hours++] = temperatureF;
+    return true;
+}
+
+uint16_t OutdoorForecast::getHours() const
+{
+    return hours;
+}
+
+bool OutdoorForecast::lookup(long offsetMs, float &value) const
+{
+    if (offsetMs < 0 || hours == 0)
+    {
+        return false;
+    }
+    unsigned long index = (unsigned long)offsetMs / HOUR_MS;
+    if (index >= hours)
+    {
+        return false;
+    }
+    if (index + 1 == hours)
+    {
+        value = temperature[index]; // Last hour: no interpolation partner
+        return offsetMs % HOUR_MS == 0;
+    }
+    float fraction = (offsetMs % HOUR_MS) / (float)HOUR_MS;
+    value = temperature[index] + (temperature[index + 1] - temperature[index]) * fraction;
+    return true;
+}
+
+bool OutdoorForecast::getTemperature(unsigned long nowMs, float &value) const
+{
+    return lookup((long)(nowMs - startMs), value);
+}
+
+float OutdoorForecast::getAnomaly(unsigned long nowMs) const
+{
+    long offsetMs = (long)(nowMs - startMs);
+    float forecast;
+    if (!lookup(offsetMs, forecast))
+    {
+        return 0.0f;
+    }
+
+    float sum = 0.0f;
+    int days = 0;
+    for (int day = 1; day <= MPC_FORECAST_BASELINE_DAYS; day++)
+    {
+        float past;
+        if (lookup(offsetMs - (long)(day * 24 * HOUR_MS), past))
+        {
+            sum += past;
+            days++;
+        }
+    }
+    return days ? forecast - sum / days : 0.0f;
+}
+
+MpcController::MpcController()
+{
+    reset();
+}
+
+void MpcController::reset()
+{
+    tau = 0.0f;
+    heatingRate = 0.0f;
+    decay = 0.0f;
+    heatBlend = 0.0f;
+    planned = false;
+    planMs = 0;
+    onStep = 0;
+    offStep = 0;
+    planCost = 0.0f;
+    planEndTemp = 0.0f;
+    planEvaluations = 0;
+    planSteps = 0;
+}
+
+float MpcController::advance(int k, bool on, float &temperature, float &heat) const
+{
+    // Exact step of dT/dt = (Tref - T)/tau + drift + heatingRate*h, with h at its mid-step value
+    float nextHeat = heat + ((on ? 1.0f : 0.0f) - heat) * heatBlend;
+    float rate = drift[k] + heatingRate * (heat + nextHeat) / 2.0f;
+    float equilibrium = THERMAL_MODEL_REFERENCE_F + rate * tau;
+    temperature = equilibrium + (temperature - equilibrium) * decay;
+    heat = nextHeat;
+
+    float cost = on ? MPC_FUEL_WEIGHT : 0.0f;
+    float cold = setpoint[k] - MPC_COLD_MARGIN_F - temperature;
+    float hot = temperature - setpoint[k] - MPC_HOT_MARGIN_F;
+    if (cold > 0.0f)
+    {
+        cost += MPC_COLD_WEIGHT * cold;
+    }
+    if (hot > 0.0f)
+    {
+        cost += MPC_HOT_WEIGHT * hot;
+    }
+    return cost * STEP_HOURS;
+}
+
+float MpcController::terminalCost(float temperature) const
+{
+    float cold = setpoint[MPC_HORIZON_STEPS - 1] - MPC_COLD_MARGIN_F - temperature;
+    return cold > 0.0f ? MPC_COLD_WEIGHT * cold * MPC_TERMINAL_HOURS : 0.0f;
+}
+
+bool MpcController::solve(const ThermalModel &model, const Schedule &schedule, float baseTemperature,
+                          float temperature, bool isOn, unsigned long onForMs, unsigned long nowMs,
+                          int minuteOfWeek, const OutdoorForecast &forecast)
+{
+    if (!model.isTrained())
+    {
+        planned = false;
+        return false;
+    }
+
+    tau = model.getTimeConstantHours();
+    heatingRate = model.getHeatingRate();
+    decay = expf(-STEP_HOURS / tau);
+    heatBlend = 1.0f - expf(-MPC_STEP_MIN / THERMAL_MODEL_HEAT_LAG_MIN);
+
+    // What the room would do on its own: schedule, learned drift, and the forecast's
+    // anomaly acting through the same loss coefficient (1/tau) as the room itself
+    for (int k = 0; k < MPC_HORIZON_STEPS; k++)
+    {
+        int midOffset = k * MPC_STEP_MIN + MPC_STEP_MIN / 2;
+        int endMinute = minuteOfWeek + (k + 1) * MPC_STEP_MIN;
+        setpoint[k] = baseTemperature + schedule.getOffset(endMinute % SCHEDULE_MINUTES_PER_WEEK);
+        drift[k] = model.getDriftRate(((minuteOfWeek + midOffset) % SCHEDULE_MINUTES_PER_DAY) / 60.0f) +
+                   forecast.getAnomaly(nowMs + (unsigned long)midOffset * 60000UL) / tau;
+    }
+
+    // Staying OFF, kept step by step as the common prefix of every plan
+    float offTemp[MPC_HORIZON_STEPS + 1];
+    float offHeat[MPC_HORIZON_STEPS + 1];
+    float offCost[MPC_HORIZON_STEPS + 1];
+    offTemp[0] = temperature;
+    offHeat[0] = model.getHeatOutput();
+    offCost[0] = 0.0f;
+    for (int k = 0; k < MPC_HORIZON_STEPS; k++)
+    {
+        offTemp[k + 1] = offTemp[k];
+        offHeat[k + 1] = offHeat[k];
+        offCost[k + 1] = offCost[k] + advance(k, false, offTemp[k + 1], offHeat[k + 1]);
+    }
+
+    // A burn younger than MPC_MIN_ON_MIN has to go on; otherwise staying OFF is the plan to beat
+    const int minOnSteps = (MPC_MIN_ON_MIN + MPC_STEP_MIN - 1) / MPC_STEP_MIN;
+    unsigned long minOnMs = MPC_MIN_ON_MIN * 60000UL;
+    int committedSteps = (isOn && onForMs < minOnMs) ? (int)((minOnMs - onForMs + STEP_MS - 1) / STEP_MS) : 0;
+    float best = committedSteps ? INFINITY : offCost[MPC_HORIZON_STEPS] + terminalCost(offTemp[MPC_HORIZON_STEPS]);
+    uint8_t bestOn = 0, bestOff = 0;
+    uint32_t evaluations = 1;
+    uint32_t steps = MPC_HORIZON_STEPS;
+
+    for (int on = 0; on < (committedSteps ? 1 : MPC_HORIZON_STEPS); on++)
+    {
+        float t = offTemp[on];
+        float h = offHeat[on];
+        bool running = on == 0 && isOn; // Already burning: no new ignition
+        float cost = offCost[on] + (running ? 0.0f : MPC_START_COST);
+        int shortest = running ? (committedSteps ? committedSteps : 1) : minOnSteps;
+
+        // Every step costs something, so a plan already over the best can only get worse
+        for (int off = on + 1; off <= MPC_HORIZON_STEPS && cost < best; off++)
+        {
+            cost += advance(off - 1, true, t, h);
+            steps++;
+            if (t >= STOVE_SAFETY_MAX_TEMP)
+            {
+                break; // Longer ON periods only get hotter
+            }
+
+            if (off - on < shortest)
+            {
+                continue;
+            }
+
+            float tailTemp = t;
+            float tailHeat = h;
+            float total = cost;
+            bool safe = true;
+            for (int k = off; k < MPC_HORIZON_STEPS && total < best; k++)
+            {
+                total += advance(k, false, tailTemp, tailHeat);
+                steps++;
+                safe = safe && tailTemp < STOVE_SAFETY_MAX_TEMP; // The stove body still heats after OFF
+            }
+            evaluations++;
+
+            total += terminalCost(tailTemp);
+            if (safe && total < best)
+            {
+                best = total;
+                bestOn = (uint8_t)on;
+                bestOff = (uint8_t)off;
+            }
+        }
+    }
+
+    planned = true;
+    planMs = nowMs;
+    onStep = bestOn;
+    offStep = bestOff;
+    planCost = best;
+    planEvaluations = evaluations;
+    planSteps = steps;
+
+    // Predicted end temperature of the chosen plan, for the log
+    float t = temperature;
+    float h = model.getHeatOutput();
+    for (int k = 0; k < MPC_HORIZON_STEPS; k++)
+    {
+        advance(k, k >= onStep && k < offStep, t, h);
+    }
+    planEndTemp = t;
+    return true;
+}
+
+bool MpcController::hasPlan() const
+{
+    return planned;
+}
+
+bool MpcController::isOnAt(unsigned long nowMs) const
+{
+    if (!planned)
+    {
+        return false;
+    }
+    unsigned long step = (nowMs - planMs) / STEP_MS;
+    return step >= onStep && step < offStep;
+}
+
+unsigned long MpcController::getOnMinutes() const
+{
+    return (unsigned long)onStep * MPC_STEP_MIN;
+}
+
+unsigned long MpcController::getOffMinutes() const
+{
+    return (unsigned long)offStep * MPC_STEP_MIN;
+}
+
+float MpcController::getCost() const
+{
+    return planCost;
+}
+
+float MpcController::getEndTemperature() const
+{
+    return planEndTemp;
+}
+
+uint32_t MpcController::getEvaluations() const
+{
+    return planEvaluations;
+}
+
+uint32_t MpcController::getSteps() const
+{
+    return planSteps;
+}
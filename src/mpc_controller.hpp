@@ -0,0 +1,208 @@
+/**
+ * @file mpc_controller.hpp
+ * @brief Receding-horizon ON/OFF planning over the schedule, room model and outdoor forecast
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Plain C++ with no Arduino dependencies (builds on a PC).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "stove_control.hpp"
+#include "thermal_model.hpp"
+#include "schedule.hpp"
+
+// Forecast storage: hourly values, 3 days back (the baseline) and up to 2 days ahead
+#define MPC_FORECAST_MAX_HOURS 120
+#define MPC_FORECAST_BASELINE_DAYS 3
+
+// Planner configuration
+#define MPC_STEP_MIN 10                 // Plan resolution (longer than the 3-minute change interval)
+#define MPC_HORIZON_STEPS 36            // 6 hours ahead
+#define MPC_SOLVE_INTERVAL_MS 60000UL   // Re-plan once a minute
+#define MPC_COLD_MARGIN_F 0.75f         // Below setpoint minus this counts as cold
+#define MPC_HOT_MARGIN_F 0.5f           // Above setpoint plus this counts as hot
+#define MPC_COLD_WEIGHT 8.0f            // Cost per °F-hour cold
+#define MPC_HOT_WEIGHT 2.0f             // Cost per °F-hour hot
+#define MPC_FUEL_WEIGHT 1.0f            // Cost per hour at full fire
+#define MPC_START_COST 1.0f             // Cost per ignition
+#define MPC_MIN_ON_MIN 30               // Once lit, the stove burns at least this long
+#define MPC_TERMINAL_HOURS 2.0f         // A deficit left at the horizon counts this long
+
+/**
+ * @class OutdoorForecast
+ * @brief Hourly outdoor temperatures on the control loop's clock
+ *
+ * The room model has no outdoor input: its constant and daily terms have
+ * learned the recent weather. What a forecast adds is the anomaly, i.e. how
+ * much warmer or colder the coming hours are than the same hours of the last
+ * MPC_FORECAST_BASELINE_DAYS days, so the series should start that far back.
+ */
+class OutdoorForecast
+{
+private:
+    float temperature[MPC_FORECAST_MAX_HOURS]; // °F, one per hour
+    uint16_t hours;
+    unsigned long startMs;                     // Monotonic time of temperature[0] (may be in the past)
+
+    bool lookup(long offsetMs, float &value) const;
+
+public:
+    /**
+     * @brief Constructor (empty forecast)
+     */
+    OutdoorForecast();
+
+    /**
+     * @brief Drop all values and start a new series
+     * @param startMs Monotonic time (ms) of the first value
+     */
+    void reset(unsigned long startMs);
+
+    /**
+     * @brief Append the next hour's temperature
+     * @param temperatureF Outdoor temperature (°F)
+     * @return false when MPC_FORECAST_MAX_HOURS are already stored
+     */
+    bool add(float temperatureF);
+
+    /**
+     * @brief Number of hourly values
+     * @return Hours stored
+     */
+    uint16_t getHours() const;
+
+    /**
+     * @brief Outdoor temperature, interpolated between hours
+     * @param nowMs Monotonic time (ms)
+     * @param value Receives °F
+     * @return false outside the series
+     */
+    bool getTemperature(unsigned long nowMs, float &value) const;
+
+    /**
+     * @brief Forecast minus the mean of the same hour on the previous days
+     * @param nowMs Monotonic time (ms)
+     * @return °F warmer (+) or colder (-) than usual; 0 when not covered
+     */
+    float getAnomaly(unsigned long nowMs) const;
+};
+
+/**
+ * @class MpcController
+ * @brief Finds the cheapest ON interval in the next MPC_HORIZON_STEPS
+ *
+ * Candidate plans are "OFF until step a, ON until step b, then OFF", plus
+ * staying OFF. Each one is simulated with the learned model and scored on
+ * degrees cold and hot against the schedule, fuel burnt and ignitions. With
+ * re-planning every minute that family is enough: only the first step of a
+ * plan is ever carried out. Every burn lasts at least MPC_MIN_ON_MIN, counted
+ * across re-plans. Plans that would reach STOVE_SAFETY_MAX_TEMP are
+ * rejected. The number of plans and steps is fixed by MPC_HORIZON_STEPS, and
+ * so is the memory: a few arrays of that size, here and on the stack.
+ */
+class MpcController
+{
+private:
+    float setpoint[MPC_HORIZON_STEPS]; // Scheduled °F at the end of each step
+    float drift[MPC_HORIZON_STEPS];    // Model drift plus forecast anomaly (°F/h)
+
+    // Model in step form, filled by solve()
+    float tau;
+    float heatingRate;
+    float decay;     // exp(-step / tau)
+    float heatBlend; // Stove lag over one step
+
+    // Current plan
+    bool planned;
+    unsigned long planMs;
+    uint8_t onStep;  // ON from this step...
+    uint8_t offStep; // ...until this one (equal: stay OFF)
+    float planCost;
+    float planEndTemp;
+    uint32_t planEvaluations;
+    uint32_t planSteps;
+
+    float advance(int k, bool on, float &temperature, float &heat) const;
+    float terminalCost(float temperature) const;
+
+public:
+    /**
+     * @brief Constructor
+     */
+    MpcController();
+
+    /**
+     * @brief Forget the plan
+     */
+    void reset();
+
+    /**
+     * @brief Plan from now (runs a fixed number of model steps)
+     * @param model Learned room model (untrained: no plan)
+     * @param schedule Week schedule
+     * @param baseTemperature Base temperature the schedule offsets apply to (°F)
+     * @param temperature Current temperature (°F)
+     * @param isOn Whether the stove is on (no ignition cost for staying on)
+     * @param onForMs How long it has been on (ms); it stays on until MPC_MIN_ON_MIN
+     * @param nowMs Monotonic time (ms)
+     * @param minuteOfWeek Current minute of the week (0 = Sunday 00:00)
+     * @param forecast Outdoor forecast (may be empty)
+     * @return true if a plan was made
+     */
+    bool solve(const ThermalModel &model, const Schedule &schedule, float baseTemperature, float temperature,
+               bool isOn, unsigned long onForMs, unsigned long nowMs, int minuteOfWeek,
+               const OutdoorForecast &forecast);
+
+    /**
+     * @brief Whether a plan exists
+     * @return true after a successful solve()
+     */
+    bool hasPlan() const;
+
+    /**
+     * @brief The plan's stove state at a time
+     * @param nowMs Monotonic time (ms)
+     * @return true if the stove should be on
+     */
+    bool isOnAt(unsigned long nowMs) const;
+
+    /**
+     * @brief Minutes from the last solve until the planned ON period starts
+     * @return Minutes (equal to getOffMinutes() when the plan stays OFF)
+     */
+    unsigned long getOnMinutes() const;
+
+    /**
+     * @brief Minutes from the last solve until the planned ON period ends
+     * @return Minutes
+     */
+    unsigned long getOffMinutes() const;
+
+    /**
+     * @brief Cost of the chosen plan
+     * @return Weighted cost (see MPC_*_WEIGHT)
+     */
+    float getCost() const;
+
+    /**
+     * @brief Predicted temperature at the end of the horizon
+     * @return °F
+     */
+    float getEndTemperature() const;
+
+    /**
+     * @brief Plans scored by the last solve()
+     * @return Plan count
+     */
+    uint32_t getEvaluations() const;
+
+    /**
+     * @brief Model steps simulated by the last solve()
+     * @return Step count
+     */
+    uint32_t getSteps() const;
+};
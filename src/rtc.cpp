@@ -6,6 +6,8 @@
  */
 
 #include "rtc.hpp"
+#include "csv_reader.hpp"
+#include "mpc_controller.hpp"
 #include "secrets.h"
 #include "SPIFFS.h"
 #include "HTTPClient.h"
@@ -21,12 +23,18 @@ static const char *DEFAULT_NTP_SERVER1 = "time.nist.gov";
 static const char *DEFAULT_NTP_SERVER2 = "pool.ntp.org";
 static const char *DEFAULT_NTP_SERVER3 = "0.pool.ntp.org";
 
+// Location for the outdoor forecast (MPC control mode); set both in secrets.h to enable downloads
+#ifndef FORECAST_LATITUDE
+#define FORECAST_LATITUDE NAN
+#define FORECAST_LONGITUDE NAN
+#endif
+
 // Static weekday strings
 static constexpr const char *const weekdays[7] = {"Sun", "Mon", "Tue", "Wed",
                                                   "Thr", "Fri", "Sat"};
 
 // Constructor with default configuration
-RTC::RTC() : isInitialized(false)
+RTC::RTC() : isInitialized(false), clockMinuteOfWeek(0), nextMinuteMillis(0), clockValid(false)
 {
     wifiConfig.ssid = DEFAULT_WIFI_SSID;
     wifiConfig.password = DEFAULT_WIFI_PASSWORD;
@@ -38,7 +46,8 @@ RTC::RTC() : isInitialized(false)
 }
 
 // Constructor with custom configuration
-RTC::RTC(const WiFiConfig &wifi, const NTPConfig &ntp) : wifiConfig(wifi), ntpConfig(ntp), isInitialized(false)
+RTC::RTC(const WiFiConfig &wifi, const NTPConfig &ntp) : wifiConfig(wifi), ntpConfig(ntp), isInitialized(false),
+                                                           clockMinuteOfWeek(0), nextMinuteMillis(0), clockValid(false)
 {
     fallbackTimezone = ntp.timezone;
 }
@@ -689,6 +698,44 @@ int RTC::getHour()
     return dt.time.hours;
 }
 
+int RTC::getMinute()
+{
+    auto dt = M5.Rtc.getDateTime();
+    return dt.time.minutes;
+}
+
+int RTC::getMinuteOfWeek()
+{
+    auto dt = M5.Rtc.getDateTime();
+    int dayOfWeek = (dt.date.weekDay == 7) ? 0 : dt.date.weekDay;
+    return (dayOfWeek * 24 + dt.time.hours) * 60 + dt.time.minutes;
+}
+
+bool RTC::serviceMinute()
+{
+    if (clockValid && (long)(millis() - nextMinuteMillis) < 0)
+    {
+        return false;
+    }
+
+    auto dt = M5.Rtc.getDateTime();
+    int dayOfWeek = (dt.date.weekDay == 7) ? 0 : dt.date.weekDay;
+    int minuteOfWeek = (dayOfWeek * 24 + dt.time.hours) * 60 + dt.time.minutes;
+
+    // Next read just after the coming boundary; a clock set in between is picked up then
+    nextMinuteMillis = millis() + (60 - dt.time.seconds) * 1000UL + RTC_MINUTE_GUARD_MS;
+
+    bool changed = !clockValid || minuteOfWeek != clockMinuteOfWeek;
+    clockMinuteOfWeek = minuteOfWeek;
+    clockValid = true;
+    return changed;
+}
+
+int RTC::getClockMinuteOfWeek() const
+{
+    return clockMinuteOfWeek;
+}
+
 int RTC::getDayOfWeek()
 {
     auto dt = M5.Rtc.getDateTime();
@@ -698,6 +745,12 @@ int RTC::getDayOfWeek()
 
 // Private methods
 
+// CsvReader data source for an open SPIFFS file
+static int readTimezoneFile(void *context, uint8_t *buffer, size_t size)
+{
+    return (int)static_cast<File *>(context)->read(buffer, size);
+}
+
 bool RTC::loadFallbackTimezone()
 {
     // Initialize SPIFFS
@@ -732,66 +785,50 @@ bool RTC::loadFallbackTimezone()
     Serial.println("Loading fallback timezone from temps.csv");
     // Serial.printf("File size: %d bytes\n", file.size());
 
-    String line;
+    CsvReader reader(readTimezoneFile, &file);
+    char timezone[64];
     bool timezoneSet = false;
-    int lineNum = 0;
 
-    while (file.available() && !timezoneSet)
+    while (!timezoneSet && reader.next())
     {
-        line = file.readStringUntil('\n');
-        line.trim();
-        lineNum++;
-
-        // Serial.printf("Line %d: '%s'\n", lineNum, line.c_str());
-
-        // Skip comments and empty lines
-        if (line.length() == 0 || line.startsWith("#"))
+        if (!reader.fieldEquals(0, "FallbackTimezone"))
         {
             continue;
         }
 
-        // Parse fallback timezone
-        if (line.startsWith("FallbackTimezone,"))
+        // Take the rest of the line: POSIX zones contain commas (e.g. PST8PDT,M3.2.0,M11.1.0)
+        if (!reader.getRest(1, timezone, sizeof(timezone)))
         {
-            // Serial.println("Found FallbackTimezone line!");
-            int commaIndex = line.indexOf(',');
-            if (commaIndex != -1)
-            {
-                String fullTimezone = line.substring(commaIndex + 1);
-                fullTimezone.trim();
+            const CsvError &error = reader.getLastError();
+            Serial.printf("Error: temps.csv line %lu, column %u: %s\n",
+                          (unsigned long)error.line, (unsigned)error.column, error.message);
+            continue;
+        }
 
-                // Handle complex timezone formats (e.g., PST8PDT,M3.2.0,M11.1.0)
-                // Take the entire string as ESP32 supports complex timezone formats
-                fallbackTimezone = fullTimezone;
-                timezoneSet = true;
-                Serial.printf("Loaded fallback timezone: '%s'\n", fallbackTimezone.c_str());
+        fallbackTimezone = timezone;
+        timezoneSet = true;
+        Serial.printf("Loaded fallback timezone: '%s'\n", fallbackTimezone.c_str());
 
-                // Also log the simplified explanation for debugging
-                if (fallbackTimezone.startsWith("PST8PDT"))
-                {
-                    Serial.println("  -> Pacific Standard Time with Daylight Saving Time");
-                }
-                else if (fallbackTimezone.startsWith("EST5EDT"))
-                {
-                    Serial.println("  -> Eastern Standard Time with Daylight Saving Time");
-                }
-                else if (fallbackTimezone.startsWith("MST7MDT"))
-                {
-                    Serial.println("  -> Mountain Standard Time with Daylight Saving Time");
-                }
-                else if (fallbackTimezone.startsWith("CST6CDT"))
-                {
-                    Serial.println("  -> Central Standard Time with Daylight Saving Time");
-                }
-                else if (fallbackTimezone.startsWith("UTC"))
-                {
-                    Serial.println("  -> Coordinated Universal Time");
-                }
-            }
-            else
-            {
-                Serial.println("Error: No comma found in FallbackTimezone line");
-            }
+        // Also log the simplified explanation for debugging
+        if (fallbackTimezone.startsWith("PST8PDT"))
+        {
+            Serial.println("  -> Pacific Standard Time with Daylight Saving Time");
+        }
+        else if (fallbackTimezone.startsWith("EST5EDT"))
+        {
+            Serial.println("  -> Eastern Standard Time with Daylight Saving Time");
+        }
+        else if (fallbackTimezone.startsWith("MST7MDT"))
+        {
+            Serial.println("  -> Mountain Standard Time with Daylight Saving Time");
+        }
+        else if (fallbackTimezone.startsWith("CST6CDT"))
+        {
+            Serial.println("  -> Central Standard Time with Daylight Saving Time");
+        }
+        else if (fallbackTimezone.startsWith("UTC"))
+        {
+            Serial.println("  -> Coordinated Universal Time");
         }
     }
 
@@ -864,6 +901,100 @@ time_t RTC::getCurrentTime()
     return time(nullptr);
 }
 
+bool RTC::downloadForecast(const char *path)
+{
+    if (isnan(FORECAST_LATITUDE) || isnan(FORECAST_LONGITUDE))
+    {
+        Serial.println("Forecast: no location set (FORECAST_LATITUDE/FORECAST_LONGITUDE in secrets.h)");
+        return false;
+    }
+
+    bool wasConnected = (WiFi.status() == WL_CONNECTED);
+    if (!wasConnected && !connectToWiFi())
+    {
+        WiFi.disconnect();
+        WiFi.mode(WIFI_OFF);
+        return false;
+    }
+
+    // Open-Meteo (no key): the baseline days before now, then the next two days, in Unix time
+    char url[224];
+    snprintf(url, sizeof(url),
+             "http://api.open-meteo.com/v1/forecast?latitude=%.3f&longitude=%.3f&hourly=temperature_2m"
+             "&temperature_unit=fahrenheit&timeformat=unixtime&past_days=%d&forecast_days=2",
+             (double)FORECAST_LATITUDE, (double)FORECAST_LONGITUDE, MPC_FORECAST_BASELINE_DAYS);
+
+    HTTPClient http;
+    http.begin(url);
+    http.setTimeout(8000);
+    http.setUserAgent("M5Stack-ESP32/1.0");
+
+    yield(); // Feed watchdog before HTTP request
+    int httpResponseCode = http.GET();
+    yield(); // Feed watchdog after HTTP request
+
+    bool saved = false;
+    if (httpResponseCode == 200)
+    {
+        // Keep only the two hourly arrays while parsing
+        JsonDocument filter;
+        filter["hourly"]["time"] = true;
+        filter["hourly"]["temperature_2m"] = true;
+        JsonDocument doc;
+        DeserializationError error = deserializeJson(doc, http.getStream(), DeserializationOption::Filter(filter));
+        JsonArray times = doc["hourly"]["time"];
+        JsonArray temperatures = doc["hourly"]["temperature_2m"];
+
+        if (error)
+        {
+            Serial.printf("Forecast: JSON parsing failed: %s\n", error.c_str());
+        }
+        else if (times.size() == 0 || temperatures.size() == 0)
+        {
+            Serial.println("Forecast: no hourly data in the response");
+        }
+        else if (SPIFFS.begin())
+        {
+            File file = SPIFFS.open(path, "w");
+            if (file)
+            {
+                file.printf("# Outdoor temperature (F), hourly, from Open-Meteo\nStart,%ld\n", times[0].as<long>());
+                size_t hours = 0;
+                for (JsonVariant value : temperatures)
+                {
+                    if (value.isNull())
+                    {
+                        break; // Gaps only occur at the end of the range
+                    }
+                    file.printf("%.1f\n", value.as<float>());
+                    hours++;
+                }
+                file.close();
+                saved = true;
+                Serial.printf("Forecast: %u hours saved to %s\n", (unsigned)hours, path);
+            }
+            else
+            {
+                Serial.printf("Forecast: cannot write %s\n", path);
+            }
+        }
+    }
+    else
+    {
+        Serial.printf("Forecast download failed: %d\n", httpResponseCode);
+        reportHTTPError(httpResponseCode);
+    }
+    http.end();
+
+    // Leave the radio as it was: off, unless the caller already had it up
+    if (!wasConnected)
+    {
+        WiFi.disconnect();
+        WiFi.mode(WIFI_OFF);
+    }
+    return saved;
+}
+
 bool RTC::detectTimezoneFromLocation()
 {
     Serial.println("Attempting automatic timezone detection...");
@@ -34,6 +34,8 @@
 #define SNTP_ENABLED 0
 #endif
 
+#define RTC_MINUTE_GUARD_MS 50 // Read the RTC this long after a minute boundary, so the new minute has begun
+
 /**
  * @struct WiFiConfig
  * @brief WiFi configuration structure
@@ -71,6 +73,11 @@ private:
     bool isInitialized;
     String fallbackTimezone;
 
+    // Minute clock: the hardware RTC is read once per minute, just after the boundary
+    int clockMinuteOfWeek;           // Minute of the week at the last read
+    unsigned long nextMinuteMillis;  // millis() at which the next minute starts
+    bool clockValid;                 // Read at least once
+
     /**
      * @brief Load fallback timezone from temps.csv
      * @return true if successfully loaded
@@ -177,12 +184,50 @@ public:
      */
     int getHour();
 
+    /**
+     * @brief Get current minute (0-59)
+     * @return Current minute
+     */
+    int getMinute();
+
+    /**
+     * @brief Get current minute of the week from a single RTC read
+     * @return Minutes since Sunday 00:00 (0-10079)
+     */
+    int getMinuteOfWeek();
+
+    /**
+     * @brief Clock service: call every loop pass
+     * Reads the RTC only when the next minute is due (tracked with millis()),
+     * so other passes cost one comparison. Everything that follows the time
+     * of day should hang off this notification instead of reading the clock.
+     * @return true once per minute, when the minute of the week has changed
+     */
+    bool serviceMinute();
+
+    /**
+     * @brief Minute of the week as of the last serviceMinute() - no RTC read
+     * @return Minutes since Sunday 00:00 (0-10079)
+     */
+    int getClockMinuteOfWeek() const;
+
     /**
      * @brief Get current day of week (0=Sunday, 6=Saturday)
      * @return Day of week
      */
     int getDayOfWeek();
 
+    /**
+     * @brief Download the hourly outdoor forecast and save it for Stove::loadForecast
+     * Fetches from Open-Meteo for FORECAST_LATITUDE/FORECAST_LONGITUDE
+     * (secrets.h), covering the last MPC_FORECAST_BASELINE_DAYS days and the
+     * next two. Brings WiFi up for the request and turns it off again.
+     * Blocks for several seconds.
+     * @param path SPIFFS file to write
+     * @return true if a forecast was saved
+     */
+    bool downloadForecast(const char *path);
+
 private:
     // Private helper methods still used internally
     time_t getCurrentTime();
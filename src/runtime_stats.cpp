@@ -0,0 +1,219 @@
+/**
+ * @file runtime_stats.cpp
+ * @brief Stove runtime accounting implementation
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include <string.h>
+#include "runtime_stats.hpp"
+
+#define HOURS_PER_WEEK 168
+
+RuntimeStats::RuntimeStats(RuntimeStatsData &storage) : data(storage), lastUpdateMs(0), started(false)
+{
+    // storage is not touched here: it may be RTC memory holding the last run's data
+}
+
+uint32_t RuntimeStats::computeChecksum(const RuntimeStatsData &stats)
+{
+    // FNV-1a over everything before the checksum field
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&stats);
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < offsetof(RuntimeStatsData, checksum); i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+bool RuntimeStats::isValid(const RuntimeStatsData &stats)
+{
+    return stats.magic == RUNTIME_MAGIC && stats.version == RUNTIME_VERSION && stats.size == sizeof(RuntimeStatsData) &&
+           stats.hourIndex < RUNTIME_HOURS && stats.dayIndex < RUNTIME_DAYS && stats.weekIndex < RUNTIME_WEEKS &&
+           stats.checksum == computeChecksum(stats);
+}
+
+void RuntimeStats::clear()
+{
+    memset(&data, 0, sizeof(data));
+    data.magic = RUNTIME_MAGIC;
+    data.version = RUNTIME_VERSION;
+    data.size = sizeof(RuntimeStatsData);
+    data.hourOfWeek = -1;
+    data.checksum = computeChecksum(data);
+    started = false;
+}
+
+bool RuntimeStats::restore(const RuntimeStatsData &saved)
+{
+    if (!isValid(saved))
+    {
+        return false;
+    }
+    memcpy(&data, &saved, sizeof(data));
+    started = false;
+    return true;
+}
+
+void RuntimeStats::advanceHour()
+{
+    data.hourIndex = (data.hourIndex + 1) % RUNTIME_HOURS;
+    memset(&data.hours[data.hourIndex], 0, sizeof(RuntimeBucket));
+}
+
+void RuntimeStats::advanceDay()
+{
+    data.dayIndex = (data.dayIndex + 1) % RUNTIME_DAYS;
+    memset(&data.days[data.dayIndex], 0, sizeof(RuntimeBucket));
+}
+
+void RuntimeStats::advanceWeek()
+{
+    data.weekIndex = (data.weekIndex + 1) % RUNTIME_WEEKS;
+    memset(&data.weeks[data.weekIndex], 0, sizeof(RuntimeBucket));
+}
+
+bool RuntimeStats::update(bool on, unsigned long nowMs, int minuteOfWeek)
+{
+    bool hourClosed = false;
+    int hourOfWeek = (minuteOfWeek / 60) % HOURS_PER_WEEK;
+
+    // Close buckets when the wall-clock hour, day or week moves on
+    if (data.hourOfWeek < 0)
+    {
+        data.hourOfWeek = hourOfWeek;
+    }
+    else if ((data.hourOfWeek - hourOfWeek + HOURS_PER_WEEK) % HOURS_PER_WEEK <= RUNTIME_CLOCK_BACK_HOURS)
+    {
+        // Clock set back: carry on in the current buckets rather than wrapping a whole week
+        data.hourOfWeek = hourOfWeek;
+    }
+    else
+    {
+        int hours = (hourOfWeek - data.hourOfWeek + HOURS_PER_WEEK) % HOURS_PER_WEEK;
+        for (int i = 0; i < hours && i < RUNTIME_HOURS; i++)
+        {
+            advanceHour();
+        }
+
+        int days = (hourOfWeek / 24 - data.hourOfWeek / 24 + 7) % 7;
+        for (int i = 0; i < days; i++)
+        {
+            advanceDay();
+        }
+
+        // Passing Sunday 00:00 starts a new week
+        if (hourOfWeek < data.hourOfWeek)
+        {
+            advanceWeek();
+        }
+
+        data.hourOfWeek = hourOfWeek;
+        hourClosed = true;
+    }
+
+    // Time since the last pass, credited to the current buckets
+    if (started)
+    {
+        unsigned long elapsedMs = nowMs - lastUpdateMs;
+        if (elapsedMs <= RUNTIME_MAX_GAP_MS)
+        {
+            // Whole seconds only; the remainder carries over to the next pass
+            uint32_t seconds = elapsedMs / 1000;
+            lastUpdateMs += seconds * 1000;
+
+            RuntimeBucket *buckets[3] = {&data.hours[data.hourIndex], &data.days[data.dayIndex],
+                                         &data.weeks[data.weekIndex]};
+            for (RuntimeBucket *bucket : buckets)
+            {
+                bucket->seconds += seconds;
+                if (data.wasOn)
+                {
+                    bucket->onSeconds += seconds;
+                }
+            }
+            if (data.wasOn)
+            {
+                data.totalOnSeconds += seconds;
+            }
+        }
+        else
+        {
+            lastUpdateMs = nowMs;
+        }
+    }
+    else
+    {
+        lastUpdateMs = nowMs;
+        started = true;
+    }
+
+    // A cycle is counted when the stove comes on
+    if (on && !data.wasOn)
+    {
+        data.hours[data.hourIndex].cycles++;
+        data.days[data.dayIndex].cycles++;
+        data.weeks[data.weekIndex].cycles++;
+        data.totalCycles++;
+    }
+    data.wasOn = on;
+
+    data.checksum = computeChecksum(data);
+    return hourClosed;
+}
+
+RuntimeSummary RuntimeStats::getSummary(RuntimePeriod period, size_t ago) const
+{
+    RuntimeSummary summary = {0, 0, 0, 0};
+    const RuntimeBucket *bucket = nullptr;
+
+    switch (period)
+    {
+    case RUNTIME_HOUR:
+        if (ago < RUNTIME_HOURS)
+        {
+            bucket = &data.hours[(data.hourIndex + RUNTIME_HOURS - ago) % RUNTIME_HOURS];
+        }
+        break;
+    case RUNTIME_DAY:
+        if (ago < RUNTIME_DAYS)
+        {
+            bucket = &data.days[(data.dayIndex + RUNTIME_DAYS - ago) % RUNTIME_DAYS];
+        }
+        break;
+    case RUNTIME_WEEK:
+        if (ago < RUNTIME_WEEKS)
+        {
+            bucket = &data.weeks[(data.weekIndex + RUNTIME_WEEKS - ago) % RUNTIME_WEEKS];
+        }
+        break;
+    }
+
+    if (!bucket)
+    {
+        return summary;
+    }
+
+    summary.onHours = bucket->onSeconds / 3600.0f;
+    summary.cycles = bucket->cycles;
+    summary.averageCycleMinutes = bucket->cycles ? bucket->onSeconds / 60.0f / bucket->cycles : 0;
+    summary.dutyPercent = bucket->seconds ? 100.0f * bucket->onSeconds / bucket->seconds : 0;
+    return summary;
+}
+
+float RuntimeStats::getTotalOnHours() const
+{
+    return data.totalOnSeconds / 3600.0f;
+}
+
+uint32_t RuntimeStats::getTotalCycles() const
+{
+    return data.totalCycles;
+}
+
+const RuntimeStatsData &RuntimeStats::getData()
+{
+    data.checksum = computeChecksum(data);
+    return data;
+}
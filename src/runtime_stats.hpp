@@ -0,0 +1,166 @@
+/**
+ * @file runtime_stats.hpp
+ * @brief Stove on-time, cycle and duty-cycle accounting in hour/day/week rollups
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Plain C++ with no Arduino dependencies (builds on a PC).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Rollup sizes
+#define RUNTIME_HOURS 24            // Last 24 hours
+#define RUNTIME_DAYS 7              // Last 7 days
+#define RUNTIME_WEEKS 8             // Last 8 weeks
+#define RUNTIME_MAX_GAP_MS 600000UL // Longer gaps between updates (stalls, clock trouble) are not counted
+#define RUNTIME_CLOCK_BACK_HOURS 24 // A clock moving back by up to this much is a correction, not a week going by
+#define RUNTIME_MAGIC 0x52554E54    // "RUNT"
+#define RUNTIME_VERSION 1           // Bump when RuntimeStatsData changes
+
+/**
+ * @enum RuntimePeriod
+ * @brief Rollup granularity
+ */
+enum RuntimePeriod
+{
+    RUNTIME_HOUR,
+    RUNTIME_DAY,
+    RUNTIME_WEEK
+};
+
+/**
+ * @struct RuntimeBucket
+ * @brief Stove activity within one hour, day or week
+ */
+struct RuntimeBucket
+{
+    uint32_t onSeconds;      // Time the stove was ON
+    uint32_t seconds;        // Time observed - less than the period after a boot or for the current bucket
+    uint16_t cycles;         // OFF->ON transitions
+    uint16_t reserved;
+};
+
+/**
+ * @struct RuntimeStatsData
+ * @brief All rollups - plain data so it can live in RTC memory and be saved as a blob
+ */
+struct RuntimeStatsData
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;                       // sizeof(RuntimeStatsData) when written
+    RuntimeBucket hours[RUNTIME_HOURS];  // Rings; the index below is the current bucket
+    RuntimeBucket days[RUNTIME_DAYS];
+    RuntimeBucket weeks[RUNTIME_WEEKS];
+    uint8_t hourIndex;
+    uint8_t dayIndex;
+    uint8_t weekIndex;
+    uint8_t wasOn;                       // Stove state at the last update
+    int16_t hourOfWeek;                  // Hour of the week of the current hour bucket, -1 = none yet
+    uint16_t reserved;
+    uint32_t totalOnSeconds;             // Since the statistics were started
+    uint32_t totalCycles;
+    uint32_t checksum;                   // Over everything above
+};
+
+/**
+ * @struct RuntimeSummary
+ * @brief One bucket in the units people read
+ */
+struct RuntimeSummary
+{
+    float onHours;
+    uint16_t cycles;
+    float averageCycleMinutes;  // ON time per cycle, 0 without cycles
+    float dutyPercent;          // ON time / observed time
+};
+
+/**
+ * @class RuntimeStats
+ * @brief Accumulates stove ON time and cycles into fixed-size rollup rings
+ *
+ * update() is called with the stove state on every control pass. ON time is
+ * measured with millis() and added to the current hour, day and week
+ * buckets. The wall clock only decides when a bucket closes, so a clock that
+ * is set mid-hour doesn't lose time, and one set back (DST, a correction)
+ * keeps filling the current buckets. Memory is fixed: 39 buckets of 12 bytes.
+ * The data lives in a caller-provided RuntimeStatsData, so it can sit in RTC
+ * memory (survives resets) and be copied to flash from time to time.
+ */
+class RuntimeStats
+{
+private:
+    RuntimeStatsData &data;
+    unsigned long lastUpdateMs;
+    bool started;                // First update since boot seen
+
+    void advanceHour();
+    void advanceDay();
+    void advanceWeek();
+    static uint32_t computeChecksum(const RuntimeStatsData &stats);
+
+public:
+    /**
+     * @brief Constructor
+     * @param storage Where the rollups live (e.g. RTC memory); check it with isValid()
+     */
+    explicit RuntimeStats(RuntimeStatsData &storage);
+
+    /**
+     * @brief Whether storage holds intact statistics (magic, version, size, checksum)
+     * @param stats Data to check
+     * @return true if the data can be used
+     */
+    static bool isValid(const RuntimeStatsData &stats);
+
+    /**
+     * @brief Start from empty rollups
+     */
+    void clear();
+
+    /**
+     * @brief Replace the rollups, e.g. with a copy saved in flash
+     * @param saved Saved data
+     * @return false (and nothing changed) if the copy isn't valid
+     */
+    bool restore(const RuntimeStatsData &saved);
+
+    /**
+     * @brief Account for the time since the last call
+     * @param on Stove is ON now
+     * @param nowMs millis()
+     * @param minuteOfWeek Current minute of the week (0 = Sunday 00:00)
+     * @return true if an hour bucket was closed (a good moment to save)
+     */
+    bool update(bool on, unsigned long nowMs, int minuteOfWeek);
+
+    /**
+     * @brief Summarise one bucket
+     * @param period Hour, day or week
+     * @param ago 0 = current bucket, 1 = the one before, ...
+     * @return Summary (all zero if out of range)
+     */
+    RuntimeSummary getSummary(RuntimePeriod period, size_t ago = 0) const;
+
+    /**
+     * @brief Stove ON time since the statistics were started
+     * @return Hours
+     */
+    float getTotalOnHours() const;
+
+    /**
+     * @brief Stove cycles since the statistics were started
+     * @return Cycle count
+     */
+    uint32_t getTotalCycles() const;
+
+    /**
+     * @brief Rollups with a fresh checksum, ready to save
+     * @return Data
+     */
+    const RuntimeStatsData &getData();
+};
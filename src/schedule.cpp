@@ -0,0 +1,387 @@
+/**
+ * @file schedule.cpp
+ * @brief Compiled week schedule implementation
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include "schedule.hpp"
+#include "csv_reader.hpp"
+
+#define ALL_DAYS 0x7F
+#define WEEKDAYS 0x3E // Monday to Friday
+#define WEEKENDS 0x41 // Saturday and Sunday
+
+static const char *DAY_NAMES[7] = {"sun", "mon", "tue", "wed", "thu", "fri", "sat"};
+
+static int16_t toTenths(float offset)
+{
+    return (int16_t)(offset * 10.0f + (offset < 0 ? -0.5f : 0.5f));
+}
+
+// Case-insensitive compare of a field (not NUL-terminated) with a lowercase keyword
+static bool fieldEquals(const char *field, size_t length, const char *keyword)
+{
+    size_t i = 0;
+    for (; i < length && keyword[i]; i++)
+    {
+        if (tolower((unsigned char)field[i]) != keyword[i])
+        {
+            return false;
+        }
+    }
+    return i == length && keyword[i] == '\0';
+}
+
+static int parseDayName(const char *field, size_t length)
+{
+    // "Mon" or "Monday" - the first three letters decide
+    if (length < 3)
+    {
+        return -1;
+    }
+    for (int day = 0; day < 7; day++)
+    {
+        if (fieldEquals(field, 3, DAY_NAMES[day]))
+        {
+            return day;
+        }
+    }
+    return -1;
+}
+
+static bool parseDays(const char *field, size_t length, uint8_t *mask)
+{
+    if (fieldEquals(field, length, "daily"))
+    {
+        *mask = ALL_DAYS;
+        return true;
+    }
+    if (fieldEquals(field, length, "weekdays"))
+    {
+        *mask = WEEKDAYS;
+        return true;
+    }
+    if (fieldEquals(field, length, "weekends"))
+    {
+        *mask = WEEKENDS;
+        return true;
+    }
+
+    // Single day or range such as "Mon-Fri" / "Fri-Mon" (wraps)
+    const char *dash = (const char *)memchr(field, '-', length);
+    int first = parseDayName(field, dash ? (size_t)(dash - field) : length);
+    int last = dash ? parseDayName(dash + 1, length - (dash - field) - 1) : first;
+    if (first < 0 || last < 0)
+    {
+        return false;
+    }
+
+    *mask = 0;
+    for (int day = first;; day = (day + 1) % 7)
+    {
+        *mask |= 1 << day;
+        if (day == last)
+        {
+            break;
+        }
+    }
+    return true;
+}
+
+// "HH:MM" -> minute of day
+static bool parseTime(const char *field, size_t length, uint16_t *minuteOfDay)
+{
+    char *end;
+    long hours = strtol(field, &end, 10);
+    if (end == field || *end != ':' || hours < 0 || hours > 23)
+    {
+        return false;
+    }
+    const char *minuteStart = end + 1;
+    long minutes = strtol(minuteStart, &end, 10);
+    if (end == minuteStart || (size_t)(end - field) != length || minutes < 0 || minutes > 59)
+    {
+        return false;
+    }
+    *minuteOfDay = (uint16_t)(hours * 60 + minutes);
+    return true;
+}
+
+Schedule::Schedule() : pointCount(0)
+{
+    compile();
+}
+
+void Schedule::clear()
+{
+    pointCount = 0;
+}
+
+bool Schedule::isRamp(size_t slot) const
+{
+    return table.rampBits[slot / 8] & (1 << (slot % 8));
+}
+
+void Schedule::setRamp(size_t slot, bool ramp)
+{
+    if (ramp)
+    {
+        table.rampBits[slot / 8] |= 1 << (slot % 8);
+    }
+    else
+    {
+        table.rampBits[slot / 8] &= ~(1 << (slot % 8));
+    }
+}
+
+bool Schedule::addPoint(uint16_t minuteOfWeek, float offset, bool ramp)
+{
+    if (minuteOfWeek >= SCHEDULE_MINUTES_PER_WEEK)
+    {
+        return false;
+    }
+
+    SchedulePoint point = {(uint16_t)(minuteOfWeek - minuteOfWeek % SCHEDULE_SLOT_MINUTES), toTenths(offset), ramp};
+
+    for (size_t i = 0; i < pointCount; i++)
+    {
+        if (points[i].minuteOfWeek == point.minuteOfWeek)
+        {
+            points[i] = point;
+            return true;
+        }
+    }
+
+    if (pointCount >= SCHEDULE_MAX_POINTS)
+    {
+        return false;
+    }
+    points[pointCount++] = point;
+    return true;
+}
+
+bool Schedule::addDailyPoint(uint8_t dayMask, uint16_t minuteOfDay, float offset, bool ramp)
+{
+    if (minuteOfDay >= SCHEDULE_MINUTES_PER_DAY)
+    {
+        return false;
+    }
+
+    bool ok = true;
+    for (int day = 0; day < 7; day++)
+    {
+        if (dayMask & (1 << day))
+        {
+            ok &= addPoint(day * SCHEDULE_MINUTES_PER_DAY + minuteOfDay, offset, ramp);
+        }
+    }
+    return ok;
+}
+
+ScheduleLineResult Schedule::parseRecord(CsvReader &reader)
+{
+    size_t firstLength;
+    const char *first = reader.getField(0, firstLength);
+    if (!first || firstLength == 0 || reader.getFieldCount() < 2)
+    {
+        return SCHEDULE_LINE_OTHER;
+    }
+
+    // Original format: Hour,Offset,Description - hour 1-24, applies every day
+    if (isdigit((unsigned char)*first))
+    {
+        long hour;
+        float offset;
+        if (!reader.getInt(0, hour) || !reader.getFloat(1, offset))
+        {
+            return SCHEDULE_LINE_INVALID;
+        }
+        if (hour < 0 || hour > 24)
+        {
+            reader.fail(0, "hour must be 0-24");
+            return SCHEDULE_LINE_INVALID;
+        }
+        // 24 = midnight, the start of the day
+        if (!addDailyPoint(ALL_DAYS, (uint16_t)((hour % 24) * 60), offset))
+        {
+            reader.fail(0, "too many schedule points");
+            return SCHEDULE_LINE_INVALID;
+        }
+        return SCHEDULE_LINE_ADDED;
+    }
+
+    // Week format: Days,HH:MM,Offset[,Description] - anything else is not a schedule line
+    uint8_t dayMask;
+    if (!parseDays(first, firstLength, &dayMask))
+    {
+        return SCHEDULE_LINE_OTHER;
+    }
+
+    size_t secondLength;
+    const char *second = reader.getField(1, secondLength);
+    bool ramp = secondLength > 0 && *second == '~';
+    if (ramp)
+    {
+        second++;
+        secondLength--;
+    }
+    uint16_t minuteOfDay;
+    if (!parseTime(second, secondLength, &minuteOfDay))
+    {
+        reader.fail(1, "expected a time as HH:MM or ~HH:MM");
+        return SCHEDULE_LINE_INVALID;
+    }
+
+    float offset;
+    if (!reader.getFloat(2, offset))
+    {
+        return SCHEDULE_LINE_INVALID;
+    }
+
+    if (!addDailyPoint(dayMask, minuteOfDay, offset, ramp))
+    {
+        reader.fail(0, "too many schedule points");
+        return SCHEDULE_LINE_INVALID;
+    }
+    return SCHEDULE_LINE_ADDED;
+}
+
+void Schedule::compile()
+{
+    const size_t slots = SCHEDULE_SLOTS_PER_WEEK;
+    memset(&table, 0, sizeof(table));
+    table.pointCount = (uint16_t)pointCount;
+
+    if (pointCount == 0)
+    {
+        int16_t fallback = toTenths(SCHEDULE_DEFAULT_OFFSET);
+        for (size_t slot = 0; slot < slots; slot++)
+        {
+            table.slotOffset[slot] = fallback;
+            table.nextChangeSlot[slot] = slot;
+        }
+        table.constant = true;
+        return;
+    }
+
+    // Insertion sort by time (at most a few hundred points, once per load)
+    for (size_t i = 1; i < pointCount; i++)
+    {
+        SchedulePoint point = points[i];
+        size_t j = i;
+        while (j > 0 && points[j - 1].minuteOfWeek > point.minuteOfWeek)
+        {
+            points[j] = points[j - 1];
+            j--;
+        }
+        points[j] = point;
+    }
+
+    // Fill from each point up to the next one, wrapping at the end of the week
+    for (size_t i = 0; i < pointCount; i++)
+    {
+        const SchedulePoint &from = points[i];
+        const SchedulePoint &to = points[(i + 1) % pointCount];
+        size_t startSlot = from.minuteOfWeek / SCHEDULE_SLOT_MINUTES;
+        size_t endSlot = to.minuteOfWeek / SCHEDULE_SLOT_MINUTES;
+        size_t span = (endSlot + slots - startSlot) % slots;
+        if (span == 0)
+        {
+            span = slots; // Single point: it covers the whole week
+        }
+
+        for (size_t k = 0; k < span; k++)
+        {
+            size_t slot = (startSlot + k) % slots;
+            if (to.ramp && span < slots)
+            {
+                int32_t rise = to.offsetTenths - from.offsetTenths;
+                table.slotOffset[slot] = (int16_t)(from.offsetTenths + rise * (int32_t)k / (int32_t)span);
+                setRamp(slot, true);
+            }
+            else
+            {
+                table.slotOffset[slot] = from.offsetTenths;
+            }
+        }
+    }
+
+    // Next change per slot: walk backwards twice round the week so the wrap is covered
+    table.constant = true;
+    for (size_t slot = 0; slot < slots; slot++)
+    {
+        if (table.slotOffset[slot] != table.slotOffset[0] || isRamp(slot))
+        {
+            table.constant = false;
+            break;
+        }
+    }
+    if (table.constant)
+    {
+        for (size_t slot = 0; slot < slots; slot++)
+        {
+            table.nextChangeSlot[slot] = slot;
+        }
+        return;
+    }
+
+    for (size_t n = 2 * slots; n-- > 0;)
+    {
+        size_t slot = n % slots;
+        size_t next = (slot + 1) % slots;
+        bool changes = table.slotOffset[next] != table.slotOffset[slot] || isRamp(next);
+        table.nextChangeSlot[slot] = changes ? next : table.nextChangeSlot[next];
+    }
+}
+
+float Schedule::getOffset(uint16_t minuteOfWeek) const
+{
+    minuteOfWeek %= SCHEDULE_MINUTES_PER_WEEK;
+    size_t slot = minuteOfWeek / SCHEDULE_SLOT_MINUTES;
+    float tenths = table.slotOffset[slot];
+
+    if (isRamp(slot))
+    {
+        int16_t nextTenths = table.slotOffset[(slot + 1) % SCHEDULE_SLOTS_PER_WEEK];
+        tenths += (nextTenths - table.slotOffset[slot]) * (float)(minuteOfWeek % SCHEDULE_SLOT_MINUTES) / SCHEDULE_SLOT_MINUTES;
+    }
+    return tenths / 10.0f;
+}
+
+uint16_t Schedule::getMinutesUntilChange(uint16_t minuteOfWeek) const
+{
+    if (table.constant)
+    {
+        return SCHEDULE_MINUTES_PER_WEEK;
+    }
+
+    minuteOfWeek %= SCHEDULE_MINUTES_PER_WEEK;
+    size_t slot = minuteOfWeek / SCHEDULE_SLOT_MINUTES;
+    if (isRamp(slot))
+    {
+        return 1;
+    }
+
+    uint16_t changeMinute = table.nextChangeSlot[slot] * SCHEDULE_SLOT_MINUTES;
+    uint16_t minutes = (changeMinute + SCHEDULE_MINUTES_PER_WEEK - minuteOfWeek) % SCHEDULE_MINUTES_PER_WEEK;
+    return minutes ? minutes : SCHEDULE_MINUTES_PER_WEEK;
+}
+
+size_t Schedule::getPointCount() const
+{
+    return table.pointCount;
+}
+
+const ScheduleTable &Schedule::getTable() const
+{
+    return table;
+}
+
+ScheduleTable &Schedule::editTable()
+{
+    return table;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file schedule.hpp
+ * @brief Compiled week schedule of temperature offsets in 15-minute slots
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Plain C++ with no Arduino dependencies (builds in tools/sim/).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Schedule layout
+#define SCHEDULE_SLOT_MINUTES 15
+#define SCHEDULE_MINUTES_PER_DAY 1440
+#define SCHEDULE_MINUTES_PER_WEEK 10080
+#define SCHEDULE_SLOTS_PER_DAY (SCHEDULE_MINUTES_PER_DAY / SCHEDULE_SLOT_MINUTES)
+#define SCHEDULE_SLOTS_PER_WEEK (SCHEDULE_MINUTES_PER_WEEK / SCHEDULE_SLOT_MINUTES) // 672
+#define SCHEDULE_MAX_POINTS 336                                                       // Two per hour of the week
+#define SCHEDULE_DEFAULT_OFFSET -5.0f                                                 // Used when no points are loaded
+
+class CsvReader;
+
+/**
+ * @enum ScheduleLineResult
+ * @brief Outcome of parsing one temps.csv record
+ */
+enum ScheduleLineResult
+{
+    SCHEDULE_LINE_ADDED,   // Schedule point(s) added
+    SCHEDULE_LINE_OTHER,   // Not a schedule line (e.g. BaseTemperature) - for the caller to handle
+    SCHEDULE_LINE_INVALID  // Schedule line with a bad field - error recorded in the reader
+};
+
+/**
+ * @struct SchedulePoint
+ * @brief One schedule entry: from this time on the offset is this value
+ */
+struct SchedulePoint
+{
+    uint16_t minuteOfWeek; // 0 = Sunday 00:00, rounded down to a slot boundary
+    int16_t offsetTenths;  // Offset from the base temperature in 0.1°F
+    bool ramp;             // Ramp linearly from the previous point instead of stepping
+};
+
+/**
+ * @struct ScheduleTable
+ * @brief Compiled schedule, one entry per slot - plain data so it can be cached as a blob
+ */
+struct ScheduleTable
+{
+    int16_t slotOffset[SCHEDULE_SLOTS_PER_WEEK];      // Offset at slot start (0.1°F)
+    uint16_t nextChangeSlot[SCHEDULE_SLOTS_PER_WEEK]; // First later slot whose start differs or that ramps
+    uint8_t rampBits[(SCHEDULE_SLOTS_PER_WEEK + 7) / 8];
+    uint8_t constant;                                 // Same offset all week
+    uint8_t reserved;
+    uint16_t pointCount;                              // Points it was compiled from
+};
+
+/**
+ * @class Schedule
+ * @brief Week of temperature offsets, compiled to a table for O(1) lookup
+ *
+ * Points are collected with addPoint()/parseRecord() and then compile()d into
+ * one entry per 15-minute slot (Sunday 00:00 first). Each slot stores its
+ * starting offset, whether it ramps towards the next slot, and the next slot
+ * where the offset changes. That makes getOffset() and getMinutesUntilChange()
+ * O(1), so callers can sleep until the setpoint actually moves.
+ *
+ * A point holds until the next one, wrapping from Saturday night to Sunday
+ * morning. A ramp point reaches its value at its own time, starting from the
+ * previous point's value at the previous point's time.
+ */
+class Schedule
+{
+private:
+    // Points collected since the last clear(), in file order
+    SchedulePoint points[SCHEDULE_MAX_POINTS];
+    size_t pointCount;
+
+    ScheduleTable table;
+
+    bool isRamp(size_t slot) const;
+    void setRamp(size_t slot, bool ramp);
+
+public:
+    /**
+     * @brief Constructor - a flat SCHEDULE_DEFAULT_OFFSET schedule
+     */
+    Schedule();
+
+    /**
+     * @brief Remove all points (the table keeps its last compiled contents)
+     */
+    void clear();
+
+    /**
+     * @brief Add a point; a later point at the same slot replaces an earlier one
+     * @param minuteOfWeek Minute of the week (0 = Sunday 00:00)
+     * @param offset Offset from the base temperature (°F)
+     * @param ramp true to ramp from the previous point instead of stepping
+     * @return false if the time is out of range or the schedule is full
+     */
+    bool addPoint(uint16_t minuteOfWeek, float offset, bool ramp = false);
+
+    /**
+     * @brief Add a point, or one per selected day, to every selected day
+     * @param dayMask Bit 0 = Sunday ... bit 6 = Saturday
+     * @param minuteOfDay Minute of the day (0-1439)
+     * @param offset Offset from the base temperature (°F)
+     * @param ramp true to ramp from the previous point
+     * @return false if any point was rejected
+     */
+    bool addDailyPoint(uint8_t dayMask, uint16_t minuteOfDay, float offset, bool ramp = false);
+
+    /**
+     * @brief Parse the reader's current record as a schedule line
+     * Accepts the original "Hour,Offset,Description" (1-24, 24 = midnight, every
+     * day) and "Days,HH:MM,Offset,Description", where Days is Sun..Sat, Daily,
+     * Weekdays or Weekends, and "~HH:MM" ramps into the point.
+     * @param reader Reader positioned on a record; errors are recorded in it
+     * @return Whether the record was added, was not a schedule line, or was invalid
+     */
+    ScheduleLineResult parseRecord(CsvReader &reader);
+
+    /**
+     * @brief Build the slot table from the collected points
+     * With no points the schedule is flat at SCHEDULE_DEFAULT_OFFSET.
+     */
+    void compile();
+
+    /**
+     * @brief Get the scheduled offset (O(1))
+     * @param minuteOfWeek Minute of the week (0 = Sunday 00:00)
+     * @return Offset from the base temperature (°F)
+     */
+    float getOffset(uint16_t minuteOfWeek) const;
+
+    /**
+     * @brief Minutes until the offset next changes (O(1))
+     * Inside a ramp the offset changes every minute, so this is 1.
+     * @param minuteOfWeek Minute of the week (0 = Sunday 00:00)
+     * @return Minutes, SCHEDULE_MINUTES_PER_WEEK if the schedule is flat
+     */
+    uint16_t getMinutesUntilChange(uint16_t minuteOfWeek) const;
+
+    /**
+     * @brief Number of points compiled into the table
+     * @return Point count
+     */
+    size_t getPointCount() const;
+
+    /**
+     * @brief Compiled table, e.g. to cache it
+     * @return Table
+     */
+    const ScheduleTable &getTable() const;
+
+    /**
+     * @brief Writable compiled table, for loading it straight from a cache
+     * The schedule is only valid again once the table is completely written
+     * (or compile() has run).
+     * @return Table
+     */
+    ScheduleTable &editTable();
+};
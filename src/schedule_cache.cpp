@@ -0,0 +1,86 @@
+/**
+ * @file schedule_cache.cpp
+ * @brief NVS schedule cache implementation
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "schedule_cache.hpp"
+
+static const char *HEADER_KEY = "header";
+static const char *TABLE_KEY = "table";
+
+uint32_t ScheduleCache::crc32(uint32_t crc, const void *data, size_t length)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+bool ScheduleCache::fingerprint(File &file, uint32_t &size, uint32_t &crc)
+{
+    uint8_t buffer[128];
+    size = 0;
+    crc = 0;
+
+    file.seek(0);
+    while (file.available())
+    {
+        size_t count = file.read(buffer, sizeof(buffer));
+        if (count == 0)
+        {
+            return false;
+        }
+        crc = crc32(crc, buffer, count);
+        size += count;
+    }
+    file.seek(0);
+    return size == file.size();
+}
+
+bool ScheduleCache::load(uint32_t csvSize, uint32_t csvCrc, ScheduleCacheHeader &header, ScheduleTable &table)
+{
+    Preferences preferences;
+    if (!preferences.begin(SCHEDULE_CACHE_NAMESPACE, true))
+    {
+        return false; // Namespace doesn't exist yet - first boot
+    }
+
+    bool hit = preferences.getBytes(HEADER_KEY, &header, sizeof(header)) == sizeof(header) &&
+               header.magic == SCHEDULE_CACHE_MAGIC && header.version == SCHEDULE_CACHE_VERSION &&
+               header.tableSize == sizeof(ScheduleTable) && header.csvSize == csvSize && header.csvCrc == csvCrc &&
+               preferences.getBytes(TABLE_KEY, &table, sizeof(table)) == sizeof(table) &&
+               crc32(0, &table, sizeof(table)) == header.tableCrc;
+
+    preferences.end();
+    return hit;
+}
+
+bool ScheduleCache::store(ScheduleCacheHeader &header, const ScheduleTable &table)
+{
+    header.magic = SCHEDULE_CACHE_MAGIC;
+    header.version = SCHEDULE_CACHE_VERSION;
+    header.tableSize = sizeof(ScheduleTable);
+    header.tableCrc = crc32(0, &table, sizeof(table));
+
+    Preferences preferences;
+    if (!preferences.begin(SCHEDULE_CACHE_NAMESPACE, false))
+    {
+        return false;
+    }
+
+    // Table first: a reset in between leaves the old header, which no longer matches the table CRC
+    bool ok = preferences.putBytes(TABLE_KEY, &table, sizeof(table)) == sizeof(table) &&
+              preferences.putBytes(HEADER_KEY, &header, sizeof(header)) == sizeof(header);
+
+    preferences.end();
+    return ok;
+}
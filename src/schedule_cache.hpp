@@ -0,0 +1,88 @@
+/**
+ * @file schedule_cache.hpp
+ * @brief NVS cache of the compiled temps.csv schedule
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include <Preferences.h>
+#include "schedule.hpp"
+
+// Configuration
+#define SCHEDULE_CACHE_NAMESPACE "schedule"
+#define SCHEDULE_CACHE_MAGIC 0x53434844 // "SCHD"
+#define SCHEDULE_CACHE_VERSION 2        // Bump when ScheduleTable or the parser's meaning changes
+
+/**
+ * @struct ScheduleCacheHeader
+ * @brief Identifies the CSV a cached table was compiled from
+ */
+struct ScheduleCacheHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t tableSize;       // sizeof(ScheduleTable) when written
+    uint32_t csvSize;         // temps.csv size in bytes
+    uint32_t csvCrc;          // CRC-32 of temps.csv
+    float baseTemperature;    // BaseTemperature line, if present
+    uint8_t baseTemperatureSet;
+    uint8_t reserved[3];
+    uint32_t parseMicros;     // How long the CSV parse took - reported on cache hits
+    uint32_t tableCrc;        // CRC-32 of the ScheduleTable blob
+};
+
+/**
+ * @class ScheduleCache
+ * @brief Stores the compiled schedule in NVS so boot can skip the CSV parse
+ *
+ * The header and the table are two NVS blobs. A cached table is used only if
+ * the header matches this firmware's version and the current temps.csv size
+ * and CRC, and the table itself passes its CRC. Checking the CSV still means
+ * reading it, but only as raw bytes into a small buffer - no String or
+ * per-field parsing.
+ */
+class ScheduleCache
+{
+public:
+    /**
+     * @brief CRC-32 (IEEE), incremental
+     * @param crc 0 to start, or the previous result to continue
+     * @param data Bytes to add
+     * @param length Number of bytes
+     * @return Updated CRC
+     */
+    static uint32_t crc32(uint32_t crc, const void *data, size_t length);
+
+    /**
+     * @brief Size and CRC-32 of a file, read in small chunks
+     * @param file Open file, read from the start (rewound afterwards)
+     * @param size Receives the size in bytes
+     * @param crc Receives the CRC-32
+     * @return true if the whole file was read
+     */
+    static bool fingerprint(File &file, uint32_t &size, uint32_t &crc);
+
+    /**
+     * @brief Load a cached table if it was compiled from this CSV
+     * On failure the table may be partially overwritten - compile it again.
+     * @param csvSize Current temps.csv size
+     * @param csvCrc Current temps.csv CRC-32
+     * @param header Receives the cached header
+     * @param table Receives the cached table
+     * @return true on a valid cache hit
+     */
+    bool load(uint32_t csvSize, uint32_t csvCrc, ScheduleCacheHeader &header, ScheduleTable &table);
+
+    /**
+     * @brief Store a freshly compiled table
+     * Fills in magic, version, table size and table CRC.
+     * @param header CSV fingerprint, base temperature and parse time
+     * @param table Compiled table
+     * @return true if both blobs were written
+     */
+    bool store(ScheduleCacheHeader &header, const ScheduleTable &table);
+};
@@ -21,6 +21,11 @@
 // Note: Both transmitter and receiver should use the same AppEUI and AppKey
 // when they belong to the same LoRaWAN application
 
+// Location for the outdoor forecast used by the MPC control mode (Open-Meteo, no account needed)
+// Leave undefined to run MPC from the learned room model alone
+// #define FORECAST_LATITUDE 47.61
+// #define FORECAST_LONGITUDE -122.33
+
 // You can add other sensitive configuration here as needed
 // For example:
 // #define API_KEY "your_api_key_here"
@@ -0,0 +1,263 @@
+/**
+ * @file sensor_array.cpp
+ * @brief MCP9808 sensor array implementation
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "sensor_array.hpp"
+
+// Global instance for easy access
+SensorArray sensorArray;
+
+SensorArray::SensorArray() : sensorCount(0), isAwake(false), lastFused(NAN),
+                             resolution(MCP9808_Resolution::RES_0_0625C), readsSinceReport(0)
+{
+    for (size_t i = 0; i < SENSOR_FUSION_MAX_SENSORS; i++)
+    {
+        sensors[i] = nullptr;
+    }
+}
+
+SensorArray::~SensorArray()
+{
+    for (size_t i = 0; i < sensorCount; i++)
+    {
+        delete sensors[i];
+    }
+}
+
+bool SensorArray::setup()
+{
+    // Initialize I2C if not already done
+    Wire.begin();
+
+    // Set up once; the sensors persist for the life of the program
+    if (sensorCount > 0)
+    {
+        return true;
+    }
+
+    Serial.println("Scanning I2C bus for MCP9808 sensors (0x18-0x1F)");
+    for (uint8_t address = SENSOR_ARRAY_FIRST_ADDRESS; address <= SENSOR_ARRAY_LAST_ADDRESS; address++)
+    {
+        // Quick probe first, so empty addresses don't log a full setup failure
+        Wire.beginTransmission(address);
+        if (Wire.endTransmission() != 0)
+        {
+            continue;
+        }
+
+        TemperatureSensor *sensor = new TemperatureSensor(address, resolution);
+        if (!sensor->setup())
+        {
+            delete sensor; // Something else answers at this address
+            continue;
+        }
+
+        fusion.setWeight(sensorCount, SENSOR_ARRAY_WEIGHTS[address - SENSOR_ARRAY_FIRST_ADDRESS]);
+        sensors[sensorCount++] = sensor;
+    }
+
+    fusion.reset(sensorCount);
+    isAwake = sensorCount > 0;
+
+    if (sensorCount == 0)
+    {
+        Serial.println("No MCP9808 temperature sensor found! Check connections.");
+        return false;
+    }
+
+    Serial.printf("Found %u MCP9808 sensor(s)\n", (unsigned)sensorCount);
+    return true;
+}
+
+float SensorArray::readTemperatureFahrenheit()
+{
+    startConversion();
+    delay(getMsUntilReady());
+
+    float temperature = NAN;
+    pollTemperatureFahrenheit(temperature);
+    return temperature;
+}
+
+void SensorArray::startConversion()
+{
+    for (size_t i = 0; i < sensorCount; i++)
+    {
+        sensors[i]->startConversion();
+    }
+    isAwake = sensorCount > 0;
+}
+
+unsigned long SensorArray::getMsUntilReady() const
+{
+    unsigned long longest = 0;
+    for (size_t i = 0; i < sensorCount; i++)
+    {
+        longest = max(longest, sensors[i]->getMsUntilReady());
+    }
+    return longest;
+}
+
+bool SensorArray::pollTemperatureFahrenheit(float &temperature)
+{
+    if (sensorCount == 0)
+    {
+        temperature = NAN;
+        return true;
+    }
+    for (size_t i = 0; i < sensorCount; i++)
+    {
+        if (!sensors[i]->isConversionReady())
+        {
+            return false;
+        }
+    }
+
+    // One burst: every sensor back to back, each with a completed conversion
+    float readings[SENSOR_FUSION_MAX_SENSORS];
+    for (size_t i = 0; i < sensorCount; i++)
+    {
+        float reading = NAN;
+        sensors[i]->pollTemperatureFahrenheit(reading);
+        readings[i] = isValidReading(reading) ? reading : NAN;
+    }
+
+    temperature = fuse(readings);
+    return true;
+}
+
+float SensorArray::getLastTemperatureFahrenheit() const
+{
+    return lastFused;
+}
+
+float SensorArray::fuse(const float *readings)
+{
+    size_t healthyBefore = fusion.getHealthyCount();
+    float fused;
+    size_t used = fusion.fuse(readings, fused);
+
+    if (fusion.getHealthyCount() != healthyBefore)
+    {
+        Serial.printf("Temperature sensors: %u of %u healthy\n", (unsigned)fusion.getHealthyCount(),
+                      (unsigned)sensorCount);
+        Serial.print(getStatistics());
+    }
+    if (sensorCount > 1 && used > 0)
+    {
+        Serial.printf("Fused %u of %u sensors: %.2f°F\n", (unsigned)used, (unsigned)sensorCount, fused);
+    }
+
+    if (used > 0)
+    {
+        lastFused = fused;
+    }
+    return fused;
+}
+
+void SensorArray::wakeUp()
+{
+    for (size_t i = 0; i < sensorCount; i++)
+    {
+        sensors[i]->wakeUp();
+    }
+    isAwake = true;
+}
+
+void SensorArray::shutdown()
+{
+    if (isAwake && sensorCount > 0)
+    {
+        // The sensors wake together
+        power.addRead(millis() - sensors[0]->getWokeAtMs(), sensors[0]->getResolution());
+
+        if (++readsSinceReport >= SENSOR_ARRAY_REPORT_READS)
+        {
+            Serial.printf("Temperature sensors: awake %.0f ms per read over %lu reads, %.0f%% less than at a fixed "
+                          "0.0625°C\n",
+                          getAwakeMsPerRead(), (unsigned long)power.getReads(), getAwakeSaving() * 100);
+            readsSinceReport = 0;
+        }
+    }
+
+    for (size_t i = 0; i < sensorCount; i++)
+    {
+        sensors[i]->shutdown();
+    }
+    isAwake = false;
+}
+
+void SensorArray::setResolutionForDistance(float distanceF)
+{
+    MCP9808_Resolution next = SensorPower::getResolutionForDistance(distanceF);
+    if (next == resolution)
+    {
+        return;
+    }
+    for (size_t i = 0; i < sensorCount; i++)
+    {
+        sensors[i]->setResolution(next);
+    }
+    resolution = next;
+    Serial.printf("Temperature sensors: resolution %s, %.1f°F from a switching point\n", getResolutionString(),
+                  distanceF);
+}
+
+float SensorArray::getAwakeMsPerRead() const
+{
+    return power.getAwakeMsPerRead();
+}
+
+float SensorArray::getAwakeSaving() const
+{
+    return power.getAwakeSaving();
+}
+
+bool SensorArray::getAwakeStatus() const
+{
+    return isAwake;
+}
+
+bool SensorArray::isValidReading(float temperature) const
+{
+    // Same range check as a single sensor
+    return sensorCount > 0 ? sensors[0]->isValidReading(temperature) : !isnan(temperature);
+}
+
+size_t SensorArray::getSensorCount() const
+{
+    return sensorCount;
+}
+
+uint8_t SensorArray::getI2CAddress(size_t index) const
+{
+    return index < sensorCount ? sensors[index]->getI2CAddress() : 0;
+}
+
+const SensorHealth &SensorArray::getHealth(size_t index) const
+{
+    return fusion.getHealth(index);
+}
+
+const char *SensorArray::getResolutionString() const
+{
+    return sensorCount > 0 ? sensors[0]->getResolutionString() : "No sensor";
+}
+
+String SensorArray::getStatistics() const
+{
+    String stats;
+    char line[128];
+    for (size_t i = 0; i < sensorCount; i++)
+    {
+        const SensorHealth &h = fusion.getHealth(i);
+        snprintf(line, sizeof(line), "  0x%02X: %s, %.2f°F (offset %+.2f°F), %lu reads, %lu failed, %lu rejected\n",
+                 sensors[i]->getI2CAddress(), h.healthy ? "healthy" : "DROPPED", h.lastValue, h.meanDeviation,
+                 (unsigned long)h.reads, (unsigned long)h.failures, (unsigned long)h.rejections);
+        stats += line;
+    }
+    return stats;
+}
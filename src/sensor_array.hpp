@@ -0,0 +1,182 @@
+/**
+ * @file sensor_array.hpp
+ * @brief Every MCP9808 on the I2C bus, read in one burst and fused
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include <M5Unified.h>
+#include <Wire.h>
+#include "temp_sensor.hpp"
+#include "sensor_fusion.hpp"
+#include "sensor_power.hpp"
+
+// MCP9808 address range (A0-A2 strapping)
+#define SENSOR_ARRAY_FIRST_ADDRESS 0x18
+#define SENSOR_ARRAY_LAST_ADDRESS 0x1F
+
+// Weight of each address in the fused temperature, 0x18 first (0 = monitor only)
+static const float SENSOR_ARRAY_WEIGHTS[SENSOR_FUSION_MAX_SENSORS] = {1, 1, 1, 1, 1, 1, 1, 1};
+
+// Awake-time report
+#define SENSOR_ARRAY_REPORT_READS 30 // Log awake time every 30 reads (an hour at the idle poll)
+
+/**
+ * @class SensorArray
+ * @brief Discovers the MCP9808 sensors on the bus and presents them as one sensor
+ *
+ * setup() probes 0x18-0x1F and sets up each sensor that answers. Every read
+ * takes all of them back to back and fuses the results (SensorFusion), so a
+ * sensor that fails or drifts is dropped without interrupting control.
+ * startConversion() and pollTemperatureFahrenheit() split a read so the
+ * caller never waits on a conversion; readTemperatureFahrenheit() blocks.
+ * setResolutionForDistance() trades precision for conversion time when the
+ * temperature is far from where the controller would switch.
+ * The power and validity calls match TemperatureSensor, so a single sensor
+ * is simply an array of one.
+ */
+class SensorArray
+{
+private:
+    TemperatureSensor *sensors[SENSOR_FUSION_MAX_SENSORS]; // Discovered sensors, in address order
+    size_t sensorCount;
+    SensorFusion fusion;
+    bool isAwake;
+    float lastFused; // Last fused reading (°F), NAN before the first
+    MCP9808_Resolution resolution;
+
+    SensorPower power; // Awake time since boot
+    uint16_t readsSinceReport;
+
+    float fuse(const float *readings);
+
+public:
+    /**
+     * @brief Constructor
+     */
+    SensorArray();
+
+    /**
+     * @brief Destructor
+     */
+    ~SensorArray();
+
+    /**
+     * @brief Probe 0x18-0x1F and set up every MCP9808 found
+     * @return true if at least one sensor was found
+     */
+    bool setup();
+
+    /**
+     * @brief Read every sensor in one burst and fuse the results
+     * Blocks until every sensor has completed a conversion (up to 260 ms after a wake).
+     * @return Fused temperature in Fahrenheit, NAN if no sensor gave a usable reading
+     */
+    float readTemperatureFahrenheit();
+
+    /**
+     * @brief Start a conversion on every sensor without waiting for it
+     */
+    void startConversion();
+
+    /**
+     * @brief Milliseconds until every sensor has completed a conversion
+     * @return 0 when ready
+     */
+    unsigned long getMsUntilReady() const;
+
+    /**
+     * @brief Read and fuse the results once every sensor has completed a conversion
+     * @param temperature Receives the fused °F, NAN if no sensor gave a usable reading
+     * @return true once a result was read, false while a sensor is still converting
+     */
+    bool pollTemperatureFahrenheit(float &temperature);
+
+    /**
+     * @brief Last fused reading, without touching the bus
+     * @return Temperature in Fahrenheit, NAN before the first reading
+     */
+    float getLastTemperatureFahrenheit() const;
+
+    /**
+     * @brief Wake every sensor from shutdown mode
+     */
+    void wakeUp();
+
+    /**
+     * @brief Put every sensor into shutdown mode for power saving
+     * Adds the time since the wake to the awake-time totals.
+     */
+    void shutdown();
+
+    /**
+     * @brief Pick the resolution for the next reading from the distance to a switching point
+     * The coarsest resolution whose step fits SENSOR_POWER_RESOLUTION_MARGIN
+     * times into the distance: 0.5°C (30 ms) far away, down to 0.0625°C
+     * (250 ms) close by. Call while the sensors are in shutdown.
+     * @param distanceF Distance from the nearest switching point (°F), NAN for full resolution
+     */
+    void setResolutionForDistance(float distanceF);
+
+    /**
+     * @brief Measured awake time per read since boot
+     * @return Milliseconds, 0 before the first read
+     */
+    float getAwakeMsPerRead() const;
+
+    /**
+     * @brief Awake time saved against a fixed 0.0625°C resolution
+     * @return Fraction (0-1)
+     */
+    float getAwakeSaving() const;
+
+    /**
+     * @brief Check if the sensors are awake
+     * @return true if awake, false if in shutdown
+     */
+    bool getAwakeStatus() const;
+
+    /**
+     * @brief Check if a reading is valid
+     * @param temperature Temperature reading to validate
+     * @return true if reading is within reasonable range
+     */
+    bool isValidReading(float temperature) const;
+
+    /**
+     * @brief Number of sensors found by setup()
+     * @return Sensor count
+     */
+    size_t getSensorCount() const;
+
+    /**
+     * @brief I2C address of a sensor
+     * @param index Sensor index (0 to getSensorCount() - 1)
+     * @return I2C address
+     */
+    uint8_t getI2CAddress(size_t index) const;
+
+    /**
+     * @brief Health statistics of a sensor
+     * @param index Sensor index (0 to getSensorCount() - 1)
+     * @return Health record
+     */
+    const SensorHealth &getHealth(size_t index) const;
+
+    /**
+     * @brief Get resolution as string for debugging
+     * @return Resolution description string
+     */
+    const char *getResolutionString() const;
+
+    /**
+     * @brief Get per-sensor health as a printable string
+     * @return Statistics string, one line per sensor
+     */
+    String getStatistics() const;
+};
+
+// Global instance for easy access
+extern SensorArray sensorArray;
@@ -0,0 +1,183 @@
+/**
+ * @file sensor_fusion.cpp
+ * @brief Temperature sensor fusion implementation
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include <math.h>
+#include <string.h>
+#include "sensor_fusion.hpp"
+
+SensorFusion::SensorFusion() : sensorCount(0)
+{
+    for (size_t i = 0; i < SENSOR_FUSION_MAX_SENSORS; i++)
+    {
+        weights[i] = 1.0f;
+    }
+    reset(0);
+}
+
+void SensorFusion::reset(size_t count)
+{
+    sensorCount = count > SENSOR_FUSION_MAX_SENSORS ? SENSOR_FUSION_MAX_SENSORS : count;
+    memset(health, 0, sizeof(health));
+    for (size_t i = 0; i < SENSOR_FUSION_MAX_SENSORS; i++)
+    {
+        health[i].lastValue = NAN;
+        health[i].healthy = true; // Innocent until proven otherwise
+    }
+}
+
+void SensorFusion::setWeight(size_t index, float weight)
+{
+    if (index < SENSOR_FUSION_MAX_SENSORS && weight >= 0)
+    {
+        weights[index] = weight;
+    }
+}
+
+void SensorFusion::recordBad(size_t index)
+{
+    SensorHealth &h = health[index];
+    h.consecutiveGood = 0;
+    if (h.consecutiveBad < 0xFFFF)
+    {
+        h.consecutiveBad++;
+    }
+    if (h.consecutiveBad >= SENSOR_FUSION_FAIL_LIMIT)
+    {
+        h.healthy = false;
+    }
+}
+
+size_t SensorFusion::fuse(const float *readings, float &fused)
+{
+    // Median of every valid reading - healthy or not, so a recovering sensor is judged fairly
+    float sorted[SENSOR_FUSION_MAX_SENSORS];
+    size_t validCount = 0;
+    for (size_t i = 0; i < sensorCount; i++)
+    {
+        if (!isnan(readings[i]))
+        {
+            // Insertion sort - at most 8 values
+            size_t j = validCount++;
+            while (j > 0 && sorted[j - 1] > readings[i])
+            {
+                sorted[j] = sorted[j - 1];
+                j--;
+            }
+            sorted[j] = readings[i];
+        }
+    }
+    float median = NAN;
+    if (validCount > 0)
+    {
+        median = (validCount % 2) ? sorted[validCount / 2]
+                                  : (sorted[validCount / 2 - 1] + sorted[validCount / 2]) / 2.0f;
+    }
+
+    // Classify each reading, then average the healthy ones
+    float weightedSum = 0;
+    float weightSum = 0;
+    size_t used = 0;
+    float fallbackSum = 0; // Accepted readings from sensors still on probation
+    size_t fallbackCount = 0;
+    bool accepted[SENSOR_FUSION_MAX_SENSORS];
+
+    for (size_t i = 0; i < sensorCount; i++)
+    {
+        SensorHealth &h = health[i];
+        h.reads++;
+        h.lastValue = readings[i];
+        accepted[i] = false;
+
+        if (isnan(readings[i]))
+        {
+            h.failures++;
+            recordBad(i);
+            continue;
+        }
+        if (validCount >= 3 && fabsf(readings[i] - median) > SENSOR_FUSION_OUTLIER_F)
+        {
+            h.rejections++;
+            recordBad(i);
+            continue;
+        }
+
+        accepted[i] = true;
+        h.consecutiveBad = 0;
+        if (h.consecutiveGood < 0xFFFF)
+        {
+            h.consecutiveGood++;
+        }
+        if (!h.healthy && h.consecutiveGood >= SENSOR_FUSION_RECOVERY_READS)
+        {
+            h.healthy = true;
+        }
+
+        if (h.healthy && weights[i] > 0)
+        {
+            weightedSum += weights[i] * readings[i];
+            weightSum += weights[i];
+            used++;
+        }
+        else
+        {
+            fallbackSum += readings[i];
+            fallbackCount++;
+        }
+    }
+
+    // No healthy sensor left: rather than stop control, use whatever read cleanly this time
+    if (weightSum > 0)
+    {
+        fused = weightedSum / weightSum;
+    }
+    else if (fallbackCount > 0)
+    {
+        fused = fallbackSum / fallbackCount;
+        used = fallbackCount;
+    }
+    else
+    {
+        fused = NAN;
+    }
+
+    // Track each sensor's offset from the consensus
+    if (!isnan(fused))
+    {
+        for (size_t i = 0; i < sensorCount; i++)
+        {
+            if (accepted[i])
+            {
+                health[i].meanDeviation += SENSOR_FUSION_DEVIATION_ALPHA * ((readings[i] - fused) - health[i].meanDeviation);
+            }
+        }
+    }
+
+    return used;
+}
+
+size_t SensorFusion::getSensorCount() const
+{
+    return sensorCount;
+}
+
+size_t SensorFusion::getHealthyCount() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < sensorCount; i++)
+    {
+        if (health[i].healthy)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+const SensorHealth &SensorFusion::getHealth(size_t index) const
+{
+    return health[index < SENSOR_FUSION_MAX_SENSORS ? index : 0];
+}
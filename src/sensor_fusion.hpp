@@ -0,0 +1,105 @@
+/**
+ * @file sensor_fusion.hpp
+ * @brief Weighted fusion of several temperature sensors with outlier rejection
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Plain C++ with no Arduino dependencies (builds on a PC).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Fusion configuration
+#define SENSOR_FUSION_MAX_SENSORS 8        // One per MCP9808 address (0x18-0x1F)
+#define SENSOR_FUSION_OUTLIER_F 1.5f       // Reject readings this far from the median (needs 3+ sensors)
+#define SENSOR_FUSION_FAIL_LIMIT 3         // Consecutive bad readings before a sensor is dropped
+#define SENSOR_FUSION_RECOVERY_READS 5     // Consecutive good readings before it is used again
+#define SENSOR_FUSION_DEVIATION_ALPHA 0.1f // EWMA weight of a sensor's offset from the fused value
+
+/**
+ * @struct SensorHealth
+ * @brief Running statistics for one sensor
+ */
+struct SensorHealth
+{
+    uint32_t reads;              // Readings attempted
+    uint32_t failures;           // No reading (I2C error, out of range)
+    uint32_t rejections;         // Read fine but rejected as an outlier
+    uint16_t consecutiveBad;     // Failures or rejections in a row
+    uint16_t consecutiveGood;    // Good readings in a row
+    float lastValue;             // Last reading (°F), NAN after a failure
+    float meanDeviation;         // EWMA of (reading - fused value), °F - a steady offset shows here
+    bool healthy;                // Used in the fused value
+};
+
+/**
+ * @class SensorFusion
+ * @brief Combines one burst of readings into a single temperature
+ *
+ * Each burst is fused as a weighted mean of the healthy sensors. With three
+ * or more readings, any reading further than SENSOR_FUSION_OUTLIER_F from
+ * their median is rejected first. Two sensors that disagree can't be told
+ * apart, so both are kept. A sensor is dropped after SENSOR_FUSION_FAIL_LIMIT
+ * bad readings in a row. It keeps being read, and rejoins after
+ * SENSOR_FUSION_RECOVERY_READS good readings that agree with the others.
+ * Control carries on as long as one healthy sensor remains. If none is left,
+ * any reading that passed this burst is used rather than none.
+ */
+class SensorFusion
+{
+private:
+    float weights[SENSOR_FUSION_MAX_SENSORS];
+    SensorHealth health[SENSOR_FUSION_MAX_SENSORS];
+    size_t sensorCount;
+
+    void recordBad(size_t index);
+
+public:
+    /**
+     * @brief Constructor - no sensors, all weights 1
+     */
+    SensorFusion();
+
+    /**
+     * @brief Set the number of sensors and clear their statistics
+     * @param count Sensor count (capped at SENSOR_FUSION_MAX_SENSORS)
+     */
+    void reset(size_t count);
+
+    /**
+     * @brief Set a sensor's weight in the fused value
+     * @param index Sensor index
+     * @param weight Relative weight (0 = monitor only)
+     */
+    void setWeight(size_t index, float weight);
+
+    /**
+     * @brief Fuse one burst of readings
+     * @param readings One reading per sensor (°F), NAN for a failed read
+     * @param fused Receives the fused temperature (°F), NAN if no sensor was usable
+     * @return Number of sensors that contributed
+     */
+    size_t fuse(const float *readings, float &fused);
+
+    /**
+     * @brief Number of sensors being fused
+     * @return Sensor count
+     */
+    size_t getSensorCount() const;
+
+    /**
+     * @brief Number of sensors currently used in the fused value
+     * @return Healthy sensor count
+     */
+    size_t getHealthyCount() const;
+
+    /**
+     * @brief Statistics for one sensor
+     * @param index Sensor index
+     * @return Health record
+     */
+    const SensorHealth &getHealth(size_t index) const;
+};
@@ -0,0 +1,56 @@
+/**
+ * @file sensor_power.cpp
+ * @brief MCP9808 timing and awake-time accounting implementation
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "sensor_power.hpp"
+
+SensorPower::SensorPower() : awakeMs(0), fullResolutionAwakeMs(0), reads(0)
+{
+}
+
+unsigned long SensorPower::getConversionTimeMs(MCP9808_Resolution res)
+{
+    // Datasheet tCONV per resolution
+    static const unsigned long CONVERSION_MS[] = {30, 65, 130, 250};
+    return CONVERSION_MS[static_cast<uint8_t>(res) & 3] + SENSOR_POWER_CONVERSION_MARGIN_MS;
+}
+
+MCP9808_Resolution SensorPower::getResolutionForDistance(float distanceF)
+{
+    // Resolution steps in °F, coarsest first (0.5, 0.25, 0.125°C)
+    static const float STEP_F[] = {0.9f, 0.45f, 0.225f};
+    for (uint8_t r = 0; r < 3; r++)
+    {
+        if (distanceF >= STEP_F[r] * SENSOR_POWER_RESOLUTION_MARGIN)
+        {
+            return static_cast<MCP9808_Resolution>(r);
+        }
+    }
+    return MCP9808_Resolution::RES_0_0625C;
+}
+
+void SensorPower::addRead(unsigned long readAwakeMs, MCP9808_Resolution res)
+{
+    awakeMs += readAwakeMs;
+    fullResolutionAwakeMs += readAwakeMs + getConversionTimeMs(MCP9808_Resolution::RES_0_0625C) -
+                             getConversionTimeMs(res);
+    reads++;
+}
+
+uint32_t SensorPower::getReads() const
+{
+    return reads;
+}
+
+float SensorPower::getAwakeMsPerRead() const
+{
+    return reads ? (float)awakeMs / reads : 0.0f;
+}
+
+float SensorPower::getAwakeSaving() const
+{
+    return fullResolutionAwakeMs ? 1.0f - (float)awakeMs / fullResolutionAwakeMs : 0.0f;
+}
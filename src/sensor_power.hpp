@@ -0,0 +1,93 @@
+/**
+ * @file sensor_power.hpp
+ * @brief MCP9808 conversion times, resolution choice and awake-time accounting
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Plain C++ with no Arduino dependencies (builds on a PC).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Conversion timing and adaptive resolution
+#define SENSOR_POWER_CONVERSION_MARGIN_MS 10  // Slack on top of the datasheet conversion time before a result is read
+#define SENSOR_POWER_RESOLUTION_MARGIN 4.0f   // Use a resolution only this many steps from a switching point
+
+/**
+ * @enum MCP9808_Resolution
+ * @brief Resolution modes for MCP9808 temperature sensor
+ */
+enum class MCP9808_Resolution : uint8_t
+{
+    RES_0_5C = 0,   // 0.5°C resolution, 30 ms sample time
+    RES_0_25C = 1,  // 0.25°C resolution, 65 ms sample time
+    RES_0_125C = 2, // 0.125°C resolution, 130 ms sample time
+    RES_0_0625C = 3 // 0.0625°C resolution, 250 ms sample time
+};
+
+/**
+ * @class SensorPower
+ * @brief How long the MCP9808s stay awake per read, and how much a coarser resolution saves
+ *
+ * The static helpers hold the datasheet timing and the distance rule that
+ * SensorArray uses. An instance keeps the awake-time totals since boot, next
+ * to what the same reads would have cost at a fixed 0.0625°C: those would
+ * have stayed awake for the full 0.0625°C conversion instead of the one used.
+ */
+class SensorPower
+{
+private:
+    uint32_t awakeMs;
+    uint32_t fullResolutionAwakeMs;
+    uint32_t reads;
+
+public:
+    /**
+     * @brief Constructor
+     */
+    SensorPower();
+
+    /**
+     * @brief Conversion time at a resolution, with margin
+     * @param res Resolution
+     * @return Milliseconds
+     */
+    static unsigned long getConversionTimeMs(MCP9808_Resolution res);
+
+    /**
+     * @brief Resolution for a reading at some distance from a switching point
+     * The coarsest resolution whose step fits SENSOR_POWER_RESOLUTION_MARGIN
+     * times into the distance: 0.5°C (30 ms) far away, down to 0.0625°C
+     * (250 ms) close by.
+     * @param distanceF Distance from the nearest switching point (°F), NAN for full resolution
+     * @return Resolution
+     */
+    static MCP9808_Resolution getResolutionForDistance(float distanceF);
+
+    /**
+     * @brief Account for one read
+     * @param readAwakeMs Time from wake to shutdown (ms)
+     * @param res Resolution the read was taken at
+     */
+    void addRead(unsigned long readAwakeMs, MCP9808_Resolution res);
+
+    /**
+     * @brief Number of reads accounted for
+     * @return Read count
+     */
+    uint32_t getReads() const;
+
+    /**
+     * @brief Measured awake time per read
+     * @return Milliseconds, 0 before the first read
+     */
+    float getAwakeMsPerRead() const;
+
+    /**
+     * @brief Awake time saved against a fixed 0.0625°C resolution
+     * @return Fraction (0-1), 0 before the first read
+     */
+    float getAwakeSaving() const;
+};
@@ -17,6 +17,7 @@
 #include <FS.h>
 #include <SPIFFS.h>
 #include "stove.hpp"
+#include "csv_reader.hpp"
 #include "lora_transmitter.hpp"
 #include "../shared/protocol_common.hpp"
 
@@ -26,8 +27,11 @@ Stove stove;
 // External reference to global RTC instance from main
 extern RTC rtc;
 
+// Runtime statistics survive resets other than power-on here; NVS covers the rest
+RTC_NOINIT_ATTR static RuntimeStatsData retainedRuntime;
+
 // Safety maximum temperature
-const float Stove::SAFETY_MAX_TEMP = 82.0;
+const float Stove::SAFETY_MAX_TEMP = STOVE_SAFETY_MAX_TEMP;
 
 Stove::Stove(LoRaTransmitter *transmitter, float baseTemp) : loraTransmitter(transmitter),
                                                              currentState(STOVE_OFF),
@@ -35,42 +39,42 @@ Stove::Stove(LoRaTransmitter *transmitter, float baseTemp) : loraTransmitter(tra
                                                              lastStateChange(0),
                                                              lastStatusUpdate(0),
                                                              minChangeInterval(180000), // 3 minutes delay between state changes
+                                                             logic(minChangeInterval),
+                                                             preheating(false),
+                                                             controlTarget(0),
+                                                             lastModelSamples(0),
+                                                             heaterFaultReportDue(false),
+                                                             lastTraceMs(0),
+                                                             lastTraceDecision(false),
+                                                             mpcWorstMicros(0),
+                                                             mpcSolvesSinceReport(0),
+                                                             mpcLastPlanOn(false),
                                                              enabled(true),
                                                              manualOverride(false),
                                                              loraControlEnabled(false),
+                                                             reconfirmRequested(false),
                                                              lastLoRaResponse(""),
-                                                             statusDisplayText("LoRa: Not connected")
+                                                             statusDisplayText("LoRa: Not connected"),
+                                                             schedule(&scheduleBuffers[0]),
+                                                             configSize(0),
+                                                             configCrc(0),
+                                                             configWriteTime(0),
+                                                             lastConfigCheck(0),
+                                                             clockMinuteOfWeek(0),
+                                                             currentSetpoint(0),
+                                                             setpointMinuteOfWeek(0),
+                                                             setpointMinutesLeft(0),
+                                                             displayedSetpoint(NAN),
+                                                             displayedTemperature(NAN),
+                                                             localStatusText(""),
+                                                             runtimeStats(retainedRuntime),
+                                                             hoursSinceRuntimeSave(0),
+                                                             runtimeReportDue(false)
 {
-    // Initialize timeOffset array with default values as fallback
-    timeOffset[0] = 0.0; // Index 0 - unused
-    for (int i = 1; i <= 24; i++)
-    {
-        timeOffset[i] = -5.0; // Default fallback offset
-    }
-
-    // Try to load configuration from CSV file
-    bool csvLoaded = loadConfigFromCSV();
-
-    // Set base temperature
-    if (baseTemp >= 0)
-    {
-        // Use provided temperature
-        baseTemperature = baseTemp;
-    }
-    else if (csvLoaded)
-    {
-        // baseTemperature was set by loadConfigFromCSV
-        // No action needed
-    }
-    else
-    {
-        // Fallback default
-        baseTemperature = 68.0;
-    }
-
-    // Store initial value for reset functionality
+    // Schedule starts flat at SCHEDULE_DEFAULT_OFFSET; temps.csv is loaded in setup()
+    baseTemperatureOverride = (baseTemp >= 0);
+    baseTemperature = baseTemperatureOverride ? baseTemp : 68.0;
     initialBaseTemperature = baseTemperature;
-    Serial.printf("Initial base temperature stored: %.1f°F\n", initialBaseTemperature);
 }
 
 Stove::~Stove()
@@ -78,104 +82,327 @@ Stove::~Stove()
     // LoRa transmitter cleanup will be handled by its own destructor
 }
 
-bool Stove::loadConfigFromCSV()
+// Open temps.csv from SPIFFS (internal flash); an invalid File if missing
+static File openConfigFile()
 {
-    // Try to open the temps.csv file from SPIFFS (internal flash)
-    File file;
-
-    // Initialize SPIFFS
     if (!SPIFFS.begin())
     {
         Serial.println("Warning: Failed to mount SPIFFS filesystem");
-        return false;
+        return File();
     }
 
-    // Try to open from SPIFFS
-    file = SPIFFS.open("/temps.csv", "r");
+    File file = SPIFFS.open("/temps.csv", "r");
     if (!file)
     {
         // Try without leading slash
         file = SPIFFS.open("temps.csv", "r");
     }
+    return file;
+}
 
+bool Stove::loadConfigFromCSV()
+{
+    File file = openConfigFile();
     if (!file)
     {
         Serial.println("Warning: Could not open temps.csv from SPIFFS, using default values");
         return false;
     }
 
+    unsigned long startMicros = micros();
+    time_t writeTime = file.getLastWrite();
+    uint32_t csvSize = 0;
+    uint32_t csvCrc = 0;
+    bool fingerprinted = ScheduleCache::fingerprint(file, csvSize, csvCrc);
+    if (fingerprinted)
+    {
+        configSize = csvSize;
+        configCrc = csvCrc;
+        configWriteTime = writeTime;
+    }
+
+    // Unchanged CSV: one NVS read instead of a parse
+    ScheduleCacheHeader header;
+    if (fingerprinted && scheduleCache.load(csvSize, csvCrc, header, schedule->editTable()))
+    {
+        file.close();
+        unsigned long loadMicros = micros() - startMicros;
+        if (header.baseTemperatureSet)
+        {
+            baseTemperature = header.baseTemperature;
+        }
+        Serial.printf("Schedule loaded from NVS cache in %lu us (CSV parse took %lu us, saved %lu us)\n",
+                      loadMicros, (unsigned long)header.parseMicros,
+                      header.parseMicros > loadMicros ? header.parseMicros - loadMicros : 0UL);
+        return header.baseTemperatureSet;
+    }
+
     Serial.println("Loading configuration from temps.csv");
 
-    String line;
+    // Nothing is running yet, so parse straight into the active schedule; bad lines are skipped
+    float csvBaseTemperature = baseTemperature;
+    bool baseTemperatureSet = false;
+    uint32_t errors = parseConfigCSV(file, *schedule, csvBaseTemperature, baseTemperatureSet);
+    file.close();
+    if (errors > 0)
+    {
+        Serial.printf("Warning: Skipped %lu bad line(s) in temps.csv\n", (unsigned long)errors);
+    }
+
+    schedule->compile();
+    unsigned long parseMicros = micros() - startMicros;
+    Serial.printf("Compiled %u schedule points into %d 15-minute slots in %lu us\n",
+                  (unsigned)schedule->getPointCount(), SCHEDULE_SLOTS_PER_WEEK, parseMicros);
+
+    if (fingerprinted)
+    {
+        cacheSchedule(csvSize, csvCrc, csvBaseTemperature, baseTemperatureSet, parseMicros);
+    }
+
+    if (!baseTemperatureSet)
+    {
+        Serial.println("Warning: Base temperature not found in CSV, using default 68.0°F");
+        baseTemperature = 68.0;
+        return false;
+    }
+
+    baseTemperature = csvBaseTemperature;
+    Serial.println("Successfully loaded temperature configuration from temps.csv");
+    return true;
+}
+
+bool Stove::reloadConfigIfChanged()
+{
+    if (millis() - lastConfigCheck < STOVE_CONFIG_CHECK_INTERVAL_MS)
+    {
+        return false;
+    }
+    lastConfigCheck = millis();
+
+    File file = openConfigFile();
+    if (!file)
+    {
+        return false;
+    }
+
+    // Cheap check first: size and last-write time, when the filesystem records one
+    time_t writeTime = file.getLastWrite();
+    if (writeTime != 0 && writeTime == configWriteTime && file.size() == configSize)
+    {
+        file.close();
+        return false;
+    }
+
+    unsigned long startMicros = micros();
+    uint32_t csvSize = 0;
+    uint32_t csvCrc = 0;
+    if (!ScheduleCache::fingerprint(file, csvSize, csvCrc) || (csvSize == configSize && csvCrc == configCrc))
+    {
+        configWriteTime = writeTime;
+        file.close();
+        return false;
+    }
+
+    // Compile into the spare buffer; the active schedule stays in use throughout
+    Schedule *spare = (schedule == &scheduleBuffers[0]) ? &scheduleBuffers[1] : &scheduleBuffers[0];
+    float csvBaseTemperature = initialBaseTemperature;
     bool baseTemperatureSet = false;
+    uint32_t errors = parseConfigCSV(file, *spare, csvBaseTemperature, baseTemperatureSet);
+    file.close();
 
-    // Initialize timeOffset array with defaults
-    timeOffset[0] = 0.0; // Index 0 - unused
-    for (int i = 1; i <= 24; i++)
+    // Remember this version even if it is rejected, so it is reported once rather than every check
+    configSize = csvSize;
+    configCrc = csvCrc;
+    configWriteTime = writeTime;
+
+    if (errors > 0)
     {
-        timeOffset[i] = -5.0; // Default fallback
+        Serial.printf("Warning: temps.csv changed but has %lu bad line(s) - keeping the current schedule\n",
+                      (unsigned long)errors);
+        return false;
     }
 
-    while (file.available())
+    spare->compile();
+    schedule = spare; // One pointer store: callers see the old table or the new one, never a mix
+    unsigned long parseMicros = micros() - startMicros;
+
+    if (baseTemperatureSet && !baseTemperatureOverride)
     {
-        line = file.readStringUntil('\n');
-        line.trim();
+        // Follow the file's base temperature unless it was changed on the dial
+        if (baseTemperature == initialBaseTemperature)
+        {
+            baseTemperature = csvBaseTemperature;
+        }
+        initialBaseTemperature = csvBaseTemperature;
+    }
+    refreshSetpoint();
+
+    Serial.printf("Reloaded temps.csv: %u schedule points compiled in %lu us, base %.1f°F\n",
+                  (unsigned)schedule->getPointCount(), parseMicros, baseTemperature);
+
+    cacheSchedule(csvSize, csvCrc, csvBaseTemperature, baseTemperatureSet, parseMicros);
+    return true;
+}
 
-        // Skip comments and empty lines
-        if (line.length() == 0 || line.startsWith("#") || line.startsWith("Hour,"))
+void Stove::cacheSchedule(uint32_t csvSize, uint32_t csvCrc, float csvBaseTemperature, bool baseTemperatureSet,
+                          unsigned long parseMicros)
+{
+    ScheduleCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    header.csvSize = csvSize;
+    header.csvCrc = csvCrc;
+    header.baseTemperature = csvBaseTemperature;
+    header.baseTemperatureSet = baseTemperatureSet;
+    header.parseMicros = parseMicros;
+    if (!scheduleCache.store(header, schedule->getTable()))
+    {
+        Serial.println("Warning: Could not cache the compiled schedule in NVS");
+    }
+}
+
+// CsvReader data source for an open SPIFFS file
+static int readConfigFile(void *context, uint8_t *buffer, size_t size)
+{
+    return (int)static_cast<File *>(context)->read(buffer, size);
+}
+
+static void reportConfigError(void *, const CsvError &error)
+{
+    Serial.printf("Warning: temps.csv line %lu, column %u: %s\n",
+                  (unsigned long)error.line, (unsigned)error.column, error.message);
+}
+
+uint32_t Stove::parseConfigCSV(File &file, Schedule &target, float &csvBaseTemperature, bool &baseTemperatureSet)
+{
+    CsvReader reader(readConfigFile, &file, reportConfigError);
+    baseTemperatureSet = false;
+
+    // Collect schedule points from scratch
+    target.clear();
+
+    while (reader.next())
+    {
+        // Column header and settings read elsewhere
+        if (reader.fieldEquals(0, "Hour") || reader.fieldEquals(0, "FallbackTimezone"))
         {
             continue;
         }
 
-        // Parse base temperature
-        if (line.startsWith("BaseTemperature,"))
+        if (reader.fieldEquals(0, "BaseTemperature"))
         {
-            int commaIndex = line.indexOf(',');
-            if (commaIndex != -1)
+            float value;
+            if (reader.getFloat(1, value))
             {
-                String tempStr = line.substring(commaIndex + 1);
-                baseTemperature = tempStr.toFloat();
+                csvBaseTemperature = value;
                 baseTemperatureSet = true;
-                Serial.printf("Loaded base temperature: %.1f°F\n", baseTemperature);
-                continue;
+                Serial.printf("Loaded base temperature: %.1f°F\n", csvBaseTemperature);
             }
         }
+        // Schedule points: "Hour,Offset,Description" or "Days,HH:MM,Offset,Description"
+        else if (target.parseRecord(reader) == SCHEDULE_LINE_OTHER)
+        {
+            reader.fail(0, "unrecognized setting");
+        }
+    }
 
-        // Parse hourly offsets (format: Hour,Offset,Description)
-        int firstComma = line.indexOf(',');
-        int secondComma = line.indexOf(',', firstComma + 1);
+    if (reader.hasReadError())
+    {
+        Serial.println("Warning: Read error in temps.csv, schedule may be incomplete");
+        return reader.getErrorCount() + 1;
+    }
+    return reader.getErrorCount();
+}
 
-        if (firstComma != -1 && secondComma != -1)
-        {
-            String hourStr = line.substring(0, firstComma);
-            String offsetStr = line.substring(firstComma + 1, secondComma);
+static void reportForecastError(void *, const CsvError &error)
+{
+    Serial.printf("Warning: forecast.csv line %lu, column %u: %s\n",
+                  (unsigned long)error.line, (unsigned)error.column, error.message);
+}
+
+bool Stove::loadForecast()
+{
+    File file = SPIFFS.begin() ? SPIFFS.open(STOVE_FORECAST_PATH, "r") : File();
+    if (!file)
+    {
+        Serial.println("No outdoor forecast - MPC plans from the room model alone");
+        return false;
+    }
 
-            int hour = hourStr.toInt();
-            float offset = offsetStr.toFloat();
+    // Place the series on the millis() clock
+    time_t now = time(nullptr);
+    if (now < 1700000000)
+    {
+        file.close();
+        Serial.println("Warning: Clock not set, outdoor forecast not loaded");
+        return false;
+    }
 
-            if (hour >= 1 && hour <= 24)
+    static OutdoorForecast forecast; // ~500 bytes, kept off the loop task's stack
+    CsvReader reader(readConfigFile, &file, reportForecastError);
+    bool started = false;
+    while (reader.next())
+    {
+        long start;
+        float value;
+        if (reader.fieldEquals(0, "Start"))
+        {
+            if (reader.getInt(1, start))
             {
-                timeOffset[hour] = offset;
-                Serial.printf("Hour %d: %.1f°F offset\n", hour, offset);
+                forecast.reset(millis() - (unsigned long)((long)(now - start) * 1000L));
+                started = true;
             }
         }
+        else if (!started)
+        {
+            reader.fail(0, "expected Start,<Unix time> first");
+        }
+        else if (reader.getFloat(0, value) && !forecast.add(value))
+        {
+            break; // Full: the rest is beyond what the planner uses
+        }
     }
-
     file.close();
 
-    if (!baseTemperatureSet)
+    if (!started || forecast.getHours() == 0)
     {
-        Serial.println("Warning: Base temperature not found in CSV, using default 68.0°F");
-        baseTemperature = 68.0;
+        Serial.println("Warning: forecast.csv has no data");
         return false;
     }
+    logic.setForecast(forecast);
 
-    Serial.println("Successfully loaded temperature configuration from temps.csv");
+    float outdoor = 0.0f;
+    bool covered = forecast.getTemperature(millis(), outdoor);
+    Serial.printf("Outdoor forecast: %u hours, now %.1f°F, %+.1f°F against the last %d days\n",
+                  (unsigned)forecast.getHours(), covered ? outdoor : NAN, forecast.getAnomaly(millis()),
+                  MPC_FORECAST_BASELINE_DAYS);
     return true;
 }
 
 void Stove::setup()
 {
+    bool csvLoaded = loadConfigFromCSV();
+
+    // Set base temperature: constructor argument, then temps.csv, then the 68°F default
+    if (baseTemperatureOverride)
+    {
+        baseTemperature = initialBaseTemperature;
+    }
+    else if (!csvLoaded)
+    {
+        baseTemperature = 68.0;
+    }
+
+    // Store initial value for reset functionality
+    initialBaseTemperature = baseTemperature;
+    Serial.printf("Initial base temperature stored: %.1f°F\n", initialBaseTemperature);
+
+    // Seed the setpoint cache; loop() keeps it current through onMinute()
+    clockMinuteOfWeek = rtc.getMinuteOfWeek();
+    refreshSetpoint();
+
+    loadRuntimeStats();
+    loadForecast();
+
     currentState = STOVE_OFF;
     lastCommandedState = STOVE_OFF;
     lastStateChange = millis();
@@ -198,13 +425,20 @@ void Stove::setup()
     Serial.println("Temperature schedule loaded from temps.csv (or defaults if file not found)");
 }
 
-float Stove::getTemperatureAdjustment(int hour)
+float Stove::getPreheatTarget(float currentTemp, float desiredTemp, int minuteOfWeek)
 {
-    if (hour < 1 || hour > 24)
+    int targetMinute = 0;
+    float target = logic.getPreheatTarget(*schedule, baseTemperature, currentTemp, desiredTemp, minuteOfWeek,
+                                          &targetMinute);
+
+    bool nowPreheating = target > desiredTemp;
+    if (nowPreheating && !preheating)
     {
-        return 0.0; // No adjustment for invalid hours
+        Serial.printf("Optimal start: preheating to %.1f°F for %d:%02d (now %.1f°F)\n", target, targetMinute / 60,
+                      targetMinute % 60, currentTemp);
     }
-    return timeOffset[hour];
+    preheating = nowPreheating;
+    return target;
 }
 
 bool Stove::canChangeState()
@@ -253,6 +487,54 @@ String Stove::update(float currentTemp, int hourOfWeek)
     String status = "";
     static unsigned long loopCounter = 0;
 
+    // Pick up an edited temps.csv (checked every STOVE_CONFIG_CHECK_INTERVAL_MS)
+    reloadConfigIfChanged();
+
+    // Runtime accounting; each closed hour is logged, reported over LoRa and now and then saved
+    if (runtimeStats.update(currentState == STOVE_ON, millis(), clockMinuteOfWeek))
+    {
+        RuntimeSummary hour = runtimeStats.getSummary(RUNTIME_HOUR, 1);
+        RuntimeSummary day = runtimeStats.getSummary(RUNTIME_DAY);
+        Serial.printf("Stove runtime: last hour %.0f min, %u cycles (%.0f%%); today %.1f h, %u cycles (%.0f%%)\n",
+                      hour.onHours * 60, hour.cycles, hour.dutyPercent, day.onHours, day.cycles, day.dutyPercent);
+        runtimeReportDue = true;
+
+        if (++hoursSinceRuntimeSave >= STOVE_RUNTIME_SAVE_HOURS && saveRuntimeStats())
+        {
+            hoursSinceRuntimeSave = 0;
+        }
+    }
+
+    // Learn the room's response from every reading, whatever the control mode
+    int minuteOfWeek = clockMinuteOfWeek;
+    logic.observe(currentTemp, currentState == STOVE_ON, millis(), minuteOfWeek);
+    const ThermalModel &thermalModel = logic.getThermalModel();
+    if (thermalModel.getSampleCount() != lastModelSamples)
+    {
+        lastModelSamples = thermalModel.getSampleCount();
+        Serial.printf("Thermal model: tau=%.1fh, ambient=%.1f°F, heating=%.1f°F/h, error=%+.2f°F (RMS %.2f°F)%s\n",
+                      thermalModel.getTimeConstantHours(), thermalModel.getAmbientTemperature(),
+                      thermalModel.getHeatingRate(), thermalModel.getLastError(), thermalModel.getRmsError(),
+                      thermalModel.isTrained() ? "" : " - still learning");
+    }
+
+    // An ACK only says the relay clicked; the temperature trend says whether the stove heats
+    if (heaterMonitor.observe(currentTemp, currentState == STOVE_ON, millis()))
+    {
+        HeaterFault fault = heaterMonitor.getFault();
+        if (fault == HEATER_OK)
+        {
+            Serial.printf("Heater alarm cleared (%.1f°F/h)\n", heaterMonitor.getRate());
+        }
+        else
+        {
+            Serial.printf("HEATER ALARM: %s - room warming at %.1f°F/h with the stove %s, usually %.1f°F/h when ON\n",
+                          HeaterMonitor::getFaultName(fault), heaterMonitor.getRate(),
+                          currentState == STOVE_ON ? "ON" : "OFF", heaterMonitor.getExpectedRate());
+        }
+        heaterFaultReportDue = true;
+    }
+
     // If manual override is active, don't run automatic control but do update status
     if (manualOverride)
     {
@@ -261,6 +543,15 @@ String Stove::update(float currentTemp, int hourOfWeek)
             Serial.println("DEBUG: Manual override active, skipping automatic control");
         }
 
+        // With slot sync the receiver only listens in slots - re-assert the
+        // manual state there so it stays synchronized and its safety timer armed
+        if (loraControlEnabled && loraTransmitter && loraTransmitter->isSlotSyncEnabled() &&
+            loraTransmitter->beginSlot())
+        {
+            sendLoRaCommand(currentState == STOVE_ON ? CMD_STOVE_ON : CMD_STOVE_OFF);
+            loraTransmitter->endSlot();
+        }
+
         // Update display with current manual state
         if (loraControlEnabled)
         {
@@ -280,11 +571,19 @@ String Stove::update(float currentTemp, int hourOfWeek)
     // For LoRa control, we periodically check status and send commands
     if (loraControlEnabled && loraTransmitter)
     {
+        // With slot sync, all traffic waits for the next announced slot
+        if (!loraTransmitter->beginSlot())
+        {
+            loopCounter++;
+            return getDisplayStatusText();
+        }
+
         // Update remote status periodically
         updateRemoteStatus();
 
-        float desiredTemp = getDesiredTemperature(rtc);
+        float desiredTemp = getPreheatTarget(currentTemp, currentSetpoint, minuteOfWeek);
         float tempDiff = desiredTemp - currentTemp;
+        controlTarget = desiredTemp;
 
         if (!(loopCounter % 100))
         {
@@ -292,16 +591,59 @@ String Stove::update(float currentTemp, int hourOfWeek)
                           loopCounter, currentTemp, desiredTemp, tempDiff, getStateString().c_str());
         }
 
-        bool shouldBeOn = false;
+        bool isOn = (currentState == STOVE_ON || currentState == STOVE_PENDING_ON);
 
-        // Hysteresis: different thresholds for turning on vs off to prevent oscillation
-        if (currentState == STOVE_OFF || currentState == STOVE_PENDING_OFF)
+        // MPC mode: re-plan once a minute, timed against the loop's budget
+        unsigned long solveStart = micros();
+        if (logic.updatePlan(*schedule, baseTemperature, currentTemp, isOn, millis(), minuteOfWeek))
         {
-            shouldBeOn = (tempDiff >= STOVE_HYSTERESIS_LOW);
+            unsigned long solveMicros = micros() - solveStart;
+            mpcWorstMicros = max(mpcWorstMicros, solveMicros);
+            const MpcController &mpc = logic.getMpc();
+            bool planOn = mpc.isOnAt(millis());
+            if (planOn != mpcLastPlanOn || ++mpcSolvesSinceReport >= STOVE_MPC_REPORT_SOLVES)
+            {
+                Serial.printf("MPC: %s, ON +%lu..+%lu min, %.1f°F in %d h (cost %.2f, %lu plans, %lu steps, "
+                              "%lu us, worst %lu us)\n",
+                              planOn ? "ON" : "OFF", mpc.getOnMinutes(), mpc.getOffMinutes(),
+                              mpc.getEndTemperature(), MPC_HORIZON_STEPS * MPC_STEP_MIN / 60, mpc.getCost(),
+                              (unsigned long)mpc.getEvaluations(), (unsigned long)mpc.getSteps(), solveMicros,
+                              mpcWorstMicros);
+                mpcLastPlanOn = planOn;
+                mpcSolvesSinceReport = 0;
+            }
         }
-        else
+
+        bool shouldBeOn = logic.shouldBeOn(desiredTemp, currentTemp, isOn, millis());
+
+        if (logic.getControlMode() == STOVE_CONTROL_PI && !(loopCounter % 100))
+        {
+            const PiController &piController = logic.getPiController();
+            Serial.printf("    PI: output=%.2f, integral=%.2f, window duty=%.0f%%\n",
+                          piController.getOutput(), piController.getIntegral(), piController.getDuty() * 100);
+        }
+
+#if STOVE_TRACE
+        // Replay input for tools/sim/backtest.cpp: ms, minute of week, temperature, setpoint, target, mode,
+        // then relay and control-law decision as two digits (8 fields, the most CsvReader splits)
+        if (shouldBeOn != lastTraceDecision || millis() - lastTraceMs >= STOVE_TRACE_INTERVAL_MS)
         {
-            shouldBeOn = (tempDiff > STOVE_HYSTERESIS_HIGH);
+            Serial.printf("TRACE,%lu,%d,%.4f,%.2f,%.2f,%d,%d%d\n", millis(), minuteOfWeek, currentTemp,
+                          currentSetpoint, desiredTemp, (int)logic.getControlMode(), isOn ? 1 : 0, shouldBeOn ? 1 : 0);
+            lastTraceMs = millis();
+            lastTraceDecision = shouldBeOn;
+        }
+#endif
+
+        // Over the safety limit the stove goes off now, even inside the change interval
+        if (currentTemp >= SAFETY_MAX_TEMP)
+        {
+            if (currentState == STOVE_ON && !canChangeState())
+            {
+                Serial.printf("Safety: %.1f°F exceeds %.1f°F, forcing stove OFF\n", currentTemp, SAFETY_MAX_TEMP);
+                forceState(false);
+                lastCommandedState = STOVE_OFF;
+            }
         }
 
         // Send command if needed and timing allows
@@ -320,19 +662,27 @@ String Stove::update(float currentTemp, int hourOfWeek)
             unsigned long remainingSeconds = getTimeUntilNextChange();
             statusDisplayText = getStateString() + " (" + String(remainingSeconds) + "s)";
         }
+
+        loraTransmitter->endSlot();
     }
     else
     {
         // No LoRa control - just show local calculation
-        float desiredTemp = getDesiredTemperature(rtc);
+        float desiredTemp = currentSetpoint;
         float tempDiff = desiredTemp - currentTemp;
 
-        // Include temperature difference in status display for better feedback
-        statusDisplayText = String(desiredTemp, 1) + "F goal;";
-        if (abs(tempDiff) > 0.1)
+        // Include temperature difference in status display for better feedback (formatted only when it changes)
+        if (desiredTemp != displayedSetpoint || currentTemp != displayedTemperature)
         {
-            statusDisplayText += String(tempDiff > 0 ? "+" : "") + String(tempDiff, 1) + "F off";
+            displayedSetpoint = desiredTemp;
+            displayedTemperature = currentTemp;
+            localStatusText = String(desiredTemp, 1) + "F goal;";
+            if (abs(tempDiff) > 0.1)
+            {
+                localStatusText += String(tempDiff > 0 ? "+" : "") + String(tempDiff, 1) + "F off";
+            }
         }
+        statusDisplayText = localStatusText;
 
         if (!(loopCounter % 100))
         {
@@ -422,14 +772,96 @@ StoveState Stove::getState() const
 
 float Stove::getDesiredTemperature(RTC &rtc)
 {
-    int currentHour = rtc.getHour();
-    float adjustment = getTemperatureAdjustment(currentHour);
-    return baseTemperature + adjustment;
+    return getScheduledTemperature(rtc.getMinuteOfWeek());
 }
 
 float Stove::getCurrentDesiredTemperature()
 {
-    return getDesiredTemperature(rtc);
+    return currentSetpoint;
+}
+
+void Stove::onMinute(int minuteOfWeek)
+{
+    clockMinuteOfWeek = minuteOfWeek;
+
+    // Minutes since the cached value was computed; a clock set backwards shows up as a huge gap
+    unsigned long elapsed = (minuteOfWeek - setpointMinuteOfWeek + SCHEDULE_MINUTES_PER_WEEK) % SCHEDULE_MINUTES_PER_WEEK;
+    if (elapsed >= setpointMinutesLeft)
+    {
+        refreshSetpoint();
+    }
+}
+
+void Stove::refreshSetpoint()
+{
+    currentSetpoint = getScheduledTemperature(clockMinuteOfWeek);
+    setpointMinuteOfWeek = clockMinuteOfWeek;
+    setpointMinutesLeft = schedule->getMinutesUntilChange(clockMinuteOfWeek);
+}
+
+void Stove::loadRuntimeStats()
+{
+    if (RuntimeStats::isValid(retainedRuntime))
+    {
+        Serial.printf("Runtime statistics kept in RTC memory: %.1f h, %lu cycles in total\n",
+                      runtimeStats.getTotalOnHours(), (unsigned long)runtimeStats.getTotalCycles());
+        return;
+    }
+
+    // Power-on: fall back to the last copy in NVS (a few hours old at most)
+    static RuntimeStatsData saved; // Too big for the loop task's stack
+    Preferences preferences;
+    bool restored = false;
+    if (preferences.begin(STOVE_RUNTIME_NAMESPACE, true))
+    {
+        restored = preferences.getBytes("stats", &saved, sizeof(saved)) == sizeof(saved) && runtimeStats.restore(saved);
+        preferences.end();
+    }
+
+    if (restored)
+    {
+        Serial.printf("Runtime statistics restored from NVS: %.1f h, %lu cycles in total\n",
+                      runtimeStats.getTotalOnHours(), (unsigned long)runtimeStats.getTotalCycles());
+    }
+    else
+    {
+        runtimeStats.clear();
+        Serial.println("Runtime statistics started");
+    }
+}
+
+bool Stove::saveRuntimeStats()
+{
+    Preferences preferences;
+    if (!preferences.begin(STOVE_RUNTIME_NAMESPACE, false))
+    {
+        Serial.println("Warning: Could not open NVS to save runtime statistics");
+        return false;
+    }
+
+    const RuntimeStatsData &data = runtimeStats.getData();
+    bool ok = preferences.putBytes("stats", &data, sizeof(data)) == sizeof(data);
+    preferences.end();
+    if (!ok)
+    {
+        Serial.println("Warning: Could not save runtime statistics");
+    }
+    return ok;
+}
+
+const RuntimeStats &Stove::getRuntimeStats() const
+{
+    return runtimeStats;
+}
+
+float Stove::getScheduledTemperature(int minuteOfWeek) const
+{
+    return baseTemperature + schedule->getOffset(minuteOfWeek);
+}
+
+unsigned long Stove::getMinutesUntilScheduleChange()
+{
+    return schedule->getMinutesUntilChange(clockMinuteOfWeek);
 }
 
 void Stove::setBaseTemperature(float temp)
@@ -447,6 +879,7 @@ void Stove::setBaseTemperature(float temp)
     }
 
     baseTemperature = temp;
+    refreshSetpoint();
     Serial.printf("Base temperature set to %.1f°F\n", baseTemperature);
 }
 
@@ -459,6 +892,7 @@ String Stove::resetBaseTemperature()
 {
     float oldBase = baseTemperature;
     baseTemperature = initialBaseTemperature;
+    refreshSetpoint();
     Serial.printf("Base temperature reset: %.1f°F → %.1f°F\n", oldBase, baseTemperature);
     return "Reset to " + String(baseTemperature, 1) + "°F";
 }
@@ -480,6 +914,36 @@ bool Stove::isEnabled() const
     return enabled;
 }
 
+void Stove::setControlMode(StoveControlMode mode)
+{
+    if (mode != logic.getControlMode())
+    {
+        logic.setControlMode(mode);
+        Serial.printf("Stove: control mode %s\n",
+                      mode == STOVE_CONTROL_PI ? "PI" : mode == STOVE_CONTROL_MPC ? "MPC" : "HYSTERESIS");
+    }
+}
+
+StoveControlMode Stove::getControlMode() const
+{
+    return logic.getControlMode();
+}
+
+const ThermalModel &Stove::getThermalModel() const
+{
+    return logic.getThermalModel();
+}
+
+float Stove::getDecisionDistance(float temperature) const
+{
+    return logic.getDecisionDistance(controlTarget > 0 ? controlTarget : currentSetpoint, temperature);
+}
+
+const HeaterMonitor &Stove::getHeaterMonitor() const
+{
+    return heaterMonitor;
+}
+
 unsigned long Stove::getTimeUntilNextChange() const
 {
     unsigned long elapsed = millis() - lastStateChange;
@@ -668,8 +1132,44 @@ String Stove::sendLoRaCommand(const String &command)
     String modeStr = (currentMode == LoRaCommunicationMode::P2P) ? "P2P" : "LoRaWAN";
     statusDisplayText = "Sending (" + modeStr + "): " + command;
 
-    // Use fallback method for better reliability
-    String response = loraTransmitter->sendCommandWithFallback(command, 2);
+    // Command every receiver of this zone, using fallback method for better reliability
+    String response = "";
+    bool allAnswered = true;
+    for (size_t i = 0; i < STOVE_RECEIVER_COUNT; i++)
+    {
+        loraTransmitter->setDestination(STOVE_RECEIVER_IDS[i]);
+        String reply = loraTransmitter->sendCommandWithFallback(command, 2);
+
+        if (reply.length() == 0)
+        {
+            Serial.printf("No response from receiver %u\n", STOVE_RECEIVER_IDS[i]);
+            allAnswered = false;
+        }
+        else if (response.length() == 0)
+        {
+            response = reply;
+        }
+
+        String frame = loraTransmitter->getLastResponseFrame();
+        String rssi, snr, sequence;
+        if (ProtocolHelper::getField(frame, P2P_FIELD_LINK_RSSI, rssi) &&
+            ProtocolHelper::getField(frame, P2P_FIELD_LINK_SNR, snr))
+        {
+            String errors = "n/a ";
+            ProtocolHelper::getField(frame, P2P_FIELD_LINK_ERRORS, errors);
+            Serial.printf("Receiver %u hears us at RSSI %s dBm, SNR %s dB, %s%% packet errors\n",
+                          STOVE_RECEIVER_IDS[i], rssi.c_str(), snr.c_str(), errors.c_str());
+        }
+        if (ProtocolHelper::getField(frame, P2P_FIELD_RECONFIRM, sequence))
+        {
+            Serial.printf("Receiver %u resumed after a reset (sequence %s)\n", STOVE_RECEIVER_IDS[i], sequence.c_str());
+            reconfirmRequested = true;
+        }
+    }
+    if (!allAnswered)
+    {
+        response = "";
+    }
     lastLoRaResponse = response;
     lastStatusUpdate = millis();
 
@@ -696,7 +1196,27 @@ String Stove::updateRemoteStatus()
     if (millis() - lastStatusUpdate > 30000)
     { // 30 seconds
         statusDisplayText = "Getting status...";
-        String response = sendLoRaCommand(CMD_STATUS_REQUEST);
+        // Once an hour the request also carries the stove's runtime figures
+        String request = CMD_STATUS_REQUEST;
+        if (runtimeReportDue)
+        {
+            RuntimeSummary hour = runtimeStats.getSummary(RUNTIME_HOUR, 1);
+            RuntimeSummary day = runtimeStats.getSummary(RUNTIME_DAY);
+            request = ProtocolHelper::addField(request, P2P_FIELD_RUNTIME,
+                                               String(lroundf(hour.onHours * 60)) + "/" +
+                                                   String(lroundf(day.onHours * 60)) + "/" + String(day.cycles));
+        }
+        // Heater alarms ride on every request while active, and once more when cleared
+        if (heaterFaultReportDue || heaterMonitor.getFault() != HEATER_OK)
+        {
+            request = ProtocolHelper::addField(request, P2P_FIELD_HEATER_FAULT, String((int)heaterMonitor.getFault()));
+        }
+        String response = sendLoRaCommand(request);
+        if (response != "TIMEOUT")
+        {
+            runtimeReportDue = false;
+            heaterFaultReportDue = false;
+        }
 
         if (response == RESP_STOVE_ON)
         {
@@ -716,6 +1236,15 @@ String Stove::updateRemoteStatus()
         {
             statusDisplayText = "LoRa: " + response;
         }
+
+        // A receiver restored its relay after a reset; confirm what we actually want
+        if (reconfirmRequested)
+        {
+            reconfirmRequested = false;
+            bool wantOn = manualOverride ? (currentState == STOVE_ON) : (lastCommandedState == STOVE_ON);
+            Serial.printf("Reconfirming stove %s after receiver reset\n", wantOn ? "ON" : "OFF");
+            sendLoRaCommand(wantOn ? CMD_STOVE_ON : CMD_STOVE_OFF);
+        }
     }
 
     return statusDisplayText;
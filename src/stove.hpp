@@ -16,6 +16,11 @@
 #include "temp_sensor.hpp"
 #include "rtc.hpp"
 #include "lora_transmitter.hpp"
+#include "stove_logic.hpp"
+#include "heater_monitor.hpp"
+#include "schedule.hpp"
+#include "schedule_cache.hpp"
+#include "runtime_stats.hpp"
 
 /**
  * @enum StoveState
@@ -29,10 +34,25 @@ enum StoveState
     STOVE_PENDING_OFF = 3
 };
 
-// Turn on if temperature is 2°F or more below desired
-static const float STOVE_HYSTERESIS_LOW = 2.0;
-// Turn off if temperature is 0.5°F or more above desired
-static const float STOVE_HYSTERESIS_HIGH = 0.5;
+// How often temps.csv is checked for edits (size and write time, then a CRC when they are unknown or differ)
+#define STOVE_CONFIG_CHECK_INTERVAL_MS 60000
+
+// Set to 1 to print TRACE lines for tools/sim/backtest.cpp (save the serial monitor output to a file)
+#define STOVE_TRACE 0
+#define STOVE_TRACE_INTERVAL_MS 10000 // And whenever the decision flips
+
+// Outdoor forecast for the MPC mode: SPIFFS file written by RTC::downloadForecast or uploaded with the data
+#define STOVE_FORECAST_PATH "/forecast.csv"
+#define STOVE_FORECAST_REFRESH_MS (3 * 3600000UL) // Download interval while in MPC mode
+#define STOVE_MPC_REPORT_SOLVES 60                // Log the plan at least this often (solves, once a minute)
+
+// Runtime statistics: kept in RTC memory, copied to NVS every few hours against power loss
+#define STOVE_RUNTIME_NAMESPACE "runtime"
+#define STOVE_RUNTIME_SAVE_HOURS 4
+
+// Receivers (node IDs) that switch this thermostat's zone - every command goes to each
+static const uint8_t STOVE_RECEIVER_IDS[] = {P2P_DEFAULT_RECEIVER_ID};
+static const size_t STOVE_RECEIVER_COUNT = sizeof(STOVE_RECEIVER_IDS) / sizeof(STOVE_RECEIVER_IDS[0]);
 
 /**
  * @class Stove
@@ -56,28 +76,103 @@ private:
     unsigned long lastStateChange;      // Time of last state change command
     unsigned long lastStatusUpdate;     // Time of last status update from remote
     unsigned long minChangeInterval;    // Minimum time between state changes (3 minutes)
+    StoveLogic logic;                   // Control law, PI state and learned room model
+    bool preheating;                    // Heating early for an upcoming setpoint
+    float controlTarget;                // Target last given to the control law (°F), 0 before the first update
+    uint32_t lastModelSamples;          // Model sample count at the last report
+    HeaterMonitor heaterMonitor;        // Stove that won't light, relay that won't release
+    bool heaterFaultReportDue;          // Send a cleared alarm once more over LoRa
+    unsigned long lastTraceMs;          // STOVE_TRACE: time and decision of the last TRACE line
+    bool lastTraceDecision;
+    unsigned long mpcWorstMicros;       // MPC: slowest solve so far, solves since the last log line
+    uint16_t mpcSolvesSinceReport;
+    bool mpcLastPlanOn;                 // Immediate decision of the last logged plan
     bool enabled;                       // Whether automatic control is enabled
     bool manualOverride;                // Whether manual override is active
     bool loraControlEnabled;            // Whether LoRa remote control is enabled
+    bool reconfirmRequested;            // A receiver resumed after a reset and wants our state resent
     String lastLoRaResponse;            // Last response from LoRa transmitter
     String statusDisplayText;           // Current status text for display
     static const float SAFETY_MAX_TEMP; // Maximum safe temperature
 
-    // Temperature schedule adjustments by hour (24-hour format)
-    float timeOffset[25];
+    // Week schedule of offsets from the base temperature, double-buffered for hot reload
+    Schedule scheduleBuffers[2];
+    Schedule *schedule;                 // Active buffer; the other one receives reloads
+    ScheduleCache scheduleCache;        // Compiled schedule in NVS, keyed by the CSV's size and CRC
+    bool baseTemperatureOverride;       // Constructor was given a base temperature - ignore the CSV's
+    uint32_t configSize;                // Fingerprint of the temps.csv last loaded or rejected
+    uint32_t configCrc;
+    time_t configWriteTime;             // Last-write time, 0 if the filesystem keeps none
+    unsigned long lastConfigCheck;      // When temps.csv was last checked for changes
+
+    // Setpoint cache, refreshed by onMinute() at schedule changes and on base temperature edits
+    int clockMinuteOfWeek;              // Minute of the week from the last clock notification
+    float currentSetpoint;              // Scheduled temperature for clockMinuteOfWeek (°F)
+    int setpointMinuteOfWeek;           // Minute currentSetpoint was computed for
+    unsigned long setpointMinutesLeft;  // Minutes from then until the schedule next changes
+    float displayedSetpoint;            // Values behind localStatusText
+    float displayedTemperature;
+    String localStatusText;             // Local-mode status, reformatted only when its values change
+
+    // ON time and cycles per hour/day/week
+    RuntimeStats runtimeStats;
+    uint8_t hoursSinceRuntimeSave;
+    bool runtimeReportDue;              // Send the closed hour's figures with the next status request
 
     /**
      * @brief Load configuration from temps.csv file
+     * Uses the compiled schedule cached in NVS when temps.csv is unchanged.
      * @return true if successful, false if file not found or error
      */
     bool loadConfigFromCSV();
 
     /**
-     * @brief Get temperature adjustment for current time
-     * @param hour Current hour (0-23)
-     * @return Temperature adjustment in °F
+     * @brief Parse temps.csv line by line into a schedule and base temperature
+     * @param file Open temps.csv, positioned at the start
+     * @param target Schedule to fill (cleared first, not compiled)
+     * @param csvBaseTemperature Receives the BaseTemperature value, if any
+     * @param baseTemperatureSet Receives whether a BaseTemperature line was found
+     * @return Number of rejected lines (each is logged with its line and column)
+     */
+    uint32_t parseConfigCSV(File &file, Schedule &target, float &csvBaseTemperature, bool &baseTemperatureSet);
+
+    /**
+     * @brief Store the active schedule in the NVS cache
+     * @param csvSize Size of the temps.csv it was compiled from
+     * @param csvCrc CRC-32 of that temps.csv
+     * @param csvBaseTemperature BaseTemperature value from the file
+     * @param baseTemperatureSet Whether the file had a BaseTemperature line
+     * @param parseMicros How long the parse and compile took
+     */
+    void cacheSchedule(uint32_t csvSize, uint32_t csvCrc, float csvBaseTemperature, bool baseTemperatureSet,
+                       unsigned long parseMicros);
+
+    /**
+     * @brief Optimal start: raise the target early when the model says the room needs it
+     * Looks ahead up to THERMAL_MODEL_MAX_PREHEAT_MIN for a higher scheduled
+     * setpoint that full heating would only just reach in time.
+     * @param currentTemp Current temperature (°F)
+     * @param desiredTemp Setpoint scheduled for now (°F)
+     * @param minuteOfWeek Current minute of the week (0 = Sunday 00:00)
+     * @return Temperature to control to (°F)
+     */
+    float getPreheatTarget(float currentTemp, float desiredTemp, int minuteOfWeek);
+
+    /**
+     * @brief Recompute the cached setpoint for clockMinuteOfWeek
      */
-    float getTemperatureAdjustment(int hour);
+    void refreshSetpoint();
+
+    /**
+     * @brief Restore runtime statistics from RTC memory, or else from NVS
+     */
+    void loadRuntimeStats();
+
+    /**
+     * @brief Copy runtime statistics to NVS
+     * @return true if written
+     */
+    bool saveRuntimeStats();
 
     /**
      * @brief Check if enough time has passed since last state change
@@ -105,7 +200,9 @@ public:
     ~Stove();
 
     /**
-     * @brief Initialize stove control system
+     * @brief Initialize stove control system and load temps.csv
+     * Config is loaded here rather than in the constructor: the constructor
+     * runs before Serial and NVS are up.
      */
     void setup();
 
@@ -116,6 +213,16 @@ public:
      */
     String update(float currentTemp, int hourOfWeek);
 
+    /**
+     * @brief Reload temps.csv if it changed, without interrupting control
+     * Runs at most every STOVE_CONFIG_CHECK_INTERVAL_MS (update() calls it).
+     * Size and last-write time are checked first, then the CRC. The new file
+     * is compiled into the spare schedule buffer and swapped in only if every
+     * line parsed; otherwise the current schedule stays in use.
+     * @return true if a new schedule was swapped in
+     */
+    bool reloadConfigIfChanged();
+
     /**
      * @brief Manually turn stove on
      * Respects minimum change interval
@@ -142,11 +249,33 @@ public:
     float getDesiredTemperature(RTC &rtc);
 
     /**
-     * @brief Get current desired temperature (using global rtc)
+     * @brief Get current desired temperature (cached, no clock read)
      * @return Desired temperature in °F
      */
     float getCurrentDesiredTemperature();
 
+    /**
+     * @brief Clock notification: the minute of the week has changed
+     * Recomputes the setpoint only when the schedule's next change is due
+     * (or the clock jumped); other minutes cost a subtraction.
+     * @param minuteOfWeek Current minute of the week (0 = Sunday 00:00)
+     */
+    void onMinute(int minuteOfWeek);
+
+    /**
+     * @brief Get the scheduled temperature at a given time
+     * @param minuteOfWeek Minute of the week (0 = Sunday 00:00)
+     * @return Desired temperature in °F (base + schedule offset)
+     */
+    float getScheduledTemperature(int minuteOfWeek) const;
+
+    /**
+     * @brief Minutes until the scheduled temperature next changes
+     * Lets callers sleep until the setpoint actually moves.
+     * @return Minutes from now (1 during a ramp)
+     */
+    unsigned long getMinutesUntilScheduleChange();
+
     /**
      * @brief Set base temperature
      * @param temp Base temperature in °F (limited to 50-90°F range)
@@ -177,6 +306,55 @@ public:
      */
     bool isEnabled() const;
 
+    /**
+     * @brief Select the automatic control law
+     * Switching resets the PI controller's integral and window, and the MPC plan.
+     * @param mode STOVE_CONTROL_HYSTERESIS, STOVE_CONTROL_PI or STOVE_CONTROL_MPC
+     */
+    void setControlMode(StoveControlMode mode);
+
+    /**
+     * @brief Get the automatic control law
+     * @return Current control mode
+     */
+    StoveControlMode getControlMode() const;
+
+    /**
+     * @brief Load the outdoor forecast for the MPC mode from STOVE_FORECAST_PATH
+     * One "Start,<Unix time of the first hour>" line, then one temperature (°F)
+     * per line, hourly. The clock must be set to place it on the control loop's
+     * time base. Without a forecast the MPC plans from the room model alone.
+     * @return true if a forecast was loaded
+     */
+    bool loadForecast();
+
+    /**
+     * @brief Get the stove's runtime statistics (ON time, cycles, duty cycle)
+     * @return Runtime statistics
+     */
+    const RuntimeStats &getRuntimeStats() const;
+
+    /**
+     * @brief Get the learned thermal model (fitted parameters and prediction error)
+     * @return Thermal model
+     */
+    const ThermalModel &getThermalModel() const;
+
+    /**
+     * @brief How far a temperature is from the control law's nearest switching point
+     * Uses the last control target (optimal start included), or the setpoint
+     * before the first update. See StoveLogic::getDecisionDistance.
+     * @param temperature Temperature (°F)
+     * @return Distance (°F)
+     */
+    float getDecisionDistance(float temperature) const;
+
+    /**
+     * @brief Get the heater-fault detector (alarm, observed and usual heating rate)
+     * @return Heater monitor
+     */
+    const HeaterMonitor &getHeaterMonitor() const;
+
     /**
      * @brief Get time remaining until next state change is allowed
      * @return Seconds remaining, 0 if change is allowed now
@@ -242,8 +420,9 @@ public:
 
     /**
      * @brief Send command to remote stove via LoRa
+     * Addressed to every receiver in STOVE_RECEIVER_IDS; fails unless all of them answer.
      * @param command Command to send (STOVE_ON, STOVE_OFF, STATUS_REQUEST)
-     * @return Response status for display
+     * @return Response status for display (first receiver's reply)
      */
     String sendLoRaCommand(const String &command);
 
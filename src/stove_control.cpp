@@ -0,0 +1,102 @@
+/**
+ * @file stove_control.cpp
+ * @brief Stove control laws implementation
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "stove_control.hpp"
+
+bool hysteresisShouldBeOn(float tempDiff, bool isOn, float low, float high)
+{
+    // Different thresholds for turning on vs off to prevent oscillation
+    return isOn ? (tempDiff > high) : (tempDiff >= low);
+}
+
+PiController::PiController(float kp, float tiSeconds, unsigned long windowMs, unsigned long minSegmentMs)
+    : kp(kp), tiSeconds(tiSeconds), windowMs(windowMs), minSegmentMs(minSegmentMs)
+{
+    reset();
+}
+
+void PiController::reset()
+{
+    integral = 0.0f;
+    output = 0.0f;
+    duty = 0.0f;
+    windowActive = false;
+    windowStart = 0;
+    hasLastUpdate = false;
+    lastUpdateMs = 0;
+    cutOff = false;
+}
+
+float PiController::quantize(float value) const
+{
+    // Segments shorter than the minimum cycle time can't be switched - round them away
+    float onMs = value * windowMs;
+    if (onMs < minSegmentMs)
+    {
+        return 0.0f;
+    }
+    if (windowMs - onMs < minSegmentMs)
+    {
+        return 1.0f;
+    }
+    return value;
+}
+
+bool PiController::update(float setpoint, float measured, unsigned long nowMs)
+{
+    float error = setpoint - measured;
+    float dtSeconds = hasLastUpdate ? (nowMs - lastUpdateMs) / 1000.0f : 0.0f;
+    hasLastUpdate = true;
+    lastUpdateMs = nowMs;
+
+    // Anti-windup: don't integrate further into saturation
+    float unclamped = kp * error + integral;
+    bool saturatedHigh = unclamped >= 1.0f && error > 0.0f;
+    bool saturatedLow = unclamped <= 0.0f && error < 0.0f;
+    if (!saturatedHigh && !saturatedLow)
+    {
+        integral += kp * error * dtSeconds / tiSeconds;
+    }
+    if (integral < 0.0f) integral = 0.0f;
+    if (integral > 1.0f) integral = 1.0f;
+
+    output = kp * error + integral;
+    if (output < 0.0f) output = 0.0f;
+    if (output > 1.0f) output = 1.0f;
+
+    // New window: commit the current output as its duty
+    if (!windowActive || nowMs - windowStart >= windowMs)
+    {
+        windowActive = true;
+        windowStart = nowMs;
+        duty = quantize(output);
+        cutOff = false;
+    }
+
+    // A high-mass stove keeps heating after it turns off - stop early when already over target
+    if (-error >= STOVE_PI_OVERSHOOT_CUTOFF)
+    {
+        cutOff = true;
+    }
+
+    return !cutOff && (nowMs - windowStart) < (unsigned long)(duty * windowMs);
+}
+
+float PiController::getDuty() const
+{
+    return duty;
+}
+
+float PiController::getOutput() const
+{
+    return output;
+}
+
+float PiController::getIntegral() const
+{
+    return integral;
+}
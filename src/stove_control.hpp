@@ -0,0 +1,140 @@
+/**
+ * @file stove_control.hpp
+ * @brief Stove control laws (hysteresis and time-proportioned PI)
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Plain C++ with no Arduino dependencies, so the host simulator in
+ * tools/sim/ can run exactly the code the thermostat runs.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Turn on if temperature is 2°F or more below desired
+static const float STOVE_HYSTERESIS_LOW = 2.0;
+// Turn off if temperature is 0.5°F or more above desired
+static const float STOVE_HYSTERESIS_HIGH = 0.5;
+// Never heat at or above this room temperature, whatever the control law
+static const float STOVE_SAFETY_MAX_TEMP = 82.0;
+
+// PI controller tuning
+#define STOVE_PI_KP 0.25f                // Duty per °F of error (4°F below target = full power)
+#define STOVE_PI_TI_S 5400.0f            // Integral time in seconds (90 minutes)
+#define STOVE_PI_WINDOW_MS 1800000UL     // Time-proportioning window (30 minutes)
+#define STOVE_PI_OVERSHOOT_CUTOFF 0.5f   // End an ON period early once this far above target (°F)
+
+/**
+ * @enum StoveControlMode
+ * @brief Control law used by Stove::update
+ */
+enum StoveControlMode
+{
+    STOVE_CONTROL_HYSTERESIS = 0, // Bang-bang between STOVE_HYSTERESIS_LOW/HIGH
+    STOVE_CONTROL_PI = 1,         // Time-proportioned PI (PiController)
+    STOVE_CONTROL_MPC = 2         // Receding-horizon plan over the schedule and forecast (MpcController)
+};
+
+// Control law used at startup
+#define STOVE_DEFAULT_CONTROL_MODE STOVE_CONTROL_HYSTERESIS
+
+/**
+ * @struct StoveTuning
+ * @brief Control law parameters, for trying alternatives on the host
+ */
+struct StoveTuning
+{
+    float hysteresisLow;      // Turn on this far below target (°F)
+    float hysteresisHigh;     // Stay on until within this of target (°F)
+    float piKp;               // Duty per °F of error
+    float piTiSeconds;        // Integral time (s)
+    unsigned long piWindowMs; // Time-proportioning window (ms)
+};
+
+// The tuning the thermostat ships with
+#define STOVE_DEFAULT_TUNING {STOVE_HYSTERESIS_LOW, STOVE_HYSTERESIS_HIGH, STOVE_PI_KP, STOVE_PI_TI_S, STOVE_PI_WINDOW_MS}
+
+/**
+ * @brief Hysteresis decision
+ * @param tempDiff Desired minus current temperature (°F)
+ * @param isOn Whether the stove is currently on
+ * @param low Turn-on threshold (°F below target)
+ * @param high Turn-off threshold (°F below target)
+ * @return true if the stove should be on
+ */
+bool hysteresisShouldBeOn(float tempDiff, bool isOn, float low = STOVE_HYSTERESIS_LOW,
+                          float high = STOVE_HYSTERESIS_HIGH);
+
+/**
+ * @class PiController
+ * @brief PI controller driving an on/off stove with time-proportioned windows
+ *
+ * At the start of each window the PI output (0..1) becomes the ON fraction
+ * of that window. ON and OFF segments shorter than the minimum cycle time
+ * are rounded away, so the relay never switches faster than the stove
+ * allows. Anti-windup: the integral only accumulates while the output is
+ * not saturated in the direction of the error, and is clamped to 0..1.
+ */
+class PiController
+{
+private:
+    float kp;
+    float tiSeconds;
+    unsigned long windowMs;
+    unsigned long minSegmentMs;
+
+    float integral;       // Integral term, already scaled to duty (0..1)
+    float output;         // Unquantized PI output at the last update
+    float duty;           // ON fraction applied to the current window
+    bool windowActive;
+    unsigned long windowStart;
+    bool hasLastUpdate;
+    unsigned long lastUpdateMs;
+    bool cutOff;          // Current window's ON period ended early (overshoot)
+
+    float quantize(float value) const;
+
+public:
+    /**
+     * @brief Constructor
+     * @param kp Proportional gain (duty per °F)
+     * @param tiSeconds Integral time (s)
+     * @param windowMs Time-proportioning window (ms)
+     * @param minSegmentMs Shortest allowed ON or OFF period (ms)
+     */
+    PiController(float kp = STOVE_PI_KP, float tiSeconds = STOVE_PI_TI_S,
+                 unsigned long windowMs = STOVE_PI_WINDOW_MS, unsigned long minSegmentMs = 180000);
+
+    /**
+     * @brief Forget the integral and restart windowing on the next update
+     */
+    void reset();
+
+    /**
+     * @brief Run the controller
+     * @param setpoint Desired temperature (°F)
+     * @param measured Current temperature (°F)
+     * @param nowMs Monotonic time (ms)
+     * @return true if the stove should be on right now
+     */
+    bool update(float setpoint, float measured, unsigned long nowMs);
+
+    /**
+     * @brief Get the ON fraction of the current window
+     * @return Duty 0..1
+     */
+    float getDuty() const;
+
+    /**
+     * @brief Get the unquantized PI output of the last update
+     * @return Output 0..1
+     */
+    float getOutput() const;
+
+    /**
+     * @brief Get the integral term
+     * @return Integral contribution to the output (0..1)
+     */
+    float getIntegral() const;
+};
@@ -0,0 +1,182 @@
+/**
+ * @file stove_logic.cpp
+ * @brief Stove decision implementation
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include <math.h>
+#include "stove_logic.hpp"
+
+StoveLogic::StoveLogic(unsigned long minChangeIntervalMs) : mode(STOVE_DEFAULT_CONTROL_MODE),
+                                                           tuning(STOVE_DEFAULT_TUNING),
+                                                           minChangeIntervalMs(minChangeIntervalMs),
+                                                           pi(tuning.piKp, tuning.piTiSeconds, tuning.piWindowMs,
+                                                              minChangeIntervalMs),
+                                                           solved(false),
+                                                           lastSolveMs(0),
+                                                           wasOn(false),
+                                                           onSinceMs(0),
+                                                           preheatEnabled(true)
+{
+}
+
+void StoveLogic::setControlMode(StoveControlMode newMode)
+{
+    if (newMode != mode)
+    {
+        mode = newMode;
+        pi.reset();
+        mpc.reset();
+        solved = false;
+        wasOn = false;
+    }
+}
+
+StoveControlMode StoveLogic::getControlMode() const
+{
+    return mode;
+}
+
+void StoveLogic::setTuning(const StoveTuning &newTuning)
+{
+    tuning = newTuning;
+    pi = PiController(tuning.piKp, tuning.piTiSeconds, tuning.piWindowMs, minChangeIntervalMs);
+}
+
+const StoveTuning &StoveLogic::getTuning() const
+{
+    return tuning;
+}
+
+void StoveLogic::setPreheatEnabled(bool enabled)
+{
+    preheatEnabled = enabled;
+}
+
+void StoveLogic::setForecast(const OutdoorForecast &newForecast)
+{
+    forecast = newForecast;
+}
+
+const OutdoorForecast &StoveLogic::getForecast() const
+{
+    return forecast;
+}
+
+void StoveLogic::observe(float temperature, bool stoveOn, unsigned long nowMs, int minuteOfWeek)
+{
+    model.observe(temperature, stoveOn, nowMs, (minuteOfWeek % SCHEDULE_MINUTES_PER_DAY) / 60.0f);
+}
+
+float StoveLogic::getPreheatTarget(const Schedule &schedule, float baseTemperature, float temperature,
+                                   float setpoint, int minuteOfWeek, int *targetMinute) const
+{
+    float hourOfDay = (minuteOfWeek % SCHEDULE_MINUTES_PER_DAY) / 60.0f;
+    float target = setpoint;
+    if (!preheatEnabled || mode == STOVE_CONTROL_MPC)
+    {
+        return target;
+    }
+
+    // Check each slot boundary inside the preheat horizon
+    int firstSlotMinute = minuteOfWeek - minuteOfWeek % SCHEDULE_SLOT_MINUTES + SCHEDULE_SLOT_MINUTES;
+    for (int slotMinute = firstSlotMinute; slotMinute - minuteOfWeek <= THERMAL_MODEL_MAX_PREHEAT_MIN;
+         slotMinute += SCHEDULE_SLOT_MINUTES)
+    {
+        float upcoming = baseTemperature + schedule.getOffset(slotMinute % SCHEDULE_MINUTES_PER_WEEK);
+        unsigned long minutesUntil = slotMinute - minuteOfWeek;
+
+        if (upcoming > target && model.getPreheatMinutes(temperature, upcoming, hourOfDay) >= minutesUntil)
+        {
+            target = upcoming;
+            if (targetMinute)
+            {
+                *targetMinute = slotMinute % SCHEDULE_MINUTES_PER_DAY;
+            }
+        }
+    }
+    return target;
+}
+
+bool StoveLogic::updatePlan(const Schedule &schedule, float baseTemperature, float temperature, bool isOn,
+                            unsigned long nowMs, int minuteOfWeek)
+{
+    if (mode != STOVE_CONTROL_MPC)
+    {
+        return false;
+    }
+    if (isOn && !wasOn)
+    {
+        onSinceMs = nowMs;
+    }
+    wasOn = isOn;
+    if (solved && nowMs - lastSolveMs < MPC_SOLVE_INTERVAL_MS)
+    {
+        return false;
+    }
+    solved = true;
+    lastSolveMs = nowMs;
+    return mpc.solve(model, schedule, baseTemperature, temperature, isOn, isOn ? nowMs - onSinceMs : 0, nowMs,
+                     minuteOfWeek, forecast);
+}
+
+bool StoveLogic::shouldBeOn(float target, float temperature, bool isOn, unsigned long nowMs)
+{
+    bool on;
+    if (mode == STOVE_CONTROL_PI)
+    {
+        on = pi.update(target, temperature, nowMs);
+    }
+    else if (mode == STOVE_CONTROL_MPC && mpc.hasPlan())
+    {
+        on = mpc.isOnAt(nowMs);
+    }
+    else
+    {
+        on = hysteresisShouldBeOn(target - temperature, isOn, tuning.hysteresisLow, tuning.hysteresisHigh);
+    }
+
+    // Over the safety limit the stove goes off, whatever the control law
+    if (temperature >= STOVE_SAFETY_MAX_TEMP)
+    {
+        on = false;
+        pi.reset();
+    }
+    return on;
+}
+
+float StoveLogic::getDecisionDistance(float target, float temperature) const
+{
+    float distance = fabsf(STOVE_SAFETY_MAX_TEMP - temperature);
+    if (mode == STOVE_CONTROL_PI)
+    {
+        distance = fminf(distance, fabsf(target - temperature));
+    }
+    else if (mode == STOVE_CONTROL_MPC && mpc.hasPlan())
+    {
+        distance = fminf(distance, fabsf(target - MPC_COLD_MARGIN_F - temperature));
+        distance = fminf(distance, fabsf(target + MPC_HOT_MARGIN_F - temperature));
+    }
+    else
+    {
+        distance = fminf(distance, fabsf(target - tuning.hysteresisLow - temperature));
+        distance = fminf(distance, fabsf(target - tuning.hysteresisHigh - temperature));
+    }
+    return distance;
+}
+
+const PiController &StoveLogic::getPiController() const
+{
+    return pi;
+}
+
+const MpcController &StoveLogic::getMpc() const
+{
+    return mpc;
+}
+
+const ThermalModel &StoveLogic::getThermalModel() const
+{
+    return model;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file stove_logic.hpp
+ * @brief Stove decisions (setpoint, optimal start, control law, safety) without I/O
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Plain C++ with no Arduino dependencies, so the host tools in tools/sim/
+ * run the same decisions Stove::update makes on the dial.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "stove_control.hpp"
+#include "mpc_controller.hpp"
+#include "thermal_model.hpp"
+#include "schedule.hpp"
+
+/**
+ * @class StoveLogic
+ * @brief What the stove should do, given the temperature, schedule and time
+ *
+ * Holds the controller state (control law, PI integrator, MPC plan, learned
+ * room model, outdoor forecast) but none of the I/O: Stove wraps it with the
+ * relay link, the minimum change interval, logging and the display.
+ */
+class StoveLogic
+{
+private:
+    StoveControlMode mode;
+    StoveTuning tuning;
+    unsigned long minChangeIntervalMs;
+    PiController pi;
+    ThermalModel model;
+    MpcController mpc;
+    OutdoorForecast forecast;
+    bool solved;                   // MPC: a solve has run since the mode was selected
+    unsigned long lastSolveMs;
+    bool wasOn;                    // MPC: stove state at the last updatePlan, and when it came on
+    unsigned long onSinceMs;
+    bool preheatEnabled;
+
+public:
+    /**
+     * @brief Constructor
+     * @param minChangeIntervalMs Shortest ON or OFF period the PI windows may ask for (ms)
+     */
+    StoveLogic(unsigned long minChangeIntervalMs = 180000);
+
+    /**
+     * @brief Select the control law (resets the PI controller and the MPC plan on a change)
+     * @param mode Hysteresis, PI or MPC
+     */
+    void setControlMode(StoveControlMode mode);
+
+    /**
+     * @brief Get the control law
+     * @return Current control mode
+     */
+    StoveControlMode getControlMode() const;
+
+    /**
+     * @brief Replace the control law parameters (resets the PI controller)
+     * @param tuning Hysteresis thresholds and PI gains
+     */
+    void setTuning(const StoveTuning &tuning);
+
+    /**
+     * @brief Get the control law parameters
+     * @return Tuning in use
+     */
+    const StoveTuning &getTuning() const;
+
+    /**
+     * @brief Enable or disable optimal-start preheating (on by default)
+     * @param enabled true to preheat for upcoming setpoints
+     */
+    void setPreheatEnabled(bool enabled);
+
+    /**
+     * @brief Feed one observation to the room model (call on every control update)
+     * @param temperature Room temperature (°F)
+     * @param stoveOn Whether the stove is on now
+     * @param nowMs Monotonic time (ms)
+     * @param minuteOfWeek Current minute of the week (0 = Sunday 00:00)
+     */
+    void observe(float temperature, bool stoveOn, unsigned long nowMs, int minuteOfWeek);
+
+    /**
+     * @brief Replace the outdoor forecast used by the MPC mode
+     * @param forecast Hourly outdoor temperatures (copied)
+     */
+    void setForecast(const OutdoorForecast &forecast);
+
+    /**
+     * @brief Get the outdoor forecast
+     * @return Forecast (empty until set)
+     */
+    const OutdoorForecast &getForecast() const;
+
+    /**
+     * @brief Optimal start: raise the target early when the model says the room needs it
+     * Looks ahead up to THERMAL_MODEL_MAX_PREHEAT_MIN for a higher scheduled
+     * setpoint that full heating would only just reach in time. The MPC mode
+     * plans ahead by itself and gets the setpoint back unchanged.
+     * @param schedule Week schedule
+     * @param baseTemperature Base temperature the schedule offsets apply to (°F)
+     * @param temperature Current temperature (°F)
+     * @param setpoint Setpoint scheduled for now (°F)
+     * @param minuteOfWeek Current minute of the week (0 = Sunday 00:00)
+     * @param targetMinute Receives the minute of the day being preheated for (optional)
+     * @return Temperature to control to (°F)
+     */
+    float getPreheatTarget(const Schedule &schedule, float baseTemperature, float temperature, float setpoint,
+                           int minuteOfWeek, int *targetMinute = nullptr) const;
+
+    /**
+     * @brief MPC mode: re-plan if MPC_SOLVE_INTERVAL_MS has passed (call before shouldBeOn)
+     * Does nothing in the other modes. Until the room model is trained there is
+     * no plan, and shouldBeOn falls back to hysteresis.
+     * @param schedule Week schedule
+     * @param baseTemperature Base temperature the schedule offsets apply to (°F)
+     * @param temperature Current temperature (°F)
+     * @param isOn Whether the stove is on (or switching on)
+     * @param nowMs Monotonic time (ms)
+     * @param minuteOfWeek Current minute of the week (0 = Sunday 00:00)
+     * @return true if a new plan was made (for timing the solve)
+     */
+    bool updatePlan(const Schedule &schedule, float baseTemperature, float temperature, bool isOn,
+                    unsigned long nowMs, int minuteOfWeek);
+
+    /**
+     * @brief Run the control law, then the safety limit
+     * At or above STOVE_SAFETY_MAX_TEMP the answer is always OFF and the PI
+     * controller is reset.
+     * @param target Temperature to control to (°F)
+     * @param temperature Current temperature (°F)
+     * @param isOn Whether the stove is on (or switching on)
+     * @param nowMs Monotonic time (ms)
+     * @return true if the stove should be on
+     */
+    bool shouldBeOn(float target, float temperature, bool isOn, unsigned long nowMs);
+
+    /**
+     * @brief How far the temperature is from the nearest point where the decision can change
+     * Hysteresis: its two thresholds. PI: the target, since the duty follows
+     * the error. MPC: the cold and hot margins around the target. The safety
+     * limit counts in every mode. Lets the sensor read coarser when far away.
+     * @param target Temperature being controlled to (°F)
+     * @param temperature Current temperature (°F)
+     * @return Distance (°F, never negative)
+     */
+    float getDecisionDistance(float target, float temperature) const;
+
+    /**
+     * @brief Get the PI controller (output, integral, window duty)
+     * @return PI controller
+     */
+    const PiController &getPiController() const;
+
+    /**
+     * @brief Get the MPC planner (current plan, cost, work done by the last solve)
+     * @return MPC planner
+     */
+    const MpcController &getMpc() const;
+
+    /**
+     * @brief Get the learned thermal model
+     * @return Thermal model
+     */
+    const ThermalModel &getThermalModel() const;
+};
@@ -16,12 +16,9 @@
 #include <M5Unified.h>
 #include "temp_sensor.hpp"
 
-// Global instance for easy access (using default I2C address 0x18 and highest resolution)
-TemperatureSensor tempSensor(0x18, MCP9808_Resolution::RES_0_0625C);
-
 TemperatureSensor::TemperatureSensor(uint8_t address, MCP9808_Resolution res)
     : i2cAddress(address), resolution(res), isAwake(false),
-      lastTemperatureC(NAN), lastTemperatureF(NAN), lastReadTime(0)
+      lastTemperatureC(NAN), lastTemperatureF(NAN), lastReadTime(0), wokeAtMs(0)
 {
 }
 
@@ -65,12 +62,9 @@ bool TemperatureSensor::setup()
 
 float TemperatureSensor::readTemperature()
 {
-    if (!isAwake)
-    {
-        wakeUp();
-        // Allow some time for the sensor to wake up and stabilize
-        delay(10);
-    }
+    // The first result after a wake is only valid once a full conversion has completed
+    startConversion();
+    delay(getMsUntilReady());
 
     // Read temperature in Celsius
     float temperature = mcp9808.readTempC();
@@ -91,20 +85,52 @@ float TemperatureSensor::readTemperature()
 }
 
 float TemperatureSensor::readTemperatureFahrenheit()
+{
+    startConversion();
+    delay(getMsUntilReady());
+
+    float temperature = NAN;
+    pollTemperatureFahrenheit(temperature);
+    return temperature;
+}
+
+void TemperatureSensor::startConversion()
 {
     if (!isAwake)
     {
         wakeUp();
-        delay(10);
+    }
+}
+
+bool TemperatureSensor::isConversionReady() const
+{
+    return isAwake && millis() - wokeAtMs >= getConversionTimeMs();
+}
+
+unsigned long TemperatureSensor::getMsUntilReady() const
+{
+    if (!isAwake)
+    {
+        return 0;
+    }
+    unsigned long elapsed = millis() - wokeAtMs;
+    return elapsed < getConversionTimeMs() ? getConversionTimeMs() - elapsed : 0;
+}
+
+bool TemperatureSensor::pollTemperatureFahrenheit(float &temperature)
+{
+    if (!isConversionReady())
+    {
+        return false;
     }
 
     // Read temperature in Fahrenheit directly from the sensor
-    float temperature = mcp9808.readTempF();
+    temperature = mcp9808.readTempF();
 
     if (isnan(temperature))
     {
         Serial.println("Invalid temperature reading");
-        return NAN;
+        return true;
     }
 
     // Cache the valid reading
@@ -112,7 +138,37 @@ float TemperatureSensor::readTemperatureFahrenheit()
     lastTemperatureC = (temperature - 32.0) * 5.0 / 9.0; // Convert to Celsius for cache
     lastReadTime = millis();
 
-    return temperature;
+    return true;
+}
+
+unsigned long TemperatureSensor::getConversionTimeMs() const
+{
+    return getConversionTimeMs(resolution);
+}
+
+unsigned long TemperatureSensor::getConversionTimeMs(MCP9808_Resolution res)
+{
+    return SensorPower::getConversionTimeMs(res);
+}
+
+unsigned long TemperatureSensor::getWokeAtMs() const
+{
+    return wokeAtMs;
+}
+
+void TemperatureSensor::setResolution(MCP9808_Resolution res)
+{
+    if (res == resolution)
+    {
+        return;
+    }
+    mcp9808.setResolution(getResolutionMode(res));
+    resolution = res;
+}
+
+MCP9808_Resolution TemperatureSensor::getResolution() const
+{
+    return resolution;
 }
 
 uint8_t TemperatureSensor::getI2CAddress() const
@@ -122,16 +178,16 @@ uint8_t TemperatureSensor::getI2CAddress() const
 
 void TemperatureSensor::wakeUp()
 {
-    mcp9808.wake();
+    // Adafruit's wake() also delays 260 ms; clear the shutdown bit and time the conversion instead
+    mcp9808.shutdown_wake(0);
     isAwake = true;
-    Serial.println("\nMCP9808 sensor woken up - ready to read!");
+    wokeAtMs = millis();
 }
 
 void TemperatureSensor::shutdown()
 {
     mcp9808.shutdown_wake(1); // 1 = shutdown mode
     isAwake = false;
-    Serial.println("MCP9808 sensor shutdown - low power mode");
 }
 
 bool TemperatureSensor::getAwakeStatus() const
@@ -18,18 +18,7 @@
 #include <M5Unified.h>
 #include <Wire.h>
 #include "Adafruit_MCP9808.h"
-
-/**
- * @enum MCP9808_Resolution
- * @brief Resolution modes for MCP9808 temperature sensor
- */
-enum class MCP9808_Resolution : uint8_t
-{
-    RES_0_5C = 0,   // 0.5°C resolution, 30 ms sample time
-    RES_0_25C = 1,  // 0.25°C resolution, 65 ms sample time
-    RES_0_125C = 2, // 0.125°C resolution, 130 ms sample time
-    RES_0_0625C = 3 // 0.0625°C resolution, 250 ms sample time
-};
+#include "sensor_power.hpp"
 
 /**
  * @class TemperatureSensor
@@ -49,6 +38,7 @@ private:
     float lastTemperatureC;        // Cached temperature reading in Celsius
     float lastTemperatureF;        // Cached temperature reading in Fahrenheit
     unsigned long lastReadTime;    // Timestamp of last sensor read
+    unsigned long wokeAtMs;        // When the current conversion run started (wake from shutdown)
 
     /**
      * @brief Convert resolution enum to resolution mode value
@@ -78,16 +68,65 @@ public:
 
     /**
      * @brief Read temperature from sensor in Celsius
+     * Blocks until a full conversion has completed (up to getConversionTimeMs()
+     * after a wake); the control loop uses startConversion()/pollTemperatureFahrenheit().
      * @return Temperature in Celsius
      */
     float readTemperature();
 
     /**
      * @brief Read temperature in Fahrenheit
+     * Blocks like readTemperature().
      * @return Temperature in Fahrenheit
      */
     float readTemperatureFahrenheit();
 
+    /**
+     * @brief Start a conversion without waiting for it
+     * Wakes the sensor if it is in shutdown; an awake sensor converts
+     * continuously and already holds a complete result.
+     */
+    void startConversion();
+
+    /**
+     * @brief Check whether a full conversion has completed since the sensor woke
+     * @return true if pollTemperatureFahrenheit() will read a result
+     */
+    bool isConversionReady() const;
+
+    /**
+     * @brief Milliseconds until a full conversion has completed
+     * @return 0 when ready (or in shutdown, where no conversion is running)
+     */
+    unsigned long getMsUntilReady() const;
+
+    /**
+     * @brief Read the result of the conversion, if it has completed
+     * Does no I2C traffic until then, so it never waits on the sensor.
+     * @param temperature Receives °F, NAN if the reading was invalid
+     * @return true once a result was read, false while still converting or in shutdown
+     */
+    bool pollTemperatureFahrenheit(float &temperature);
+
+    /**
+     * @brief Conversion time at the current resolution, with margin
+     * @return Milliseconds
+     */
+    unsigned long getConversionTimeMs() const;
+
+    /**
+     * @brief Conversion time at a resolution, with margin
+     * @param res Resolution
+     * @return Milliseconds
+     */
+    static unsigned long getConversionTimeMs(MCP9808_Resolution res);
+
+    /**
+     * @brief When the sensor last left shutdown
+     * @return millis() at the wake
+     */
+    unsigned long getWokeAtMs() const;
+
     /**
      * @brief Get last cached temperature reading in Celsius (no sensor read)
      * @return Last temperature reading in Celsius
@@ -95,8 +134,17 @@ public:
 
     /**
      * @brief Set the sensor resolution
+     * Takes effect from the next conversion; set it while in shutdown so the
+     * first result after the wake already uses it.
      * @param res New resolution setting
      */
+    void setResolution(MCP9808_Resolution res);
+
+    /**
+     * @brief Get the sensor resolution
+     * @return Current resolution setting
+     */
+    MCP9808_Resolution getResolution() const;
 
     /**
      * @brief Get the current I2C address
@@ -105,7 +153,7 @@ public:
     uint8_t getI2CAddress() const;
 
     /**
-     * @brief Wake up the sensor from shutdown mode
+     * @brief Wake up the sensor from shutdown mode (returns at once; see startConversion())
      */
     void wakeUp();
 
@@ -134,5 +182,4 @@ public:
     const char *getResolutionString() const;
 };
 
-// Global instance for easy access
-extern TemperatureSensor tempSensor;
\ No newline at end of file
+// Instances are owned by SensorArray (sensor_array.hpp), one per address found
\ No newline at end of file
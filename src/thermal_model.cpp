@@ -0,0 +1,247 @@
+/**
+ * @file thermal_model.cpp
+ * @brief Online first-order RC model implementation
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include <math.h>
+#include "thermal_model.hpp"
+
+// Prior: 6 hour time constant, 50°F ambient, stove adds 8°F/hour, no daily swing
+static const float PRIOR_THETA[THERMAL_MODEL_PARAMS] = {(50.0f - THERMAL_MODEL_REFERENCE_F) / 6.0f, -1.0f / 6.0f,
+                                                        8.0f, 0.0f, 0.0f};
+static const float PRIOR_VARIANCE[THERMAL_MODEL_PARAMS] = {100.0f, 0.01f, 100.0f, 10.0f, 10.0f};
+
+// Readings outside this range are sensor errors (e.g. the 999 "no reading yet" value)
+static const float MIN_VALID_TEMP = -40.0f;
+static const float MAX_VALID_TEMP = 150.0f;
+
+static const float TWO_PI_PER_DAY = 2.0f * (float)M_PI / 24.0f;
+
+ThermalModel::ThermalModel()
+{
+    reset();
+}
+
+void ThermalModel::reset()
+{
+    for (int i = 0; i < THERMAL_MODEL_PARAMS; i++)
+    {
+        theta[i] = PRIOR_THETA[i];
+        for (int j = 0; j < THERMAL_MODEL_PARAMS; j++)
+        {
+            P[i][j] = (i == j) ? PRIOR_VARIANCE[i] : 0.0f;
+        }
+    }
+    samples = 0;
+    heat = 0.0f;
+    sampling = false;
+    sampleStartMs = 0;
+    lastObserveMs = 0;
+    sampleStartTemp = 0.0f;
+    sampleStartHeat = 0.0f;
+    sampleStartHour = 0.0f;
+    lastError = 0.0f;
+    meanSquareError = 0.0f;
+}
+
+void ThermalModel::regressors(float temperature, float heatOutput, float hourOfDay, float *phi) const
+{
+    phi[0] = 1.0f;
+    phi[1] = temperature - THERMAL_MODEL_REFERENCE_F;
+    phi[2] = heatOutput;
+    phi[3] = sinf(hourOfDay * TWO_PI_PER_DAY);
+    phi[4] = cosf(hourOfDay * TWO_PI_PER_DAY);
+}
+
+float ThermalModel::rate(float temperature, float heatOutput, float hourOfDay) const
+{
+    float phi[THERMAL_MODEL_PARAMS];
+    regressors(temperature, heatOutput, hourOfDay, phi);
+
+    float result = 0.0f;
+    for (int i = 0; i < THERMAL_MODEL_PARAMS; i++)
+    {
+        result += theta[i] * phi[i];
+    }
+    return result;
+}
+
+void ThermalModel::observe(float temperature, bool stoveOn, unsigned long nowMs, float hourOfDay)
+{
+    if (temperature < MIN_VALID_TEMP || temperature > MAX_VALID_TEMP)
+    {
+        sampling = false; // Restart the interval around bad readings
+        return;
+    }
+
+    // Lagged heat output: the state since the previous call is the current one
+    if (sampling)
+    {
+        float minutes = (nowMs - lastObserveMs) / 60000.0f;
+        heat += ((stoveOn ? 1.0f : 0.0f) - heat) * (1.0f - expf(-minutes / THERMAL_MODEL_HEAT_LAG_MIN));
+    }
+    lastObserveMs = nowMs;
+
+    if (!sampling)
+    {
+        sampling = true;
+        sampleStartMs = nowMs;
+        sampleStartTemp = temperature;
+        sampleStartHeat = heat;
+        sampleStartHour = hourOfDay;
+        return;
+    }
+
+    unsigned long elapsed = nowMs - sampleStartMs;
+    if (elapsed < THERMAL_MODEL_SAMPLE_MS)
+    {
+        return;
+    }
+
+    // Regress the average rate over the interval. Temperature comes from the
+    // start only - the end reading is in the measured rate, and using it on
+    // both sides would bias the loss rate towards zero.
+    float hours = elapsed / 3600000.0f;
+    float midHour = fmodf(sampleStartHour + hours / 2.0f, 24.0f);
+    float phi[THERMAL_MODEL_PARAMS];
+    regressors(sampleStartTemp, (sampleStartHeat + heat) / 2.0f, midHour, phi);
+    fit(phi, (temperature - sampleStartTemp) / hours, hours);
+
+    sampleStartMs = nowMs;
+    sampleStartTemp = temperature;
+    sampleStartHeat = heat;
+    sampleStartHour = hourOfDay;
+}
+
+void ThermalModel::fit(const float *phi, float measuredRate, float hours)
+{
+    // Score the prediction before learning from it
+    float predictedRate = 0.0f;
+    for (int i = 0; i < THERMAL_MODEL_PARAMS; i++)
+    {
+        predictedRate += theta[i] * phi[i];
+    }
+    float innovation = measuredRate - predictedRate;
+    lastError = innovation * hours;
+    meanSquareError += THERMAL_MODEL_ERROR_ALPHA * (lastError * lastError - meanSquareError);
+
+    // RLS update: k = P*phi / (lambda + phi'*P*phi)
+    float Pphi[THERMAL_MODEL_PARAMS];
+    float trace = 0.0f;
+    float denominator = 0.0f;
+    for (int i = 0; i < THERMAL_MODEL_PARAMS; i++)
+    {
+        Pphi[i] = 0.0f;
+        for (int j = 0; j < THERMAL_MODEL_PARAMS; j++)
+        {
+            Pphi[i] += P[i][j] * phi[j];
+        }
+        trace += P[i][i];
+        denominator += phi[i] * Pphi[i];
+    }
+    float lambda = trace < THERMAL_MODEL_MAX_TRACE ? THERMAL_MODEL_FORGETTING : 1.0f;
+    denominator += lambda;
+
+    for (int i = 0; i < THERMAL_MODEL_PARAMS; i++)
+    {
+        theta[i] += Pphi[i] / denominator * innovation;
+    }
+    for (int i = 0; i < THERMAL_MODEL_PARAMS; i++)
+    {
+        for (int j = 0; j < THERMAL_MODEL_PARAMS; j++)
+        {
+            P[i][j] = (P[i][j] - Pphi[i] * Pphi[j] / denominator) / lambda;
+        }
+    }
+
+    samples++;
+}
+
+bool ThermalModel::isTrained() const
+{
+    // Heat must leak out (c1 < 0) and the stove must add heat (c2 > 0)
+    return samples >= THERMAL_MODEL_MIN_SAMPLES && theta[1] < 0.0f && theta[2] > 0.0f;
+}
+
+float ThermalModel::predict(float temperature, bool stoveOn, float hours, float hourOfDay) const
+{
+    const float stepHours = THERMAL_MODEL_PREDICT_STEP_MIN / 60.0f;
+    const float heatStep = 1.0f - expf(-THERMAL_MODEL_PREDICT_STEP_MIN / THERMAL_MODEL_HEAT_LAG_MIN);
+    float h = heat;
+
+    for (float elapsed = 0.0f; elapsed < hours; elapsed += stepHours)
+    {
+        float step = (hours - elapsed) < stepHours ? (hours - elapsed) : stepHours;
+        temperature += rate(temperature, h, fmodf(hourOfDay + elapsed, 24.0f)) * step;
+        h += ((stoveOn ? 1.0f : 0.0f) - h) * heatStep;
+    }
+    return temperature;
+}
+
+unsigned long ThermalModel::getPreheatMinutes(float temperature, float target, float hourOfDay) const
+{
+    if (temperature >= target || !isTrained())
+    {
+        return 0;
+    }
+
+    // Step forward at full fire until the target is reached
+    const float stepHours = THERMAL_MODEL_PREDICT_STEP_MIN / 60.0f;
+    const float heatStep = 1.0f - expf(-THERMAL_MODEL_PREDICT_STEP_MIN / THERMAL_MODEL_HEAT_LAG_MIN);
+    float h = heat;
+    unsigned long minutes = 0;
+
+    while (temperature < target)
+    {
+        if (minutes + THERMAL_MODEL_PREHEAT_MARGIN_MIN >= THERMAL_MODEL_MAX_PREHEAT_MIN)
+        {
+            return THERMAL_MODEL_MAX_PREHEAT_MIN;
+        }
+        temperature += rate(temperature, h, fmodf(hourOfDay + minutes / 60.0f, 24.0f)) * stepHours;
+        h += (1.0f - h) * heatStep;
+        minutes += THERMAL_MODEL_PREDICT_STEP_MIN;
+    }
+    return minutes + THERMAL_MODEL_PREHEAT_MARGIN_MIN;
+}
+
+float ThermalModel::getTimeConstantHours() const
+{
+    return theta[1] < 0.0f ? -1.0f / theta[1] : 0.0f;
+}
+
+float ThermalModel::getAmbientTemperature() const
+{
+    return theta[1] < 0.0f ? THERMAL_MODEL_REFERENCE_F - theta[0] / theta[1] : 0.0f;
+}
+
+float ThermalModel::getHeatingRate() const
+{
+    return theta[2];
+}
+
+float ThermalModel::getDriftRate(float hourOfDay) const
+{
+    return rate(THERMAL_MODEL_REFERENCE_F, 0.0f, hourOfDay);
+}
+
+float ThermalModel::getHeatOutput() const
+{
+    return heat;
+}
+
+float ThermalModel::getRmsError() const
+{
+    return sqrtf(meanSquareError);
+}
+
+float ThermalModel::getLastError() const
+{
+    return lastError;
+}
+
+uint32_t ThermalModel::getSampleCount() const
+{
+    return samples;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file thermal_model.hpp
+ * @brief Online first-order RC model of the room for optimal-start preheating
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Plain C++ with no Arduino dependencies (builds in tools/sim/).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Model configuration
+#define THERMAL_MODEL_SAMPLE_MS 600000UL    // Fit one sample every 10 minutes
+#define THERMAL_MODEL_HEAT_LAG_MIN 45.0f    // Stove heat release lag - match to how long the stove body stays hot
+#define THERMAL_MODEL_FORGETTING 0.998f     // RLS forgetting factor (memory ~500 samples, ~3.5 days)
+#define THERMAL_MODEL_MAX_TRACE 1.0e4f      // Stop forgetting when the covariance grows this large
+#define THERMAL_MODEL_MIN_SAMPLES 36        // Samples (6 hours) before the model is trusted
+#define THERMAL_MODEL_ERROR_ALPHA 0.05f     // EWMA weight of the prediction error
+#define THERMAL_MODEL_MAX_PREHEAT_MIN 180   // Never start more than 3 hours early
+#define THERMAL_MODEL_PREHEAT_MARGIN_MIN 10 // Extra lead time on top of the prediction
+#define THERMAL_MODEL_PREDICT_STEP_MIN 5    // Integration step for predictions
+#define THERMAL_MODEL_REFERENCE_F 65.0f     // Temperatures are centered here for numerical conditioning
+#define THERMAL_MODEL_PARAMS 5
+
+/**
+ * @class ThermalModel
+ * @brief Recursive least-squares fit of a first-order RC room model
+ *
+ * dT/dt = c0 + c1*(T - Tref) + c2*h + c3*sin(w*t) + c4*cos(w*t)
+ *
+ * T is the room temperature (°F), Tref is THERMAL_MODEL_REFERENCE_F and rates
+ * are in °F per hour. h is the stove's heat output: its ON/OFF state passed
+ * through a first-order lag of THERMAL_MODEL_HEAT_LAG_MIN, because a
+ * high-mass stove keeps heating after it is switched off. The sin/cos terms
+ * at one cycle per day absorb the outdoor temperature and sun, which the
+ * thermostat can't measure; without them the daily swing, which lines up
+ * with the schedule, is mistaken for the room's own dynamics.
+ *
+ * The room relaxes towards Tref - c0/c1 (daily mean) with time constant
+ * -1/c1 hours. Memory is constant (a 5x5 covariance); old behaviour fades
+ * out through the forgetting factor so the model follows the seasons.
+ */
+class ThermalModel
+{
+private:
+    float theta[THERMAL_MODEL_PARAMS];                     // c0..c4 (see class description)
+    float P[THERMAL_MODEL_PARAMS][THERMAL_MODEL_PARAMS];   // Parameter covariance
+    uint32_t samples;                                      // Samples fitted since reset
+    float heat;                                            // Lagged stove output 0..1
+
+    // Current sample interval
+    bool sampling;
+    unsigned long sampleStartMs;
+    unsigned long lastObserveMs;
+    float sampleStartTemp;
+    float sampleStartHeat;
+    float sampleStartHour;
+
+    // Prediction quality
+    float lastError;   // Measured minus predicted temperature at the last sample (°F)
+    float meanSquareError;
+
+    void regressors(float temperature, float heatOutput, float hourOfDay, float *phi) const;
+    float rate(float temperature, float heatOutput, float hourOfDay) const;
+    void fit(const float *phi, float measuredRate, float hours);
+
+public:
+    /**
+     * @brief Constructor
+     */
+    ThermalModel();
+
+    /**
+     * @brief Forget everything learned and restart from the default prior
+     */
+    void reset();
+
+    /**
+     * @brief Feed one observation (call on every control update)
+     * @param temperature Room temperature (°F)
+     * @param stoveOn Whether the stove is on now
+     * @param nowMs Monotonic time (ms)
+     * @param hourOfDay Local time of day in hours (0 to <24)
+     */
+    void observe(float temperature, bool stoveOn, unsigned long nowMs, float hourOfDay);
+
+    /**
+     * @brief Check whether the model has seen enough data and is physically plausible
+     * @return true if predictions can be used
+     */
+    bool isTrained() const;
+
+    /**
+     * @brief Predict the temperature after holding the stove on or off
+     * Starts from the stove's current (lagged) heat output.
+     * @param temperature Starting temperature (°F)
+     * @param stoveOn Stove state for the whole horizon
+     * @param hours Prediction horizon (hours)
+     * @param hourOfDay Time of day at the start (hours)
+     * @return Predicted temperature (°F)
+     */
+    float predict(float temperature, bool stoveOn, float hours, float hourOfDay) const;
+
+    /**
+     * @brief Minutes of full heating needed to go from one temperature to another
+     * Includes THERMAL_MODEL_PREHEAT_MARGIN_MIN. Returns 0 if already there or the
+     * model isn't trained yet, and THERMAL_MODEL_MAX_PREHEAT_MIN if the target
+     * can't be reached within that time.
+     * @param temperature Current temperature (°F)
+     * @param target Target temperature (°F)
+     * @param hourOfDay Time of day now (hours)
+     * @return Lead time in minutes
+     */
+    unsigned long getPreheatMinutes(float temperature, float target, float hourOfDay) const;
+
+    /**
+     * @brief Room time constant, 1/(heat loss rate)
+     * @return Hours, or 0 if not plausible
+     */
+    float getTimeConstantHours() const;
+
+    /**
+     * @brief Daily mean temperature the room settles at with the stove off
+     * @return °F, or 0 if not plausible
+     */
+    float getAmbientTemperature() const;
+
+    /**
+     * @brief Rate at which the stove raises the room temperature, before losses
+     * @return °F per hour at full output
+     */
+    float getHeatingRate() const;
+
+    /**
+     * @brief Rate of change at THERMAL_MODEL_REFERENCE_F with the stove cold
+     * The part of the rate that comes from outside (c0 plus the daily terms);
+     * add c1*(T - Tref) and the heating term for the full rate.
+     * @param hourOfDay Time of day (hours)
+     * @return °F per hour
+     */
+    float getDriftRate(float hourOfDay) const;
+
+    /**
+     * @brief Stove heat output after the lag, as the model tracks it
+     * @return 0 (cold) to 1 (full fire)
+     */
+    float getHeatOutput() const;
+
+    /**
+     * @brief RMS one-sample prediction error (EWMA)
+     * @return °F per THERMAL_MODEL_SAMPLE_MS
+     */
+    float getRmsError() const;
+
+    /**
+     * @brief Prediction error of the most recent sample
+     * @return Measured minus predicted (°F)
+     */
+    float getLastError() const;
+
+    /**
+     * @brief Number of samples fitted
+     * @return Sample count
+     */
+    uint32_t getSampleCount() const;
+};
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""
+@file decode_journal.py
+@brief Decode the receiver's flash event journal
+@version 1.0.0
+@date 2026-10-17
+
+Usage:
+    python tools/decode_journal.py --port COM5          # send DUMP and decode (needs pyserial)
+    python tools/decode_journal.py capture.bin          # decode a saved dump
+    python tools/decode_journal.py capture.bin --csv    # CSV output for spreadsheets
+
+Record layout must match JournalRecord in receiver/src/event_journal.hpp.
+"""
+
+import argparse
+import struct
+import sys
+
+RECORD = struct.Struct("<IIBBBBhbB")  # 16 bytes, little endian
+ERASED_SEQUENCE = 0xFFFFFFFF
+
+EVENT_NAMES = {1: "BOOT", 2: "COMMAND", 3: "RELAY", 4: "SAFETY_TIMEOUT", 5: "LINK", 6: "HEATER_FAULT"}
+COMMAND_NAMES = {0: "UNKNOWN", 1: "STOVE_ON", 2: "STOVE_OFF", 3: "STATUS_REQUEST"}
+HEATER_FAULTS = {0: "cleared", 1: "NO HEAT", 2: "STUCK ON"}
+RESET_REASONS = {0: "unknown", 1: "power-on", 2: "external", 3: "software", 4: "panic",
+                 5: "int-wdt", 6: "task-wdt", 7: "wdt", 8: "deep-sleep", 9: "brownout", 10: "sdio"}
+
+
+def crc8(data):
+    """CRC-8, polynomial 0x07 - same as EventJournal::crc8."""
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def extract_payload(raw):
+    """Return the binary records between the BEGIN and END markers."""
+    begin = raw.find(b"JOURNAL BEGIN")
+    if begin < 0:
+        raise ValueError("no 'JOURNAL BEGIN' marker found")
+    start = raw.index(b"\n", begin) + 1
+    end = raw.rfind(b"JOURNAL END")
+    if end < start:
+        raise ValueError("no 'JOURNAL END' marker found")
+    header = raw[begin:start].split()
+    expected = int(header[2]) if len(header) > 2 else None
+    return raw[start:end], expected
+
+
+def parse_records(payload):
+    """Parse records, skipping bytes that fail the CRC (e.g. interleaved log lines)."""
+    records = []
+    skipped = 0
+    offset = 0
+    while offset + RECORD.size <= len(payload):
+        chunk = payload[offset:offset + RECORD.size]
+        fields = RECORD.unpack(chunk)
+        if fields[0] != ERASED_SEQUENCE and crc8(chunk[:-1]) == fields[-1]:
+            records.append(fields)
+            offset += RECORD.size
+        else:
+            skipped += 1
+            offset += 1
+    records.sort(key=lambda r: r[0])
+    return records, skipped
+
+
+def describe(record):
+    sequence, uptime_ms, boot, event, channel, code, value1, value2, _ = record
+    if event == 1:
+        return "reset=%s channels=%d" % (RESET_REASONS.get(code, code), value1)
+    if event == 2:
+        return "node=%d cmd=%s rssi=%d snr=%d" % (channel, COMMAND_NAMES.get(code, code), value1, value2)
+    if event == 3:
+        return "channel=%d state=%s%s" % (channel, "ON" if code else "OFF", " (resumed after reset)" if value1 == 1 else "")
+    if event == 4:
+        return "channel=%d cutoff latency=%d ms" % (channel, value1)
+    if event == 5:
+        return "rssi=%d snr=%d" % (value1, value2)
+    if event == 6:
+        return "channel=%d alarm=%s" % (channel, HEATER_FAULTS.get(code, code))
+    return "code=%d value1=%d value2=%d" % (code, value1, value2)
+
+
+def format_uptime(ms):
+    seconds, ms = divmod(ms, 1000)
+    minutes, seconds = divmod(seconds, 60)
+    hours, minutes = divmod(minutes, 60)
+    return "%d:%02d:%02d.%03d" % (hours, minutes, seconds, ms)
+
+
+def read_from_port(port, baud):
+    import serial  # pyserial, only needed for live dumps
+
+    with serial.Serial(port, baud, timeout=5) as link:
+        link.reset_input_buffer()
+        link.write(b"DUMP\n")
+        data = bytearray()
+        while b"JOURNAL END" not in data and b"JOURNAL UNAVAILABLE" not in data:
+            chunk = link.read(4096)
+            if not chunk:
+                raise TimeoutError("receiver stopped sending before 'JOURNAL END'")
+            data.extend(chunk)
+        return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode the receiver event journal")
+    parser.add_argument("capture", nargs="?", help="saved dump (raw serial capture)")
+    parser.add_argument("--port", help="serial port of the receiver, e.g. COM5 or /dev/ttyACM0")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--csv", action="store_true", help="print CSV instead of a table")
+    args = parser.parse_args()
+
+    if args.port:
+        raw = read_from_port(args.port, args.baud)
+    elif args.capture:
+        with open(args.capture, "rb") as f:
+            raw = f.read()
+    else:
+        parser.error("give a capture file or --port")
+
+    payload, expected = extract_payload(raw)
+    records, skipped = parse_records(payload)
+
+    if args.csv:
+        print("sequence,boot,uptime_ms,event,channel,code,value1,value2")
+        for r in records:
+            print("%d,%d,%d,%s,%d,%d,%d,%d" % (r[0], r[2], r[1], EVENT_NAMES.get(r[3], r[3]), r[4], r[5], r[6], r[7]))
+    else:
+        for r in records:
+            print("%8d  boot %3d  %13s  %-15s %s" % (r[0], r[2], format_uptime(r[1]),
+                                                     EVENT_NAMES.get(r[3], r[3]), describe(r)))
+
+    summary = "%d records" % len(records)
+    if expected is not None and expected != len(records):
+        summary += " (receiver reported %d)" % expected
+    if skipped:
+        summary += ", skipped %d stray bytes" % skipped
+    print(summary, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
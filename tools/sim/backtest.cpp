@@ -0,0 +1,428 @@
+/**
+ * @file backtest.cpp
+ * @brief Host replay of recorded thermostat traces through the control logic
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * Reads the TRACE lines the dial prints with STOVE_TRACE set to 1 in
+ * src/stove.hpp (other serial output in the capture is skipped). It does two
+ * things:
+ *
+ * 1. Open loop: every line is fed to StoveLogic with the recorded
+ *    temperature, target and relay state. Its decision is compared with the
+ *    one the dial logged. With the shipped tuning any disagreement means the
+ *    host build and the firmware no longer decide alike.
+ *
+ * 2. Closed loop: alternative hysteresis and PI tunings run against the
+ *    recorded room. The difference their stove makes is added on top of the
+ *    recorded temperature. That difference comes from the room's time
+ *    constant and heating rate, which are fitted from the trace by
+ *    ThermalModel. Weather, sun and doors stay exactly as recorded. Each
+ *    candidate is scored on comfort, runtime and cycles.
+ *
+ * Build and run on the host (no Arduino needed):
+ *     g++ -std=c++17 -O2 -Isrc tools/sim/backtest.cpp src/stove_logic.cpp src/stove_control.cpp \
+ *         src/mpc_controller.cpp src/thermal_model.cpp src/schedule.cpp src/csv_reader.cpp -o backtest
+ *     ./backtest capture.log [--band 1.0] [--hysteresis LOW:HIGH ...] [--pi KP:TI_MIN ...]
+ *
+ * Without --hysteresis/--pi a built-in grid around the shipped tuning is scored.
+ * tools/sim/house_sim --trace writes a synthetic trace in the same format.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "stove_logic.hpp"
+#include "csv_reader.hpp"
+
+static const unsigned long MIN_CHANGE_MS = 180000; // Stove::minChangeInterval
+static const uint32_t MAX_GAP_MS = 600000;         // Longer gaps (reboots, lost capture) restart the replay
+static const double MCP9808_STEP_F = 0.0625 * 1.8; // Sensor resolution at RES_0_0625C
+static const int MAX_CANDIDATES = 32;
+
+struct TraceLine
+{
+    uint32_t ms;
+    int minuteOfWeek;
+    float temperature;
+    float setpoint;
+    float target;
+    int mode;
+    bool on;
+    bool decision;
+};
+
+struct Candidate
+{
+    char name[32];
+    StoveControlMode mode;
+    StoveTuning tuning;
+};
+
+struct Score
+{
+    double agreement;   // Open loop: fraction of lines where the decision matches the log
+    long disagreements;
+    double coldDegMin;  // Closed loop: °F x minutes below the band
+    double hotDegMin;
+    double runtimeHours;
+    long cycles;
+    double maxTemperature;
+};
+
+struct FileSource
+{
+    FILE *file;
+};
+
+static int readFile(void *context, uint8_t *buffer, size_t size)
+{
+    FILE *file = static_cast<FileSource *>(context)->file;
+    size_t count = fread(buffer, 1, size, file);
+    return ferror(file) ? -1 : (int)count;
+}
+
+static bool loadTrace(const char *path, std::vector<TraceLine> &trace)
+{
+    FileSource source = {fopen(path, "rb")};
+    if (!source.file)
+    {
+        fprintf(stderr, "Cannot open trace %s\n", path);
+        return false;
+    }
+
+    // No error callback: the capture is mostly ordinary log output
+    CsvReader reader(readFile, &source);
+    long rejected = 0;
+    while (reader.next())
+    {
+        if (!reader.fieldEquals(0, "TRACE"))
+        {
+            continue;
+        }
+        long ms, minute, mode;
+        size_t stateLength;
+        TraceLine line;
+        const char *state = reader.getField(7, stateLength); // Relay and decision, e.g. "10"
+        if (reader.getFieldCount() < 8 || !reader.getInt(1, ms) || !reader.getInt(2, minute) ||
+            !reader.getFloat(3, line.temperature) || !reader.getFloat(4, line.setpoint) ||
+            !reader.getFloat(5, line.target) || !reader.getInt(6, mode) || stateLength != 2 ||
+            (state[0] != '0' && state[0] != '1') || (state[1] != '0' && state[1] != '1'))
+        {
+            rejected++; // Usually a line cut by other output
+            continue;
+        }
+        line.ms = (uint32_t)ms;
+        line.minuteOfWeek = (int)minute;
+        line.mode = (int)mode;
+        line.on = state[0] == '1';
+        line.decision = state[1] == '1';
+        trace.push_back(line);
+    }
+    fclose(source.file);
+
+    if (rejected)
+    {
+        fprintf(stderr, "%s: skipped %ld garbled TRACE lines\n", path, rejected);
+    }
+    if (trace.size() < 2)
+    {
+        fprintf(stderr, "%s: no TRACE lines (set STOVE_TRACE to 1 in src/stove.hpp)\n", path);
+        return false;
+    }
+    return true;
+}
+
+static Score replay(const std::vector<TraceLine> &trace, const Candidate &candidate, double tauHours,
+                    double heatingRate, double band)
+{
+    Score s = {};
+    s.maxTemperature = -1e9;
+
+    // Open loop: same inputs the dial had
+    StoveLogic openLoop(MIN_CHANGE_MS);
+    openLoop.setControlMode(candidate.mode);
+    openLoop.setTuning(candidate.tuning);
+    uint64_t clockMs = 0;
+    for (size_t i = 0; i < trace.size(); i++)
+    {
+        const TraceLine &line = trace[i];
+        clockMs += i ? (uint32_t)(line.ms - trace[i - 1].ms) : 0;
+        bool decision = openLoop.shouldBeOn(line.target, line.temperature, line.on, (unsigned long)clockMs);
+        if (decision != line.decision)
+        {
+            s.disagreements++;
+        }
+    }
+    s.agreement = 1.0 - (double)s.disagreements / trace.size();
+
+    // Closed loop: recorded room plus the effect of this candidate's stove
+    StoveLogic logic(MIN_CHANGE_MS);
+    logic.setControlMode(candidate.mode);
+    logic.setTuning(candidate.tuning);
+    double lagHours = THERMAL_MODEL_HEAT_LAG_MIN / 60.0;
+    double heatRecorded = 0.0, heatCandidate = 0.0, delta = 0.0;
+    bool on = trace[0].on;
+    uint64_t lastChangeMs = 0;
+    bool changedOnce = false;
+    bool coasting = false;
+    clockMs = 0;
+
+    for (size_t i = 0; i < trace.size(); i++)
+    {
+        const TraceLine &line = trace[i];
+        uint32_t stepMs = i ? (uint32_t)(line.ms - trace[i - 1].ms) : 0;
+        if (stepMs > MAX_GAP_MS)
+        {
+            // Lost data: restart from the recorded state
+            delta = 0.0;
+            heatCandidate = heatRecorded;
+            on = line.on;
+            stepMs = 0;
+        }
+        clockMs += stepMs;
+        double hours = stepMs / 3600000.0;
+
+        // Linear room: the candidate's extra heat decays with the room's time constant
+        bool recordedOn = trace[i ? i - 1 : 0].on;
+        double blend = 1.0 - std::exp(-hours / lagHours);
+        heatRecorded += ((recordedOn ? 1.0 : 0.0) - heatRecorded) * blend;
+        heatCandidate += ((on ? 1.0 : 0.0) - heatCandidate) * blend;
+        delta = delta * std::exp(-hours / tauHours) + heatingRate * (heatCandidate - heatRecorded) * hours;
+
+        double room = line.temperature + delta;
+        float measured = (float)(std::round(room / MCP9808_STEP_F) * MCP9808_STEP_F);
+
+        bool want = logic.shouldBeOn(line.target, measured, on, (unsigned long)clockMs);
+        bool allowed = !changedOnce || clockMs - lastChangeMs >= MIN_CHANGE_MS;
+        bool safetyTrip = on && measured >= STOVE_SAFETY_MAX_TEMP;
+        if (want != on && (allowed || safetyTrip))
+        {
+            on = want;
+            lastChangeMs = clockMs;
+            changedOnce = true;
+            if (on)
+            {
+                s.cycles++;
+            }
+        }
+
+        // Score against the schedule, not the preheat target
+        if (i && line.setpoint < trace[i - 1].setpoint)
+        {
+            coasting = true;
+        }
+        double below = (line.setpoint - band) - room;
+        double above = room - (line.setpoint + band);
+        if (coasting && above <= 0.0)
+        {
+            coasting = false;
+        }
+        if (below > 0)
+        {
+            s.coldDegMin += below * hours * 60.0;
+        }
+        if (above > 0 && !coasting)
+        {
+            s.hotDegMin += above * hours * 60.0;
+        }
+        if (on)
+        {
+            s.runtimeHours += hours;
+        }
+        s.maxTemperature = std::fmax(s.maxTemperature, room);
+    }
+    return s;
+}
+
+static Score scoreRecorded(const std::vector<TraceLine> &trace, double band)
+{
+    Score s = {};
+    s.agreement = 1.0;
+    s.maxTemperature = -1e9;
+    bool coasting = false;
+    for (size_t i = 1; i < trace.size(); i++)
+    {
+        const TraceLine &line = trace[i];
+        const TraceLine &previous = trace[i - 1];
+        uint32_t stepMs = line.ms - previous.ms;
+        double hours = stepMs > MAX_GAP_MS ? 0.0 : stepMs / 3600000.0;
+        if (line.on && !previous.on)
+        {
+            s.cycles++;
+        }
+        if (line.setpoint < previous.setpoint)
+        {
+            coasting = true;
+        }
+        double below = (line.setpoint - band) - line.temperature;
+        double above = line.temperature - (line.setpoint + band);
+        if (coasting && above <= 0.0)
+        {
+            coasting = false;
+        }
+        if (below > 0)
+        {
+            s.coldDegMin += below * hours * 60.0;
+        }
+        if (above > 0 && !coasting)
+        {
+            s.hotDegMin += above * hours * 60.0;
+        }
+        if (previous.on)
+        {
+            s.runtimeHours += hours;
+        }
+        s.maxTemperature = std::fmax(s.maxTemperature, line.temperature);
+    }
+    return s;
+}
+
+static void print(const char *name, const Score &s)
+{
+    printf("%-20s %8.2f%% %8ld %10.0f %10.0f %9.1f %7ld %7.1f\n", name, s.agreement * 100.0, s.disagreements,
+           s.coldDegMin, s.hotDegMin, s.runtimeHours, s.cycles, s.maxTemperature);
+}
+
+static bool addCandidate(Candidate *candidates, int &count, StoveControlMode mode, float a, float b)
+{
+    if (count >= MAX_CANDIDATES)
+    {
+        return false;
+    }
+    Candidate &c = candidates[count++];
+    c.mode = mode;
+    c.tuning = STOVE_DEFAULT_TUNING;
+    if (mode == STOVE_CONTROL_HYSTERESIS)
+    {
+        c.tuning.hysteresisLow = a;
+        c.tuning.hysteresisHigh = b;
+        snprintf(c.name, sizeof(c.name), "hyst %.1f/%.1f", a, b);
+    }
+    else
+    {
+        c.tuning.piKp = a;
+        c.tuning.piTiSeconds = b * 60.0f;
+        snprintf(c.name, sizeof(c.name), "PI kp %.2f ti %.0fm", a, b);
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    const char *tracePath = nullptr;
+    double band = 1.0;
+    double tauHours = 0.0, heatingRate = 0.0; // 0 = fit from the trace
+    Candidate candidates[MAX_CANDIDATES];
+    int count = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        float a, b;
+        if (!strcmp(argv[i], "--band") && hasValue)
+            band = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--tau") && hasValue)
+            tauHours = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--heating") && hasValue)
+            heatingRate = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--hysteresis") && hasValue && sscanf(argv[++i], "%f:%f", &a, &b) == 2)
+            addCandidate(candidates, count, STOVE_CONTROL_HYSTERESIS, a, b);
+        else if (!strcmp(argv[i], "--pi") && hasValue && sscanf(argv[++i], "%f:%f", &a, &b) == 2)
+            addCandidate(candidates, count, STOVE_CONTROL_PI, a, b);
+        else if (argv[i][0] != '-' && !tracePath)
+            tracePath = argv[i];
+        else
+        {
+            fprintf(stderr, "usage: %s capture.log [--band F] [--tau HOURS] [--heating F_PER_HOUR]\n"
+                            "          [--hysteresis LOW:HIGH ...] [--pi KP:TI_MINUTES ...]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (!tracePath)
+    {
+        fprintf(stderr, "usage: %s capture.log [options]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<TraceLine> trace;
+    if (!loadTrace(tracePath, trace))
+    {
+        return 1;
+    }
+
+    auto started = std::chrono::steady_clock::now();
+
+    // Fit the room from the recording itself
+    ThermalModel model;
+    uint64_t clockMs = 0;
+    double traceHours = 0.0;
+    for (size_t i = 0; i < trace.size(); i++)
+    {
+        uint32_t stepMs = i ? (uint32_t)(trace[i].ms - trace[i - 1].ms) : 0;
+        clockMs += stepMs;
+        traceHours += stepMs > MAX_GAP_MS ? 0.0 : stepMs / 3600000.0;
+        model.observe(trace[i].temperature, trace[i].on, (unsigned long)clockMs,
+                      (trace[i].minuteOfWeek % SCHEDULE_MINUTES_PER_DAY) / 60.0f);
+    }
+    bool fitted = model.isTrained();
+    if (tauHours <= 0)
+    {
+        tauHours = fitted ? model.getTimeConstantHours() : 6.0;
+    }
+    if (heatingRate <= 0)
+    {
+        heatingRate = fitted ? model.getHeatingRate() : 8.0;
+    }
+
+    // Shipped tuning in the logged mode first, then the grid or the candidates given. MPC
+    // plans from the schedule and the forecast, which the trace doesn't carry, so an MPC
+    // trace is compared against the shipped hysteresis instead.
+    bool loggedMpc = trace.back().mode == STOVE_CONTROL_MPC;
+    StoveControlMode loggedMode = trace.back().mode == STOVE_CONTROL_PI ? STOVE_CONTROL_PI : STOVE_CONTROL_HYSTERESIS;
+    Candidate shipped = {"shipped", loggedMode, STOVE_DEFAULT_TUNING};
+    if (count == 0)
+    {
+        static const float LOW[] = {1.0f, 1.5f, 2.0f, 3.0f};
+        static const float HIGH[] = {0.0f, 0.5f, 1.0f};
+        static const float KP[] = {0.15f, 0.25f, 0.4f};
+        static const float TI_MIN[] = {45.0f, 90.0f, 180.0f};
+        for (float low : LOW)
+            for (float high : HIGH)
+                addCandidate(candidates, count, STOVE_CONTROL_HYSTERESIS, low, high);
+        for (float kp : KP)
+            for (float ti : TI_MIN)
+                addCandidate(candidates, count, STOVE_CONTROL_PI, kp, ti);
+    }
+
+    printf("%s: %zu lines, %.1f hours, logged mode %s\n", tracePath, trace.size(), traceHours,
+           loggedMpc ? "MPC (shipped row replays hysteresis)" : loggedMode == STOVE_CONTROL_PI ? "PI" : "hysteresis");
+    printf("Room %s: tau %.1f h, heating %.1f°F/h at full fire\n\n",
+           fitted ? "fitted from trace" : "not fitted (defaults)", tauHours, heatingRate);
+    printf("%-20s %9s %8s %10s %10s %9s %7s %7s\n", "candidate", "agree", "differ", "cold °Fmin", "hot °Fmin",
+           "runtime h", "cycles", "max °F");
+
+    print("recorded", scoreRecorded(trace, band));
+    Score shippedScore = replay(trace, shipped, tauHours, heatingRate, band);
+    print(shipped.name, shippedScore);
+    for (int i = 0; i < count; i++)
+    {
+        print(candidates[i].name, replay(trace, candidates[i], tauHours, heatingRate, band));
+    }
+
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    printf("\n%d replays of %.1f hours in %.2f s (%.0fx real time)\n", count + 1, traceHours, wall,
+           wall > 0 ? traceHours * 3600.0 * (count + 1) / wall : 0.0);
+    if (shippedScore.disagreements && !loggedMpc)
+    {
+        printf("Note: the shipped tuning disagrees with %ld logged decisions - firmware and host logic differ,\n"
+               "or the trace was recorded with other settings\n",
+               shippedScore.disagreements);
+    }
+    return 0;
+}
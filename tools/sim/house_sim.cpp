@@ -0,0 +1,851 @@
+/**
+ * @file house_sim.cpp
+ * @brief Host benchmark: the thermostat's control logic in a simulated house over a year
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * Runs StoveLogic (src/stove_logic.cpp) - schedule, optimal start, control
+ * law and safety limit, exactly as Stove::update uses them - against a
+ * multi-zone RC house with outdoor weather. Reports comfort (degree-minutes
+ * outside the band around the schedule), stove runtime and fuel, ON cycles
+ * and LoRa airtime. Deterministic for a given house file and seed, so saved
+ * results work as a regression baseline for controller changes.
+ *
+ * Build and run on the host (no Arduino needed):
+ *     g++ -std=c++17 -O2 -Isrc tools/sim/house_sim.cpp src/stove_logic.cpp src/stove_control.cpp \
+ *         src/mpc_controller.cpp src/thermal_model.cpp src/schedule.cpp src/csv_reader.cpp -o house_sim
+ *     ./house_sim [--house tools/sim/house.csv] [--schedule data/temps.csv] [--days 365]
+ *                 [--mode all|hysteresis|pi|mpc] [--save results.csv] [--check results.csv] [--tolerance 2]
+ *                 [--trace capture.log]
+ *
+ * The house file format is described in tools/sim/house.csv. --trace writes
+ * the first run as STOVE_TRACE lines, the input tools/sim/backtest.cpp reads.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "stove_logic.hpp"
+#include "csv_reader.hpp"
+
+// Simulation parameters
+static const double STEP_S = 10.0;                  // Physics and control loop period
+static const unsigned long MIN_CHANGE_MS = 180000;  // Stove::minChangeInterval
+static const unsigned long STATUS_INTERVAL_MS = 30000; // Stove::updateRemoteStatus
+static const double MCP9808_STEP_F = 0.0625 * 1.8;  // Sensor resolution at RES_0_0625C
+static const int MAX_ZONES = 8;
+static const int MAX_LINKS = 16;
+static const int HOURS_PER_YEAR = 8760;
+
+// LoRa airtime - match P2P_SPREADING_FACTOR etc. in shared/protocol_common.hpp
+static const int LORA_SF = 12;
+static const double LORA_BW_HZ = 125000.0;
+static const int LORA_CR = 1;                       // 4/5
+static const int LORA_PREAMBLE = 15;
+static const int STATUS_REQUEST_BYTES = 36;         // "STATUS_REQUEST;S=1;D=2;Q=12345"
+static const int STATUS_REPLY_BYTES = 44;           // "STOVE_OFF_ACK;RS=-87;SN=7;PE=0;S=2;D=1"
+static const int COMMAND_BYTES = 30;                // "STOVE_ON;S=1;D=2;Q=12345"
+static const int COMMAND_REPLY_BYTES = 24;          // "STOVE_ON_ACK;S=2;D=1"
+
+struct Zone
+{
+    char name[16];
+    double capacity;     // BTU/°F
+    double lossUA;       // BTU/h/°F to outdoors
+    double solarPeak;    // BTU/h at full sun
+    double internalGain; // BTU/h
+    double stoveShare;   // Fraction of the stove's output
+    bool thermostat;
+};
+
+struct Link
+{
+    int a;
+    int b;
+    double ua; // BTU/h/°F
+};
+
+struct House
+{
+    Zone zones[MAX_ZONES];
+    int zoneCount;
+    Link links[MAX_LINKS];
+    int linkCount;
+    int thermostatZone;
+    double stoveOutput;      // BTU/h at full fire
+    double stoveBodyMinutes; // Stove body time constant
+
+    bool weatherFromFile;
+    char weatherPath[128];
+    double weatherMean, annualSwing, dailySwing, frontSigma, frontHours, cloudiness;
+
+    double sensorPollS;
+    double band;
+    unsigned long seed;
+};
+
+struct Results
+{
+    double coldDegMin;      // Thermostat zone: °F x minutes below the band
+    double hotDegMin;       // Thermostat zone: °F x minutes above the band (coasting after a setback excluded)
+    double houseColdDegMin; // All zones, mean
+    double runtimeHours;
+    double fuelMBtu;
+    long cycles;
+    double airtimePerDay;   // Seconds of transmissions per day, both directions
+    double maxTemperature;  // Thermostat zone
+    double wallSeconds;
+    long solves;            // MPC plans made, and their host CPU time
+    double solveMicros;
+    double solveMaxMicros;
+};
+
+// ---------------------------------------------------------------------------
+// File input through CsvReader, the same parser the dial uses for temps.csv
+
+struct FileSource
+{
+    FILE *file;
+    const char *path;
+};
+
+static int readFile(void *context, uint8_t *buffer, size_t size)
+{
+    FILE *file = static_cast<FileSource *>(context)->file;
+    size_t count = fread(buffer, 1, size, file);
+    return ferror(file) ? -1 : (int)count;
+}
+
+static void reportError(void *context, const CsvError &error)
+{
+    fprintf(stderr, "%s:%lu:%u: %s\n", static_cast<FileSource *>(context)->path, (unsigned long)error.line,
+            error.column, error.message);
+}
+
+static bool loadSchedule(const char *path, Schedule &schedule, float &baseTemperature)
+{
+    FileSource source = {fopen(path, "rb"), path};
+    if (!source.file)
+    {
+        fprintf(stderr, "Cannot open schedule %s\n", path);
+        return false;
+    }
+
+    CsvReader reader(readFile, &source, reportError);
+    baseTemperature = 68.0f;
+    schedule.clear();
+    while (reader.next())
+    {
+        if (reader.fieldEquals(0, "Hour") || reader.fieldEquals(0, "FallbackTimezone"))
+        {
+            continue;
+        }
+        if (reader.fieldEquals(0, "BaseTemperature"))
+        {
+            reader.getFloat(1, baseTemperature);
+        }
+        else if (schedule.parseRecord(reader) == SCHEDULE_LINE_OTHER)
+        {
+            reader.fail(0, "unrecognized setting");
+        }
+    }
+    fclose(source.file);
+    schedule.compile();
+    return reader.getErrorCount() == 0 && !reader.hasReadError();
+}
+
+static int findZone(const House &house, const char *name, size_t length)
+{
+    for (int i = 0; i < house.zoneCount; i++)
+    {
+        if (strlen(house.zones[i].name) == length && strncmp(house.zones[i].name, name, length) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static bool loadHouse(const char *path, House &house)
+{
+    FileSource source = {fopen(path, "rb"), path};
+    if (!source.file)
+    {
+        fprintf(stderr, "Cannot open house file %s\n", path);
+        return false;
+    }
+
+    memset(&house, 0, sizeof(house));
+    house.thermostatZone = -1;
+    house.stoveOutput = 36000;
+    house.stoveBodyMinutes = 45;
+    house.weatherMean = 48;
+    house.annualSwing = 14;
+    house.dailySwing = 8;
+    house.frontSigma = 5;
+    house.frontHours = 48;
+    house.cloudiness = 0.5;
+    house.sensorPollS = 120;
+    house.band = 1.0;
+    house.seed = 1;
+
+    CsvReader reader(readFile, &source, reportError);
+    while (reader.next())
+    {
+        if (reader.fieldEquals(0, "Zone"))
+        {
+            if (house.zoneCount >= MAX_ZONES)
+            {
+                reader.fail(0, "too many zones");
+                continue;
+            }
+            Zone &zone = house.zones[house.zoneCount];
+            size_t length;
+            const char *name = reader.getField(1, length);
+            float capacity, loss, solar, internal, share;
+            long thermostat;
+            if (!name || length == 0 || length >= sizeof(zone.name))
+            {
+                reader.fail(1, "bad zone name");
+                continue;
+            }
+            if (!reader.getFloat(2, capacity) || !reader.getFloat(3, loss) || !reader.getFloat(4, solar) ||
+                !reader.getFloat(5, internal) || !reader.getFloat(6, share) || !reader.getInt(7, thermostat))
+            {
+                continue;
+            }
+            if (capacity <= 0)
+            {
+                reader.fail(2, "capacity must be positive");
+                continue;
+            }
+            memcpy(zone.name, name, length);
+            zone.name[length] = '\0';
+            zone.capacity = capacity;
+            zone.lossUA = loss;
+            zone.solarPeak = solar;
+            zone.internalGain = internal;
+            zone.stoveShare = share;
+            zone.thermostat = thermostat != 0;
+            if (zone.thermostat)
+            {
+                house.thermostatZone = house.zoneCount;
+            }
+            house.zoneCount++;
+        }
+        else if (reader.fieldEquals(0, "Link"))
+        {
+            size_t lengthA, lengthB;
+            const char *a = reader.getField(1, lengthA);
+            const char *b = reader.getField(2, lengthB);
+            float ua;
+            int zoneA = a ? findZone(house, a, lengthA) : -1;
+            int zoneB = b ? findZone(house, b, lengthB) : -1;
+            if (zoneA < 0 || zoneB < 0 || zoneA == zoneB)
+            {
+                reader.fail(zoneA < 0 ? 1 : 2, "unknown zone (define zones before links)");
+                continue;
+            }
+            if (!reader.getFloat(3, ua))
+            {
+                continue;
+            }
+            if (house.linkCount >= MAX_LINKS)
+            {
+                reader.fail(0, "too many links");
+                continue;
+            }
+            house.links[house.linkCount++] = {zoneA, zoneB, ua};
+        }
+        else if (reader.fieldEquals(0, "Stove"))
+        {
+            float output, body;
+            if (reader.getFloat(1, output) && reader.getFloat(2, body))
+            {
+                house.stoveOutput = output;
+                house.stoveBodyMinutes = body > 1 ? body : 1;
+            }
+        }
+        else if (reader.fieldEquals(0, "Weather") && reader.fieldEquals(1, "File"))
+        {
+            house.weatherFromFile = reader.getRest(2, house.weatherPath, sizeof(house.weatherPath));
+        }
+        else if (reader.fieldEquals(0, "Weather") && reader.fieldEquals(1, "Synthetic"))
+        {
+            float values[6];
+            bool ok = true;
+            for (int i = 0; i < 6 && ok; i++)
+            {
+                ok = reader.getFloat(2 + i, values[i]);
+            }
+            if (ok)
+            {
+                house.weatherFromFile = false;
+                house.weatherMean = values[0];
+                house.annualSwing = values[1];
+                house.dailySwing = values[2];
+                house.frontSigma = values[3];
+                house.frontHours = values[4] > 1 ? values[4] : 1;
+                house.cloudiness = values[5];
+            }
+        }
+        else if (reader.fieldEquals(0, "Sensor"))
+        {
+            float poll;
+            if (reader.getFloat(1, poll))
+            {
+                house.sensorPollS = poll > STEP_S ? poll : STEP_S;
+            }
+        }
+        else if (reader.fieldEquals(0, "Band"))
+        {
+            float band;
+            if (reader.getFloat(1, band))
+            {
+                house.band = band;
+            }
+        }
+        else if (reader.fieldEquals(0, "Seed"))
+        {
+            long seed;
+            if (reader.getInt(1, seed))
+            {
+                house.seed = (unsigned long)seed;
+            }
+        }
+        else
+        {
+            reader.fail(0, "unrecognized line");
+        }
+    }
+    fclose(source.file);
+
+    if (house.zoneCount == 0 || house.thermostatZone < 0)
+    {
+        fprintf(stderr, "%s: need at least one zone and a thermostat zone\n", path);
+        return false;
+    }
+    return reader.getErrorCount() == 0 && !reader.hasReadError();
+}
+
+// ---------------------------------------------------------------------------
+// Weather: one outdoor temperature and sun fraction per hour, interpolated
+
+class Weather
+{
+private:
+    std::vector<float> temperature; // °F
+    std::vector<float> sun;         // 0..1 of SolarPeak
+    uint64_t state;
+
+    double uniform()
+    {
+        // xorshift64*: same sequence on every platform, unlike <random> distributions
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return ((state * 2685821657736338717ULL) >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    double gaussian()
+    {
+        double u = uniform();
+        return std::sqrt(-2.0 * std::log(u > 1e-12 ? u : 1e-12)) * std::cos(2 * M_PI * uniform());
+    }
+
+    static double clearSky(int hourOfYear)
+    {
+        // Daylight from about 8.5 h in December to 15.5 h in June, strongest at noon
+        double day = hourOfYear / 24.0;
+        double hour = hourOfYear % 24 + 0.5;
+        double halfDay = 6.0 + 1.75 * std::cos(2 * M_PI * (day - 172) / 365.0);
+        double x = (hour - 12.0) / halfDay;
+        return std::fabs(x) < 1.0 ? std::cos(x * M_PI / 2) : 0.0;
+    }
+
+public:
+    bool synthesize(const House &house)
+    {
+        state = house.seed * 0x9E3779B97F4A7C15ULL + 1;
+        temperature.resize(HOURS_PER_YEAR);
+        sun.resize(HOURS_PER_YEAR);
+
+        double decay = std::exp(-1.0 / house.frontHours);
+        double front = 0.0;
+        double cloud = 0.0;
+        for (int h = 0; h < HOURS_PER_YEAR; h++)
+        {
+            double day = h / 24.0;
+            double hour = h % 24;
+            if (h % 24 == 0)
+            {
+                cloud = std::fmin(1.0, 2.0 * house.cloudiness * uniform());
+            }
+            front = front * decay + house.frontSigma * std::sqrt(1 - decay * decay) * gaussian();
+            temperature[h] = (float)(house.weatherMean - house.annualSwing * std::cos(2 * M_PI * (day - 15) / 365.0) -
+                                     house.dailySwing * std::cos(2 * M_PI * (hour - 5) / 24.0) + front);
+            sun[h] = (float)(clearSky(h) * (1.0 - cloud));
+        }
+        return true;
+    }
+
+    bool load(const char *path)
+    {
+        FileSource source = {fopen(path, "rb"), path};
+        if (!source.file)
+        {
+            fprintf(stderr, "Cannot open weather file %s\n", path);
+            return false;
+        }
+
+        CsvReader reader(readFile, &source, reportError);
+        temperature.clear();
+        sun.clear();
+        while (reader.next())
+        {
+            float value, fraction = 0.5f;
+            if (!reader.getFloat(0, value))
+            {
+                continue;
+            }
+            if (reader.getFieldCount() > 1)
+            {
+                reader.getFloat(1, fraction);
+            }
+            temperature.push_back(value);
+            sun.push_back((float)(clearSky((int)sun.size() % HOURS_PER_YEAR) * fraction));
+        }
+        fclose(source.file);
+        if (temperature.empty())
+        {
+            fprintf(stderr, "%s: no weather data\n", path);
+            return false;
+        }
+        return reader.getErrorCount() == 0;
+    }
+
+    void at(double seconds, double &outdoor, double &sunFraction) const
+    {
+        // Data shorter than the run repeats
+        double hours = seconds / 3600.0;
+        size_t count = temperature.size();
+        size_t index = (size_t)hours % count;
+        size_t next = (index + 1) % count;
+        double fraction = hours - std::floor(hours);
+        outdoor = temperature[index] + (temperature[next] - temperature[index]) * fraction;
+        sunFraction = sun[index] + (sun[next] - sun[index]) * fraction;
+    }
+};
+
+// ---------------------------------------------------------------------------
+
+static double loraAirtime(int payloadBytes)
+{
+    // Semtech SX126x time-on-air, explicit header, CRC on
+    double symbol = std::pow(2.0, LORA_SF) / LORA_BW_HZ;
+    int lowRateOptimize = symbol > 0.016 ? 1 : 0;
+    double bits = 8.0 * payloadBytes - 4.0 * LORA_SF + 28 + 16;
+    double symbols = 8 + std::fmax(std::ceil(bits / (4.0 * (LORA_SF - 2 * lowRateOptimize))) * (LORA_CR + 4), 0.0);
+    return (LORA_PREAMBLE + 4.25 + symbols) * symbol;
+}
+
+static Results simulate(const House &house, const Weather &weather, const Schedule &schedule, float baseTemperature,
+                        int days, StoveControlMode mode, bool preheat, bool useForecast, FILE *trace = nullptr)
+{
+    auto started = std::chrono::steady_clock::now();
+    static OutdoorForecast forecast;
+
+    StoveLogic logic(MIN_CHANGE_MS);
+    logic.setControlMode(mode);
+    logic.setPreheatEnabled(preheat);
+
+    const Zone *zones = house.zones;
+    double temperature[MAX_ZONES];
+    double flow[MAX_ZONES];
+    bool coasting[MAX_ZONES] = {};
+    for (int i = 0; i < house.zoneCount; i++)
+    {
+        temperature[i] = baseTemperature + schedule.getOffset(0);
+    }
+
+    const double statusAirtime = loraAirtime(STATUS_REQUEST_BYTES) + loraAirtime(STATUS_REPLY_BYTES);
+    const double commandAirtime = loraAirtime(COMMAND_BYTES) + loraAirtime(COMMAND_REPLY_BYTES);
+
+    Results r = {};
+    r.maxTemperature = -1e9;
+    double body = 0.0; // Stove body heat release, 0..1 of full output
+    bool on = false;
+    unsigned long lastChangeMs = 0; // Stove starts with lastStateChange = 0, as on the dial
+    unsigned long lastStatusMs = 0;
+    double airtime = 0.0;
+    float measured = 0.0f;
+    double nextPoll = 0.0;
+    float lastSetpoint = baseTemperature + schedule.getOffset(0);
+
+    const double duration = days * 86400.0;
+    for (double t = 0; t < duration; t += STEP_S)
+    {
+        unsigned long nowMs = (unsigned long)(t * 1000.0);
+        int minuteOfWeek = (int)(t / 60.0) % SCHEDULE_MINUTES_PER_WEEK;
+        float setpoint = baseTemperature + schedule.getOffset(minuteOfWeek);
+        if (setpoint < lastSetpoint)
+        {
+            for (int i = 0; i < house.zoneCount; i++)
+            {
+                coasting[i] = true;
+            }
+        }
+        lastSetpoint = setpoint;
+
+        // The dial: sensor poll, then the same steps as Stove::update
+        if (t >= nextPoll)
+        {
+            measured = (float)(std::round(temperature[house.thermostatZone] / MCP9808_STEP_F) * MCP9808_STEP_F);
+            nextPoll += house.sensorPollS;
+        }
+        logic.observe(measured, on, nowMs, minuteOfWeek);
+        if (useForecast && fmod(t, 3600.0) == 0.0)
+        {
+            // A perfect forecast, refreshed hourly: the weather itself, 3 days back and 2 ahead
+            double start = t - MPC_FORECAST_BASELINE_DAYS * 86400.0;
+            forecast.reset((unsigned long)(long long)(start * 1000.0));
+            for (int hour = 0; hour < MPC_FORECAST_MAX_HOURS; hour++)
+            {
+                double outdoor, sun;
+                weather.at(std::fmax(start + hour * 3600.0, 0.0), outdoor, sun);
+                forecast.add((float)outdoor);
+            }
+            logic.setForecast(forecast);
+        }
+        auto solveStart = std::chrono::steady_clock::now();
+        if (logic.updatePlan(schedule, baseTemperature, measured, on, nowMs, minuteOfWeek))
+        {
+            double micros =
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - solveStart).count();
+            r.solves++;
+            r.solveMicros += micros;
+            r.solveMaxMicros = std::fmax(r.solveMaxMicros, micros);
+        }
+        float target = logic.getPreheatTarget(schedule, baseTemperature, measured, setpoint, minuteOfWeek);
+        bool want = logic.shouldBeOn(target, measured, on, nowMs);
+        if (trace)
+        {
+            // Same fields as Stove::update prints with STOVE_TRACE, with millis() wrapping at 32 bits
+            fprintf(trace, "TRACE,%lu,%d,%.4f,%.2f,%.2f,%d,%d%d\n", (unsigned long)(uint32_t)nowMs, minuteOfWeek,
+                    measured, setpoint, target, (int)mode, on ? 1 : 0, want ? 1 : 0);
+        }
+
+        bool allowed = nowMs - lastChangeMs >= MIN_CHANGE_MS;
+        bool safetyTrip = measured >= STOVE_SAFETY_MAX_TEMP && on; // Forced OFF even inside the interval
+        if (want != on && (allowed || safetyTrip))
+        {
+            on = want;
+            lastChangeMs = nowMs;
+            lastStatusMs = nowMs;
+            airtime += commandAirtime;
+            if (on)
+            {
+                r.cycles++;
+            }
+        }
+        else if (nowMs - lastStatusMs > STATUS_INTERVAL_MS)
+        {
+            lastStatusMs = nowMs;
+            airtime += statusAirtime;
+        }
+
+        // House: stove body lag, then every zone's heat balance (explicit Euler)
+        double outdoor, sun;
+        weather.at(t, outdoor, sun);
+        body += ((on ? 1.0 : 0.0) - body) * STEP_S / (house.stoveBodyMinutes * 60.0);
+        double stoveHeat = house.stoveOutput * body;
+
+        for (int i = 0; i < house.zoneCount; i++)
+        {
+            flow[i] = zones[i].lossUA * (outdoor - temperature[i]) + zones[i].solarPeak * sun +
+                      zones[i].internalGain + zones[i].stoveShare * stoveHeat;
+        }
+        for (int k = 0; k < house.linkCount; k++)
+        {
+            const Link &link = house.links[k];
+            double q = link.ua * (temperature[link.a] - temperature[link.b]);
+            flow[link.a] -= q;
+            flow[link.b] += q;
+        }
+
+        double houseCold = 0.0;
+        for (int i = 0; i < house.zoneCount; i++)
+        {
+            temperature[i] += flow[i] * STEP_S / 3600.0 / zones[i].capacity;
+
+            double below = (setpoint - house.band) - temperature[i];
+            double above = temperature[i] - (setpoint + house.band);
+            if (coasting[i] && above <= 0.0)
+            {
+                coasting[i] = false; // Back in the band after a setback
+            }
+            if (below > 0)
+            {
+                houseCold += below * STEP_S / 60.0;
+            }
+            if (i == house.thermostatZone)
+            {
+                if (below > 0)
+                {
+                    r.coldDegMin += below * STEP_S / 60.0;
+                }
+                if (above > 0 && !coasting[i])
+                {
+                    r.hotDegMin += above * STEP_S / 60.0;
+                }
+                r.maxTemperature = std::fmax(r.maxTemperature, temperature[i]);
+            }
+        }
+        r.houseColdDegMin += houseCold / house.zoneCount;
+
+        if (on)
+        {
+            r.runtimeHours += STEP_S / 3600.0;
+        }
+        r.fuelMBtu += stoveHeat * STEP_S / 3600.0 / 1e6;
+    }
+
+    r.airtimePerDay = airtime / days;
+    r.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return r;
+}
+
+static void print(const char *name, const Results &r)
+{
+    printf("%-15s %10.0f %10.0f %10.0f %9.0f %9.1f %8ld %9.0f %8.1f %7.2f\n", name, r.coldDegMin, r.hotDegMin,
+           r.houseColdDegMin, r.runtimeHours, r.fuelMBtu, r.cycles, r.airtimePerDay, r.maxTemperature, r.wallSeconds);
+}
+
+// ---------------------------------------------------------------------------
+// Regression baseline: one CSV line per run
+
+struct Baseline
+{
+    char name[32];
+    float coldDegMin, hotDegMin, houseColdDegMin, runtimeHours, cycles, airtimePerDay;
+};
+
+static bool saveBaseline(const char *path, const char *const *names, const Results *results, int count)
+{
+    FILE *file = fopen(path, "w");
+    if (!file)
+    {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return false;
+    }
+    fprintf(file, "# run,coldDegMin,hotDegMin,houseColdDegMin,runtimeHours,cycles,airtimeSecondsPerDay\n");
+    for (int i = 0; i < count; i++)
+    {
+        const Results &r = results[i];
+        fprintf(file, "%s,%.1f,%.1f,%.1f,%.2f,%ld,%.1f\n", names[i], r.coldDegMin, r.hotDegMin, r.houseColdDegMin,
+                r.runtimeHours, r.cycles, r.airtimePerDay);
+    }
+    fclose(file);
+    return true;
+}
+
+static bool worse(const char *run, const char *what, double now, double before, double tolerance, double slack)
+{
+    if (now <= before * (1.0 + tolerance / 100.0) + slack)
+    {
+        return false;
+    }
+    printf("REGRESSION %s: %s %.1f -> %.1f (%+.1f%%)\n", run, what, before, now,
+           before > 0 ? (now - before) / before * 100.0 : 100.0);
+    return true;
+}
+
+static int checkBaseline(const char *path, const char *const *names, const Results *results, int count,
+                         double tolerance)
+{
+    FileSource source = {fopen(path, "rb"), path};
+    if (!source.file)
+    {
+        fprintf(stderr, "Cannot open baseline %s\n", path);
+        return 1;
+    }
+
+    CsvReader reader(readFile, &source, reportError);
+    int regressions = 0;
+    int compared = 0;
+    while (reader.next())
+    {
+        Baseline b;
+        size_t length;
+        const char *name = reader.getField(0, length);
+        if (!name || length >= sizeof(b.name) || !reader.getFloat(1, b.coldDegMin) ||
+            !reader.getFloat(2, b.hotDegMin) || !reader.getFloat(3, b.houseColdDegMin) ||
+            !reader.getFloat(4, b.runtimeHours) || !reader.getFloat(5, b.cycles) ||
+            !reader.getFloat(6, b.airtimePerDay))
+        {
+            continue;
+        }
+        memcpy(b.name, name, length);
+        b.name[length] = '\0';
+
+        for (int i = 0; i < count; i++)
+        {
+            if (strcmp(names[i], b.name) != 0)
+            {
+                continue;
+            }
+            const Results &r = results[i];
+            compared++;
+            regressions += worse(b.name, "cold degree-minutes", r.coldDegMin, b.coldDegMin, tolerance, 1.0);
+            regressions += worse(b.name, "hot degree-minutes", r.hotDegMin, b.hotDegMin, tolerance, 1.0);
+            regressions += worse(b.name, "runtime hours", r.runtimeHours, b.runtimeHours, tolerance, 0.1);
+            regressions += worse(b.name, "cycles", (double)r.cycles, b.cycles, tolerance, 1.0);
+            regressions += worse(b.name, "airtime s/day", r.airtimePerDay, b.airtimePerDay, tolerance, 0.1);
+        }
+    }
+    fclose(source.file);
+
+    if (compared == 0)
+    {
+        fprintf(stderr, "%s: no matching runs to compare\n", path);
+        return 1;
+    }
+    printf("\nBaseline %s: %d run(s) compared, %d regression(s) beyond %.1f%%\n", path, compared, regressions,
+           tolerance);
+    return regressions ? 2 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *housePath = "tools/sim/house.csv";
+    const char *schedulePath = "data/temps.csv";
+    const char *savePath = nullptr;
+    const char *checkPath = nullptr;
+    const char *tracePath = nullptr;
+    const char *modeName = "all";
+    int days = 365;
+    double tolerance = 2.0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--house") && hasValue)
+            housePath = argv[++i];
+        else if (!strcmp(argv[i], "--schedule") && hasValue)
+            schedulePath = argv[++i];
+        else if (!strcmp(argv[i], "--days") && hasValue)
+            days = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--mode") && hasValue)
+            modeName = argv[++i];
+        else if (!strcmp(argv[i], "--save") && hasValue)
+            savePath = argv[++i];
+        else if (!strcmp(argv[i], "--check") && hasValue)
+            checkPath = argv[++i];
+        else if (!strcmp(argv[i], "--tolerance") && hasValue)
+            tolerance = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--trace") && hasValue)
+            tracePath = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--house file] [--schedule temps.csv] [--days n] [--mode all|hysteresis|pi|mpc]\n"
+                            "          [--save results.csv] [--check results.csv] [--tolerance percent]\n"
+                            "          [--trace capture.log]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (days <= 0)
+    {
+        fprintf(stderr, "--days must be positive\n");
+        return 1;
+    }
+
+    House house;
+    static Schedule schedule; // ~20 KB of points and table
+    float baseTemperature;
+    if (!loadHouse(housePath, house) || !loadSchedule(schedulePath, schedule, baseTemperature))
+    {
+        return 1;
+    }
+    Weather weather;
+    if (house.weatherFromFile ? !weather.load(house.weatherPath) : !weather.synthesize(house))
+    {
+        return 1;
+    }
+    FILE *trace = nullptr;
+    if (tracePath && !(trace = fopen(tracePath, "w")))
+    {
+        fprintf(stderr, "Cannot write %s\n", tracePath);
+        return 1;
+    }
+
+    struct Run
+    {
+        const char *name;
+        StoveControlMode mode;
+        bool preheat;
+        bool forecast;
+    };
+    static const Run RUNS[] = {{"hysteresis", STOVE_CONTROL_HYSTERESIS, false, false},
+                               {"PI", STOVE_CONTROL_PI, false, false},
+                               {"hysteresis+pre", STOVE_CONTROL_HYSTERESIS, true, false},
+                               {"PI+pre", STOVE_CONTROL_PI, true, false},
+                               {"MPC", STOVE_CONTROL_MPC, false, false},
+                               {"MPC+forecast", STOVE_CONTROL_MPC, false, true}};
+    static const int RUN_COUNT = sizeof(RUNS) / sizeof(RUNS[0]);
+    const char *names[RUN_COUNT];
+    Results results[RUN_COUNT];
+    int count = 0;
+
+    printf("%d days, %d zones, stove %.0f BTU/h, schedule %s (base %.1f°F), band ±%.1f°F\n", days, house.zoneCount,
+           house.stoveOutput, schedulePath, baseTemperature, house.band);
+    printf("LoRa SF%d/%.0f kHz: status exchange %.2f s, command exchange %.2f s on air\n\n", LORA_SF,
+           LORA_BW_HZ / 1000, loraAirtime(STATUS_REQUEST_BYTES) + loraAirtime(STATUS_REPLY_BYTES),
+           loraAirtime(COMMAND_BYTES) + loraAirtime(COMMAND_REPLY_BYTES));
+    printf("%-15s %10s %10s %10s %9s %9s %8s %9s %8s %7s\n", "controller", "cold °Fmin", "hot °Fmin",
+           "house cold", "runtime h", "fuel MBTU", "cycles", "air s/day", "max °F", "wall s");
+
+    for (const Run &run : RUNS)
+    {
+        bool selected = !strcmp(modeName, "all") ||
+                        (!strcmp(modeName, "hysteresis") && run.mode == STOVE_CONTROL_HYSTERESIS) ||
+                        (!strcmp(modeName, "pi") && run.mode == STOVE_CONTROL_PI) ||
+                        (!strcmp(modeName, "mpc") && run.mode == STOVE_CONTROL_MPC);
+        if (!selected)
+        {
+            continue;
+        }
+        names[count] = run.name;
+        results[count] = simulate(house, weather, schedule, baseTemperature, days, run.mode, run.preheat,
+                                  run.forecast, count == 0 ? trace : nullptr);
+        print(run.name, results[count]);
+        count++;
+    }
+    if (trace)
+    {
+        fclose(trace);
+    }
+    if (count == 0)
+    {
+        fprintf(stderr, "Unknown mode %s\n", modeName);
+        return 1;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        if (results[i].solves)
+        {
+            printf("%-15s %ld plans, %.0f us mean, %.0f us worst (host CPU)\n", names[i], results[i].solves,
+                   results[i].solveMicros / results[i].solves, results[i].solveMaxMicros);
+        }
+    }
+
+    if (savePath && !saveBaseline(savePath, names, results, count))
+    {
+        return 1;
+    }
+    return checkPath ? checkBaseline(checkPath, names, results, count, tolerance) : 0;
+}
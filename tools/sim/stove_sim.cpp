@@ -0,0 +1,255 @@
+/**
+ * @file stove_sim.cpp
+ * @brief Host simulation comparing the stove control laws
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * Runs the hysteresis and PI controllers from src/stove_control.cpp against
+ * a two-node room model and prints overshoot, cycling and comfort figures,
+ * with and without optimal-start preheating from src/thermal_model.cpp.
+ *
+ * Build and run on the host (no Arduino needed):
+ *     g++ -std=c++17 -O2 -Isrc tools/sim/stove_sim.cpp src/stove_control.cpp src/thermal_model.cpp -o stove_sim
+ *     ./stove_sim [days]
+ *
+ * Model: the stove body (time constant ~45 min) heats the room air, which
+ * loses heat to the outdoors (time constant ~6 h). The stove keeps heating
+ * after it is switched off, which is what makes hysteresis overshoot.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "stove_control.hpp"
+#include "thermal_model.hpp"
+
+// Simulation parameters
+static const double STEP_S = 10.0;                // Control loop period
+static const double STOVE_TAU_S = 45 * 60.0;      // Stove body heat-up/cool-down time constant (high mass)
+static const double ROOM_TAU_S = 6 * 3600.0;      // Room loss time constant
+static const double STOVE_EXCESS_F = 100.0;       // Body-over-room temperature at full fire
+static const double FULL_FIRE_RISE_F = 50.0;      // Room-over-outdoor rise at steady full fire
+static const double OUTDOOR_MEAN_F = 35.0;
+static const double OUTDOOR_SWING_F = 10.0;       // Day/night amplitude
+static const unsigned long MIN_CHANGE_MS = 180000; // Stove::minChangeInterval
+static const double BAND_F = 1.0;                 // Comfort band around the setpoint
+static const double SETTLE_S = 2 * 3600.0;        // Ignore this long after a setpoint change
+static const double LATE_F = 2.0;                 // "Late" = this far below a setpoint that just rose
+
+struct Results
+{
+    double maxOvershoot;
+    double meanOvershoot;   // Mean of per-cycle peak overshoot
+    double meanError;       // Mean settled room-minus-setpoint (negative = runs cool)
+    double cyclesPerDay;
+    double timeInBand;      // Fraction of settled time within ±BAND_F
+    double runtime;         // Fraction of time the stove is on
+    double lateMinutes;     // Per day: minutes more than LATE_F below a setpoint that just rose
+};
+
+static float setpointAt(double t)
+{
+    double hour = std::fmod(t / 3600.0, 24.0);
+    return (hour >= 6.0 && hour < 22.0) ? 68.0f : 62.0f;
+}
+
+static double nextSetpointChange(double t, float *value)
+{
+    // Schedule changes only on the hour
+    float current = setpointAt(t);
+    for (double next = (std::floor(t / 3600.0) + 1) * 3600.0; next < t + 86400.0; next += 3600.0)
+    {
+        if (setpointAt(next) != current)
+        {
+            *value = setpointAt(next);
+            return next;
+        }
+    }
+    *value = current;
+    return t + 86400.0;
+}
+
+static double outdoorAt(double t)
+{
+    double hour = std::fmod(t / 3600.0, 24.0);
+    return OUTDOOR_MEAN_F - OUTDOOR_SWING_F * std::cos((hour - 3.0) / 24.0 * 2 * M_PI);
+}
+
+static Results simulate(StoveControlMode mode, int days, bool preheat, ThermalModel &model)
+{
+    PiController pi(STOVE_PI_KP, STOVE_PI_TI_S, STOVE_PI_WINDOW_MS, MIN_CHANGE_MS);
+
+    double room = 62.0;
+    double excess = 0.0; // Stove body above room
+    bool on = false;
+    unsigned long lastChangeMs = 0;
+    bool changedOnce = false;
+    double lastSetpointChange = 0.0;
+    float lastSetpoint = setpointAt(0);
+
+    bool coasting = false; // Drifting down after a setpoint drop - not overshoot
+    bool rising = false;   // Setpoint went up at lastSetpointChange
+
+    Results r = {0, 0, 0, 0, 0, 0, 0};
+    int cycles = 0;
+    double settled = 0, inBand = 0, errorSum = 0, onTime = 0, late = 0;
+    double cyclePeak = 0, peakSum = 0;
+    int peakCount = 0;
+
+    const double duration = days * 86400.0;
+    const double roomGain = FULL_FIRE_RISE_F / (STOVE_EXCESS_F * ROOM_TAU_S);
+
+    for (double t = 0; t < duration; t += STEP_S)
+    {
+        unsigned long nowMs = (unsigned long)(t * 1000.0);
+        float setpoint = setpointAt(t);
+        if (setpoint != lastSetpoint)
+        {
+            coasting = setpoint < lastSetpoint;
+            rising = setpoint > lastSetpoint;
+            lastSetpoint = setpoint;
+            lastSetpointChange = t;
+        }
+
+        // Thermostat reads to 0.1°F like the MCP9808 display
+        float measured = std::round(room * 10.0) / 10.0f;
+
+        float hourOfDay = (float)std::fmod(t / 3600.0, 24.0);
+
+        // Optimal start: aim for the next setpoint once the model says it's time
+        float target = setpoint;
+        if (preheat)
+        {
+            float nextSetpoint;
+            double nextChange = nextSetpointChange(t, &nextSetpoint);
+            if (nextSetpoint > setpoint &&
+                model.getPreheatMinutes(measured, nextSetpoint, hourOfDay) * 60.0 >= nextChange - t)
+            {
+                target = nextSetpoint;
+            }
+        }
+
+        bool want = (mode == STOVE_CONTROL_PI) ? pi.update(target, measured, nowMs)
+                                               : hysteresisShouldBeOn(target - measured, on);
+        if (measured >= STOVE_SAFETY_MAX_TEMP)
+        {
+            want = false;
+            pi.reset();
+        }
+
+        bool allowed = !changedOnce || nowMs - lastChangeMs >= MIN_CHANGE_MS;
+        if (want != on && allowed)
+        {
+            on = want;
+            lastChangeMs = nowMs;
+            changedOnce = true;
+            if (on)
+            {
+                cycles++;
+            }
+        }
+
+        model.observe(measured, on, nowMs, hourOfDay);
+
+        // Two-node thermal model, explicit Euler
+        double fire = on ? STOVE_EXCESS_F : 0.0;
+        excess += (fire - excess) / STOVE_TAU_S * STEP_S;
+        room += (roomGain * excess - (room - outdoorAt(t)) / ROOM_TAU_S) * STEP_S;
+
+        // Warm ahead of a rising setpoint is preheating, not overshoot
+        double error = room - std::fmax(setpoint, target);
+        if (coasting && error <= 0.0)
+        {
+            coasting = false;
+        }
+        if (coasting)
+        {
+            error = 0.0;
+        }
+        if (error > r.maxOvershoot)
+        {
+            r.maxOvershoot = error;
+        }
+        if (error > 0)
+        {
+            cyclePeak = std::fmax(cyclePeak, error);
+        }
+        else if (cyclePeak > 0)
+        {
+            peakSum += cyclePeak;
+            peakCount++;
+            cyclePeak = 0;
+        }
+
+        if (rising && t - lastSetpointChange < SETTLE_S && error < -LATE_F)
+        {
+            late += STEP_S;
+        }
+
+        if (t - lastSetpointChange >= SETTLE_S)
+        {
+            settled += STEP_S;
+            errorSum += (room - setpoint) * STEP_S;
+            if (std::fabs(error) <= BAND_F)
+            {
+                inBand += STEP_S;
+            }
+        }
+        if (on)
+        {
+            onTime += STEP_S;
+        }
+    }
+
+    r.meanOvershoot = peakCount ? peakSum / peakCount : 0.0;
+    r.meanError = settled > 0 ? errorSum / settled : 0.0;
+    r.cyclesPerDay = (double)cycles / days;
+    r.timeInBand = settled > 0 ? inBand / settled : 0.0;
+    r.runtime = onTime / duration;
+    r.lateMinutes = late / 60.0 / days;
+    return r;
+}
+
+static void print(const char *name, const Results &r)
+{
+    printf("%-15s %9.2f %9.2f %9.2f %10.1f %10.1f%% %9.1f%% %9.0f\n", name, r.maxOvershoot, r.meanOvershoot,
+           r.meanError, r.cyclesPerDay, r.timeInBand * 100.0, r.runtime * 100.0, r.lateMinutes);
+}
+
+static void printModel(const char *name, const ThermalModel &model)
+{
+    printf("Fitted (%s): tau %.1f h, ambient %.1f°F, heating %.1f°F/h, RMS error %.3f°F per %lu min%s\n", name,
+           model.getTimeConstantHours(), model.getAmbientTemperature(), model.getHeatingRate(), model.getRmsError(),
+           THERMAL_MODEL_SAMPLE_MS / 60000, model.isTrained() ? "" : " (untrained)");
+}
+
+int main(int argc, char **argv)
+{
+    int days = argc > 1 ? std::atoi(argv[1]) : 7;
+    if (days <= 0)
+    {
+        fprintf(stderr, "usage: %s [days]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%d days, schedule 68/62°F, outdoor %.0f±%.0f°F, min change %lu s\n\n", days, OUTDOOR_MEAN_F,
+           OUTDOOR_SWING_F, MIN_CHANGE_MS / 1000);
+    printf("%-15s %9s %9s %9s %10s %11s %10s %9s\n", "controller", "max over", "mean over", "mean err",
+           "cycles/day", "in ±1°F", "runtime", "late min");
+
+    ThermalModel hysteresisModel, piModel;
+    print("hysteresis", simulate(STOVE_CONTROL_HYSTERESIS, days, false, hysteresisModel));
+    print("PI", simulate(STOVE_CONTROL_PI, days, false, piModel));
+
+    // Preheat runs learn from scratch, like a freshly booted thermostat
+    ThermalModel hysteresisPreheat, piPreheat;
+    print("hysteresis+pre", simulate(STOVE_CONTROL_HYSTERESIS, days, true, hysteresisPreheat));
+    print("PI+pre", simulate(STOVE_CONTROL_PI, days, true, piPreheat));
+
+    printf("\nTrue room: tau %.1f h, ambient %.1f°F, heating %.1f°F/h at full fire\n", ROOM_TAU_S / 3600.0,
+           OUTDOOR_MEAN_F, FULL_FIRE_RISE_F * 3600.0 / ROOM_TAU_S);
+    printModel("hysteresis+pre", hysteresisPreheat);
+    printModel("PI+pre", piPreheat);
+    return 0;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file check.hpp
+ * @brief Minimal assertion macros for the host tests in tools/test/
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * A failed CHECK prints the file, line and expression and the test carries
+ * on, so one run lists every failure. Each test's main() ends with
+ * "return checkSummary(name);", which exits nonzero if anything failed.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+inline int &checkFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+inline int &checkCount()
+{
+    static int count = 0;
+    return count;
+}
+
+#define CHECK(condition)                                                          \
+    do                                                                            \
+    {                                                                             \
+        checkCount()++;                                                           \
+        if (!(condition))                                                         \
+        {                                                                         \
+            checkFailures()++;                                                    \
+            std::printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+        }                                                                         \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance)                                                  \
+    do                                                                                           \
+    {                                                                                            \
+        checkCount()++;                                                                          \
+        double checkActual = (actual);                                                           \
+        double checkExpected = (expected);                                                       \
+        if (!(std::fabs(checkActual - checkExpected) <= (tolerance)))                            \
+        {                                                                                        \
+            checkFailures()++;                                                                   \
+            std::printf("%s:%d: CHECK_NEAR failed: %s = %g, expected %g +/- %g\n", __FILE__, __LINE__, \
+                        #actual, checkActual, checkExpected, (double)(tolerance));               \
+        }                                                                                        \
+    } while (0)
+
+/**
+ * @brief Print the result line for a test program
+ * @param name Test name shown in the summary
+ * @return Exit code for main(): 0 if every check passed
+ */
+inline int checkSummary(const char *name)
+{
+    std::printf("%s: %d checks, %d failed\n", name, checkCount(), checkFailures());
+    return checkFailures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,249 @@
+/**
+ * @file csv_fuzz.cpp
+ * @brief Fuzz target: arbitrary bytes through CsvReader and Schedule::parseRecord
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * Each input is read the way Stove::parseConfigCSV() reads temps.csv: every
+ * record goes to Schedule::parseRecord(), the typed getters are tried on
+ * each field, and the schedule is compiled and queried at the end. The
+ * first byte picks the read chunk size, so record boundaries fall anywhere.
+ * Besides the sanitizers, the target checks that every offset is finite and
+ * every change time is within a week.
+ *
+ * With libFuzzer (clang):
+ *     clang++ -std=c++17 -g -O1 -fsanitize=fuzzer,address,undefined -DCSV_FUZZ_LIBFUZZER -Isrc \
+ *         tools/test/csv_fuzz.cpp src/csv_reader.cpp src/schedule.cpp -o csv_fuzz
+ *     ./csv_fuzz corpus/
+ *
+ * Without libFuzzer (any g++; tools/test/run_tests.sh runs it this way):
+ *     g++ -std=c++17 -g -O1 -fsanitize=address,undefined -Isrc \
+ *         tools/test/csv_fuzz.cpp src/csv_reader.cpp src/schedule.cpp -o csv_fuzz
+ *     ./csv_fuzz [--runs 20000] [--seed 1]    random temps.csv-like inputs
+ *     ./csv_fuzz crash-file ...               replay saved inputs
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "csv_reader.hpp"
+#include "schedule.hpp"
+
+struct FuzzSource
+{
+    const uint8_t *data;
+    size_t size;
+    size_t position;
+    size_t maxChunk;
+};
+
+static int fuzzRead(void *context, uint8_t *buffer, size_t size)
+{
+    FuzzSource *source = (FuzzSource *)context;
+    size_t count = source->size - source->position;
+    count = count < size ? count : size;
+    count = count < source->maxChunk ? count : source->maxChunk;
+    memcpy(buffer, source->data + source->position, count);
+    source->position += count;
+    return (int)count;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+    static Schedule schedule;
+    schedule.clear();
+
+    FuzzSource source = {data + 1, size - 1, 0, (size_t)(data[0] % CSV_READ_CHUNK) + 1};
+    CsvReader reader(fuzzRead, &source);
+    uint32_t lastLine = 0;
+    while (reader.next())
+    {
+        if (reader.getLineNumber() <= lastLine || reader.getFieldCount() == 0 ||
+            reader.getFieldCount() > CSV_MAX_FIELDS)
+        {
+            abort();
+        }
+        lastLine = reader.getLineNumber();
+
+        schedule.parseRecord(reader);
+        for (size_t i = 0; i <= reader.getFieldCount(); i++)
+        {
+            size_t length;
+            const char *text = reader.getField(i, length);
+            if (text && (length > CSV_MAX_LINE || memchr(text, '\n', length)))
+            {
+                abort();
+            }
+            long whole;
+            float number;
+            char rest[24];
+            reader.getInt(i, whole);
+            reader.getFloat(i, number);
+            reader.getRest(i, rest, sizeof(rest));
+            reader.fieldEquals(i, "BaseTemperature");
+        }
+    }
+
+    schedule.compile();
+    for (uint16_t minute = 0; minute < SCHEDULE_MINUTES_PER_WEEK; minute += 7)
+    {
+        uint16_t until = schedule.getMinutesUntilChange(minute);
+        if (!std::isfinite(schedule.getOffset(minute)) || until == 0 || until > SCHEDULE_MINUTES_PER_WEEK)
+        {
+            abort();
+        }
+    }
+    return 0;
+}
+
+#ifndef CSV_FUZZ_LIBFUZZER
+
+// Pieces of temps.csv lines, so random inputs reach the parser's deeper paths
+static const char *const TOKENS[] = {
+    "BaseTemperature", "Timezone", "Daily", "Weekdays", "Weekends", "Mon", "Saturday", "Fri-Mon", "sun-",
+    ",", ",", ",", ":", "~", "#", " ", "\t", "\r\n", "\n", "\n", "\0",
+    "0", "1", "8", "23", "24", "59", "60", "-12.5", "1e38", "1e99", "nan", "inf", "0x1F", "-", ".",
+    "08:00", "~09:30", "24:00", "7:5", "99999999999999999999",
+};
+
+static const char *const DAYS[] = {"Daily", "Weekdays", "weekends", "Sun", "Monday", "tue-thu", "Sat-Sun", "Fri-Mon"};
+static const char *const OFFSETS[] = {"0", "-12.0", "2.5", " 1 ", "-0.05", "10"};
+
+static uint32_t nextRandom(uint32_t &state)
+{
+    // xorshift32
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static size_t append(uint8_t *buffer, size_t length, size_t capacity, const char *text)
+{
+    while (*text && length < capacity)
+    {
+        buffer[length++] = (uint8_t)*text++;
+    }
+    return length;
+}
+
+// A well-formed schedule line in either format, so most inputs also add points
+static size_t appendScheduleLine(uint32_t &state, uint8_t *buffer, size_t length, size_t capacity)
+{
+    char line[64];
+    const char *offset = OFFSETS[nextRandom(state) % (sizeof(OFFSETS) / sizeof(OFFSETS[0]))];
+    if (nextRandom(state) % 3 == 0)
+    {
+        snprintf(line, sizeof(line), "%u,%s,Hourly\n", (unsigned)(nextRandom(state) % 25), offset);
+    }
+    else
+    {
+        snprintf(line, sizeof(line), "%s,%s%02u:%02u,%s\n", DAYS[nextRandom(state) % (sizeof(DAYS) / sizeof(DAYS[0]))],
+                 nextRandom(state) % 4 == 0 ? "~" : "", (unsigned)(nextRandom(state) % 24),
+                 (unsigned)(nextRandom(state) % 60), offset);
+    }
+    return append(buffer, length, capacity, line);
+}
+
+static size_t makeInput(uint32_t &state, uint8_t *buffer, size_t capacity)
+{
+    size_t length = 0;
+    buffer[length++] = (uint8_t)nextRandom(state);
+    size_t pieces = nextRandom(state) % 200;
+    for (size_t i = 0; i < pieces && length < capacity; i++)
+    {
+        uint32_t choice = nextRandom(state) % 16;
+        if (choice == 0)
+        {
+            // Run of one byte, long enough to overflow the line buffer
+            size_t run = nextRandom(state) % (2 * CSV_MAX_LINE);
+            uint8_t byte = (uint8_t)nextRandom(state);
+            for (size_t j = 0; j < run && length < capacity; j++)
+            {
+                buffer[length++] = byte;
+            }
+        }
+        else if (choice == 1)
+        {
+            buffer[length++] = (uint8_t)nextRandom(state);
+        }
+        else if (choice < 8)
+        {
+            length = appendScheduleLine(state, buffer, length, capacity);
+        }
+        else
+        {
+            size_t index = nextRandom(state) % (sizeof(TOKENS) / sizeof(TOKENS[0]));
+            size_t tokenLength = TOKENS[index][0] ? strlen(TOKENS[index]) : 1;
+            for (size_t j = 0; j < tokenLength && length < capacity; j++)
+            {
+                buffer[length++] = (uint8_t)TOKENS[index][j];
+            }
+        }
+    }
+    return length;
+}
+
+static int replay(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return 1;
+    }
+    static uint8_t data[1 << 20];
+    size_t size = fread(data, 1, sizeof(data), file);
+    fclose(file);
+    LLVMFuzzerTestOneInput(data, size);
+    printf("%s: %zu bytes OK\n", path, size);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    long runs = 20000;
+    uint32_t seed = 1;
+    int replayed = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc)
+        {
+            runs = atol(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            if (replay(argv[i]) != 0)
+            {
+                return 1;
+            }
+            replayed++;
+        }
+    }
+    if (replayed > 0)
+    {
+        return 0;
+    }
+
+    uint32_t state = seed ? seed : 1;
+    static uint8_t buffer[4096];
+    for (long run = 0; run < runs; run++)
+    {
+        size_t size = makeInput(state, buffer, sizeof(buffer));
+        LLVMFuzzerTestOneInput(buffer, size);
+    }
+    printf("csv_fuzz: %ld random inputs (seed %u) OK\n", runs, (unsigned)seed);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,346 @@
+/**
+ * @file csv_reader_test.cpp
+ * @brief Host test: CsvReader and Schedule::parseRecord on temps.csv-style input
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * Feeds text to CsvReader through a memory source that returns it a few
+ * bytes at a time, so lines and fields straddle read chunks. Checks comment
+ * and blank line skipping, CRLF endings, over-long lines, field splitting
+ * and the typed getters, then the schedule lines parsed from the records
+ * and the table they compile to.
+ *
+ * Build and run on the host (tools/test/run_tests.sh builds every test):
+ *     g++ -std=c++17 -Isrc tools/test/csv_reader_test.cpp src/csv_reader.cpp src/schedule.cpp -o csv_reader_test
+ *     ./csv_reader_test
+ */
+
+#include <cstring>
+#include <string>
+
+#include "check.hpp"
+#include "csv_reader.hpp"
+#include "schedule.hpp"
+
+/**
+ * @struct MemorySource
+ * @brief CsvReader data source over a string, at most maxChunk bytes per read
+ */
+struct MemorySource
+{
+    std::string text;
+    size_t position;
+    size_t maxChunk;
+    bool failAtEnd; // Report a read error instead of end of file
+
+    MemorySource(const std::string &text, size_t maxChunk, bool failAtEnd = false)
+        : text(text), position(0), maxChunk(maxChunk), failAtEnd(failAtEnd)
+    {
+    }
+
+    static int read(void *context, uint8_t *buffer, size_t size)
+    {
+        MemorySource *source = (MemorySource *)context;
+        size_t count = source->text.size() - source->position;
+        if (count == 0)
+        {
+            return source->failAtEnd ? -1 : 0;
+        }
+        count = count < size ? count : size;
+        count = count < source->maxChunk ? count : source->maxChunk;
+        memcpy(buffer, source->text.data() + source->position, count);
+        source->position += count;
+        return (int)count;
+    }
+};
+
+static std::string field(const CsvReader &reader, size_t index)
+{
+    size_t length;
+    const char *text = reader.getField(index, length);
+    return text ? std::string(text, length) : std::string("<none>");
+}
+
+static const char *SAMPLE =
+    "BaseTemperature,70.0\n"
+    "\n"
+    "# Hour,Offset,Description\n"
+    "1,-12.0,Sleep\n"
+    "8,0.0,Morning\n"
+    "  17 , 2.0 , Evening, with a comma\n"
+    "22,-8.0,Night\n"
+    "   \n"
+    "   # indented comment\n"
+    "Weekends,08:00,-12.0,Sleep in\n"
+    "Weekends,~09:30,0.0,Warm up"; // No newline at the end
+
+static void testChunking()
+{
+    // The same records come out whatever size the reads are
+    const size_t chunks[] = {1, 2, 3, 7, CSV_READ_CHUNK, 4096};
+    for (size_t chunk : chunks)
+    {
+        MemorySource source(SAMPLE, chunk);
+        CsvReader reader(MemorySource::read, &source);
+
+        CHECK(reader.next());
+        CHECK(reader.getLineNumber() == 1);
+        CHECK(reader.fieldEquals(0, "basetemperature"));
+        float base = 0;
+        CHECK(reader.getFloat(1, base) && base == 70.0f);
+
+        CHECK(reader.next());
+        CHECK(reader.getLineNumber() == 4);
+        CHECK(field(reader, 2) == "Sleep");
+
+        CHECK(reader.next());
+        CHECK(reader.next());
+        CHECK(reader.getLineNumber() == 6);
+        CHECK(reader.getFieldCount() == 4);
+        CHECK(field(reader, 0) == "17");
+        CHECK(field(reader, 1) == "2.0");
+        CHECK(field(reader, 3) == "with a comma");
+        long hour = 0;
+        CHECK(reader.getInt(0, hour) && hour == 17);
+
+        CHECK(reader.next());
+        CHECK(reader.next());
+        CHECK(reader.getLineNumber() == 10);
+        CHECK(reader.next());
+        CHECK(reader.getLineNumber() == 11);
+        CHECK(field(reader, 1) == "~09:30");
+        CHECK(field(reader, 3) == "Warm up");
+
+        CHECK(!reader.next());
+        CHECK(!reader.next()); // Stays at the end
+        CHECK(reader.getErrorCount() == 0);
+        CHECK(!reader.hasReadError());
+    }
+}
+
+static void testLineEndings()
+{
+    MemorySource source("a, b ,c\r\n\r\n#x\r\nd\r\n", 3);
+    CsvReader reader(MemorySource::read, &source);
+    CHECK(reader.next());
+    CHECK(reader.getFieldCount() == 3);
+    CHECK(field(reader, 0) == "a");
+    CHECK(field(reader, 1) == "b");
+    CHECK(field(reader, 2) == "c");
+    CHECK(reader.next());
+    CHECK(reader.getLineNumber() == 4);
+    CHECK(field(reader, 0) == "d");
+    CHECK(reader.getFieldCount() == 1);
+    CHECK(!reader.next());
+
+    // NULs are dropped rather than ending the line early
+    MemorySource nul(std::string("12\0,3\n", 6), 64);
+    CsvReader nulReader(MemorySource::read, &nul);
+    CHECK(nulReader.next());
+    CHECK(field(nulReader, 0) == "12");
+    CHECK(field(nulReader, 1) == "3");
+}
+
+/**
+ * @struct CountingSource
+ * @brief MemorySource that also counts the errors reported through the callback
+ */
+struct CountingSource : MemorySource
+{
+    int reported = 0;
+
+    CountingSource(const std::string &text, size_t maxChunk) : MemorySource(text, maxChunk)
+    {
+    }
+
+    static void onError(void *context, const CsvError &)
+    {
+        ((CountingSource *)context)->reported++;
+    }
+};
+
+static void testLongLines()
+{
+    std::string fits(CSV_MAX_LINE, 'x');
+    std::string tooLong(CSV_MAX_LINE + 1, 'y');
+    std::string text = fits + "\n" + tooLong + "\r\n" + std::string(1000, 'z') + "\nlast\n";
+
+    CountingSource source(text, 5);
+    CsvReader reader(MemorySource::read, &source, CountingSource::onError);
+    CHECK(reader.next());
+    CHECK(field(reader, 0) == fits);
+    CHECK(reader.next()); // Both over-long lines are skipped
+    CHECK(field(reader, 0) == "last");
+    CHECK(reader.getLineNumber() == 4);
+    CHECK(reader.getErrorCount() == 2);
+    CHECK(source.reported == 2);
+    CHECK(reader.getLastError().line == 3);
+    CHECK(reader.getLastError().column == 0);
+    CHECK(strcmp(reader.getLastError().message, "line too long") == 0);
+}
+
+static void testFields()
+{
+    // Commas past CSV_MAX_FIELDS stay in the last field
+    MemorySource source("1,2,3,4,5,6,7,8,9,10\nTimezone, PST8PDT,M3.2.0,M11.1.0 \n,\n", 64);
+    CsvReader reader(MemorySource::read, &source);
+    CHECK(reader.next());
+    CHECK(reader.getFieldCount() == CSV_MAX_FIELDS);
+    CHECK(field(reader, CSV_MAX_FIELDS - 1) == "8,9,10");
+    CHECK(field(reader, CSV_MAX_FIELDS) == "<none>");
+
+    CHECK(reader.next());
+    char zone[32];
+    CHECK(reader.getRest(1, zone, sizeof(zone)));
+    CHECK(strcmp(zone, "PST8PDT,M3.2.0,M11.1.0") == 0);
+    char small[8];
+    CHECK(!reader.getRest(1, small, sizeof(small)));
+    CHECK(strcmp(reader.getLastError().message, "value too long") == 0);
+    CHECK(reader.getLastError().column == 11); // After the trimmed space
+
+    CHECK(reader.next()); // A lone comma is a record with two empty fields
+    CHECK(reader.getFieldCount() == 2);
+    long number;
+    CHECK(!reader.getInt(0, number));
+    CHECK(strcmp(reader.getLastError().message, "missing number") == 0);
+    CHECK(!reader.getRest(1, zone, sizeof(zone)));
+}
+
+static void testNumbers()
+{
+    MemorySource source("12x, 7 ,1e2,nan,-3.5, 0x10,\n", 64);
+    CsvReader reader(MemorySource::read, &source);
+    CHECK(reader.next());
+
+    long whole;
+    float number;
+    CHECK(!reader.getInt(0, whole));
+    CHECK(reader.getLastError().column == 1);
+    CHECK(strcmp(reader.getLastError().message, "expected a whole number") == 0);
+    CHECK(reader.getInt(1, whole) && whole == 7);
+    CHECK(reader.getFloat(2, number) && number == 100.0f);
+    CHECK(!reader.getFloat(3, number));
+    CHECK(strcmp(reader.getLastError().message, "expected a number") == 0);
+    CHECK(reader.getFloat(4, number) && number == -3.5f);
+    CHECK(!reader.getInt(5, whole)); // Decimal only
+    CHECK(!reader.getFloat(6, number));
+    CHECK(!reader.getFloat(9, number)); // No such field
+    CHECK(reader.getErrorCount() == 5);
+}
+
+static void testReadError()
+{
+    MemorySource source("1,2\n3,4", 2, true);
+    CsvReader reader(MemorySource::read, &source);
+    CHECK(reader.next());
+    CHECK(reader.next()); // The partial last line still counts
+    CHECK(field(reader, 1) == "4");
+    CHECK(!reader.next());
+    CHECK(reader.hasReadError());
+
+    MemorySource empty("", 64);
+    CsvReader emptyReader(MemorySource::read, &empty);
+    CHECK(!emptyReader.next());
+    CHECK(emptyReader.getLineNumber() == 0);
+    CHECK(!emptyReader.hasReadError());
+}
+
+/**
+ * @brief Parse one line as a schedule record
+ */
+static ScheduleLineResult parseLine(Schedule &schedule, const char *text, CsvError *error = nullptr)
+{
+    MemorySource source(text, 64);
+    CsvReader reader(MemorySource::read, &source);
+    if (!reader.next())
+    {
+        return SCHEDULE_LINE_OTHER;
+    }
+    ScheduleLineResult result = schedule.parseRecord(reader);
+    if (error)
+    {
+        *error = reader.getLastError();
+    }
+    return result;
+}
+
+static void testScheduleRecords()
+{
+    static Schedule schedule;
+    CsvError error;
+
+    CHECK(parseLine(schedule, "8,0.0,Morning") == SCHEDULE_LINE_ADDED);
+    CHECK(parseLine(schedule, "24,-1") == SCHEDULE_LINE_ADDED);
+    CHECK(parseLine(schedule, "BaseTemperature,70") == SCHEDULE_LINE_OTHER);
+    CHECK(parseLine(schedule, "Timezone,PST8PDT,M3.2.0,M11.1.0") == SCHEDULE_LINE_OTHER);
+    CHECK(parseLine(schedule, "8") == SCHEDULE_LINE_OTHER);
+    CHECK(parseLine(schedule, "Weekends,~09:30,0.0") == SCHEDULE_LINE_ADDED);
+    CHECK(parseLine(schedule, "mon-wed,6:05,1.5") == SCHEDULE_LINE_ADDED);
+    CHECK(parseLine(schedule, "Fri-Mon,23:59,1") == SCHEDULE_LINE_ADDED); // Wraps over the weekend
+    CHECK(parseLine(schedule, "Monday,07:00,1") == SCHEDULE_LINE_ADDED);
+
+    CHECK(parseLine(schedule, "25,1", &error) == SCHEDULE_LINE_INVALID);
+    CHECK(strcmp(error.message, "hour must be 0-24") == 0);
+    CHECK(parseLine(schedule, "8,1.0x", &error) == SCHEDULE_LINE_INVALID);
+    CHECK(error.column == 3);
+    CHECK(parseLine(schedule, "Mon,24:00,1", &error) == SCHEDULE_LINE_INVALID);
+    CHECK(error.column == 5);
+    CHECK(strcmp(error.message, "expected a time as HH:MM or ~HH:MM") == 0);
+    CHECK(parseLine(schedule, "Mon,08:60,1") == SCHEDULE_LINE_INVALID);
+    CHECK(parseLine(schedule, "Mon,08:00x,1") == SCHEDULE_LINE_INVALID);
+    CHECK(parseLine(schedule, "Mon,~,1") == SCHEDULE_LINE_INVALID);
+    CHECK(parseLine(schedule, "Mon,08:00") == SCHEDULE_LINE_INVALID);
+    CHECK(parseLine(schedule, "Mo,08:00,1") == SCHEDULE_LINE_OTHER);
+    CHECK(parseLine(schedule, "Mon-Funday,08:00,1") == SCHEDULE_LINE_OTHER);
+}
+
+static void testSampleSchedule()
+{
+    static Schedule schedule;
+    MemorySource source(SAMPLE, 3);
+    CsvReader reader(MemorySource::read, &source);
+    int added = 0;
+    int other = 0;
+    while (reader.next())
+    {
+        ScheduleLineResult result = schedule.parseRecord(reader);
+        added += result == SCHEDULE_LINE_ADDED;
+        other += result == SCHEDULE_LINE_OTHER;
+    }
+    CHECK(added == 6);
+    CHECK(other == 1);
+    CHECK(reader.getErrorCount() == 0);
+    schedule.compile();
+    CHECK(schedule.getPointCount() == 4 * 7 + 2); // Weekend 08:00 replaces the daily one
+
+    const uint16_t monday = 1 * SCHEDULE_MINUTES_PER_DAY;
+    const uint16_t saturday = 6 * SCHEDULE_MINUTES_PER_DAY;
+    CHECK_NEAR(schedule.getOffset(monday + 3 * 60), -12.0, 0.01);
+    CHECK_NEAR(schedule.getOffset(monday + 12 * 60), 0.0, 0.01);
+    CHECK_NEAR(schedule.getOffset(monday + 18 * 60), 2.0, 0.01);
+    CHECK_NEAR(schedule.getOffset(monday + 23 * 60), -8.0, 0.01);
+    CHECK(schedule.getMinutesUntilChange(monday + 12 * 60) == 5 * 60);
+
+    // Weekends sleep in, then ramp from -12 at 08:00 to 0 at 09:30
+    CHECK_NEAR(schedule.getOffset(saturday + 8 * 60), -12.0, 0.01);
+    CHECK_NEAR(schedule.getOffset(saturday + 8 * 60 + 45), -6.0, 0.1);
+    CHECK_NEAR(schedule.getOffset(saturday + 9 * 60 + 30), 0.0, 0.01);
+    CHECK(schedule.getMinutesUntilChange(saturday + 8 * 60 + 45) == 1);
+
+    // Saturday 22:00 holds past midnight until Sunday 01:00
+    CHECK_NEAR(schedule.getOffset(0), -8.0, 0.01);
+    CHECK(schedule.getMinutesUntilChange(saturday + 23 * 60) == 2 * 60);
+}
+
+int main()
+{
+    testChunking();
+    testLineEndings();
+    testLongLines();
+    testFields();
+    testNumbers();
+    testReadError();
+    testScheduleRecords();
+    testSampleSchedule();
+    return checkSummary("csv_reader_test");
+}
@@ -0,0 +1,301 @@
+/**
+ * @file heater_monitor_test.cpp
+ * @brief Host test: HeaterMonitor on synthetic room temperature traces
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * A Trace feeds HeaterMonitor one observation a minute, the way the control
+ * loop does, with the room temperature moving at a set rate (°F/h). Covers
+ * learning the usual ON rate, NO HEAT with and without a learned rate,
+ * STUCK ON, the clear hysteresis of both, and a stall in the samples.
+ *
+ * Build and run on the host (tools/test/run_tests.sh builds every test):
+ *     g++ -std=c++17 -Isrc tools/test/heater_monitor_test.cpp src/heater_monitor.cpp -o heater_monitor_test
+ *     ./heater_monitor_test
+ */
+
+#include <string>
+
+#include "check.hpp"
+#include "heater_monitor.hpp"
+
+/**
+ * @struct Trace
+ * @brief Room temperature and time, fed to a HeaterMonitor once a minute
+ */
+struct Trace
+{
+    HeaterMonitor &monitor;
+    unsigned long nowMs;
+    float temperature;
+    int changes;              // observe() calls that returned true
+    int firstFaultMinute;     // Minute of the run the fault was first reported, -1 = not yet
+
+    Trace(HeaterMonitor &heaterMonitor, float startTemperature)
+        : monitor(heaterMonitor), nowMs(0), temperature(startTemperature), changes(0), firstFaultMinute(-1)
+    {
+    }
+
+    /**
+     * @brief Run for a number of minutes with the stove in one state
+     * @param minutes Minutes to run
+     * @param on Stove state
+     * @param ratePerHour How fast the room changes (°F/h)
+     */
+    void run(int minutes, bool on, float ratePerHour)
+    {
+        firstFaultMinute = -1;
+        for (int minute = 0; minute < minutes; minute++)
+        {
+            changes += monitor.observe(temperature, on, nowMs) ? 1 : 0;
+            if (firstFaultMinute < 0 && monitor.getFault() != HEATER_OK)
+            {
+                firstFaultMinute = minute;
+            }
+            nowMs += HEATER_MONITOR_SAMPLE_MS;
+            temperature += ratePerHour / 60;
+        }
+    }
+
+    /**
+     * @brief Healthy cycles: ON warming at onRate, then OFF cooling slowly
+     */
+    void learn(int periods, float onRate)
+    {
+        for (int i = 0; i < periods; i++)
+        {
+            run(60, true, onRate);
+            run(90, false, -0.5f);
+        }
+    }
+};
+
+// Minutes from a state change to the first full window, then to a confirmed alarm
+#define FIRST_ON_WINDOW (HEATER_MONITOR_ON_SETTLE_MIN + HEATER_MONITOR_WINDOW - 1)
+#define FIRST_OFF_WINDOW (HEATER_MONITOR_OFF_SETTLE_MIN + HEATER_MONITOR_WINDOW - 1)
+#define CONFIRM_MINUTES (HEATER_MONITOR_CONFIRM - 1)
+
+static void testRegression()
+{
+    SlidingRegression regression;
+    CHECK(regression.getSlope() == 0);
+    regression.add(70);
+    CHECK(regression.getSlope() == 0);
+
+    // A line keeps its slope through many laps of the ring
+    for (int i = 1; i < 10 * HEATER_MONITOR_WINDOW + 7; i++)
+    {
+        regression.add(70 + 0.05f * i);
+        if (i == HEATER_MONITOR_WINDOW - 2)
+        {
+            CHECK(!regression.isFull());
+        }
+    }
+    CHECK(regression.isFull());
+    CHECK_NEAR(regression.getSlope(), 0.05, 1e-4);
+
+    // Only the last window counts
+    for (int i = 0; i < HEATER_MONITOR_WINDOW; i++)
+    {
+        regression.add(80 - 0.02f * i);
+    }
+    CHECK_NEAR(regression.getSlope(), -0.02, 1e-4);
+
+    regression.clear();
+    CHECK(!regression.isFull());
+    CHECK(regression.getSlope() == 0);
+}
+
+static void testLearning()
+{
+    HeaterMonitor monitor;
+    Trace trace(monitor, 66);
+
+    // An ON period too short for a full window teaches nothing
+    trace.run(FIRST_ON_WINDOW, true, 3);
+    trace.run(90, false, -0.5f);
+    CHECK(monitor.getLearnedPeriods() == 0);
+
+    trace.learn(1, 3);
+    CHECK(monitor.getLearnedPeriods() == 1);
+    CHECK_NEAR(monitor.getExpectedRate(), 3, 0.01);
+
+    // Later periods move the EWMA part of the way
+    trace.learn(1, 4);
+    CHECK(monitor.getLearnedPeriods() == 2);
+    CHECK_NEAR(monitor.getExpectedRate(), 3 + HEATER_MONITOR_LEARN_ALPHA, 0.01);
+
+    // The latest window's rate, while OFF and settled
+    CHECK_NEAR(monitor.getRate(), -0.5, 0.01);
+    CHECK(monitor.getFault() == HEATER_OK);
+    CHECK(trace.changes == 0);
+
+    monitor.reset();
+    CHECK(monitor.getLearnedPeriods() == 0);
+    CHECK(monitor.getExpectedRate() == 0);
+    CHECK(monitor.getRate() == 0);
+}
+
+static void testNoHeat()
+{
+    HeaterMonitor monitor;
+    Trace trace(monitor, 66);
+    trace.learn(HEATER_MONITOR_MIN_HISTORY, 3);
+    float expected = monitor.getExpectedRate();
+    CHECK_NEAR(expected, 3, 0.01);
+
+    // Barely warming: confirmed after HEATER_MONITOR_CONFIRM windows, not before
+    float slow = expected * HEATER_MONITOR_MIN_RATE_FRACTION * 0.5f;
+    trace.run(60, true, slow);
+    CHECK(monitor.getFault() == HEATER_NO_HEAT);
+    CHECK(trace.firstFaultMinute == FIRST_ON_WINDOW + CONFIRM_MINUTES);
+    CHECK(trace.changes == 1);
+
+    // Warming again, but not clearly past the threshold: the alarm holds
+    float marginal = expected * HEATER_MONITOR_MIN_RATE_FRACTION * 1.5f;
+    trace.run(HEATER_MONITOR_WINDOW, true, marginal);
+    CHECK(monitor.getFault() == HEATER_NO_HEAT);
+    CHECK_NEAR(monitor.getRate(), marginal, 0.01);
+
+    // Clearly past it: cleared on the next window
+    float healthy = expected * HEATER_MONITOR_MIN_RATE_FRACTION / HEATER_MONITOR_CLEAR_RATIO * 1.2f;
+    trace.run(HEATER_MONITOR_WINDOW, true, healthy);
+    CHECK(monitor.getFault() == HEATER_OK);
+    CHECK(trace.changes == 2);
+
+    // A NO HEAT alarm ends with its ON period, and that period isn't learned
+    uint16_t learned = monitor.getLearnedPeriods();
+    trace.run(90, true, 0);
+    CHECK(monitor.getFault() == HEATER_NO_HEAT);
+    trace.run(1, false, 0);
+    CHECK(monitor.getFault() == HEATER_OK);
+    CHECK(monitor.getLearnedPeriods() == learned);
+    CHECK_NEAR(monitor.getExpectedRate(), expected, 1e-4);
+
+    // A short dip doesn't confirm
+    trace.run(90, false, -0.5f);
+    int before = trace.changes;
+    trace.run(FIRST_ON_WINDOW + 3, true, 3);
+    trace.run(3, true, -2);
+    trace.run(HEATER_MONITOR_WINDOW * 2, true, 3);
+    CHECK(trace.changes == before);
+    CHECK(monitor.getFault() == HEATER_OK);
+}
+
+static void testNoHeatWithoutHistory()
+{
+    HeaterMonitor monitor;
+    Trace trace(monitor, 68);
+
+    // Not warming at all is fine until the usual rate is known...
+    trace.run(60, true, 0.05f);
+    CHECK(monitor.getFault() == HEATER_OK);
+
+    // ...but a room that cools with the stove ON is NO HEAT
+    trace.run(1, false, 0);
+    trace.run(60, true, -1);
+    CHECK(monitor.getFault() == HEATER_NO_HEAT);
+    CHECK(trace.firstFaultMinute == FIRST_ON_WINDOW + CONFIRM_MINUTES);
+
+    // Barely warming doesn't clear it
+    trace.run(HEATER_MONITOR_WINDOW * 2, true, HEATER_MONITOR_NO_HEAT_CLEAR_F * 0.5f);
+    CHECK(monitor.getFault() == HEATER_NO_HEAT);
+    CHECK(trace.changes == 1);
+
+    // Warming clearly does
+    trace.run(HEATER_MONITOR_WINDOW, true, HEATER_MONITOR_NO_HEAT_CLEAR_F * 2);
+    CHECK(monitor.getFault() == HEATER_OK);
+    CHECK(trace.changes == 2);
+    CHECK(monitor.getLearnedPeriods() < HEATER_MONITOR_MIN_HISTORY);
+}
+
+static void testStuckOn()
+{
+    HeaterMonitor monitor;
+    Trace trace(monitor, 68);
+
+    // Warming while OFF is ignored during the settle time...
+    trace.run(FIRST_OFF_WINDOW, false, 3);
+    CHECK(monitor.getFault() == HEATER_OK);
+    CHECK(monitor.getRate() == 0);
+
+    // ...and reported once it has lasted HEATER_MONITOR_CONFIRM windows past it
+    trace.run(CONFIRM_MINUTES, false, 3);
+    CHECK(monitor.getFault() == HEATER_OK);
+    trace.run(1, false, 3);
+    CHECK(monitor.getFault() == HEATER_STUCK_ON);
+    CHECK(trace.changes == 1);
+
+    // Slowing down, but still past the clear level: holds
+    trace.run(HEATER_MONITOR_WINDOW, false, HEATER_MONITOR_STUCK_RATE_F * 0.8f);
+    CHECK(monitor.getFault() == HEATER_STUCK_ON);
+
+    // Switching ON doesn't end it by itself
+    trace.run(FIRST_ON_WINDOW - 1, true, 3);
+    CHECK(monitor.getFault() == HEATER_STUCK_ON);
+
+    // OFF again and settled: clears once the room is steady
+    trace.run(FIRST_OFF_WINDOW + 1, false, 0);
+    CHECK(monitor.getFault() == HEATER_OK);
+    CHECK(trace.changes == 2);
+
+    // Gentle warming (sun) while OFF is below the limit
+    trace.run(120, false, HEATER_MONITOR_STUCK_RATE_F * 0.8f);
+    CHECK(monitor.getFault() == HEATER_OK);
+
+    // With a fast stove learned, the limit rises to half its rate
+    HeaterMonitor learned;
+    Trace learnedTrace(learned, 66);
+    learnedTrace.learn(HEATER_MONITOR_MIN_HISTORY, 4);
+    learnedTrace.run(FIRST_OFF_WINDOW + HEATER_MONITOR_WINDOW * 2, false, 1.6f);
+    CHECK(learned.getFault() == HEATER_OK);
+    learnedTrace.run(1, true, 0);
+    learnedTrace.run(FIRST_OFF_WINDOW + HEATER_MONITOR_WINDOW * 2, false, 2.5f);
+    CHECK(learned.getFault() == HEATER_STUCK_ON);
+}
+
+static void testStall()
+{
+    HeaterMonitor monitor;
+    Trace trace(monitor, 68);
+
+    // OFF and settled with a steady room
+    trace.run(FIRST_OFF_WINDOW + 5, false, 0);
+    CHECK(monitor.getRate() == 0);
+
+    // Samples stop for five minutes while the room jumps a degree; at the old
+    // spacing that step would look like fast warming
+    trace.nowMs += 5 * HEATER_MONITOR_SAMPLE_MS;
+    trace.temperature += 1;
+
+    // The window starts over, so the rate holds until it has refilled
+    trace.run(HEATER_MONITOR_WINDOW - 1, false, 0);
+    CHECK(monitor.getRate() == 0);
+    trace.run(HEATER_MONITOR_WINDOW * 2, false, 0);
+    CHECK(monitor.getRate() == 0);
+    CHECK(monitor.getFault() == HEATER_OK);
+    CHECK(trace.changes == 0);
+
+    // Extra observations within a sample period are ignored
+    for (int i = 1; i <= 10; i++)
+    {
+        CHECK(!monitor.observe(90, false, trace.nowMs - HEATER_MONITOR_SAMPLE_MS + i * 1000));
+    }
+    trace.run(HEATER_MONITOR_WINDOW, false, 0);
+    CHECK(monitor.getRate() == 0);
+
+    CHECK(HeaterMonitor::getFaultName(HEATER_OK) == std::string("OK"));
+    CHECK(HeaterMonitor::getFaultName(HEATER_NO_HEAT) == std::string("NO HEAT"));
+    CHECK(HeaterMonitor::getFaultName(HEATER_STUCK_ON) == std::string("STUCK ON"));
+}
+
+int main()
+{
+    testRegression();
+    testLearning();
+    testNoHeat();
+    testNoHeatWithoutHistory();
+    testStuckOn();
+    testStall();
+    return checkSummary("heater_monitor_test");
+}
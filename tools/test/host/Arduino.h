@@ -0,0 +1,294 @@
+/**
+ * @file Arduino.h
+ * @brief Just enough of the Arduino core to build shared/ and receiver code on a PC
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * Only for the host tests in tools/test/ (put this directory first on the
+ * include path with -Itools/test/host). Provides:
+ * - String, backed by std::string, with the members the firmware uses
+ * - Serial, which discards output unless HOST_SERIAL is set in the environment
+ * - A simulated clock: millis()/micros() only move when delay() is called or
+ *   a test calls hostAdvanceMs(), so timing-dependent code runs instantly and
+ *   deterministically
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using std::max;
+using std::min;
+
+#define SERIAL_8N1 0x800001c
+
+// ---------------------------------------------------------------- Simulated clock
+
+inline uint64_t &hostClockUs()
+{
+    static uint64_t now = 0;
+    return now;
+}
+
+inline void hostAdvanceMs(unsigned long ms)
+{
+    hostClockUs() += (uint64_t)ms * 1000;
+}
+
+inline unsigned long millis()
+{
+    return (unsigned long)(hostClockUs() / 1000);
+}
+
+inline unsigned long micros()
+{
+    return (unsigned long)hostClockUs();
+}
+
+inline void delay(unsigned long ms)
+{
+    hostAdvanceMs(ms);
+}
+
+inline void delayMicroseconds(unsigned int us)
+{
+    hostClockUs() += us;
+}
+
+inline void yield()
+{
+}
+
+// ---------------------------------------------------------------- String
+
+class String
+{
+private:
+    std::string text;
+
+    static std::string fromLong(long value, unsigned char base)
+    {
+        char buffer[72];
+        if (base == 10)
+        {
+            std::snprintf(buffer, sizeof(buffer), "%ld", value);
+            return buffer;
+        }
+        return fromUnsignedLong((unsigned long)value, base);
+    }
+
+    static std::string fromUnsignedLong(unsigned long value, unsigned char base)
+    {
+        if (value == 0)
+        {
+            return "0";
+        }
+        std::string digits;
+        while (value > 0)
+        {
+            digits.insert(digits.begin(), "0123456789abcdefghijklmnopqrstuvwxyz"[value % base]);
+            value /= base;
+        }
+        return digits;
+    }
+
+    static std::string fromDouble(double value, unsigned int decimals)
+    {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%.*f", (int)decimals, value);
+        return buffer;
+    }
+
+public:
+    String() {}
+    String(const char *value) : text(value ? value : "") {}
+    String(const std::string &value) : text(value) {}
+    explicit String(char value) : text(1, value) {}
+    explicit String(unsigned char value, unsigned char base = 10) : text(fromUnsignedLong(value, base)) {}
+    explicit String(int value, unsigned char base = 10) : text(fromLong(value, base)) {}
+    explicit String(unsigned int value, unsigned char base = 10) : text(fromUnsignedLong(value, base)) {}
+    explicit String(long value, unsigned char base = 10) : text(fromLong(value, base)) {}
+    explicit String(unsigned long value, unsigned char base = 10) : text(fromUnsignedLong(value, base)) {}
+    explicit String(float value, unsigned int decimals = 2) : text(fromDouble(value, decimals)) {}
+    explicit String(double value, unsigned int decimals = 2) : text(fromDouble(value, decimals)) {}
+
+    unsigned int length() const { return (unsigned int)text.size(); }
+    const char *c_str() const { return text.c_str(); }
+    char charAt(unsigned int index) const { return index < text.size() ? text[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+
+    int indexOf(char c, unsigned int from = 0) const
+    {
+        size_t at = text.find(c, from);
+        return at == std::string::npos ? -1 : (int)at;
+    }
+
+    int indexOf(const String &needle, unsigned int from = 0) const
+    {
+        size_t at = text.find(needle.text, from);
+        return at == std::string::npos ? -1 : (int)at;
+    }
+
+    int lastIndexOf(char c) const
+    {
+        size_t at = text.rfind(c);
+        return at == std::string::npos ? -1 : (int)at;
+    }
+
+    String substring(unsigned int begin) const
+    {
+        return begin >= text.size() ? String() : String(text.substr(begin));
+    }
+
+    String substring(unsigned int begin, unsigned int end) const
+    {
+        if (begin > end)
+        {
+            std::swap(begin, end);
+        }
+        if (begin >= text.size())
+        {
+            return String();
+        }
+        end = std::min<unsigned int>(end, (unsigned int)text.size());
+        return String(text.substr(begin, end - begin));
+    }
+
+    bool startsWith(const String &prefix) const { return text.compare(0, prefix.text.size(), prefix.text) == 0; }
+
+    bool endsWith(const String &suffix) const
+    {
+        return text.size() >= suffix.text.size() &&
+               text.compare(text.size() - suffix.text.size(), suffix.text.size(), suffix.text) == 0;
+    }
+
+    bool equals(const String &other) const { return text == other.text; }
+
+    bool equalsIgnoreCase(const String &other) const
+    {
+        if (text.size() != other.text.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            if (std::tolower((unsigned char)text[i]) != std::tolower((unsigned char)other.text[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    long toInt() const { return std::strtol(text.c_str(), nullptr, 10); }
+    float toFloat() const { return std::strtof(text.c_str(), nullptr); }
+
+    void trim()
+    {
+        size_t begin = 0;
+        while (begin < text.size() && std::isspace((unsigned char)text[begin]))
+        {
+            begin++;
+        }
+        size_t end = text.size();
+        while (end > begin && std::isspace((unsigned char)text[end - 1]))
+        {
+            end--;
+        }
+        text = text.substr(begin, end - begin);
+    }
+
+    void toUpperCase()
+    {
+        for (char &c : text)
+        {
+            c = (char)std::toupper((unsigned char)c);
+        }
+    }
+
+    void toLowerCase()
+    {
+        for (char &c : text)
+        {
+            c = (char)std::tolower((unsigned char)c);
+        }
+    }
+
+    String &operator+=(const String &other) { text += other.text; return *this; }
+    String &operator+=(const char *other) { text += other; return *this; }
+    String &operator+=(char c) { text += c; return *this; }
+    String &operator+=(int value) { text += fromLong(value, 10); return *this; }
+    String &operator+=(unsigned int value) { text += fromUnsignedLong(value, 10); return *this; }
+    String &operator+=(long value) { text += fromLong(value, 10); return *this; }
+    String &operator+=(unsigned long value) { text += fromUnsignedLong(value, 10); return *this; }
+
+    friend String operator+(const String &a, const String &b) { return String(a.text + b.text); }
+    friend String operator+(const String &a, const char *b) { return String(a.text + b); }
+    friend String operator+(const char *a, const String &b) { return String(a + b.text); }
+    friend String operator+(const String &a, char b) { return String(a.text + b); }
+    friend String operator+(const String &a, int b) { return a + String(b); }
+    friend String operator+(const String &a, unsigned int b) { return a + String(b); }
+    friend String operator+(const String &a, long b) { return a + String(b); }
+    friend String operator+(const String &a, unsigned long b) { return a + String(b); }
+
+    friend bool operator==(const String &a, const String &b) { return a.text == b.text; }
+    friend bool operator==(const String &a, const char *b) { return a.text == b; }
+    friend bool operator!=(const String &a, const String &b) { return a.text != b.text; }
+    friend bool operator!=(const String &a, const char *b) { return a.text != b; }
+    friend bool operator<(const String &a, const String &b) { return a.text < b.text; }
+};
+
+// ---------------------------------------------------------------- Serial
+
+class HostSerial
+{
+private:
+    bool echo() const
+    {
+        static const bool enabled = std::getenv("HOST_SERIAL") != nullptr;
+        return enabled;
+    }
+
+public:
+    void begin(unsigned long) {}
+
+    int printf(const char *format, ...)
+    {
+        if (!echo())
+        {
+            return 0;
+        }
+        va_list args;
+        va_start(args, format);
+        int written = std::vprintf(format, args);
+        va_end(args);
+        return written;
+    }
+
+    void print(const String &text) { printf("%s", text.c_str()); }
+    void print(const char *text) { printf("%s", text); }
+    void print(char c) { printf("%c", c); }
+    void print(int value) { printf("%d", value); }
+    void print(unsigned int value) { printf("%u", value); }
+    void print(long value) { printf("%ld", value); }
+    void print(unsigned long value) { printf("%lu", value); }
+    void print(double value) { printf("%.2f", value); }
+
+    void println() { printf("\n"); }
+
+    template <typename T>
+    void println(const T &value)
+    {
+        print(value);
+        println();
+    }
+};
+
+inline HostSerial Serial;
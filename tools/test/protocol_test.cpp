@@ -0,0 +1,262 @@
+/**
+ * @file protocol_test.cpp
+ * @brief Host test: frame fields, node addressing and multi-zone routing
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * Covers ProtocolHelper (shared/protocol_common.hpp) and ZoneRouter
+ * (receiver/src/zone_router.cpp): the frames a thermostat builds, which of
+ * them a receiver acts on and which relay channel they drive, and which
+ * replies a thermostat accepts when several zones share the channel, with
+ * disjoint node IDs and with the shipped defaults.
+ *
+ * Build and run on the host (tools/test/run_tests.sh builds every test):
+ *     g++ -std=c++17 -Itools/test/host tools/test/protocol_test.cpp receiver/src/zone_router.cpp \
+ *         -o protocol_test
+ *     ./protocol_test
+ */
+
+#include "check.hpp"
+#include "../../shared/protocol_common.hpp"
+#include "../../receiver/src/zone_router.hpp"
+
+// Two receivers share the channel: receiver 1 drives two zones, receiver 4 one
+static const uint8_t RECEIVER_A = 1;
+static const uint8_t RECEIVER_B = 4;
+static const uint8_t LIVING_ROOM = 2; // Receiver A, channel 0
+static const uint8_t BEDROOM = 3;     // Receiver A, channel 1
+static const uint8_t WORKSHOP = 5;    // Receiver B, channel 0
+
+/**
+ * @brief What a receiver does with a frame, as handleCommand() decides it
+ * @return Relay channel the frame drives, ZONE_NO_CHANNEL if it is ignored
+ */
+static uint8_t receive(const String &frame, uint8_t receiverId, const ZoneRouter &router)
+{
+    if (!ProtocolHelper::isAddressedTo(frame, receiverId) || ProtocolHelper::isReply(frame))
+    {
+        return ZONE_NO_CHANNEL;
+    }
+    return router.route(ProtocolHelper::getNodeId(frame, P2P_FIELD_SOURCE));
+}
+
+static void testFields()
+{
+    String frame = "STOVE_ON";
+    frame = ProtocolHelper::addField(frame, P2P_FIELD_NEXT_SLOT, String(60));
+    frame = ProtocolHelper::addField(frame, P2P_FIELD_LINK_RSSI, String(-87));
+    CHECK(frame == "STOVE_ON;NS=60;RS=-87");
+    CHECK(ProtocolHelper::getCommand(frame) == "STOVE_ON");
+    CHECK(ProtocolHelper::getCommand("PING") == "PING");
+
+    String value;
+    CHECK(ProtocolHelper::getField(frame, P2P_FIELD_NEXT_SLOT, value) && value == "60");
+    CHECK(ProtocolHelper::getField(frame, P2P_FIELD_LINK_RSSI, value) && value == "-87");
+    CHECK(!ProtocolHelper::getField(frame, P2P_FIELD_SEQUENCE, value));
+
+    // "S" must not match the tail of "RS" or "NS"
+    CHECK(!ProtocolHelper::getField(frame, P2P_FIELD_SOURCE, value));
+    CHECK(ProtocolHelper::getNodeId(frame, P2P_FIELD_SOURCE) == P2P_NODE_ID_NONE);
+
+    // A command with fields is still a valid command
+    CHECK(ProtocolHelper::isValidCommand(frame));
+    CHECK(!ProtocolHelper::isValidCommand("STOVE_MAYBE;NS=60"));
+}
+
+static void testHexRoundTrip()
+{
+    String frame = ProtocolHelper::buildCommandFrame(CMD_STOVE_OFF, LIVING_ROOM, RECEIVER_A, 513, 45);
+    String hex = ProtocolHelper::asciiToHex(ProtocolHelper::createP2PMessage(frame));
+    CHECK(hex.startsWith("544845524D4F")); // "THERMO"
+    String received = ProtocolHelper::hexToAscii(hex);
+    CHECK(ProtocolHelper::isValidP2PMessage(received));
+    CHECK(ProtocolHelper::parseP2PMessage(received) == frame);
+    CHECK(ProtocolHelper::parseP2PMessage("OTHERSTOVE_ON") == "");
+}
+
+static void testAddressing()
+{
+    CHECK(ProtocolHelper::addAddress("PING", P2P_NODE_ID_NONE, P2P_NODE_ID_NONE) == "PING");
+    CHECK(ProtocolHelper::addAddress("PING", LIVING_ROOM, P2P_NODE_ID_NONE) == "PING;S=2");
+    CHECK(ProtocolHelper::addAddress("PING", LIVING_ROOM, RECEIVER_A) == "PING;S=2;D=1");
+
+    // Out-of-range or malformed IDs read as "no ID"
+    CHECK(ProtocolHelper::getNodeId("PING;S=255", P2P_FIELD_SOURCE) == P2P_NODE_ID_BROADCAST);
+    CHECK(ProtocolHelper::getNodeId("PING;S=254", P2P_FIELD_SOURCE) == 254);
+    CHECK(ProtocolHelper::getNodeId("PING;S=0", P2P_FIELD_SOURCE) == P2P_NODE_ID_NONE);
+    CHECK(ProtocolHelper::getNodeId("PING;S=256", P2P_FIELD_SOURCE) == P2P_NODE_ID_NONE);
+    CHECK(ProtocolHelper::getNodeId("PING;S=-3", P2P_FIELD_SOURCE) == P2P_NODE_ID_NONE);
+    CHECK(ProtocolHelper::getNodeId("PING;S=x", P2P_FIELD_SOURCE) == P2P_NODE_ID_NONE);
+    CHECK(ProtocolHelper::getNodeId("PING", P2P_FIELD_DEST) == P2P_NODE_ID_NONE);
+
+    // Unaddressed and broadcast frames are for everyone
+    CHECK(ProtocolHelper::isAddressedTo("STOVE_ON", RECEIVER_A));
+    CHECK(ProtocolHelper::isAddressedTo("STOVE_ON;D=255", RECEIVER_A));
+    CHECK(ProtocolHelper::isAddressedTo("STOVE_ON;D=1", RECEIVER_A));
+    CHECK(!ProtocolHelper::isAddressedTo("STOVE_ON;D=4", RECEIVER_A));
+}
+
+static void testCommandFrame()
+{
+    // The address must survive the fields added after it
+    String frame = ProtocolHelper::buildCommandFrame(CMD_STOVE_ON, LIVING_ROOM, RECEIVER_A, 7, 60);
+    CHECK(frame == "STOVE_ON;S=2;D=1;Q=7;NS=60");
+    CHECK(ProtocolHelper::getCommand(frame) == CMD_STOVE_ON);
+    CHECK(ProtocolHelper::getNodeId(frame, P2P_FIELD_SOURCE) == LIVING_ROOM);
+    CHECK(ProtocolHelper::getNodeId(frame, P2P_FIELD_DEST) == RECEIVER_A);
+
+    String value;
+    CHECK(ProtocolHelper::getField(frame, P2P_FIELD_SEQUENCE, value) && value == "7");
+    CHECK(ProtocolHelper::getField(frame, P2P_FIELD_NEXT_SLOT, value) && value == "60");
+
+    // No slot announced, no node IDs configured
+    CHECK(ProtocolHelper::buildCommandFrame(CMD_PING, P2P_NODE_ID_NONE, P2P_NODE_ID_NONE, 65535, -1) ==
+          "PING;Q=65535");
+
+    // The widest request and reply still fit a link message on the receiver
+    String request = ProtocolHelper::addField(CMD_STATUS_REQUEST, P2P_FIELD_RUNTIME, "60/1440/65535");
+    request = ProtocolHelper::addField(request, P2P_FIELD_HEATER_FAULT, "2");
+    request = ProtocolHelper::buildCommandFrame(request, 254, 254, 65535, 4294967L);
+    CHECK(request.length() <= P2P_MAX_FRAME_LENGTH);
+
+    String reply = ProtocolHelper::addField(RESP_STOVE_OFF_ACK, P2P_FIELD_LINK_RSSI, "-137");
+    reply = ProtocolHelper::addField(reply, P2P_FIELD_LINK_SNR, "-20");
+    reply = ProtocolHelper::addField(reply, P2P_FIELD_LINK_ERRORS, "100");
+    reply = ProtocolHelper::addField(reply, P2P_FIELD_RECONFIRM, "4294967295");
+    reply = ProtocolHelper::addAddress(reply, 254, 254);
+    CHECK(reply.length() <= P2P_MAX_FRAME_LENGTH);
+}
+
+static void testZoneRouter()
+{
+    ZoneRouter router;
+    CHECK(router.getChannelCount() == 0);
+    CHECK(router.route(LIVING_ROOM) == ZONE_NO_CHANNEL);
+
+    CHECK(router.bind(LIVING_ROOM, 0));
+    CHECK(router.bind(BEDROOM, 1));
+    CHECK(router.bind(P2P_NODE_ID_NONE, 0));
+    CHECK(!router.bind(P2P_NODE_ID_BROADCAST, 0));
+    CHECK(!router.bind(WORKSHOP, ZONE_MAX_CHANNELS));
+    CHECK(router.getChannelCount() == 2);
+
+    CHECK(router.route(LIVING_ROOM) == 0);
+    CHECK(router.route(BEDROOM) == 1);
+    CHECK(router.route(P2P_NODE_ID_NONE) == 0);
+    CHECK(router.route(WORKSHOP) == ZONE_NO_CHANNEL);
+    CHECK(router.route(P2P_NODE_ID_BROADCAST) == ZONE_NO_CHANNEL);
+
+    // Rebinding moves the thermostat
+    CHECK(router.bind(BEDROOM, 2));
+    CHECK(router.route(BEDROOM) == 2);
+    CHECK(router.getChannelCount() == 3);
+}
+
+static void testSharedChannel()
+{
+    ZoneRouter routerA;
+    routerA.bind(LIVING_ROOM, 0);
+    routerA.bind(BEDROOM, 1);
+    routerA.bind(P2P_NODE_ID_NONE, 0);
+    ZoneRouter routerB;
+    routerB.bind(WORKSHOP, 0);
+
+    // Each thermostat's command reaches only its own receiver and channel
+    String living = ProtocolHelper::buildCommandFrame(CMD_STOVE_ON, LIVING_ROOM, RECEIVER_A, 1, 60);
+    String bedroom = ProtocolHelper::buildCommandFrame(CMD_STOVE_ON, BEDROOM, RECEIVER_A, 1, -1);
+    String workshop = ProtocolHelper::buildCommandFrame(CMD_STOVE_ON, WORKSHOP, RECEIVER_B, 1, 60);
+    CHECK(receive(living, RECEIVER_A, routerA) == 0);
+    CHECK(receive(bedroom, RECEIVER_A, routerA) == 1);
+    CHECK(receive(workshop, RECEIVER_A, routerA) == ZONE_NO_CHANNEL);
+    CHECK(receive(living, RECEIVER_B, routerB) == ZONE_NO_CHANNEL);
+    CHECK(receive(workshop, RECEIVER_B, routerB) == 0);
+
+    // A thermostat without addressing still drives receiver A's first channel
+    String legacy = ProtocolHelper::buildCommandFrame(CMD_STOVE_ON, P2P_NODE_ID_NONE, P2P_NODE_ID_NONE, 1, -1);
+    CHECK(receive(legacy, RECEIVER_A, routerA) == 0);
+    CHECK(receive(legacy, RECEIVER_B, routerB) == ZONE_NO_CHANNEL); // Heard, but not bound
+
+    // An addressed sender that no receiver knows is ignored
+    String stranger = ProtocolHelper::buildCommandFrame(CMD_STOVE_ON, 9, RECEIVER_A, 1, -1);
+    CHECK(receive(stranger, RECEIVER_A, routerA) == ZONE_NO_CHANNEL);
+}
+
+static void testReplies()
+{
+    String toLiving = ProtocolHelper::addAddress(RESP_STOVE_ON_ACK, RECEIVER_A, LIVING_ROOM);
+    String toBedroom = ProtocolHelper::addAddress(RESP_STOVE_ON_ACK, RECEIVER_A, BEDROOM);
+    String fromOtherReceiver = ProtocolHelper::addAddress(RESP_STOVE_ON_ACK, RECEIVER_B, LIVING_ROOM);
+
+    CHECK(ProtocolHelper::isReplyFor(toLiving, LIVING_ROOM, RECEIVER_A));
+    CHECK(!ProtocolHelper::isReplyFor(toBedroom, LIVING_ROOM, RECEIVER_A));
+    CHECK(!ProtocolHelper::isReplyFor(fromOtherReceiver, LIVING_ROOM, RECEIVER_A));
+
+    // Older receivers reply without a source, or without any address
+    CHECK(ProtocolHelper::isReplyFor(RESP_STOVE_ON_ACK, LIVING_ROOM, RECEIVER_A));
+    CHECK(ProtocolHelper::isReplyFor("STOVE_ON_ACK;D=2", LIVING_ROOM, RECEIVER_A));
+
+    // A thermostat that does not address its receiver takes a reply from anyone
+    CHECK(ProtocolHelper::isReplyFor(fromOtherReceiver, LIVING_ROOM, P2P_NODE_ID_NONE));
+
+    // Broadcasts, e.g. a receiver's safety timeout notice
+    CHECK(ProtocolHelper::isReplyFor("SAFETY_TIMEOUT;S=1;D=255", BEDROOM, RECEIVER_A));
+
+    // Another zone's command overheard on the channel is not a reply
+    String bedroomCommand = ProtocolHelper::buildCommandFrame(CMD_STOVE_OFF, BEDROOM, RECEIVER_A, 3, -1);
+    CHECK(!ProtocolHelper::isReplyFor(bedroomCommand, LIVING_ROOM, RECEIVER_A));
+}
+
+static void testDefaultIds()
+{
+    // As shipped, thermostat and receiver are both node 1, and a second zone
+    // added later (thermostat 2) talks to the same receiver
+    const uint8_t thermostat = P2P_DEFAULT_THERMOSTAT_ID;
+    const uint8_t receiver = P2P_DEFAULT_RECEIVER_ID;
+    CHECK(thermostat == receiver);
+    ZoneRouter router;
+    router.bind(thermostat, 0);
+    router.bind(2, 1);
+    router.bind(P2P_NODE_ID_NONE, 0);
+
+    // The thermostat's own command, and the reply it waits for
+    String command = ProtocolHelper::buildCommandFrame(CMD_STOVE_ON, thermostat, receiver, 7, -1);
+    String ack = ProtocolHelper::addAddress(RESP_ACK, receiver, thermostat);
+    String status = ProtocolHelper::addAddress(RESP_STOVE_ON_ACK, receiver, thermostat);
+    CHECK(receive(command, receiver, router) == 0);
+    CHECK(ProtocolHelper::isReplyFor(ack, thermostat, receiver));
+    CHECK(ProtocolHelper::isReplyFor(status, thermostat, receiver));
+    CHECK(!ProtocolHelper::isReplyFor(command, thermostat, receiver));
+
+    // Thermostat 2's command carries D=1 too: a command for the receiver, not a
+    // reply for thermostat 1, even when thermostat 1 doesn't address its receiver
+    String other = ProtocolHelper::buildCommandFrame(CMD_STOVE_OFF, 2, receiver, 3, 60);
+    CHECK(receive(other, receiver, router) == 1);
+    CHECK(!ProtocolHelper::isReplyFor(other, thermostat, receiver));
+    CHECK(!ProtocolHelper::isReplyFor(other, thermostat, P2P_NODE_ID_NONE));
+
+    // Every kind of reply from a second receiver with the default ID carries D=1:
+    // none of them is a command for this receiver, so none is answered
+    const char *replies[] = {RESP_ACK, RESP_NACK, RESP_STOVE_ON_ACK, RESP_STOVE_OFF_ACK, RESP_PONG,
+                             RESP_STATUS, RESP_ERROR, RESP_TIMEOUT, RESP_UNKNOWN};
+    for (const char *reply : replies)
+    {
+        String frame = ProtocolHelper::addAddress(reply, receiver, thermostat);
+        CHECK(ProtocolHelper::isReply(frame));
+        CHECK(receive(frame, receiver, router) == ZONE_NO_CHANNEL);
+    }
+    CHECK(!ProtocolHelper::isReply(command));
+    CHECK(!ProtocolHelper::isReply(ProtocolHelper::addAddress("SELF_DESTRUCT", thermostat, receiver)));
+}
+
+int main()
+{
+    testFields();
+    testHexRoundTrip();
+    testAddressing();
+    testCommandFrame();
+    testZoneRouter();
+    testSharedChannel();
+    testReplies();
+    testDefaultIds();
+    return checkSummary("protocol_test");
+}
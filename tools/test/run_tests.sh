@@ -0,0 +1,44 @@
+#!/bin/bash
+# Build and run every host test in tools/test/ with AddressSanitizer and UBSan.
+#
+# Usage, from anywhere in the repository:
+#     tools/test/run_tests.sh [output directory]
+#
+# Exits nonzero if any test fails to build or run. Set HOST_SERIAL=1 to see
+# the Serial output of the code under test.
+
+cd "$(dirname "$0")/../.." || exit 1
+OUT=${1:-$(mktemp -d)}
+mkdir -p "$OUT"
+
+CXXFLAGS="-std=c++17 -g -O1 -Wall -Wno-sign-compare -fsanitize=address,undefined -fno-sanitize-recover=all"
+FAILED=0
+
+# run_test NAME SOURCE... - build the test from its sources and run it
+run_test() {
+    local name=$1
+    shift
+    if ! g++ $CXXFLAGS -Itools/test/host -Isrc "$@" -o "$OUT/$name"; then
+        echo "$name: BUILD FAILED"
+        FAILED=1
+        return
+    fi
+    "$OUT/$name" || FAILED=1
+}
+
+run_test protocol_test tools/test/protocol_test.cpp receiver/src/zone_router.cpp
+run_test sync_listener_test tools/test/sync_listener_test.cpp receiver/src/sync_listener.cpp
+run_test wio_e5_modem_test tools/test/wio_e5_modem_test.cpp
+run_test csv_reader_test tools/test/csv_reader_test.cpp src/csv_reader.cpp src/schedule.cpp
+run_test csv_fuzz tools/test/csv_fuzz.cpp src/csv_reader.cpp src/schedule.cpp
+run_test sensor_fusion_test tools/test/sensor_fusion_test.cpp src/sensor_fusion.cpp
+run_test runtime_stats_test tools/test/runtime_stats_test.cpp src/runtime_stats.cpp
+run_test heater_monitor_test tools/test/heater_monitor_test.cpp src/heater_monitor.cpp
+run_test sensor_power_test tools/test/sensor_power_test.cpp src/sensor_power.cpp src/stove_logic.cpp \
+    src/stove_control.cpp src/mpc_controller.cpp src/thermal_model.cpp src/schedule.cpp src/csv_reader.cpp
+
+if [ $FAILED -ne 0 ]; then
+    echo "Host tests FAILED"
+    exit 1
+fi
+echo "All host tests passed"
@@ -0,0 +1,312 @@
+/**
+ * @file runtime_stats_test.cpp
+ * @brief Host test: RuntimeStats hour/day/week rollups on a simulated clock
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * A StatsClock drives update() the way the control loop does: a pass every
+ * minute (or as told), with millis() and the wall clock moving together
+ * unless a test steps the wall clock on its own. Covers duty and cycle
+ * counts per bucket, hour/day/week rollover including the Sunday wrap, gaps
+ * that aren't counted, a clock set back, and the checksum on save/restore.
+ *
+ * Build and run on the host (tools/test/run_tests.sh builds every test):
+ *     g++ -std=c++17 -Isrc tools/test/runtime_stats_test.cpp src/runtime_stats.cpp -o runtime_stats_test
+ *     ./runtime_stats_test
+ */
+
+#include <cstring>
+
+#include "check.hpp"
+#include "runtime_stats.hpp"
+
+#define MINUTES_PER_DAY 1440
+#define MINUTES_PER_WEEK 10080
+
+static int minuteOf(int day, int hour, int minute)
+{
+    return day * MINUTES_PER_DAY + hour * 60 + minute;
+}
+
+/**
+ * @struct StatsClock
+ * @brief millis() and the minute of the week, advanced together
+ */
+struct StatsClock
+{
+    RuntimeStats &stats;
+    unsigned long nowMs;
+    int minute;          // Minute of the week; may run past a week, wrapped when passed on
+    int hoursClosed;     // update() calls that returned true
+
+    StatsClock(RuntimeStats &runtimeStats, int startMinute)
+        : stats(runtimeStats), nowMs(1000), minute(startMinute), hoursClosed(0)
+    {
+    }
+
+    bool pass(bool on)
+    {
+        bool closed = stats.update(on, nowMs, minute % MINUTES_PER_WEEK);
+        hoursClosed += closed ? 1 : 0;
+        return closed;
+    }
+
+    /**
+     * @brief One pass per minute; the stove is ON for the first onMinutes of each hour
+     */
+    void run(int minutes, int onMinutes)
+    {
+        for (int i = 0; i < minutes; i++)
+        {
+            pass(minute % 60 < onMinutes);
+            nowMs += 60000;
+            minute++;
+        }
+    }
+};
+
+static void testHourBucket()
+{
+    RuntimeStatsData storage;
+    RuntimeStats stats(storage);
+    stats.clear();
+
+    // Monday 10:00-11:00, ON for the first 15 minutes
+    StatsClock clock(stats, minuteOf(1, 10, 0));
+    clock.run(60, 15);
+    CHECK(clock.hoursClosed == 0);
+    CHECK(clock.pass(false));
+
+    // The first pass only starts the clock: 59 minutes observed
+    RuntimeSummary hour = stats.getSummary(RUNTIME_HOUR, 1);
+    CHECK_NEAR(hour.onHours, 0.25, 1e-4);
+    CHECK(hour.cycles == 1);
+    CHECK_NEAR(hour.averageCycleMinutes, 15, 1e-3);
+    CHECK_NEAR(hour.dutyPercent, 100.0 * 15 / 59, 1e-3);
+
+    // The new hour has only the minute before the pass
+    RuntimeSummary current = stats.getSummary(RUNTIME_HOUR);
+    CHECK(current.cycles == 0);
+    CHECK(current.onHours == 0);
+    CHECK(current.dutyPercent == 0);
+
+    // Day and week hold the same time so far
+    CHECK_NEAR(stats.getSummary(RUNTIME_DAY).onHours, 0.25, 1e-4);
+    CHECK_NEAR(stats.getSummary(RUNTIME_WEEK).onHours, 0.25, 1e-4);
+    CHECK(stats.getSummary(RUNTIME_WEEK).cycles == 1);
+
+    // Out of range is all zero
+    CHECK(stats.getSummary(RUNTIME_HOUR, RUNTIME_HOURS).cycles == 0);
+    CHECK(stats.getSummary(RUNTIME_WEEK, RUNTIME_WEEKS).onHours == 0);
+}
+
+static void testDaysAndWeeks()
+{
+    RuntimeStatsData storage;
+    RuntimeStats stats(storage);
+    stats.clear();
+
+    // Eight days from Sunday 00:00, ON 10 minutes of every hour
+    StatsClock clock(stats, minuteOf(0, 0, 0));
+    clock.run(8 * MINUTES_PER_DAY, 10);
+    CHECK(clock.hoursClosed == 8 * 24 - 1);
+    CHECK(stats.getTotalCycles() == 8 * 24);
+    CHECK_NEAR(stats.getTotalOnHours(), 8 * 24 / 6.0, 1e-3);
+
+    // Every hour in the ring is a full, closed hour
+    for (size_t ago = 1; ago < RUNTIME_HOURS; ago++)
+    {
+        RuntimeSummary hour = stats.getSummary(RUNTIME_HOUR, ago);
+        CHECK(hour.cycles == 1);
+        CHECK_NEAR(hour.dutyPercent, 100.0 / 6, 1e-3);
+    }
+
+    // The six full days before today
+    for (size_t ago = 1; ago < RUNTIME_DAYS; ago++)
+    {
+        RuntimeSummary day = stats.getSummary(RUNTIME_DAY, ago);
+        CHECK(day.cycles == 24);
+        CHECK_NEAR(day.onHours, 4, 1e-3);
+    }
+
+    // Passing Sunday 00:00 closed the first week
+    RuntimeSummary lastWeek = stats.getSummary(RUNTIME_WEEK, 1);
+    CHECK(lastWeek.cycles == 7 * 24);
+    CHECK_NEAR(lastWeek.onHours, 7 * 24 / 6.0, 1e-3);
+    CHECK_NEAR(lastWeek.dutyPercent, 100.0 / 6, 0.01);
+    CHECK(stats.getSummary(RUNTIME_WEEK).cycles == 24);
+    CHECK(stats.getSummary(RUNTIME_WEEK, 2).cycles == 0);
+}
+
+static void testSundayWrap()
+{
+    RuntimeStatsData storage;
+    RuntimeStats stats(storage);
+    stats.clear();
+
+    // Saturday 23:00 through Sunday 01:00 with the stove ON throughout
+    StatsClock clock(stats, minuteOf(6, 23, 0));
+    clock.run(120, 60);
+    CHECK(clock.hoursClosed == 1);
+    CHECK(stats.getSummary(RUNTIME_WEEK, 1).cycles == 1);
+    CHECK_NEAR(stats.getSummary(RUNTIME_WEEK, 1).onHours, 59 / 60.0, 1e-3);
+    CHECK_NEAR(stats.getSummary(RUNTIME_WEEK).onHours, 1, 1e-3);
+    CHECK(stats.getSummary(RUNTIME_WEEK).cycles == 0);
+    CHECK_NEAR(stats.getSummary(RUNTIME_DAY, 1).onHours, 59 / 60.0, 1e-3);
+
+    // Back after three days off (a restart, so no millis() history): one pass
+    // closes the day buckets in between and the hour ring is all new
+    RuntimeStats restarted(storage);
+    StatsClock later(restarted, minuteOf(3, 9, 0));
+    CHECK(later.pass(false));
+    CHECK(restarted.getSummary(RUNTIME_DAY, 3).onHours > 0.9f);
+    CHECK(restarted.getSummary(RUNTIME_DAY, 2).onHours == 0);
+    CHECK(restarted.getSummary(RUNTIME_DAY, 1).onHours == 0);
+    for (size_t ago = 0; ago < RUNTIME_HOURS; ago++)
+    {
+        CHECK(restarted.getSummary(RUNTIME_HOUR, ago).cycles == 0);
+    }
+    CHECK_NEAR(restarted.getSummary(RUNTIME_WEEK).onHours, 1, 1e-3);
+}
+
+static void testGaps()
+{
+    RuntimeStatsData storage;
+    RuntimeStats stats(storage);
+    stats.clear();
+
+    // Passes 1.5 s apart: whole seconds are credited, the rest carries over
+    StatsClock clock(stats, minuteOf(2, 8, 0));
+    for (int i = 0; i < 5; i++)
+    {
+        clock.pass(true);
+        clock.nowMs += 1500;
+    }
+    CHECK_NEAR(stats.getTotalOnHours() * 3600, 6, 1e-3);
+    CHECK(stats.getTotalCycles() == 1);
+
+    // A stall longer than the limit isn't counted, ON or not
+    clock.nowMs += RUNTIME_MAX_GAP_MS;
+    clock.pass(true);
+    CHECK_NEAR(stats.getTotalOnHours() * 3600, 6, 1e-3);
+
+    // ...and counting resumes from there
+    clock.nowMs += 30000;
+    clock.pass(true);
+    CHECK_NEAR(stats.getTotalOnHours() * 3600, 36, 1e-3);
+
+    // A gap of exactly the limit still counts
+    clock.nowMs += RUNTIME_MAX_GAP_MS;
+    clock.pass(false);
+    CHECK_NEAR(stats.getTotalOnHours() * 3600, 36 + RUNTIME_MAX_GAP_MS / 1000, 1e-3);
+
+    // OFF->ON is a cycle, staying ON is not
+    clock.nowMs += 1000;
+    clock.pass(true);
+    clock.nowMs += 1000;
+    clock.pass(true);
+    CHECK(stats.getTotalCycles() == 2);
+}
+
+static void testClockSetBack()
+{
+    RuntimeStatsData storage;
+    RuntimeStats stats(storage);
+    stats.clear();
+
+    // Monday 10:30 to 11:10, ON throughout
+    StatsClock clock(stats, minuteOf(1, 10, 30));
+    clock.run(40, 60);
+    CHECK(clock.hoursClosed == 1);
+    float weekOnHours = stats.getSummary(RUNTIME_WEEK).onHours;
+
+    // Clock set back an hour (DST): nothing closes or clears
+    clock.minute -= 60;
+    CHECK(!clock.pass(true));
+    CHECK(stats.getSummary(RUNTIME_HOUR, 1).cycles == 1);
+    CHECK_NEAR(stats.getSummary(RUNTIME_HOUR, 1).onHours, 29 / 60.0, 1e-3);
+    CHECK_NEAR(stats.getSummary(RUNTIME_WEEK).onHours, weekOnHours + 1 / 60.0, 1e-3);
+    CHECK(stats.getSummary(RUNTIME_WEEK, 1).onHours == 0);
+    CHECK(stats.getSummary(RUNTIME_DAY, 1).onHours == 0);
+
+    // Time keeps accruing in the current buckets, and the next hour closes normally
+    clock.nowMs += 60000;
+    clock.minute++;
+    clock.run(50, 60);
+    CHECK(clock.hoursClosed == 2);
+    CHECK_NEAR(stats.getSummary(RUNTIME_HOUR, 1).onHours, 1, 1e-3);
+    CHECK_NEAR(stats.getSummary(RUNTIME_HOUR, 2).onHours, 29 / 60.0, 1e-3);
+    CHECK_NEAR(stats.getTotalOnHours(), 90 / 60.0, 1e-3);
+
+    // Set back across Sunday 00:00: the week is not wrapped
+    stats.clear();
+    StatsClock sunday(stats, minuteOf(0, 0, 0));
+    sunday.run(30, 60);
+    sunday.minute = minuteOf(6, 23, 40);
+    CHECK(!sunday.pass(true));
+    CHECK_NEAR(stats.getSummary(RUNTIME_WEEK).onHours, 0.5, 1e-3);
+    CHECK(stats.getSummary(RUNTIME_WEEK, 1).onHours == 0);
+    CHECK_NEAR(stats.getSummary(RUNTIME_DAY).onHours, 0.5, 1e-3);
+
+    // Reaching Sunday 00:00 again closes that week once, with nothing lost
+    sunday.nowMs += 60000;
+    sunday.minute++;
+    sunday.run(30, 60);
+    CHECK(sunday.hoursClosed == 1);
+    CHECK_NEAR(stats.getSummary(RUNTIME_WEEK, 1).onHours, 49 / 60.0, 1e-3);
+    CHECK_NEAR(stats.getSummary(RUNTIME_WEEK).onHours, 11 / 60.0, 1e-3);
+    CHECK(stats.getSummary(RUNTIME_WEEK, 2).onHours == 0);
+    CHECK_NEAR(stats.getSummary(RUNTIME_DAY, 1).onHours, 49 / 60.0, 1e-3);
+    CHECK_NEAR(stats.getTotalOnHours(), 1, 1e-3);
+}
+
+static void testPersistence()
+{
+    RuntimeStatsData storage;
+    memset(&storage, 0xA5, sizeof(storage));
+    CHECK(!RuntimeStats::isValid(storage));
+
+    RuntimeStats stats(storage);
+    stats.clear();
+    CHECK(RuntimeStats::isValid(storage));
+
+    StatsClock clock(stats, minuteOf(4, 18, 0));
+    clock.run(90, 20);
+    RuntimeStatsData saved = stats.getData();
+    CHECK(RuntimeStats::isValid(saved));
+
+    // Any damage is caught
+    RuntimeStatsData damaged = saved;
+    damaged.days[2].onSeconds ^= 1;
+    CHECK(!RuntimeStats::isValid(damaged));
+    damaged = saved;
+    damaged.version++;
+    CHECK(!RuntimeStats::isValid(damaged));
+    damaged = saved;
+    damaged.hourIndex = RUNTIME_HOURS;
+    CHECK(!RuntimeStats::isValid(damaged));
+    CHECK(!stats.restore(damaged));
+
+    // A valid copy restores, and the first pass after it only restarts the clock
+    RuntimeStatsData other;
+    RuntimeStats restored(other);
+    restored.clear();
+    CHECK(restored.restore(saved));
+    CHECK(restored.getTotalCycles() == stats.getTotalCycles());
+    CHECK(restored.getSummary(RUNTIME_HOUR, 1).onHours == stats.getSummary(RUNTIME_HOUR, 1).onHours);
+    CHECK(restored.getSummary(RUNTIME_DAY).cycles == 2);
+    float onHours = restored.getTotalOnHours();
+    CHECK(!restored.update(true, clock.nowMs + 120000, clock.minute % MINUTES_PER_WEEK));
+    CHECK_NEAR(restored.getTotalOnHours(), onHours, 1e-6);
+}
+
+int main()
+{
+    testHourBucket();
+    testDaysAndWeeks();
+    testSundayWrap();
+    testGaps();
+    testClockSetBack();
+    testPersistence();
+    return checkSummary("runtime_stats_test");
+}
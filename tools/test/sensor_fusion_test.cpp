@@ -0,0 +1,430 @@
+/**
+ * @file sensor_fusion_test.cpp
+ * @brief Host test: SensorFusion fed from a simulated bus of MCP9808s
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * SimulatedBus stands in for the I2C bus SensorArray scans: up to eight
+ * MCP9808s at 0x18-0x1F, each answering with an ambient temperature
+ * register (the device's 13-bit two's complement format) for the room
+ * temperature plus its own offset. A device can be told to stop answering
+ * (NACK) or to return a fixed register value (a glitched bus reads all
+ * ones). A burst is decoded and range-checked as SensorArray does and
+ * handed to SensorFusion.
+ *
+ * Covers failing sensors, outliers, probation and rejoin, two sensors that
+ * disagree, monitor-only weights, and the fallback to sensors on probation
+ * when no healthy one is left.
+ *
+ * Build and run on the host (tools/test/run_tests.sh builds every test):
+ *     g++ -std=c++17 -Isrc tools/test/sensor_fusion_test.cpp src/sensor_fusion.cpp -o sensor_fusion_test
+ *     ./sensor_fusion_test
+ */
+
+#include <cmath>
+
+#include "check.hpp"
+#include "sensor_fusion.hpp"
+
+#define BUS_FIRST_ADDRESS 0x18
+#define BUS_ADDRESSES 8
+
+/**
+ * @class SimulatedBus
+ * @brief MCP9808s on an I2C bus, with injectable faults
+ */
+class SimulatedBus
+{
+public:
+    enum Fault
+    {
+        FAULT_NONE,
+        FAULT_NACK,  // Device does not acknowledge
+        FAULT_STUCK, // Device returns stuckRegister
+    };
+
+private:
+    struct Device
+    {
+        bool present;
+        float offsetC;
+        Fault fault;
+        uint16_t stuckRegister;
+    };
+
+    Device devices[BUS_ADDRESSES];
+
+public:
+    float roomC = 20.0f;
+
+    SimulatedBus()
+    {
+        for (Device &device : devices)
+        {
+            device = {false, 0.0f, FAULT_NONE, 0};
+        }
+    }
+
+    void attach(uint8_t address, float offsetC = 0.0f)
+    {
+        devices[address - BUS_FIRST_ADDRESS] = {true, offsetC, FAULT_NONE, 0};
+    }
+
+    void setFault(uint8_t address, Fault fault, uint16_t stuckRegister = 0xFFFF)
+    {
+        devices[address - BUS_FIRST_ADDRESS].fault = fault;
+        devices[address - BUS_FIRST_ADDRESS].stuckRegister = stuckRegister;
+    }
+
+    void setOffset(uint8_t address, float offsetC)
+    {
+        devices[address - BUS_FIRST_ADDRESS].offsetC = offsetC;
+    }
+
+    /**
+     * @brief Address probe, as Wire.beginTransmission()/endTransmission() at setup
+     */
+    bool probe(uint8_t address) const
+    {
+        const Device &device = devices[address - BUS_FIRST_ADDRESS];
+        return device.present && device.fault != FAULT_NACK;
+    }
+
+    /**
+     * @brief Read the ambient temperature register (0x05)
+     * @return false if the device does not acknowledge
+     */
+    bool readAmbient(uint8_t address, uint16_t &value) const
+    {
+        const Device &device = devices[address - BUS_FIRST_ADDRESS];
+        if (!device.present || device.fault == FAULT_NACK)
+        {
+            return false;
+        }
+        if (device.fault == FAULT_STUCK)
+        {
+            value = device.stuckRegister;
+            return true;
+        }
+        // 0.0625°C steps, sign in bit 12, alert flags in bits 13-15 left clear
+        long sixteenths = lroundf((roomC + device.offsetC) * 16.0f);
+        value = (uint16_t)(sixteenths & 0x1FFF);
+        return true;
+    }
+};
+
+/**
+ * @brief Decode the ambient register as the MCP9808 driver does
+ */
+static float decodeCelsius(uint16_t value)
+{
+    float celsius = (value & 0x0FFF) / 16.0f;
+    if (value & 0x1000)
+    {
+        celsius -= 256.0f;
+    }
+    return celsius;
+}
+
+/**
+ * @brief The part of SensorArray under test: the scanned sensors and their fusion
+ */
+struct Array
+{
+    SimulatedBus &bus;
+    uint8_t addresses[BUS_ADDRESSES];
+    size_t count = 0;
+    SensorFusion fusion;
+
+    explicit Array(SimulatedBus &bus) : bus(bus)
+    {
+        for (uint8_t address = BUS_FIRST_ADDRESS; address < BUS_FIRST_ADDRESS + BUS_ADDRESSES; address++)
+        {
+            if (bus.probe(address))
+            {
+                addresses[count++] = address;
+            }
+        }
+        fusion.reset(count);
+    }
+
+    /**
+     * @brief Read every sensor back to back and fuse the burst
+     * @return Sensors used in the fused value
+     */
+    size_t poll(float &fused)
+    {
+        float readings[SENSOR_FUSION_MAX_SENSORS];
+        for (size_t i = 0; i < count; i++)
+        {
+            uint16_t value;
+            float fahrenheit = NAN;
+            if (bus.readAmbient(addresses[i], value))
+            {
+                fahrenheit = decodeCelsius(value) * 9.0f / 5.0f + 32.0f;
+            }
+            // Same range check as SensorArray::isValidReading()
+            readings[i] = (!std::isnan(fahrenheit) && fahrenheit >= -40.0f && fahrenheit <= 125.0f) ? fahrenheit : NAN;
+        }
+        return fusion.fuse(readings, fused);
+    }
+};
+
+static float roomF(const SimulatedBus &bus)
+{
+    return bus.roomC * 9.0f / 5.0f + 32.0f;
+}
+
+static void testScanAndAgreement()
+{
+    SimulatedBus bus;
+    bus.attach(0x18, 0.0f);
+    bus.attach(0x1A, 0.125f);
+    bus.attach(0x1F, -0.125f);
+    Array array(bus);
+    CHECK(array.count == 3);
+    CHECK(array.addresses[1] == 0x1A);
+
+    float fused;
+    for (int burst = 0; burst < 50; burst++)
+    {
+        bus.roomC = 20.0f + 0.05f * burst;
+        CHECK(array.poll(fused) == 3);
+        CHECK_NEAR(fused, roomF(bus), 0.12);
+    }
+    CHECK(array.fusion.getHealthyCount() == 3);
+    CHECK(array.fusion.getHealth(0).reads == 50);
+
+    // Each sensor's steady offset shows up in its mean deviation (0.125°C = 0.225°F)
+    CHECK_NEAR(array.fusion.getHealth(1).meanDeviation, 0.225, 0.03);
+    CHECK_NEAR(array.fusion.getHealth(2).meanDeviation, -0.225, 0.03);
+}
+
+static void testFailingSensor()
+{
+    SimulatedBus bus;
+    bus.attach(0x18);
+    bus.attach(0x19, 0.25f);
+    bus.attach(0x1A, -0.25f);
+    Array array(bus);
+
+    float fused;
+    array.poll(fused);
+    bus.setFault(0x19, SimulatedBus::FAULT_NACK);
+
+    // Still counted healthy until SENSOR_FUSION_FAIL_LIMIT failures in a row
+    for (int burst = 1; burst < SENSOR_FUSION_FAIL_LIMIT; burst++)
+    {
+        CHECK(array.poll(fused) == 2);
+        CHECK(array.fusion.getHealth(1).healthy);
+        CHECK(std::isnan(array.fusion.getHealth(1).lastValue));
+    }
+    CHECK(array.poll(fused) == 2);
+    CHECK(!array.fusion.getHealth(1).healthy);
+    CHECK(array.fusion.getHealthyCount() == 2);
+    CHECK(array.fusion.getHealth(1).failures == SENSOR_FUSION_FAIL_LIMIT);
+    CHECK_NEAR(fused, (roomF(bus) + (roomF(bus) - 0.45f)) / 2.0f, 0.12);
+
+    // A single good read in between resets the count
+    bus.setFault(0x1A, SimulatedBus::FAULT_NACK);
+    array.poll(fused);
+    array.poll(fused);
+    bus.setFault(0x1A, SimulatedBus::FAULT_NONE);
+    array.poll(fused);
+    bus.setFault(0x1A, SimulatedBus::FAULT_NACK);
+    array.poll(fused);
+    CHECK(array.fusion.getHealth(2).healthy);
+}
+
+static void testOutlier()
+{
+    SimulatedBus bus;
+    bus.attach(0x18);
+    bus.attach(0x19);
+    bus.attach(0x1A);
+    bus.attach(0x1B);
+    Array array(bus);
+
+    float fused;
+    array.poll(fused);
+
+    // A sensor reading 3°C high is rejected from the first burst, so the fused value never moves
+    bus.setOffset(0x1B, 3.0f);
+    for (int burst = 0; burst < SENSOR_FUSION_FAIL_LIMIT; burst++)
+    {
+        CHECK(array.poll(fused) == 3);
+        CHECK_NEAR(fused, roomF(bus), 0.06);
+    }
+    CHECK(array.fusion.getHealth(3).rejections == SENSOR_FUSION_FAIL_LIMIT);
+    CHECK(array.fusion.getHealth(3).failures == 0);
+    CHECK(!array.fusion.getHealth(3).healthy);
+
+    // A glitched bus reading all ones decodes to -0.06°C - in range, but an outlier
+    bus.setFault(0x18, SimulatedBus::FAULT_STUCK, 0xFFFF);
+    CHECK(array.poll(fused) == 2);
+    CHECK(array.fusion.getHealth(0).rejections == 1);
+    CHECK_NEAR(fused, roomF(bus), 0.06);
+
+    // Small disagreements inside the outlier limit are kept
+    bus.setFault(0x18, SimulatedBus::FAULT_NONE);
+    bus.setOffset(0x1A, 0.75f); // 1.35°F
+    CHECK(array.poll(fused) == 3);
+}
+
+static void testProbationAndRejoin()
+{
+    SimulatedBus bus;
+    bus.attach(0x18);
+    bus.attach(0x19);
+    bus.attach(0x1A, 4.0f); // Starts out far off
+    Array array(bus);
+
+    float fused;
+    for (int burst = 0; burst < SENSOR_FUSION_FAIL_LIMIT; burst++)
+    {
+        array.poll(fused);
+    }
+    CHECK(!array.fusion.getHealth(2).healthy);
+
+    // Back in agreement: read, but on probation for SENSOR_FUSION_RECOVERY_READS bursts
+    bus.setOffset(0x1A, 0.1f);
+    for (int burst = 1; burst < SENSOR_FUSION_RECOVERY_READS; burst++)
+    {
+        CHECK(array.poll(fused) == 2);
+        CHECK(!array.fusion.getHealth(2).healthy);
+        CHECK(array.fusion.getHealth(2).consecutiveGood == burst);
+    }
+    CHECK(array.poll(fused) == 3);
+    CHECK(array.fusion.getHealth(2).healthy);
+    CHECK(array.fusion.getHealthyCount() == 3);
+
+    // Probation restarts on any bad reading
+    for (int burst = 0; burst < SENSOR_FUSION_FAIL_LIMIT; burst++)
+    {
+        bus.setFault(0x1A, SimulatedBus::FAULT_NACK);
+        array.poll(fused);
+    }
+    bus.setFault(0x1A, SimulatedBus::FAULT_NONE);
+    for (int burst = 1; burst < SENSOR_FUSION_RECOVERY_READS; burst++)
+    {
+        array.poll(fused);
+    }
+    bus.setFault(0x1A, SimulatedBus::FAULT_NACK);
+    array.poll(fused);
+    bus.setFault(0x1A, SimulatedBus::FAULT_NONE);
+    CHECK(array.poll(fused) == 2);
+    CHECK(array.fusion.getHealth(2).consecutiveGood == 1);
+}
+
+static void testTwoSensorsDisagree()
+{
+    SimulatedBus bus;
+    bus.attach(0x18);
+    bus.attach(0x1C, 2.0f);
+    Array array(bus);
+
+    // With only two there is no majority, so both stay and are averaged
+    float fused;
+    for (int burst = 0; burst < 10; burst++)
+    {
+        CHECK(array.poll(fused) == 2);
+    }
+    CHECK_NEAR(fused, roomF(bus) + 1.8, 0.06);
+    CHECK(array.fusion.getHealthyCount() == 2);
+    CHECK(array.fusion.getHealth(1).rejections == 0);
+}
+
+static void testAllOnProbation()
+{
+    SimulatedBus bus;
+    bus.attach(0x18);
+    bus.attach(0x19, 0.5f);
+    Array array(bus);
+
+    // Both stop answering: no temperature at all
+    float fused;
+    bus.setFault(0x18, SimulatedBus::FAULT_NACK);
+    bus.setFault(0x19, SimulatedBus::FAULT_NACK);
+    for (int burst = 0; burst < SENSOR_FUSION_FAIL_LIMIT; burst++)
+    {
+        CHECK(array.poll(fused) == 0);
+        CHECK(std::isnan(fused));
+    }
+    CHECK(array.fusion.getHealthyCount() == 0);
+
+    // One comes back: used at once although still on probation, as it is all there is
+    bus.setFault(0x19, SimulatedBus::FAULT_NONE);
+    CHECK(array.poll(fused) == 1);
+    CHECK_NEAR(fused, roomF(bus) + 0.9, 0.06);
+    CHECK(!array.fusion.getHealth(1).healthy);
+
+    // The other returns too: both probation readings are averaged
+    bus.setFault(0x18, SimulatedBus::FAULT_NONE);
+    CHECK(array.poll(fused) == 2);
+    CHECK_NEAR(fused, roomF(bus) + 0.45, 0.06);
+
+    // Once 0x19 has served its probation it alone is healthy, and 0x18 drops out until it catches up
+    for (int burst = 2; burst < SENSOR_FUSION_RECOVERY_READS; burst++)
+    {
+        array.poll(fused);
+    }
+    CHECK(array.fusion.getHealth(1).healthy);
+    CHECK(!array.fusion.getHealth(0).healthy);
+    CHECK(array.poll(fused) == 2);
+    CHECK(array.fusion.getHealthyCount() == 2);
+}
+
+static void testMonitorOnly()
+{
+    SimulatedBus bus;
+    bus.attach(0x18);
+    bus.attach(0x19, 1.0f);
+    Array array(bus);
+    array.fusion.setWeight(1, 0.0f);
+
+    // A weight-0 sensor is watched but not used...
+    float fused;
+    CHECK(array.poll(fused) == 1);
+    CHECK_NEAR(fused, roomF(bus), 0.06);
+    CHECK_NEAR(array.fusion.getHealth(1).meanDeviation, 0.1 * 1.8, 0.01);
+
+    // ...unless nothing else is left
+    bus.setFault(0x18, SimulatedBus::FAULT_NACK);
+    for (int burst = 0; burst < SENSOR_FUSION_FAIL_LIMIT; burst++)
+    {
+        array.poll(fused);
+    }
+    CHECK(array.poll(fused) == 1);
+    CHECK_NEAR(fused, roomF(bus) + 1.8, 0.06);
+}
+
+static void testEmptyBus()
+{
+    SimulatedBus bus;
+    bus.attach(0x1D);
+    bus.setFault(0x1D, SimulatedBus::FAULT_NACK);
+    Array array(bus);
+    CHECK(array.count == 0);
+
+    float fused = 0;
+    CHECK(array.poll(fused) == 0);
+    CHECK(std::isnan(fused));
+
+    // More sensors than the fusion handles are capped
+    SensorFusion fusion;
+    fusion.reset(SENSOR_FUSION_MAX_SENSORS + 4);
+    CHECK(fusion.getSensorCount() == SENSOR_FUSION_MAX_SENSORS);
+}
+
+int main()
+{
+    testScanAndAgreement();
+    testFailingSensor();
+    testOutlier();
+    testProbationAndRejoin();
+    testTwoSensorsDisagree();
+    testAllOnProbation();
+    testMonitorOnly();
+    testEmptyBus();
+    return checkSummary("sensor_fusion_test");
+}
@@ -0,0 +1,214 @@
+/**
+ * @file sensor_power_test.cpp
+ * @brief Host test: MCP9808 resolution choice, awake-time saving and StoveLogic::getDecisionDistance
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * Checks the conversion times and the distance-to-resolution table the dial
+ * uses between reads, the awake-time saving it reports, and that the
+ * distance StoveLogic gives is honest: in each control law, the decision
+ * doesn't change before the temperature has moved that far, so a reading
+ * coarsened to fit 4 times into it can't flip the stove on its own.
+ *
+ * Build and run on the host (tools/test/run_tests.sh builds every test):
+ *     g++ -std=c++17 -Isrc tools/test/sensor_power_test.cpp src/sensor_power.cpp src/stove_logic.cpp \
+ *         src/stove_control.cpp src/mpc_controller.cpp src/thermal_model.cpp src/schedule.cpp \
+ *         src/csv_reader.cpp -o sensor_power_test
+ *     ./sensor_power_test
+ */
+
+#include <cmath>
+
+#include "check.hpp"
+#include "sensor_power.hpp"
+#include "stove_logic.hpp"
+
+// Step of each resolution in °F, by MCP9808_Resolution value
+static const float STEP_F[] = {0.9f, 0.45f, 0.225f, 0.1125f};
+
+static float stepOf(MCP9808_Resolution res)
+{
+    return STEP_F[static_cast<uint8_t>(res)];
+}
+
+static void testConversionTimes()
+{
+    CHECK(SensorPower::getConversionTimeMs(MCP9808_Resolution::RES_0_5C) == 30 + SENSOR_POWER_CONVERSION_MARGIN_MS);
+    CHECK(SensorPower::getConversionTimeMs(MCP9808_Resolution::RES_0_25C) == 65 + SENSOR_POWER_CONVERSION_MARGIN_MS);
+    CHECK(SensorPower::getConversionTimeMs(MCP9808_Resolution::RES_0_125C) == 130 + SENSOR_POWER_CONVERSION_MARGIN_MS);
+    CHECK(SensorPower::getConversionTimeMs(MCP9808_Resolution::RES_0_0625C) == 250 + SENSOR_POWER_CONVERSION_MARGIN_MS);
+}
+
+static void testResolutionForDistance()
+{
+    // The table in the developer guide, at and just inside each boundary
+    CHECK(SensorPower::getResolutionForDistance(10) == MCP9808_Resolution::RES_0_5C);
+    CHECK(SensorPower::getResolutionForDistance(3.6f) == MCP9808_Resolution::RES_0_5C);
+    CHECK(SensorPower::getResolutionForDistance(3.59f) == MCP9808_Resolution::RES_0_25C);
+    CHECK(SensorPower::getResolutionForDistance(1.8f) == MCP9808_Resolution::RES_0_25C);
+    CHECK(SensorPower::getResolutionForDistance(1.79f) == MCP9808_Resolution::RES_0_125C);
+    CHECK(SensorPower::getResolutionForDistance(0.9f) == MCP9808_Resolution::RES_0_125C);
+    CHECK(SensorPower::getResolutionForDistance(0.89f) == MCP9808_Resolution::RES_0_0625C);
+    CHECK(SensorPower::getResolutionForDistance(0) == MCP9808_Resolution::RES_0_0625C);
+
+    // No distance known yet, or nonsense: full resolution
+    CHECK(SensorPower::getResolutionForDistance(NAN) == MCP9808_Resolution::RES_0_0625C);
+    CHECK(SensorPower::getResolutionForDistance(-5) == MCP9808_Resolution::RES_0_0625C);
+
+    // Never finer further away, and a coarse step always fits the margin
+    MCP9808_Resolution previous = MCP9808_Resolution::RES_0_0625C;
+    for (int i = 0; i <= 1000; i++)
+    {
+        float distance = i * 0.01f;
+        MCP9808_Resolution res = SensorPower::getResolutionForDistance(distance);
+        CHECK(static_cast<uint8_t>(res) <= static_cast<uint8_t>(previous));
+        CHECK(res == MCP9808_Resolution::RES_0_0625C || stepOf(res) * SENSOR_POWER_RESOLUTION_MARGIN <= distance);
+        previous = res;
+    }
+}
+
+static void testAwakeSaving()
+{
+    SensorPower power;
+    CHECK(power.getReads() == 0);
+    CHECK(power.getAwakeMsPerRead() == 0);
+    CHECK(power.getAwakeSaving() == 0);
+
+    // Only full-resolution reads: nothing saved
+    power.addRead(265, MCP9808_Resolution::RES_0_0625C);
+    power.addRead(275, MCP9808_Resolution::RES_0_0625C);
+    CHECK_NEAR(power.getAwakeMsPerRead(), 270, 1e-3);
+    CHECK_NEAR(power.getAwakeSaving(), 0, 1e-6);
+
+    // A coarse read would have waited the full conversion instead of its own
+    SensorPower coarse;
+    coarse.addRead(45, MCP9808_Resolution::RES_0_5C);
+    CHECK_NEAR(coarse.getAwakeSaving(), 1 - 45.0 / (45 + 250 - 30), 1e-6);
+    coarse.addRead(140, MCP9808_Resolution::RES_0_125C);
+    coarse.addRead(262, MCP9808_Resolution::RES_0_0625C);
+    CHECK(coarse.getReads() == 3);
+    CHECK_NEAR(coarse.getAwakeMsPerRead(), (45 + 140 + 262) / 3.0, 1e-3);
+    CHECK_NEAR(coarse.getAwakeSaving(), 1 - 447.0 / (447 + (250 - 30) + (250 - 130)), 1e-6);
+
+    // Time spent on anything else (I2C, a slow loop pass) counts in both
+    SensorPower slow;
+    slow.addRead(1040, MCP9808_Resolution::RES_0_5C);
+    CHECK_NEAR(slow.getAwakeSaving(), 1 - 1040.0 / (1040 + 220), 1e-6);
+}
+
+/**
+ * @brief Check that the decision can't change within the reported distance
+ * Sweeps the temperature around the target and, for each point, tries
+ * temperatures nearer than the distance on both sides with the stove ON
+ * and OFF.
+ */
+static void checkDistanceHolds(StoveLogic &logic, float target, unsigned long nowMs)
+{
+    int violations = 0;
+    for (float temperature = target - 6; temperature <= STOVE_SAFETY_MAX_TEMP + 2; temperature += 0.05f)
+    {
+        float distance = logic.getDecisionDistance(target, temperature);
+        CHECK(distance >= 0);
+        for (int isOn = 0; isOn < 2; isOn++)
+        {
+            bool here = logic.shouldBeOn(target, temperature, isOn, nowMs);
+            for (float f = -0.95f; f <= 0.95f; f += 0.19f)
+            {
+                if (logic.shouldBeOn(target, temperature + f * distance, isOn, nowMs) != here)
+                {
+                    violations++;
+                }
+            }
+        }
+    }
+    CHECK(violations == 0);
+}
+
+static void testHysteresisDistance()
+{
+    StoveLogic logic;
+    const StoveTuning &tuning = logic.getTuning();
+    float target = 70;
+
+    // Nearest of the two thresholds and the safety limit
+    CHECK_NEAR(logic.getDecisionDistance(target, 60), target - tuning.hysteresisLow - 60, 1e-4);
+    CHECK_NEAR(logic.getDecisionDistance(target, target - tuning.hysteresisLow), 0, 1e-4);
+    CHECK_NEAR(logic.getDecisionDistance(target, target - 1), fminf(tuning.hysteresisLow - 1, 1 - tuning.hysteresisHigh),
+               1e-4);
+    CHECK_NEAR(logic.getDecisionDistance(target, 75), 75 - (target - tuning.hysteresisHigh), 1e-4);
+    CHECK_NEAR(logic.getDecisionDistance(target, 80), 2, 1e-4);
+    CHECK_NEAR(logic.getDecisionDistance(target, 84), 2, 1e-4);
+
+    // Far below the target the sensor may read coarsely; near a threshold it may not
+    CHECK(SensorPower::getResolutionForDistance(logic.getDecisionDistance(target, 62)) ==
+          MCP9808_Resolution::RES_0_5C);
+    CHECK(SensorPower::getResolutionForDistance(logic.getDecisionDistance(target, target - tuning.hysteresisLow + 0.3f)) ==
+          MCP9808_Resolution::RES_0_0625C);
+
+    checkDistanceHolds(logic, target, 0);
+
+    // A target near the safety limit: the limit is the nearer switching point
+    CHECK_NEAR(logic.getDecisionDistance(81.5f, 80.9f), fminf(1.1f, 81.5f - tuning.hysteresisHigh - 80.9f), 1e-4);
+    checkDistanceHolds(logic, 81.5f, 0);
+}
+
+static void testPiDistance()
+{
+    StoveLogic logic;
+    logic.setControlMode(STOVE_CONTROL_PI);
+
+    // The duty follows the error, so the target itself is the switching point
+    CHECK_NEAR(logic.getDecisionDistance(70, 66), 4, 1e-4);
+    CHECK_NEAR(logic.getDecisionDistance(70, 71.5f), 1.5, 1e-4);
+    CHECK_NEAR(logic.getDecisionDistance(70, 70), 0, 1e-4);
+    CHECK_NEAR(logic.getDecisionDistance(79, 80.5f), 1.5, 1e-4);
+    CHECK_NEAR(logic.getDecisionDistance(70, 81), 1, 1e-4);
+}
+
+static void testMpcDistance()
+{
+    StoveLogic logic;
+    logic.setControlMode(STOVE_CONTROL_MPC);
+    const StoveTuning &tuning = logic.getTuning();
+
+    // Without a plan MPC runs hysteresis, and the distance says so
+    CHECK_NEAR(logic.getDecisionDistance(70, 66), 70 - tuning.hysteresisLow - 66, 1e-4);
+    CHECK_NEAR(logic.getDecisionDistance(70, 72), 72 - (70 - tuning.hysteresisHigh), 1e-4);
+
+    // A day of a simulated room (time constant 20 h, stove adds 4°F/h) trains the model
+    Schedule schedule;
+    schedule.compile();
+    float temperature = 64;
+    float heat = 0;
+    bool on = false;
+    unsigned long nowMs = 0;
+    for (int minute = 0; minute < 24 * 60; minute++)
+    {
+        on = (minute / 90) % 2 == 0;
+        heat += (on - heat) / THERMAL_MODEL_HEAT_LAG_MIN;
+        temperature += ((45 - temperature) / 20.0f + 4 * heat) / 60;
+        logic.observe(temperature, on, nowMs, minute);
+        nowMs += 60000;
+    }
+    CHECK(logic.getThermalModel().isTrained());
+    logic.updatePlan(schedule, 68, temperature, on, nowMs, 24 * 60);
+    CHECK(logic.getMpc().hasPlan());
+
+    // With a plan, the comfort margins around the target are the switching points
+    CHECK_NEAR(logic.getDecisionDistance(68, 64), 68 - MPC_COLD_MARGIN_F - 64, 1e-4);
+    CHECK_NEAR(logic.getDecisionDistance(68, 67.5f), fminf(67.5f - (68 - MPC_COLD_MARGIN_F), 68 + MPC_HOT_MARGIN_F - 67.5f),
+               1e-4);
+    CHECK_NEAR(logic.getDecisionDistance(68, 71), 71 - (68 + MPC_HOT_MARGIN_F), 1e-4);
+    CHECK_NEAR(logic.getDecisionDistance(68, 81.2f), 0.8, 1e-4);
+}
+
+int main()
+{
+    testConversionTimes();
+    testResolutionForDistance();
+    testAwakeSaving();
+    testHysteresisDistance();
+    testPiDistance();
+    testMpcDistance();
+    return checkSummary("sensor_power_test");
+}
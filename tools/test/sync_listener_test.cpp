@@ -0,0 +1,123 @@
+/**
+ * @file sync_listener_test.cpp
+ * @brief Host test: SyncListener slot tracking with one and several thermostats
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * Feeds SyncListener (receiver/src/sync_listener.cpp) slot announcements and
+ * checks when it lets the radio sleep: not before every bound thermostat has
+ * announced a slot, until just before the earliest of their next slots, and
+ * not at all once one of them stops announcing or misses too many slots.
+ *
+ * Build and run on the host (tools/test/run_tests.sh builds every test):
+ *     g++ -std=c++17 -Itools/test/host tools/test/sync_listener_test.cpp receiver/src/sync_listener.cpp \
+ *         -o sync_listener_test
+ *     ./sync_listener_test
+ */
+
+#include "check.hpp"
+#include "../../receiver/src/sync_listener.hpp"
+
+static const unsigned long NO_LIMIT = 3600000;
+
+static String announce(uint8_t source, long seconds)
+{
+    return ProtocolHelper::buildCommandFrame(CMD_STATUS_REQUEST, source, 1, 1, seconds);
+}
+
+static void testSingleThermostat()
+{
+    SyncListener listener;
+    listener.setup(true);
+    CHECK(listener.addThermostat(2));
+    CHECK(!listener.isSynced());
+    CHECK(listener.getSleepDuration(100000, NO_LIMIT) == 0);
+
+    // Slot in 60 s, announced at the start of a frame that took one airtime
+    unsigned long heardMs = 100000;
+    listener.onFrame(2, announce(2, 60), heardMs);
+    CHECK(listener.isSynced());
+    unsigned long slotMs = heardMs - P2P_TX_AIRTIME_MS + 60000;
+
+    // Lingers for retries, then sleeps in watchdog-sized pieces up to the guard time
+    CHECK(listener.getSleepDuration(heardMs + SYNC_SLOT_LINGER_MS - 1, NO_LIMIT) == 0);
+    CHECK(listener.getSleepDuration(heardMs + SYNC_SLOT_LINGER_MS, NO_LIMIT) == SYNC_MAX_SLEEP_MS);
+    CHECK(listener.getSleepDuration(heardMs + SYNC_SLOT_LINGER_MS, 5000) == 5000);
+    unsigned long nowMs = slotMs - SYNC_GUARD_MS - 6000;
+    CHECK(listener.getSleepDuration(nowMs, NO_LIMIT) == 6000);
+    CHECK(listener.getSleepDuration(slotMs - SYNC_GUARD_MS - SYNC_MIN_SLEEP_MS + 1, NO_LIMIT) == 0);
+
+    // A frame without an announcement ends sync
+    listener.onFrame(2, ProtocolHelper::addAddress(CMD_STOVE_ON, 2, 1), slotMs);
+    CHECK(!listener.isSynced());
+    CHECK(listener.getSleepDuration(slotMs + 30000, NO_LIMIT) == 0);
+}
+
+static void testMissedSlots()
+{
+    SyncListener listener;
+    listener.setup(true);
+    listener.addThermostat(2);
+    listener.onFrame(2, announce(2, 60), 0);
+    unsigned long slotMs = 60000 - P2P_TX_AIRTIME_MS;
+
+    // Each missed slot is predicted forward; the last allowed miss ends sync
+    for (int missed = 1; missed < SYNC_MAX_MISSED_SLOTS; missed++)
+    {
+        unsigned long nowMs = slotMs + SYNC_SLOT_WINDOW_MS + 1;
+        slotMs += 60000;
+        CHECK(listener.getSleepDuration(nowMs, NO_LIMIT) == SYNC_MAX_SLEEP_MS);
+        CHECK(listener.isSynced());
+    }
+    CHECK(listener.getSleepDuration(slotMs + SYNC_SLOT_WINDOW_MS + 1, NO_LIMIT) == 0);
+    CHECK(!listener.isSynced());
+}
+
+static void testSeveralThermostats()
+{
+    SyncListener listener;
+    listener.setup(true);
+    listener.addThermostat(2);
+    listener.addThermostat(3);
+
+    // One of two announced: the other could transmit any time
+    listener.onFrame(2, announce(2, 60), 0);
+    CHECK(!listener.isSynced());
+    CHECK(listener.getSleepDuration(SYNC_SLOT_LINGER_MS + 1000, NO_LIMIT) == 0);
+
+    // Both announced: wake for whichever comes first
+    listener.onFrame(3, announce(3, 20), 15000);
+    CHECK(listener.isSynced());
+    unsigned long firstSlotMs = 15000 - P2P_TX_AIRTIME_MS + 20000;
+    unsigned long nowMs = 15000 + SYNC_SLOT_LINGER_MS;
+    CHECK(listener.getSleepDuration(nowMs, NO_LIMIT) == firstSlotMs - SYNC_GUARD_MS - nowMs);
+
+    // Thermostat 3's slot passed; thermostat 2's comes next
+    listener.onFrame(3, announce(3, 120), firstSlotMs);
+    unsigned long secondSlotMs = 60000 - P2P_TX_AIRTIME_MS;
+    nowMs = secondSlotMs - SYNC_GUARD_MS - 8000;
+    CHECK(listener.getSleepDuration(nowMs, NO_LIMIT) == 8000);
+
+    // Thermostat 2 stops announcing: no sleep, whatever thermostat 3 does
+    listener.onFrame(2, ProtocolHelper::addAddress(CMD_STOVE_OFF, 2, 1), secondSlotMs);
+    CHECK(!listener.isSynced());
+    CHECK(listener.getSleepDuration(secondSlotMs + SYNC_SLOT_LINGER_MS + 1000, NO_LIMIT) == 0);
+
+    // Up to SYNC_MAX_THERMOSTATS sources, unaddressed frames counting as one
+    SyncListener full;
+    full.setup(true);
+    for (uint8_t id = 1; id <= SYNC_MAX_THERMOSTATS; id++)
+    {
+        CHECK(full.addThermostat(id));
+    }
+    CHECK(full.addThermostat(1));
+    CHECK(!full.addThermostat(P2P_NODE_ID_NONE));
+}
+
+int main()
+{
+    testSingleThermostat();
+    testMissedSlots();
+    testSeveralThermostats();
+    return checkSummary("sync_listener_test");
+}
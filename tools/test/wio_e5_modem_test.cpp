@@ -0,0 +1,364 @@
+/**
+ * @file wio_e5_modem_test.cpp
+ * @brief Host test: WioE5Modem's AT exchange against a scripted module
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * ScriptedPort stands in for the UART. Each command the driver sends can be
+ * given a reply: text chunks that become readable at set times after the
+ * command, on the simulated clock of tools/test/host/Arduino.h. That makes
+ * the timing paths of readResponse() (silence, echo waits, TX DONE after the
+ * airtime, a frame split by a pause) and receiveReply() (other nodes' frames
+ * before the reply) run exactly and instantly.
+ *
+ * Build and run on the host (tools/test/run_tests.sh builds every test):
+ *     g++ -std=c++17 -Itools/test/host tools/test/wio_e5_modem_test.cpp -o wio_e5_modem_test
+ *     ./wio_e5_modem_test
+ */
+
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "check.hpp"
+#include "../../shared/wio_e5_modem.hpp"
+
+/**
+ * @class ScriptedPort
+ * @brief Simulated Grove-Wio-E5 UART that answers from a script
+ */
+class ScriptedPort
+{
+public:
+    typedef std::vector<std::pair<unsigned long, std::string>> Reply; // (ms after the command, text)
+
+private:
+    struct Chunk
+    {
+        unsigned long dueMs;
+        std::string text;
+    };
+
+    std::deque<Reply> replies; // One per expected command, in order
+    std::deque<Chunk> pending;
+
+public:
+    std::vector<std::string> commands; // Every line the driver sent
+    int openCount = 0;
+
+    /**
+     * @brief Queue the module's answer to the next command
+     */
+    void expect(const Reply &reply)
+    {
+        replies.push_back(reply);
+    }
+
+    /**
+     * @brief Deliver text at an absolute time, independent of any command
+     */
+    void deliverAt(unsigned long dueMs, const std::string &text)
+    {
+        pending.push_back({dueMs, text});
+    }
+
+    void begin(unsigned long, uint32_t, int, int)
+    {
+        openCount++;
+    }
+
+    void end()
+    {
+    }
+
+    int available()
+    {
+        int count = 0;
+        for (const Chunk &chunk : pending)
+        {
+            if (chunk.dueMs > millis())
+            {
+                break;
+            }
+            count += (int)chunk.text.size();
+        }
+        return count;
+    }
+
+    int read()
+    {
+        if (pending.empty() || pending.front().dueMs > millis())
+        {
+            return -1;
+        }
+        Chunk &chunk = pending.front();
+        int c = (unsigned char)chunk.text[0];
+        chunk.text.erase(0, 1);
+        if (chunk.text.empty())
+        {
+            pending.pop_front();
+        }
+        return c;
+    }
+
+    size_t write(uint8_t)
+    {
+        return 1; // Wake bytes
+    }
+
+    size_t println(const String &line)
+    {
+        commands.push_back(line.c_str());
+        if (!replies.empty())
+        {
+            unsigned long now = millis();
+            for (const auto &step : replies.front())
+            {
+                pending.push_back({now + step.first, step.second});
+            }
+            replies.pop_front();
+        }
+        return line.length() + 2;
+    }
+};
+
+struct TestPolicy
+{
+    static const bool BAUD_SEARCH = false;
+    static const long FIXED_BAUD = 9600;
+    static const unsigned long BOOT_WAIT_MS = 1000;
+    static const unsigned long CONNECT_TIMEOUT_MS = 10000;
+    static void feedWatchdog() {}
+};
+
+typedef WioE5Modem<ScriptedPort, TestPolicy> Modem;
+
+static std::string txCommand(const String &frame)
+{
+    return std::string("AT+TEST=TXLRPKT,\"") + ProtocolHelper::asciiToHex(frame).c_str() + "\"";
+}
+
+static std::string txEcho(const String &frame)
+{
+    return std::string("+TEST: TXLRPKT \"") + ProtocolHelper::asciiToHex(frame).c_str() + "\"\r\n";
+}
+
+static void testAirtime()
+{
+    // SF12/125 kHz: about 1.9 s for a short command, over 5 s for the longest frame
+    CHECK_NEAR(ProtocolHelper::getAirtimeMs(30), 1876, 1);
+    CHECK(ProtocolHelper::getAirtimeMs(31) >= ProtocolHelper::getAirtimeMs(30));
+    CHECK(ProtocolHelper::getAirtimeMs(P2P_MAX_FRAME_LENGTH) > 5000);
+    CHECK(Modem::getTxTimeoutMs("PING") == ProtocolHelper::getAirtimeMs(4) + WIO_E5_TX_MARGIN_MS);
+}
+
+static void testPlainCommand()
+{
+    ScriptedPort port;
+    Modem modem;
+    modem.attach(&port, 1, 2);
+
+    // Reply in one piece
+    port.expect({{20, "+AT: OK\r\n"}});
+    unsigned long start = millis();
+    CHECK(modem.sendATCommand("AT", "OK", 2000));
+    CHECK(port.commands.back() == "AT");
+    CHECK(millis() - start < 20 + WIO_E5_RESPONSE_SILENCE_MS + 100);
+
+    // A bare echo, then the reply after a pause longer than the silence limit
+    port.expect({{5, "AT\r\n"}, {1200, "+AT: OK\r\n"}});
+    CHECK(modem.sendATCommand("AT", "OK", 3000));
+
+    // Reply text that isn't the expected one
+    port.expect({{20, "+MODE: LWOTAA\r\n"}});
+    CHECK(!modem.sendATCommand("AT+MODE=TEST", "TEST"));
+
+    // No answer at all: fails after the timeout, not before
+    start = millis();
+    CHECK(!modem.sendATCommand("AT", "OK", 2000));
+    CHECK(millis() - start >= 2000);
+    CHECK(millis() - start < 2100);
+
+    // Stale bytes from before the command are not part of its reply
+    port.deliverAt(millis(), "+TEST: TX DONE\r\n");
+    port.expect({{20, "+TEST: TXLRPKT \"00\"\r\n"}});
+    CHECK(!modem.sendATCommand("AT+TEST=TXLRPKT,\"00\"", "TX DONE", 2000));
+}
+
+static void testEchoThenTxDone()
+{
+    ScriptedPort port;
+    Modem modem;
+    modem.attach(&port, 1, 2);
+
+    // The echo comes at once, TX DONE only after the airtime - far past the silence limit
+    String frame = ProtocolHelper::buildCommandFrame(CMD_STOVE_ON, 2, 1, 1, 60);
+    unsigned long airtime = ProtocolHelper::getAirtimeMs(frame.length());
+    port.expect({{15, txEcho(frame)}, {15 + airtime, "+TEST: TX DONE\r\n"}});
+    unsigned long start = millis();
+    CHECK(modem.sendP2PMessage(frame));
+    CHECK(port.commands.back() == txCommand(frame));
+    CHECK(millis() - start >= airtime);
+    CHECK(millis() - start < airtime + WIO_E5_RESPONSE_SILENCE_MS + 200);
+
+    // The longest frame allowed takes over 5 s on air and still completes
+    String longFrame = frame;
+    while (longFrame.length() < P2P_MAX_FRAME_LENGTH)
+    {
+        longFrame += 'X';
+    }
+    airtime = ProtocolHelper::getAirtimeMs(longFrame.length());
+    port.expect({{15, txEcho(longFrame)}, {15 + airtime, "+TEST: TX DONE\r\n"}});
+    CHECK(modem.sendP2PMessage(longFrame));
+
+    // TX DONE split across reads
+    port.expect({{15, txEcho(frame)}, {1500, "+TEST: TX D"}, {1510, "ONE\r\n"}});
+    CHECK(modem.sendP2PMessage(frame));
+}
+
+static void testTxTimeout()
+{
+    ScriptedPort port;
+    Modem modem;
+    modem.attach(&port, 1, 2);
+
+    // Echo but no TX DONE: gives up once the airtime plus margin has passed
+    String frame = ProtocolHelper::buildCommandFrame(CMD_STOVE_OFF, 2, 1, 2, -1);
+    port.expect({{15, txEcho(frame)}});
+    unsigned long start = millis();
+    CHECK(!modem.sendP2PMessage(frame));
+    unsigned long elapsed = millis() - start;
+    CHECK(elapsed >= Modem::getTxTimeoutMs(frame));
+    CHECK(elapsed < Modem::getTxTimeoutMs(frame) + 100);
+
+    // TX DONE after the timeout is too late
+    port.expect({{15, txEcho(frame)}, {Modem::getTxTimeoutMs(frame) + 500, "+TEST: TX DONE\r\n"}});
+    CHECK(!modem.sendP2PMessage(frame));
+}
+
+static void testReceive()
+{
+    ScriptedPort port;
+    Modem modem;
+    modem.attach(&port, 1, 2);
+
+    // Reply frame split across reads by a pause longer than the silence limit
+    String reply = ProtocolHelper::addAddress(RESP_STOVE_ON_ACK, 1, 2);
+    std::string hex = ProtocolHelper::asciiToHex(reply).c_str();
+    std::string rxLine = "+TEST: LEN:" + std::to_string(reply.length()) + ", RSSI:-91, SNR:6\r\n+TEST: RX \"";
+    port.expect({{10, "+TEST: RXLRPKT\r\n"},
+                 {2500, rxLine + hex.substr(0, 9)},
+                 {3200, hex.substr(9) + "\"\r\n"}});
+    CHECK(modem.sendATCommand("AT+TEST=RXLRPKT", ""));
+    unsigned long start = millis();
+    String response = modem.readResponse(P2P_RX_TIMEOUT);
+    CHECK(response.indexOf(("+TEST: RX \"" + hex + "\"").c_str()) >= 0);
+    int quote = response.indexOf("RX \"") + 3;
+    CHECK(ProtocolHelper::hexToAscii(response.substring(quote + 1, response.indexOf('"', quote + 1))) == reply);
+
+    // ...and returned once it is complete, not at the end of the RX window
+    CHECK(millis() - start >= 3200);
+    CHECK(millis() - start < 3200 + WIO_E5_RESPONSE_SILENCE_MS + 200);
+
+    // Nothing heard: the echo alone, after the RX window
+    port.expect({{10, "+TEST: RXLRPKT\r\n"}});
+    CHECK(modem.sendATCommand("AT+TEST=RXLRPKT", ""));
+    start = millis();
+    response = modem.readResponse(P2P_RX_TIMEOUT);
+    CHECK(response == "+TEST: RXLRPKT");
+    CHECK(millis() - start >= WIO_E5_RX_DONE_WAIT_MS);
+    CHECK(millis() - start <= (unsigned long)P2P_RX_TIMEOUT + 20);
+}
+
+static std::string rxLine(const String &frame)
+{
+    return "+TEST: LEN:" + std::to_string(frame.length()) + ", RSSI:-91, SNR:6\r\n+TEST: RX \"" +
+           ProtocolHelper::asciiToHex(frame).c_str() + "\"\r\n";
+}
+
+static void testReceiveReply()
+{
+    ScriptedPort port;
+    Modem modem;
+    modem.attach(&port, 1, 2);
+
+    // Another zone's exchange heard first: the window goes on and our reply still counts
+    String foreign = ProtocolHelper::addAddress(RESP_STOVE_ON_ACK, 4, 3);
+    String reply = ProtocolHelper::addAddress(RESP_STOVE_ON_ACK, 1, 2);
+    port.expect({{10, "+TEST: RXLRPKT\r\n"}, {2000, rxLine(foreign)}, {4500, rxLine(reply)}});
+    unsigned long start = millis();
+    CHECK(modem.receiveReply(2, 1, P2P_RX_TIMEOUT) == reply);
+    CHECK(millis() - start >= 4500);
+    CHECK(millis() - start < 4600);
+    CHECK(port.commands.size() == 1);
+    CHECK(port.commands.back() == "AT+TEST=RXLRPKT");
+
+    // Both frames in one read, and our reply split by a pause
+    std::string replyLine = rxLine(reply);
+    port.expect({{10, "+TEST: RXLRPKT\r\n"},
+                 {1500, rxLine(foreign) + replyLine.substr(0, replyLine.size() - 8)},
+                 {2600, replyLine.substr(replyLine.size() - 8)}});
+    start = millis();
+    CHECK(modem.receiveReply(2, 1, P2P_RX_TIMEOUT) == reply);
+    CHECK(millis() - start >= 2600);
+    CHECK(millis() - start < 2700);
+    CHECK(port.commands.size() == 2);
+
+    // Only other nodes' frames: nothing once the window is over
+    port.expect({{10, "+TEST: RXLRPKT\r\n"}, {1000, rxLine(foreign)}, {9000, rxLine(foreign)}});
+    start = millis();
+    CHECK(modem.receiveReply(2, 1, P2P_RX_TIMEOUT) == "");
+    CHECK(millis() - start >= (unsigned long)P2P_RX_TIMEOUT);
+    CHECK(millis() - start <= (unsigned long)P2P_RX_TIMEOUT + 20);
+    CHECK(port.commands.size() == 3);
+
+    // Shipped node IDs: thermostat 2's command to receiver 1 also carries D=1,
+    // and arrives first; thermostat 1 waits on for receiver 1's reply
+    String command = ProtocolHelper::buildCommandFrame(CMD_STOVE_ON, 2, P2P_DEFAULT_RECEIVER_ID, 11, 60);
+    String ack = ProtocolHelper::addAddress(RESP_STOVE_ON_ACK, P2P_DEFAULT_RECEIVER_ID, P2P_DEFAULT_THERMOSTAT_ID);
+    for (uint8_t peer : {(uint8_t)P2P_DEFAULT_RECEIVER_ID, (uint8_t)P2P_NODE_ID_NONE})
+    {
+        port.expect({{10, "+TEST: RXLRPKT\r\n"}, {1800, rxLine(command)}, {5200, rxLine(ack)}});
+        start = millis();
+        CHECK(modem.receiveReply(P2P_DEFAULT_THERMOSTAT_ID, peer, P2P_RX_TIMEOUT) == ack);
+        CHECK(millis() - start >= 5200);
+        CHECK(millis() - start < 5300);
+    }
+    CHECK(port.commands.size() == 5);
+}
+
+static void testConnect()
+{
+    ScriptedPort port;
+    Modem modem;
+    modem.attach(&port, 1, 2);
+
+    // Silent through the boot, then answers the second probe
+    port.expect({});
+    port.expect({{30, "+AT: OK\r\n"}});
+    CHECK(modem.connect());
+    CHECK(modem.getBaudRate() == TestPolicy::FIXED_BAUD);
+    CHECK(port.openCount == 1);
+    CHECK(port.commands.size() == 2);
+
+    // resume() fails without an answer and leaves connect()'s result alone
+    ScriptedPort deadPort;
+    Modem deadModem;
+    deadModem.attach(&deadPort, 1, 2);
+    CHECK(!deadModem.resume(2));
+    CHECK(deadModem.getBaudRate() == 0);
+    CHECK(deadPort.commands.size() == 2);
+}
+
+int main()
+{
+    testAirtime();
+    testPlainCommand();
+    testEchoThenTxDone();
+    testTxTimeout();
+    testReceive();
+    testReceiveReply();
+    testConnect();
+    return checkSummary("wio_e5_modem_test");
+}